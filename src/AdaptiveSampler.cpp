@@ -0,0 +1,260 @@
+#include <cmath>
+#include <sstream>
+
+#include "AdaptiveSampler.h"
+#include "Rand.h"
+#include "Options.h"
+#include "Log.h"
+
+AdaptiveSampler* AdaptiveSampler::m_Instance = nullptr;
+
+
+AdaptiveSampler* AdaptiveSampler::Instance() {
+
+    if (!m_Instance) {
+        m_Instance = new AdaptiveSampler();
+    }
+    return m_Instance;
+}
+
+
+/*
+ * Initialise the adaptive importance sampler
+ *
+ * Reads the sampler's program options and compiles the hit predicate.  The sampler is enabled
+ * only if --initial-sampling AIS was specified and the evolution mode is BSE - otherwise this
+ * is a no-op and Weight() returns 1.0 for every binary.
+ *
+ * The exploration phase is sized from the number of binaries main will evolve (see Options::CountSystemsToEvolve()),
+ * which allows for grid files and commandline options specified as ranges or sets.
+ *
+ *
+ * bool Initialise()
+ *
+ * @return                                      Boolean status (true = ok, false = hit predicate could not be compiled, or grid file could not be read)
+ */
+bool AdaptiveSampler::Initialise() {
+
+    m_Enabled = OPTIONS->InitialSampling() == INITIAL_SAMPLING::AIS && OPTIONS->EvolutionMode() == EVOLUTION_MODE::BSE;
+    if (!m_Enabled) return true;
+
+    if (!LOGGING->CompilePredicate(OPTIONS->AISHitPredicate(), m_HitPredicate)) {                  // compile the hit predicate
+        m_Enabled = false;                                                                          // failed - error already shown
+        return false;
+    }
+
+    long int systems = OPTIONS->CountSystemsToEvolve();                                             // number of binaries main will evolve
+    if (systems < 0) {                                                                              // counted ok?
+        LOGGING->Squawk(ERR_MSG(ERROR::FILE_READ_ERROR) + " while counting the binaries in grid file " + OPTIONS->GridFilename());  // no - show error
+        m_Enabled = false;
+        return false;
+    }
+
+    m_DefensiveFraction  = OPTIONS->AISExploratoryFraction();
+    m_ExploratorySystems = std::max(1UL, static_cast<unsigned long int>(std::ceil(m_DefensiveFraction * systems)));
+    m_BatchSize          = static_cast<unsigned long int>(OPTIONS->AISBatchSize());
+    m_Kappa              = OPTIONS->AISKappa();
+
+    m_ActiveDimensions.assign(static_cast<size_t>(QMC_DIMENSION::COUNT), false);
+    m_Point.assign(static_cast<size_t>(QMC_DIMENSION::COUNT), 0.0);
+
+    m_Hits.clear();
+    m_Components.clear();
+    m_ComponentNorm.clear();
+
+    m_Systems           = 0;
+    m_SystemsSinceRefit = 0;
+    m_HitsExploration   = 0;
+    m_HitsRefinement    = 0;
+    m_WeightedHits      = 0.0;
+    m_WeightedHitsSq    = 0.0;
+
+    return true;
+}
+
+
+/*
+ * Draw the initial-condition point for the next binary
+ *
+ * Called once per binary, before its initial conditions are sampled.  Refits the proposal at the
+ * end of the exploration phase and after every batch in the refinement phase, draws a point from
+ * the current proposal, calculates its importance weight, and hands the point to the random number
+ * service to be consumed by the initial-condition samplers.
+ *
+ * No-op if the sampler is not enabled.
+ *
+ *
+ * void NextPoint()
+ */
+void AdaptiveSampler::NextPoint() {
+
+    if (!m_Enabled) return;
+
+    if (m_Systems == m_ExploratorySystems ||                                                        // end of exploration phase?
+       (m_Systems > m_ExploratorySystems && m_SystemsSinceRefit >= m_BatchSize)) {                  // or end of refinement batch?
+        RefitProposal();                                                                            // yes - refit
+    }
+
+    if (m_Components.empty() || RAND->Random() < m_DefensiveFraction) {                            // draw from the prior?
+        for (auto &coordinate : m_Point) coordinate = RAND->Random();                              // yes
+    }
+    else {                                                                                          // no - draw from a mixture component
+        const std::vector<double>& centre = m_Components[RAND->RandomInt(static_cast<int>(m_Components.size()))];
+        for (size_t dimension = 0; dimension < m_Point.size(); dimension++) {
+            if (m_ActiveDimensions[dimension]) {
+                double coordinate;
+                do { coordinate = centre[dimension] + RAND->RandomGaussian(m_Sigma); } while (coordinate <= 0.0 || coordinate >= 1.0);  // truncated to the unit interval
+                m_Point[dimension] = coordinate;
+            }
+            else m_Point[dimension] = RAND->Random();                                               // dimension not sampled - uniform
+        }
+    }
+
+    m_Weight = m_Components.empty() ? 1.0 : 1.0 / ProposalDensity(m_Point);
+
+    RAND->QuasiRandomPoint(m_Point);
+
+    m_Systems++;
+    m_SystemsSinceRefit++;
+}
+
+
+/*
+ * Record the outcome of the current binary
+ *
+ * Called once per binary at the end of its evolution.  During the exploration phase records which
+ * dimensions of the point were consumed by the initial-condition samplers (only those dimensions
+ * are adapted).  Hits are added to the list of hits used at the next refit, and counted towards
+ * the estimated hit fraction.
+ *
+ *
+ * void RecordOutcome(const bool p_Hit)
+ *
+ * @param   [IN]    p_Hit                       Whether the binary satisfied the hit predicate
+ */
+void AdaptiveSampler::RecordOutcome(const bool p_Hit) {
+
+    if (!m_Enabled) return;
+
+    bool exploring = m_Systems <= m_ExploratorySystems;
+
+    if (exploring) {
+        for (size_t dimension = 0; dimension < m_ActiveDimensions.size(); dimension++) {
+            if (RAND->QuasiRandomDimensionUsed(static_cast<QMC_DIMENSION>(dimension))) m_ActiveDimensions[dimension] = true;
+        }
+    }
+
+    if (!p_Hit) return;
+
+    if (exploring) m_HitsExploration++;
+    else           m_HitsRefinement++;
+
+    m_Hits.push_back(m_Point);
+    m_WeightedHits   += m_Weight;
+    m_WeightedHitsSq += m_Weight * m_Weight;
+}
+
+
+/*
+ * Refit the proposal distribution
+ *
+ * One Gaussian component per hit so far, with width kappa x N_explore^(-1/D) in each of the D active
+ * dimensions.  The truncation normalisation of each component (the probability mass of the
+ * untruncated Gaussian inside the unit hypercube) is precomputed here for ProposalDensity().
+ *
+ *
+ * void RefitProposal()
+ */
+void AdaptiveSampler::RefitProposal() {
+
+    m_SystemsSinceRefit = 0;
+
+    int activeDimensions = 0;
+    for (bool active : m_ActiveDimensions) if (active) activeDimensions++;
+
+    if (activeDimensions == 0 || m_Hits.empty()) {                                                  // nothing to adapt to
+        m_Components.clear();
+        m_ComponentNorm.clear();
+        return;
+    }
+
+    m_Sigma      = m_Kappa * std::pow(static_cast<double>(m_ExploratorySystems), -1.0 / static_cast<double>(activeDimensions));
+    m_Components = m_Hits;
+
+    auto Phi = [](const double p_X) { return 0.5 * std::erfc(-p_X / std::sqrt(2.0)); };           // standard normal CDF
+
+    m_ComponentNorm.resize(m_Components.size());
+    for (size_t component = 0; component < m_Components.size(); component++) {
+        double norm = 1.0;
+        for (size_t dimension = 0; dimension < m_ActiveDimensions.size(); dimension++) {
+            if (!m_ActiveDimensions[dimension]) continue;
+            double mu = m_Components[component][dimension];
+            norm *= Phi((1.0 - mu) / m_Sigma) - Phi(-mu / m_Sigma);
+        }
+        m_ComponentNorm[component] = norm;
+    }
+}
+
+
+/*
+ * Calculate the density of the current proposal at the specified point
+ *
+ * q(u) = f + (1 - f) x (1/H) x sum_h [ prod_d N(u_d; mu_hd, sigma) / Z_h ]
+ *
+ * Inactive dimensions are uniform under both the prior and the proposal, so do not contribute.
+ *
+ *
+ * double ProposalDensity(const std::vector<double>& p_Point)
+ *
+ * @param   [IN]    p_Point                     The point at which to evaluate the density
+ * @return                                      Proposal density (relative to the uniform prior)
+ */
+double AdaptiveSampler::ProposalDensity(const std::vector<double>& p_Point) const {
+
+    const double normalisation = 1.0 / (m_Sigma * std::sqrt(2.0 * M_PI));
+
+    double mixture = 0.0;
+    for (size_t component = 0; component < m_Components.size(); component++) {
+        double density = 1.0;
+        for (size_t dimension = 0; dimension < m_ActiveDimensions.size(); dimension++) {
+            if (!m_ActiveDimensions[dimension]) continue;
+            double z = (p_Point[dimension] - m_Components[component][dimension]) / m_Sigma;
+            density *= normalisation * std::exp(-0.5 * z * z);
+        }
+        mixture += density / m_ComponentNorm[component];
+    }
+
+    return m_DefensiveFraction + (1.0 - m_DefensiveFraction) * mixture / static_cast<double>(m_Components.size());
+}
+
+
+/*
+ * Summary of the sampler's run, for the run details file
+ *
+ * The estimated hit fraction is the importance-weighted mean of the hit indicator over all binaries
+ * sampled, with its standard error.
+ *
+ *
+ * std::string Summary()
+ *
+ * @return                                      Multi-line summary (empty if the sampler is not enabled)
+ */
+std::string AdaptiveSampler::Summary() const {
+
+    if (!m_Enabled) return "";
+
+    double n      = static_cast<double>(std::max(1UL, m_Systems));
+    double mean   = m_WeightedHits / n;
+    double stdErr = std::sqrt(std::max(0.0, m_WeightedHitsSq / n - mean * mean) / n);
+
+    std::ostringstream ss;
+    ss << "\nAdaptive importance sampling:\n"
+       << "  Binaries sampled         = " << m_Systems << "\n"
+       << "  Exploratory binaries     = " << std::min(m_Systems, m_ExploratorySystems) << "\n"
+       << "  Hits (exploration)       = " << m_HitsExploration << "\n"
+       << "  Hits (refinement)        = " << m_HitsRefinement << "\n"
+       << "  Proposal components      = " << m_Components.size() << "\n"
+       << "  Estimated hit fraction   = " << mean << " +/- " << stdErr << "\n";
+
+    return ss.str();
+}
@@ -0,0 +1,115 @@
+#ifndef __AdaptiveSampler_h__
+#define __AdaptiveSampler_h__
+
+#define SAMPLER AdaptiveSampler::Instance()
+
+#include <string>
+#include <vector>
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+/*
+ * AdaptiveSampler Singleton - in-process adaptive importance sampling of binary initial conditions
+ *
+ * Enabled with program option --initial-sampling AIS (BSE mode only).  The sampler works in the unit
+ * hypercube of initial-condition uniforms: each binary's initial conditions are drawn by the usual
+ * inverse-CDF samplers (utils::Sample*()), but the first uniform each sampler draws comes from a point
+ * supplied by this sampler (see Rand::QuasiRandomPoint()).  Because the prior is uniform on the unit
+ * hypercube the importance weight of a binary is simply 1 / q(u), where q is the proposal density at
+ * the point u - no knowledge of the individual initial-condition distributions is required.
+ *
+ * The sampler runs in two phases (after the STROOPWAFEL algorithm, Broekgaarden et al. 2019):
+ *
+ *     exploration: the first (--ais-exploratory-fraction x number of binaries evolved) binaries are sampled from
+ *                  the prior (weight 1).  Binaries that satisfy the hit predicate (--ais-hit-predicate)
+ *                  are recorded as hits.
+ *
+ *     refinement : binaries are sampled from the defensive mixture
+ *
+ *                      q(u) = f x 1 + (1 - f) x g(u)
+ *
+ *                  where f is the exploratory fraction and g is a mixture of Gaussians (truncated to the
+ *                  unit hypercube), one per hit, with width kappa x N_explore^(-1/D) in each of the D
+ *                  dimensions actually sampled.  g is refitted (new hits added) after every batch of
+ *                  --ais-batch-size binaries.
+ *
+ * Every binary is an unbiased sample (the weight of each binary corrects for the proposal in force when it
+ * was drawn), so population estimates are sum(weight x f(binary)) / number of binaries.  The importance
+ * weight is written to the BSE system parameters logfile (BINARY_PROPERTY::IMPORTANCE_WEIGHT).
+ *
+ * Initial conditions redrawn by the binary constructor (e.g. stars touching at birth) fall back to the
+ * pseudo-random stream and carry the weight of the original point - as with QMC sampling.
+ */
+
+class AdaptiveSampler {
+
+private:
+
+    AdaptiveSampler() {
+        m_Enabled            = false;
+        m_ExploratorySystems = 0;
+        m_BatchSize          = 0;
+        m_Kappa              = 1.0;
+        m_DefensiveFraction  = 1.0;
+        m_Sigma              = 0.0;
+        m_Systems            = 0;
+        m_SystemsSinceRefit  = 0;
+        m_Weight             = 1.0;
+        m_HitsExploration    = 0;
+        m_HitsRefinement     = 0;
+        m_WeightedHits       = 0.0;
+        m_WeightedHitsSq     = 0.0;
+    };
+    AdaptiveSampler(AdaptiveSampler const&) = delete;
+    AdaptiveSampler& operator = (AdaptiveSampler const&) = delete;
+
+    static AdaptiveSampler* m_Instance;
+
+    bool                             m_Enabled;                                     // adaptive importance sampling enabled?
+    std::vector<PredicateTokenT>     m_HitPredicate;                                // compiled hit predicate
+
+    unsigned long int                m_ExploratorySystems;                          // number of binaries in the exploration phase
+    unsigned long int                m_BatchSize;                                   // number of binaries between proposal refits
+    double                           m_Kappa;                                       // proposal component width scale factor
+    double                           m_DefensiveFraction;                           // fraction of the proposal that is the prior (= exploratory fraction)
+
+    std::vector<bool>                m_ActiveDimensions;                            // dimensions consumed by the initial-condition samplers (seen during exploration)
+    std::vector<std::vector<double>> m_Hits;                                        // points of all hits so far
+    std::vector<std::vector<double>> m_Components;                                  // centres of the proposal mixture components
+    std::vector<double>              m_ComponentNorm;                               // truncation normalisation of each component
+    double                           m_Sigma;                                       // proposal component width (in each active dimension)
+
+    unsigned long int                m_Systems;                                     // number of binaries sampled
+    unsigned long int                m_SystemsSinceRefit;                           // number of binaries sampled since the proposal was last refitted
+    std::vector<double>              m_Point;                                       // point for the current binary
+    double                           m_Weight;                                      // importance weight of the current binary
+
+    unsigned long int                m_HitsExploration;                             // number of hits in the exploration phase
+    unsigned long int                m_HitsRefinement;                              // number of hits in the refinement phase
+    double                           m_WeightedHits;                                // sum of weights of hits
+    double                           m_WeightedHitsSq;                              // sum of squared weights of hits
+
+    double ProposalDensity(const std::vector<double>& p_Point) const;
+    void   RefitProposal();
+
+
+public:
+
+    static AdaptiveSampler* Instance();
+
+    bool   Initialise();
+
+    bool   Enabled() const                                                          { return m_Enabled; }
+    const  std::vector<PredicateTokenT>& HitPredicate() const                       { return m_HitPredicate; }
+    double Weight() const                                                           { return m_Enabled ? m_Weight : 1.0; }
+
+    void   NextPoint();
+    void   RecordOutcome(const bool p_Hit);
+
+    std::string Summary() const;
+};
+
+
+#endif // __AdaptiveSampler_h__
@@ -1,9 +1,22 @@
 #include "BaseBinaryStar.h"
 #include "vector3d.h"
+#include "CoalescenceTime.h"
+#include "TrackLibrary.h"
+#include "powers.h"
 
 // gsl includes
 #include <gsl/gsl_poly.h>
 
+#include <sstream>
+#include <chrono>
+
+#include <boost/numeric/odeint.hpp>
+
+BaseBinaryStar::MassTransferOrbitValidationT BaseBinaryStar::m_MassTransferOrbitValidation = { 0, 0, 0, 0.0, 0.0, 0.0 };
+BaseBinaryStar::DonorRadiusValidationT        BaseBinaryStar::m_DonorRadiusValidation        = { 0, 0, 0.0, 0.0, 0.0 };
+BaseBinaryStar::NonInteractingFastPathT       BaseBinaryStar::m_NonInteractingFastPath       = { 0, 0, 0, 0, 0, 0.0 };
+BaseBinaryStar::CullingT                      BaseBinaryStar::m_Culling                      = { 0, 0, 0, 0, 0.0 };
+
 
 /* Constructor
  *
@@ -82,9 +95,31 @@ BaseBinaryStar::BaseBinaryStar(const unsigned long int p_Seed, const long int p_
     // initial conditions (so might leave the insufficient space for the  (say) one to be
     // sampled...)
 
+    // the kick random values not specified by the user are drawn here, for each star (star 1 first), from the
+    // kick substream of the binary (see Rand::Stream()) rather than taken from the program options: the program
+    // options draw them when the options are advanced - from the generator as the previous binary left it - so
+    // would make the evolution of this binary depend on the binaries evolved before it.  The substream is keyed
+    // by the random seed of the binary, and leaves the draws from the main generator (initial conditions and
+    // evolution) as they were.
+
+    for (KickParameters *kickParameters : { &kickParameters1, &kickParameters2 }) {
+        RAND->Stream(RANDOM_STREAM::SUPERNOVA_KICK, true);
+        if (!kickParameters->magnitudeRandomSpecified) kickParameters->magnitudeRandom = RAND->Random();
+        if (!kickParameters->thetaSpecified || !kickParameters->phiSpecified) {
+            double theta, phi;
+            std::tie(theta, phi) = utils::DrawKickDirection(OPTIONS->KickDirectionDistribution(), OPTIONS->KickDirectionPower());
+            if (!kickParameters->thetaSpecified) kickParameters->theta = theta;
+            if (!kickParameters->phiSpecified)   kickParameters->phi   = phi;
+        }
+        if (!kickParameters->meanAnomalySpecified) kickParameters->meanAnomaly = RAND->Random(0.0, _2_PI);
+        RAND->StreamClear();
+    }
+
     int tries = 0;
     do {
 
+        RAND->Stream(RANDOM_STREAM::INITIAL_CONDITIONS);                                                                                // common random numbers: initial conditions substream (no-op unless --common-random-numbers)
+
         double mass1 = OPTIONS->OptionSpecified("initial-mass-1") == 1                                                                  // user specified primary mass?
                         ? OPTIONS->InitialMass1()                                                                                       // yes, use it
                         : utils::SampleInitialMass(OPTIONS->InitialMassFunction(), 
@@ -148,6 +183,8 @@ BaseBinaryStar::BaseBinaryStar(const unsigned long int p_Seed, const long int p_
                                                         OPTIONS->EccentricityDistributionMax(), 
                                                         OPTIONS->EccentricityDistributionMin());                                        // no, sample it
 
+        RAND->StreamClear();
+
         // binary star contains two instances of star to hold masses, radii and luminosities.
         // star 1 initially more massive
         m_Star1 = OPTIONS->OptionSpecified("rotational-frequency-1") == 1                                                               // user specified primary rotational frequency?
@@ -239,6 +276,22 @@ void BaseBinaryStar::SetInitialValues(const unsigned long int p_Seed, const long
     m_RandomSeed  = p_Seed;
     m_Id          = p_Id;
 
+    m_ImportanceWeight = SAMPLER->Weight();                                                             // 1.0 unless adaptive importance sampling
+
+    m_KickResample.branch     = 0;                                                                      // evolved from ZAMS
+    m_KickResample.weight     = 1.0;                                                                    // 1.0 until a supernova is resampled
+    m_KickResample.supernovae = 0;
+    m_KickResample.stepNum    = 0;
+    m_KickResample.resume     = false;
+
+    m_Fork.variation          = 0;                                                                      // evolved for the first variation
+    m_Fork.stepNum            = 0;
+    m_Fork.snapshotStepNum    = 0;
+    m_Fork.dt                 = 0.0;
+    m_Fork.stagedRecords      = 0;
+    m_Fork.resume             = false;
+    m_ForkSnapshot            = nullptr;
+
     if (OPTIONS->PopulationDataPrinting()) {                                                            // user wants to see details of binary?
         SAY("Using supplied random seed " << m_RandomSeed << " for Binary Star id = " << m_ObjectId);   // yes - show them
     }
@@ -346,6 +399,7 @@ void BaseBinaryStar::SetRemainingValues() {
 	m_Dt                                         = DEFAULT_INITIAL_DOUBLE_VALUE;
     m_TimePrev                                   = DEFAULT_INITIAL_DOUBLE_VALUE;
     m_DCOFormationTime                           = DEFAULT_INITIAL_DOUBLE_VALUE;
+    m_WDWDCoalescenceTime                        = DEFAULT_INITIAL_DOUBLE_VALUE;
 
     m_aMassLossDiff                              = DEFAULT_INITIAL_DOUBLE_VALUE;
 
@@ -404,6 +458,8 @@ void BaseBinaryStar::SetRemainingValues() {
 
     m_PrintExtraDetailedOutput                   = false;
 
+    m_DetailedOutputSample.stepsSincePrint       = 0;
+
 	// RLOF details
     m_RLOFDetails.experiencedRLOF                = false;
     m_RLOFDetails.immediateRLOFPostCEE           = false;
@@ -580,8 +636,12 @@ COMPAS_VARIABLE BaseBinaryStar::BinaryPropertyValue(const T_ANY_PROPERTY p_Prope
         case BINARY_PROPERTY::ECCENTRICITY_PRE_SUPERNOVA:                           value = EccentricityPreSN();                                                break;
         case BINARY_PROPERTY::ECCENTRICITY_PRE_COMMON_ENVELOPE:                     value = EccentricityPreCEE();                                               break;
         case BINARY_PROPERTY::ERROR:                                                value = Error();                                                            break;
+        case BINARY_PROPERTY::FORK_VARIATION:                                       value = ForkVariation();                                                    break;
         case BINARY_PROPERTY::ID:                                                   value = ObjectId();                                                         break;
         case BINARY_PROPERTY::IMMEDIATE_RLOF_POST_COMMON_ENVELOPE:                  value = ImmediateRLOFPostCEE();                                             break;
+        case BINARY_PROPERTY::IMPORTANCE_WEIGHT:                                   value = ImportanceWeight();                                                 break;
+        case BINARY_PROPERTY::KICK_RESAMPLE_BRANCH:                                 value = KickResampleBranch();                                               break;
+        case BINARY_PROPERTY::KICK_RESAMPLE_WEIGHT:                                 value = KickResampleWeight();                                               break;
         case BINARY_PROPERTY::MASS_1_FINAL:                                         value = Mass1Final();                                                       break;
         case BINARY_PROPERTY::MASS_1_POST_COMMON_ENVELOPE:                          value = Mass1PostCEE();                                                     break;
         case BINARY_PROPERTY::MASS_1_PRE_COMMON_ENVELOPE:                           value = Mass1PreCEE();                                                      break;
@@ -792,6 +852,85 @@ bool BaseBinaryStar::HasTwoOf(STELLAR_TYPE_LIST p_List) const {
 }
 
 
+/*
+ * Write detailed output record to BSE detailed output logfile if detailed output is enabled
+ *
+ * Records the state of the binary at the time the record is printed, for use by PrintDetailedOutputSampled().
+ *
+ * Kick resampling branches (see TakeKickResampleSnapshot()) do not print detailed output - the detailed
+ * output file records the binary evolved from ZAMS only.
+ *
+ *
+ * bool PrintDetailedOutput(const long int p_Id, const string p_Rec)
+ *
+ * @param   [IN]    p_Id                        Object id of the binary - used to name the detailed output file
+ * @param   [IN]    p_Rec                       pre-formatted record to be written to file (default is empty string)
+ * @return                                      Boolean status (true = success, false = failure)
+ */
+bool BaseBinaryStar::PrintDetailedOutput(const long int p_Id, const string p_Rec) {
+
+    if (!OPTIONS->DetailedOutput() || IsKickResampleBranch()) return true;  // do not print if detailed output off, or kick resampling branch
+
+    m_DetailedOutputSample.stepsSincePrint = 0;                 // record state at this record
+    m_DetailedOutputSample.mass1           = m_Star1->Mass();
+    m_DetailedOutputSample.mass2           = m_Star2->Mass();
+    m_DetailedOutputSample.radius1         = m_Star1->Radius();
+    m_DetailedOutputSample.radius2         = m_Star2->Radius();
+    m_DetailedOutputSample.semiMajorAxis   = m_SemiMajorAxis;
+    m_DetailedOutputSample.stellarType1    = m_Star1->StellarType();
+    m_DetailedOutputSample.stellarType2    = m_Star2->StellarType();
+    m_DetailedOutputSample.isRLOF1         = m_Star1->IsRLOF();
+    m_DetailedOutputSample.isRLOF2         = m_Star2->IsRLOF();
+
+    return LOGGING->LogBSEDetailedOutput(this, p_Id, p_Rec);
+}
+
+
+/*
+ * Write detailed output record to BSE detailed output logfile if detailed output is enabled, subject to
+ * the detailed output sampling policy
+ *
+ * This is used for the per-timestep detailed output record.  A record is printed if:
+ *
+ *    - the stellar type or RLOF state of either star has changed since the last record, or
+ *    - at least OPTIONS->DetailedOutputSampleInterval() timesteps have passed since the last record, or
+ *    - the mass or radius of either star, or the semi-major axis, has changed by more than the fraction
+ *      specified by OPTIONS->DetailedOutputMassDelta(), DetailedOutputRadiusDelta(), or
+ *      DetailedOutputSeparationDelta() since the last record (each ignored if 0.0)
+ *
+ * With the default sampling interval of 1 a record is printed at every timestep.  Records printed at the
+ * start and end of evolution, and at events (stellar type changes etc.), are printed via PrintDetailedOutput()
+ * and are always kept.
+ *
+ *
+ * bool PrintDetailedOutputSampled(const long int p_Id)
+ *
+ * @param   [IN]    p_Id                        Object id of the binary - used to name the detailed output file
+ * @return                                      Boolean status (true = success, false = failure)
+ */
+bool BaseBinaryStar::PrintDetailedOutputSampled(const long int p_Id) {
+
+    if (!OPTIONS->DetailedOutput() || IsKickResampleBranch()) return true;  // do not print if detailed output off, or kick resampling branch
+
+    auto changed = [](const double p_Now, const double p_Then, const double p_Delta) {
+        return p_Delta > 0.0 && std::abs(p_Now - p_Then) > p_Delta * std::abs(p_Then);
+    };
+
+    bool print = ++m_DetailedOutputSample.stepsSincePrint >= OPTIONS->DetailedOutputSampleInterval() ||
+                 m_Star1->StellarType() != m_DetailedOutputSample.stellarType1                     ||
+                 m_Star2->StellarType() != m_DetailedOutputSample.stellarType2                     ||
+                 m_Star1->IsRLOF()      != m_DetailedOutputSample.isRLOF1                          ||
+                 m_Star2->IsRLOF()      != m_DetailedOutputSample.isRLOF2                          ||
+                 changed(m_Star1->Mass(),   m_DetailedOutputSample.mass1,         OPTIONS->DetailedOutputMassDelta())   ||
+                 changed(m_Star2->Mass(),   m_DetailedOutputSample.mass2,         OPTIONS->DetailedOutputMassDelta())   ||
+                 changed(m_Star1->Radius(), m_DetailedOutputSample.radius1,       OPTIONS->DetailedOutputRadiusDelta()) ||
+                 changed(m_Star2->Radius(), m_DetailedOutputSample.radius2,       OPTIONS->DetailedOutputRadiusDelta()) ||
+                 changed(m_SemiMajorAxis,   m_DetailedOutputSample.semiMajorAxis, OPTIONS->DetailedOutputSeparationDelta());
+
+    return print ? PrintDetailedOutput(p_Id) : true;
+}
+
+
 /*
  * Write RLOF parameters to RLOF logfile if RLOF printing is enabled and at least one of the stars is in RLOF
  *
@@ -985,9 +1124,10 @@ void BaseBinaryStar::SetPostCEEValues(const double p_SemiMajorAxis,
 
 
 /*
- * Calculate the time to coalescence for a binary with arbitrary eccentricity using interpolation
+ * Calculate the time to coalescence for a binary with arbitrary eccentricity
  *
- * Peters 1964 http://journals.aps.org/pr/pdf/10.1103/PhysRev.136.B1224, eq 5.14
+ * Peters 1964 http://journals.aps.org/pr/pdf/10.1103/PhysRev.136.B1224, eq 5.14 - evaluated per program
+ * option --coalescence-time-kernel (see CoalescenceTime.h)
  *
  *
  * double CalculateTimeToCoalescence(const double p_SemiMajorAxis,
@@ -1005,44 +1145,60 @@ double BaseBinaryStar::CalculateTimeToCoalescence(const double p_SemiMajorAxis,
                                                   const double p_Eccentricity,
                                                   const double p_Mass1,
                                                   const double p_Mass2) const {
+    return COALESCENCE_TIME->TimeToCoalescence(p_SemiMajorAxis, p_Eccentricity, p_Mass1, p_Mass2);
+}
 
-    double beta    = (64.0 / 5.0) * G * G * G * p_Mass1 * p_Mass2 * (p_Mass1 + p_Mass2) / (C * C * C * C * C);  // defined in Equation 5.9 in Peters 1964 http://journals.aps.org/pr/pdf/10.1103/PhysRev.136.B1224
-    double _4_beta = 4.0 * beta;
-
-    double tC = p_SemiMajorAxis * p_SemiMajorAxis * p_SemiMajorAxis * p_SemiMajorAxis / _4_beta;                // time for a circular binary to merge
-
-    // calculate t/tc using the interpolated function
-
-    if (utils::Compare(p_Eccentricity, 0) != 0) {
 
-        double e0_2  = p_Eccentricity * p_Eccentricity;
-        double c0    = p_SemiMajorAxis * (1.0 - e0_2) * PPOW(p_Eccentricity, -12.0/19.0) * PPOW(1.0 + (121.0 * e0_2 / 304.0), -870.0/2299.0);
+/*
+ * Calculate the timestep for a fast-forwarded binary
+ *
+ * Program option --fast-forward-compact-binaries: once both stars are compact objects (WD, NS or BH)
+ * and neither is overflowing its Roche lobe, nothing further happens to the binary between events - the
+ * orbit is not changed (gravitational radiation is accounted for by the coalescence time), and white dwarf
+ * cooling and isolated pulsar spin-down (NS::UpdateMagneticFieldAndSpin()) are closed-form in the timestep.
+ * Rather than timestepping, the binary is stepped directly to the next of:
+ *
+ *    - coalescence: DCO formation time + time to coalescence for double compact objects (see ResolveCoalescence()),
+ *      or the time of coalescence for double white dwarfs (calculated here, once)
+ *    - the maximum evolution time
+ *    - the next multiple of program option --fast-forward-output-interval (if > 0), so pulsar evolution
+ *      parameters and detailed output are logged at those times
+ *
+ * The timestep taken is nudged so the binary lands just past a coalescence or the maximum evolution time,
+ * where the stopping conditions in Evolve() (which compare strictly) end evolution.
+ *
+ *
+ * double CalculateFastForwardTimestep()
+ *
+ * @return                                      Timestep to the next event in Myr
+ */
+double BaseBinaryStar::CalculateFastForwardTimestep() {
 
-		double _4_c0 = c0 * c0 * c0 * c0;
+    double eventTime = OPTIONS->MaxEvolutionTime();                                                             // the maximum evolution time is always an event
 
-        if (utils::Compare(p_Eccentricity, 0.01) < 0) {
-            tC = _4_c0 *PPOW(p_Eccentricity, 48.0/19.0) / _4_beta;
+    if (!IsUnbound()) {                                                                                         // bound binary?
+        if (IsDCO() && m_DCOFormationTime != DEFAULT_INITIAL_DOUBLE_VALUE) {                                    // yes - double compact object (coalescence resolved)?
+            eventTime = std::min(eventTime, m_DCOFormationTime + m_TimeToCoalescence);                          // yes - coalescence
         }
-        else if (utils::Compare(p_Eccentricity, 0.99) > 0) {
-
-            double _1_e0_2 = 1.0 - e0_2;
-            tC *= (768.0 / 425.0) * (_1_e0_2 * _1_e0_2 * _1_e0_2 * sqrt(_1_e0_2));                              // approximation of eq. 5.14 of Peters 1964, for high eccentricities
+        else if (IsWDandWD()) {                                                                                 // double white dwarf?
+            if (m_WDWDCoalescenceTime == DEFAULT_INITIAL_DOUBLE_VALUE) {                                        // yes - time of coalescence not yet calculated?
+                double tC             = CalculateTimeToCoalescence(m_SemiMajorAxis * AU, m_Eccentricity, m_Star1->Mass() * MSOL_TO_KG, m_Star2->Mass() * MSOL_TO_KG);
+                m_WDWDCoalescenceTime = m_Time + (tC / SECONDS_IN_YEAR) * YEAR_TO_MYR;                          // time of coalescence in Myr
+            }
+            eventTime = std::min(eventTime, m_WDWDCoalescenceTime);                                             // coalescence
         }
-        else {
-
-            double sum = 0.0;
-            double de  = p_Eccentricity / 10000;
+    }
 
-            for (double e = 0.0; utils::Compare(e, p_Eccentricity) < 0; e += de) {
-                double _1_e_2 = 1.0 - (e * e);
-                sum += de * PPOW(e, 29.0 / 19.0) * PPOW((1.0 + (121.0 / 304.0) * e * e), 1181.0 / 2299.0) / ( _1_e_2 * sqrt( _1_e_2));
-            }
+    double dt = std::max(eventTime - m_Time, NUCLEAR_MINIMUM_TIMESTEP);                                        // not less than minimum
+    while (m_Time + dt <= eventTime) dt = std::nextafter(dt, std::numeric_limits<double>::max());             // land just past the event
 
-            tC = (12.0 / 19.0) * (_4_c0 / beta) * sum;
-        }
+    double interval = OPTIONS->FastForwardOutputInterval();
+    if (interval > 0.0) {                                                                                       // output times requested?
+        double outputTime = (std::floor(m_Time / interval) + 1.0) * interval;                                  // yes - next output time
+        if (outputTime < m_Time + dt) dt = std::max(outputTime - m_Time, NUCLEAR_MINIMUM_TIMESTEP);            // stop there first (evolution continues)
     }
 
-    return tC;
+    return dt;
 }
 
 
@@ -1257,6 +1413,9 @@ bool BaseBinaryStar::ResolveSupernova() {
         UpdateSystemicVelocity(centerOfMassVelocity.RotateVector(m_ThetaE, m_PhiE, m_PsiE));                            // Update the system velocity with the new center of mass velocity
 
 
+        /////////////////////////////////////////////////////////////////////////////////////////
+        RAND->Stream(RANDOM_STREAM::SUPERNOVA_ORIENTATION);                                                            // common random numbers: Euler angles substream (no-op unless --common-random-numbers)
+
         /////////////////////////////////////////////////////////////////////////////////////////
         // Split off and evaluate depending on whether the binary is now bound or unbound
 	    if (utils::Compare(m_Eccentricity, 1.0) >= 0) {                                                                     
@@ -1359,6 +1518,8 @@ bool BaseBinaryStar::ResolveSupernova() {
             m_PsiE = _2_PI * RAND->Random();
         }
 
+        RAND->StreamClear();
+
         // Undefine the pre-processor commands 
         #undef cross
         #undef dot
@@ -1379,6 +1540,7 @@ bool BaseBinaryStar::ResolveSupernova() {
     m_CosIPrime = cos(m_IPrime);
 
     (void)PrintSupernovaDetails();                                                                                      // Log record to supernovae logfile
+    PublishEvent(EVENT_TYPE::SUPERNOVA, m_Supernova);                                                                   // publish supernova event
     m_Supernova->ClearCurrentSNEvent();
 
     return true;
@@ -1409,11 +1571,19 @@ void BaseBinaryStar::UpdateSystemicVelocity(Vector3d p_newVelocity) {
  * and if so resolve the event(s) by calling ResolveSupernova() for each of
  * the stars as appropriate.
  *
+ * If kick resampling is enabled, a snapshot of the binary is taken before the
+ * supernova is resolved (see TakeKickResampleSnapshot()).
+ *
  * void EvaluateSupernovae
  * 
  */
 void BaseBinaryStar::EvaluateSupernovae() {
 
+    if (OPTIONS->KickResamples() > 1 && !m_KickResample.resume &&                                                       // kick resampling, and not resuming at this supernova, and ...
+        (OPTIONS->KickResampleSupernovae() == KICK_RESAMPLE_SUPERNOVAE::EACH || m_KickResample.supernovae == 0)) {      // ... supernova to be resampled?
+        TakeKickResampleSnapshot();                                                                                     // yes - snapshot before the supernova is resolved
+    }
+
     m_SupernovaState = SN_STATE::NONE;                                                                                  // not yet determined
     
     if (m_Star1->IsSNevent()) {                                                                                         // star1 supernova
@@ -1579,7 +1749,7 @@ void BaseBinaryStar::ResolveCommonEnvelopeEvent() {
     m_Star2->SetPostCEEValues();                                                                                    // squirrel away post CEE stellar values for star 2
     SetPostCEEValues(aFinalRsol, m_Eccentricity, rRLdfin1Rsol, rRLdfin2Rsol);                                       // squirrel away post CEE binary values (checks for post-CE RLOF, so should be done at end)
     (void)PrintCommonEnvelope();
-    
+    PublishEvent(EVENT_TYPE::COMMON_ENVELOPE);                                                                      // publish common envelope event
 }
 
 
@@ -1597,7 +1767,7 @@ void BaseBinaryStar::ResolveCommonEnvelopeEvent() {
  */
 double BaseBinaryStar::CalculateRocheLobeRadius_Static(const double p_MassPrimary, const double p_MassSecondary) {
     double q = p_MassPrimary / p_MassSecondary;
-    double qCubeRoot = PPOW(q, 1.0 / 3.0);                                                                           // cube roots are expensive, only compute once
+    double qCubeRoot = powers::Pow<1, 3>(q);                                                                         // cube roots are expensive, only compute once
     return 0.49 / (0.6 + log(1.0 + qCubeRoot) / qCubeRoot / qCubeRoot);
 }
 
@@ -1641,11 +1811,104 @@ double BaseBinaryStar::CalculateGammaAngularMomentumLoss(const double p_DonorMas
 }
 
 
+/*
+ * Calculate the radius of a donor without an envelope after it loses mass p_MassLost
+ *
+ * Used by the Roche lobe root solver (see RadiusEqualsRocheLobeFunctor), which evaluates the radius many times
+ * per mass transfer episode.  The radius was found by copying the donor, updating the copy for the mass loss,
+ * and recalculating its attributes.  The stellar types without an envelope (MS, CH and HeMS) model the radius
+ * response directly from their on-phase radius formulae, without copying or updating the star (see
+ * CalculateRadiusAfterMassChange()) - the result is exactly the radius of the updated copy.  Other stellar types,
+ * and stars that would evolve off phase, are copied and updated as before.
+ *
+ * Program option --mass-transfer-donor-radius-response selects how the radius is found:
+ *
+ *     MODEL   : modelled where possible, otherwise copied and updated (default)
+ *     CLONE   : always copied and updated (as before the model was introduced)
+ *     VALIDATE: copied and updated (so results are unchanged), but also modelled where possible, and the two are
+ *               compared - the maximum difference, and time per evaluation of each, are written to the run details file
+ *
+ *
+ * double CalculateDonorRadiusAfterMassLoss(const BinaryConstituentStar* p_Donor, const double p_MassLost)
+ *
+ * @param   [IN]    p_Donor                     Pointer to donor
+ * @param   [IN]    p_MassLost                  Mass lost by the donor (positive)
+ * @return                                      Radius of the donor after mass loss
+ */
+double BaseBinaryStar::CalculateDonorRadiusAfterMassLoss(const BinaryConstituentStar* p_Donor, const double p_MassLost) {
+
+    double deltaMass  = -p_MassLost;
+    double deltaMass0 = -p_MassLost * p_Donor->Mass0() / p_Donor->Mass();                                                  // Mass0 scales with mass
+
+    MT_DONOR_RADIUS_RESPONSE response = OPTIONS->MassTransferDonorRadiusResponse();
+
+    bool   modelled = false;
+    double radius   = p_Donor->Radius();
+
+    if (response == MT_DONOR_RADIUS_RESPONSE::MODEL) {
+        std::tie(modelled, radius) = p_Donor->CalculateRadiusAfterMassChange(deltaMass, deltaMass0);
+        if (modelled) return radius;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    BinaryConstituentStar* donorCopy = new BinaryConstituentStar(*p_Donor);
+
+    (void)donorCopy->UpdateAttributes(deltaMass, deltaMass0);
+
+    // Modify donor Mass0 and Age for MS (including HeMS) and HG stars
+    donorCopy->UpdateInitialMass();                                                                                         // update initial mass (MS, HG & HeMS)  JR: todo: fix this kludge - mass0 is overloaded, and isn't always "initial mass"
+    donorCopy->UpdateAgeAfterMassLoss();                                                                                    // update age (MS, HG & HeMS)
+
+    (void)donorCopy->AgeOneTimestep(0.0);                                                                                   // recalculate radius of star - don't age - just update values
+
+    double cloneRadius = donorCopy->Radius();
+
+    delete donorCopy; donorCopy = nullptr;
+
+    if (response == MT_DONOR_RADIUS_RESPONSE::VALIDATE) {
+        double cloneSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        std::tie(modelled, radius) = p_Donor->CalculateRadiusAfterMassChange(deltaMass, deltaMass0);
+        double modelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        DonorRadiusValidationT& validation = m_DonorRadiusValidation;
+        validation.calls++;
+        validation.cloneSeconds += cloneSeconds;
+        if (modelled) {
+            validation.modelled++;
+            validation.modelSeconds         += modelSeconds;
+            validation.maxRelativeDifference = std::max(validation.maxRelativeDifference, std::abs(radius - cloneRadius) / cloneRadius);
+        }
+    }
+
+    return cloneRadius;
+}
+
+
 /*
  * Calculate new semi-major axis due to angular momentum loss
  *
  * Pols et al. notes; Belczynski et al. 2008, eq 32, 33
  *
+ * The semi-major axis evolves with the donor mass Md as
+ *
+ *     d ln a / dMd = -(2 / Md) (1 - beta Md / Ma - (1 - beta) (gamma + 1/2) Md / M),     Ma = Ma0 - beta (Md - Md0),  M = Md + Ma
+ *
+ * where beta is the fraction of the transferred mass accreted and gamma the specific angular momentum with which
+ * the non-accreted mass leaves the system (see CalculateGammaAngularMomentumLoss()).  Program option
+ * --mass-transfer-orbit-integrator selects how it is integrated:
+ *
+ *     ANALYTIC: closed form (see CalculateMassTransferOrbitAnalytic())
+ *     ADAPTIVE: adaptive Runge-Kutta (Cash-Karp), to tolerance --mass-transfer-orbit-tolerance
+ *     EULER   : explicit Euler, with steps of MAXIMUM_MASS_TRANSFER_FRACTION_PER_STEP of the donor mass (default - as
+ *               before the closed form was introduced)
+ *     VALIDATE: Euler (so results are unchanged), but the orbit is also evolved with the closed form and adaptively,
+ *               and the three are compared - maximum differences, and the work done, are written to the run details file
+ *
+ * If either final mass would not be positive the orbit is evolved with Euler steps.
+ *
  *
  * double CalculateMassTransferOrbit (const double                 p_DonorMass, 
  *                                    const double                 p_DeltaMassDonor, 
@@ -1654,11 +1917,10 @@ double BaseBinaryStar::CalculateGammaAngularMomentumLoss(const double p_DonorMas
  *                                    const double                 p_FractionAccreted)
  *
  * @param   [IN]    p_DonorMass                 Donor mass
- * @param   [IN]    p_AccretorMass              Accretor mass
  * @param   [IN]    p_DeltaMassDonor            Change in donor mass
  * @param   [IN]    p_ThermalRateDonor          Donor thermal mass loss rate
  * @param   [IN]    p_Accretor                  Pointer to accretor
- * @param   [IN]    p_FractionAccreted      Mass fraction lost from donor accreted by accretor
+ * @param   [IN]    p_FractionAccreted          Mass fraction lost from donor accreted by accretor
  * @return                                      Semi-major axis
  */
 double BaseBinaryStar::CalculateMassTransferOrbit(const double                 p_DonorMass, 
@@ -1667,6 +1929,171 @@ double BaseBinaryStar::CalculateMassTransferOrbit(const double                 p
                                                         BinaryConstituentStar& p_Accretor, 
                                                   const double                 p_FractionAccreted) {
 
+    unsigned long int steps       = 0;
+    unsigned long int evaluations = 0;
+
+    bool positiveMasses = utils::Compare(p_DonorMass + p_DeltaMassDonor, 0.0) > 0 && utils::Compare(p_Accretor.Mass() - (p_DeltaMassDonor * p_FractionAccreted), 0.0) > 0;
+
+    switch (positiveMasses ? OPTIONS->MassTransferOrbitIntegrator() : MT_ORBIT_INTEGRATOR::EULER) {
+        case MT_ORBIT_INTEGRATOR::ANALYTIC: return CalculateMassTransferOrbitAnalytic(p_DonorMass, p_DeltaMassDonor, p_Accretor, p_FractionAccreted);
+        case MT_ORBIT_INTEGRATOR::ADAPTIVE: return CalculateMassTransferOrbitAdaptive(p_DonorMass, p_DeltaMassDonor, p_Accretor, p_FractionAccreted, evaluations);
+        case MT_ORBIT_INTEGRATOR::EULER   : return CalculateMassTransferOrbitEuler(p_DonorMass, p_DeltaMassDonor, p_Accretor, p_FractionAccreted, steps);
+        default: {                                                                                                              // VALIDATE
+            double euler    = CalculateMassTransferOrbitEuler(p_DonorMass, p_DeltaMassDonor, p_Accretor, p_FractionAccreted, steps);
+            double analytic = CalculateMassTransferOrbitAnalytic(p_DonorMass, p_DeltaMassDonor, p_Accretor, p_FractionAccreted);
+            double adaptive = CalculateMassTransferOrbitAdaptive(p_DonorMass, p_DeltaMassDonor, p_Accretor, p_FractionAccreted, evaluations);
+
+            MassTransferOrbitValidationT& validation = m_MassTransferOrbitValidation;
+            validation.calls++;
+            validation.eulerSteps                            += steps;
+            validation.adaptiveEvaluations                   += evaluations;
+            validation.maxRelativeDifferenceAnalytic          = std::max(validation.maxRelativeDifferenceAnalytic, std::abs(analytic - euler) / euler);
+            validation.maxRelativeDifferenceAdaptive          = std::max(validation.maxRelativeDifferenceAdaptive, std::abs(adaptive - euler) / euler);
+            validation.maxRelativeDifferenceAnalyticAdaptive  = std::max(validation.maxRelativeDifferenceAnalyticAdaptive, std::abs(adaptive - analytic) / analytic);
+
+            return euler;
+        }
+    }
+}
+
+
+/*
+ * Calculate new semi-major axis due to angular momentum loss - closed form
+ *
+ * With beta constant the first two terms of d ln a / dMd (see CalculateMassTransferOrbit()) integrate to
+ * -2 ln(Md / Md0) - 2 ln(Ma / Ma0), and the third to ln(M / M0) + 2 (1 - beta) integral (gamma / M) dMd, which
+ * is closed-form for each angular momentum loss prescription (using M = Md + Ma, dM = (1 - beta) dMd):
+ *
+ *     ARBITRARY   : gamma constant                  2 (1 - beta) integral (gamma / M) dMd = 2 gamma ln(M / M0)
+ *     ISOTROPIC   : gamma / M = 1 / Ma - 1 / M                                          = 2 (1 - beta) I - 2 ln(M / M0)
+ *     JEANS       : gamma / M = 1 / Md - 1 / M                                          = 2 (1 - beta) ln(Md / Md0) - 2 ln(M / M0)
+ *     CIRCUMBINARY: gamma / M = sqrt(2) (1 / Md + 1 / Ma)                               = 2 sqrt(2) (1 - beta) (ln(Md / Md0) + I)
+ *
+ * where I = integral dMd / Ma = -ln(Ma / Ma0) / beta (= (Md - Md0) / Ma0 for beta = 0).
+ *
+ * Unknown prescriptions are integrated adaptively.
+ *
+ *
+ * double CalculateMassTransferOrbitAnalytic(const double                 p_DonorMass,
+ *                                           const double                 p_DeltaMassDonor,
+ *                                                 BinaryConstituentStar& p_Accretor,
+ *                                           const double                 p_FractionAccreted)
+ *
+ * @param   [IN]    p_DonorMass                 Donor mass
+ * @param   [IN]    p_DeltaMassDonor            Change in donor mass
+ * @param   [IN]    p_Accretor                  Pointer to accretor
+ * @param   [IN]    p_FractionAccreted          Mass fraction lost from donor accreted by accretor
+ * @return                                      Semi-major axis
+ */
+double BaseBinaryStar::CalculateMassTransferOrbitAnalytic(const double                 p_DonorMass,
+                                                          const double                 p_DeltaMassDonor,
+                                                                BinaryConstituentStar& p_Accretor,
+                                                          const double                 p_FractionAccreted) {
+
+    double beta     = p_FractionAccreted;
+    double massD0   = p_DonorMass;
+    double massA0   = p_Accretor.Mass();
+    double massD    = massD0 + p_DeltaMassDonor;
+    double massA    = massA0 - (p_DeltaMassDonor * beta);
+
+    double lnMassD  = log(massD / massD0);
+    double lnMassA  = log1p(-p_DeltaMassDonor * beta / massA0);
+    double lnMass   = log((massD + massA) / (massD0 + massA0));
+    double I        = utils::Compare(beta, 0.0) > 0 ? -lnMassA / beta : p_DeltaMassDonor / massA0;      // integral dMd / Ma
+
+    double jLossTerm;                                                                                   // 2 (1 - beta) integral (gamma / M) dMd
+    switch (OPTIONS->MassTransferAngularMomentumLossPrescription()) {
+        case MT_ANGULAR_MOMENTUM_LOSS_PRESCRIPTION::JEANS                : jLossTerm = (2.0 * (1.0 - beta) * lnMassD) - (2.0 * lnMass); break;
+        case MT_ANGULAR_MOMENTUM_LOSS_PRESCRIPTION::ISOTROPIC_RE_EMISSION: jLossTerm = (2.0 * (1.0 - beta) * I) - (2.0 * lnMass); break;
+        case MT_ANGULAR_MOMENTUM_LOSS_PRESCRIPTION::CIRCUMBINARY_RING    : jLossTerm = 2.0 * M_SQRT2 * (1.0 - beta) * (lnMassD + I); break;
+        case MT_ANGULAR_MOMENTUM_LOSS_PRESCRIPTION::ARBITRARY            : jLossTerm = 2.0 * OPTIONS->MassTransferJloss() * lnMass; break;
+
+        default: {                                                                                      // unknown prescription - no closed form
+            unsigned long int evaluations = 0;
+            return CalculateMassTransferOrbitAdaptive(p_DonorMass, p_DeltaMassDonor, p_Accretor, p_FractionAccreted, evaluations);
+        }
+    }
+
+    return m_SemiMajorAxis * exp((-2.0 * lnMassD) - (2.0 * lnMassA) + lnMass + jLossTerm);
+}
+
+
+/*
+ * Calculate new semi-major axis due to angular momentum loss - adaptive integration
+ *
+ * Integrates d ln a / dMd (see CalculateMassTransferOrbit()) with an adaptive Runge-Kutta (Cash-Karp 5(4))
+ * stepper, to absolute and relative tolerance --mass-transfer-orbit-tolerance in ln a.
+ *
+ *
+ * double CalculateMassTransferOrbitAdaptive(const double                 p_DonorMass,
+ *                                           const double                 p_DeltaMassDonor,
+ *                                                 BinaryConstituentStar& p_Accretor,
+ *                                           const double                 p_FractionAccreted,
+ *                                                 unsigned long int&     p_Evaluations)
+ *
+ * @param   [IN]        p_DonorMass             Donor mass
+ * @param   [IN]        p_DeltaMassDonor        Change in donor mass
+ * @param   [IN]        p_Accretor              Pointer to accretor
+ * @param   [IN]        p_FractionAccreted      Mass fraction lost from donor accreted by accretor
+ * @param   [IN/OUT]    p_Evaluations           Incremented by the number of derivative evaluations
+ * @return                                      Semi-major axis
+ */
+double BaseBinaryStar::CalculateMassTransferOrbitAdaptive(const double                 p_DonorMass,
+                                                          const double                 p_DeltaMassDonor,
+                                                                BinaryConstituentStar& p_Accretor,
+                                                          const double                 p_FractionAccreted,
+                                                                unsigned long int&     p_Evaluations) {
+
+    if (utils::Compare(p_DeltaMassDonor, 0.0) == 0) return m_SemiMajorAxis;                            // no mass transferred - no change
+
+    namespace odeint = boost::numeric::odeint;
+
+    double beta   = p_FractionAccreted;
+    double massD0 = p_DonorMass;
+    double massA0 = p_Accretor.Mass();
+
+    auto dLnAdMassD = [&](const DBL_VECTOR& p_LnA, DBL_VECTOR& p_dLnAdMassD, const double p_MassD) {
+        double massA = massA0 - (beta * (p_MassD - massD0));
+        double jLoss = CalculateGammaAngularMomentumLoss(p_MassD, massA);
+        p_dLnAdMassD[0] = (-2.0 / p_MassD) * (1.0 - (beta * (p_MassD / massA)) - ((1.0 - beta) * (jLoss + 0.5) * (p_MassD / (p_MassD + massA))));
+        p_Evaluations++;
+    };
+
+    double     tolerance = OPTIONS->MassTransferOrbitTolerance();
+    DBL_VECTOR lnA       = { 0.0 };                                                                     // ln(a / a0)
+
+    (void)odeint::integrate_adaptive(odeint::make_controlled<odeint::runge_kutta_cash_karp54<DBL_VECTOR>>(tolerance, tolerance),
+                                     dLnAdMassD, lnA, massD0, massD0 + p_DeltaMassDonor, p_DeltaMassDonor);
+
+    return m_SemiMajorAxis * exp(lnA[0]);
+}
+
+
+/*
+ * Calculate new semi-major axis due to angular momentum loss - explicit Euler
+ *
+ * Steps of MAXIMUM_MASS_TRANSFER_FRACTION_PER_STEP of the donor mass
+ *
+ *
+ * double CalculateMassTransferOrbitEuler(const double                 p_DonorMass,
+ *                                        const double                 p_DeltaMassDonor,
+ *                                              BinaryConstituentStar& p_Accretor,
+ *                                        const double                 p_FractionAccreted,
+ *                                              unsigned long int&     p_Steps)
+ *
+ * @param   [IN]        p_DonorMass             Donor mass
+ * @param   [IN]        p_DeltaMassDonor        Change in donor mass
+ * @param   [IN]        p_Accretor              Pointer to accretor
+ * @param   [IN]        p_FractionAccreted      Mass fraction lost from donor accreted by accretor
+ * @param   [IN/OUT]    p_Steps                 Incremented by the number of steps taken
+ * @return                                      Semi-major axis
+ */
+double BaseBinaryStar::CalculateMassTransferOrbitEuler(const double                 p_DonorMass,
+                                                       const double                 p_DeltaMassDonor,
+                                                             BinaryConstituentStar& p_Accretor,
+                                                       const double                 p_FractionAccreted,
+                                                             unsigned long int&     p_Steps) {
+
     double semiMajorAxis   = m_SemiMajorAxis;                                                                   // new semi-major axis value - default is no change
     double massA           = p_Accretor.Mass();                                                                 // accretor mass
     double massD           = p_DonorMass;                                                                       // donor mass
@@ -1690,10 +2117,129 @@ double BaseBinaryStar::CalculateMassTransferOrbit(const double                 p
         massAplusMassD = massA + massD;
     }
 
+    p_Steps += numberIterations;
+
     return semiMajorAxis;
 }
 
 
+/*
+ * Summary of the comparison of the orbit integrators through mass transfer, for the run details file
+ * (--mass-transfer-orbit-integrator VALIDATE)
+ *
+ *
+ * std::string MassTransferOrbitSummary()
+ *
+ * @return                                      Multi-line summary (empty unless VALIDATE mode)
+ */
+std::string BaseBinaryStar::MassTransferOrbitSummary() {
+
+    if (OPTIONS->MassTransferOrbitIntegrator() != MT_ORBIT_INTEGRATOR::VALIDATE) return "";
+
+    const MassTransferOrbitValidationT& validation = m_MassTransferOrbitValidation;
+
+    std::ostringstream ss;
+    ss << "\nMass transfer orbit validation (closed form and adaptive integration, tolerance " << OPTIONS->MassTransferOrbitTolerance() << ", vs Euler):\n"
+       << "  Orbits integrated = " << validation.calls
+       << "; Euler steps = " << validation.eulerSteps
+       << ", adaptive derivative evaluations = " << validation.adaptiveEvaluations << "\n"
+       << "  Max relative difference in semi-major axis: closed form vs Euler = " << validation.maxRelativeDifferenceAnalytic
+       << ", adaptive vs Euler = " << validation.maxRelativeDifferenceAdaptive
+       << ", adaptive vs closed form = " << validation.maxRelativeDifferenceAnalyticAdaptive << "\n";
+
+    return ss.str();
+}
+
+
+/*
+ * Summarise the comparison of the modelled donor radius with the radius of an updated copy of the donor, over the run
+ *
+ * Written to the run details file.
+ *
+ *
+ * std::string DonorRadiusResponseSummary()
+ *
+ * @return                                      Multi-line summary (empty unless VALIDATE mode)
+ */
+std::string BaseBinaryStar::DonorRadiusResponseSummary() {
+
+    if (OPTIONS->MassTransferDonorRadiusResponse() != MT_DONOR_RADIUS_RESPONSE::VALIDATE) return "";
+
+    const DonorRadiusValidationT& validation = m_DonorRadiusValidation;
+
+    std::ostringstream ss;
+    ss << "\nMass transfer donor radius response validation (modelled vs updated copy of the donor):\n"
+       << "  Radii evaluated = " << validation.calls
+       << ", modelled = " << validation.modelled
+       << ", not modelled (copy only) = " << (validation.calls - validation.modelled) << "\n"
+       << "  Max relative difference in radius = " << validation.maxRelativeDifference << "\n"
+       << "  Time per evaluation: updated copy = " << (validation.calls > 0 ? 1.0E9 * validation.cloneSeconds / validation.calls : 0.0) << " ns"
+       << ", model = " << (validation.modelled > 0 ? 1.0E9 * validation.modelSeconds / validation.modelled : 0.0) << " ns\n";
+
+    return ss.str();
+}
+
+
+/*
+ * Summarise the use of the non-interacting fast path over the run (see EvolveNonInteracting())
+ *
+ * Written to the run details file.
+ *
+ *
+ * std::string NonInteractingFastPathSummary()
+ *
+ * @return                                      Multi-line summary (empty unless the fast path was tried)
+ */
+std::string BaseBinaryStar::NonInteractingFastPathSummary() {
+
+    const NonInteractingFastPathT& fastPath = m_NonInteractingFastPath;
+
+    if (fastPath.binaries == 0) return "";
+
+    std::ostringstream ss;
+    ss << "\nNon-interacting fast path:\n"
+       << "  Binaries tried = " << fastPath.binaries
+       << "; evolved independently to the first remnant = " << fastPath.fastPathed
+       << ", predicted to interact (track library) = " << fastPath.predictedToInteract
+       << ", could interact = " << fastPath.interacting
+       << ", remnant too soon to skip = " << fastPath.tooShort << "\n"
+       << "  Time skipped = " << fastPath.timeSkipped << " Myr\n";
+
+    return ss.str();
+}
+
+
+/*
+ * Summarise the binaries culled over the run (--culling-mode)
+ *
+ * Each binary is counted once - its kick resampling branches and forks are not counted.
+ * Written to the run details file.
+ *
+ *
+ * std::string CullingSummary()
+ *
+ * @return                                      Multi-line summary (empty unless culling was enabled)
+ */
+std::string BaseBinaryStar::CullingSummary() {
+
+    const CullingT& culling = m_Culling;
+
+    if (culling.binaries == 0) return "";
+
+    unsigned long int culled = culling.whiteDwarf + culling.companionMass + culling.totalMass;
+
+    std::ostringstream ss;
+    ss << "\nCulling (" << CULLING_MODE_LABEL.at(OPTIONS->CullingMode()) << "):\n"
+       << "  Binaries evolved = " << culling.binaries
+       << "; culled = " << culled
+       << " (He or CO white dwarf = " << culling.whiteDwarf
+       << ", NS/BH with companion mass <= MECS = " << culling.companionMass
+       << ", total mass <= 2 MECS = " << culling.totalMass << ")\n";
+    if (culled > 0) ss << "  Mean time at culling = " << culling.timeAtCulling / culled << " Myr\n";
+
+    return ss.str();
+}
+
 
 /*
  * Calculate the response of the donor Roche Lobe to mass loss during mass transfer per Sluys 2013, Woods et al., 2012
@@ -1717,7 +2263,7 @@ double BaseBinaryStar::CalculateZRocheLobe(const double p_jLoss) const {
 
     double q = donorMass / accretorMass;
 
-    double q_1_3 = PPOW(q, 1.0 / 3.0);
+    double q_1_3 = powers::Pow<1, 3>(q);
 
     double k1 = -2.0 * (1.0 - (beta * q) - (1.0 - beta) * (gamma + 0.5) * (q / (1.0 + q)));
     double k2 = (2.0 / 3.0) - q_1_3 * (1.2 * q_1_3 + 1.0 / (1.0 + q_1_3)) / (3.0 * (0.6 * q_1_3 * q_1_3 + log(1.0 + q_1_3)));
@@ -2196,29 +2742,36 @@ void BaseBinaryStar::ResolveMassChanges() {
  */
 void BaseBinaryStar::EvaluateBinary(const double p_Dt) {
 
-    CalculateMassTransfer(p_Dt);                                                                                        // calculate mass transfer if necessary
-
-    CalculateWindsMassLoss();                                                                                           // calculate mass loss dues to winds
-
-    if ((m_CEDetails.CEEnow || StellarMerger()) &&                                                                      // CEE or merger?
-        !(OPTIONS->CHEMode() != CHE_MODE::NONE && HasTwoOf({STELLAR_TYPE::CHEMICALLY_HOMOGENEOUS}))) {                  // yes - avoid CEE if CH+CH
-        ResolveCommonEnvelopeEvent();                                                                                   // resolve CEE - immediate event
-    }
-    else if (m_Star1->IsSNevent() || m_Star2->IsSNevent()) {
-        EvaluateSupernovae();                                                                                           // evaluate supernovae (both stars) - immediate event
+    if (m_KickResample.resume) {                                                                                        // kick resampling branch resuming at its snapshot?
+        EvaluateSupernovae();                                                                                           // yes - evaluate supernovae under the redrawn kick(s) (mass changes resolved before the snapshot)
+        m_KickResample.resume      = false;                                                                             // resumed
+        m_PrintExtraDetailedOutput = false;                                                                             // reset detailed output printing flag for the next timestep
     }
     else {
-        ResolveMassChanges();                                                                                           // apply mass loss and mass transfer as necessary
-        if (HasStarsTouching()) {                                                                                       // if stars emerged from mass transfer as touching, it's a merger
-            m_Flags.stellarMerger = true;
+        CalculateMassTransfer(p_Dt);                                                                                    // calculate mass transfer if necessary
+
+        CalculateWindsMassLoss();                                                                                       // calculate mass loss dues to winds
+
+        if ((m_CEDetails.CEEnow || StellarMerger()) &&                                                                  // CEE or merger?
+            !(OPTIONS->CHEMode() != CHE_MODE::NONE && HasTwoOf({STELLAR_TYPE::CHEMICALLY_HOMOGENEOUS}))) {              // yes - avoid CEE if CH+CH
+            ResolveCommonEnvelopeEvent();                                                                               // resolve CEE - immediate event
+        }
+        else if (m_Star1->IsSNevent() || m_Star2->IsSNevent()) {
+            EvaluateSupernovae();                                                                                       // evaluate supernovae (both stars) - immediate event
+        }
+        else {
+            ResolveMassChanges();                                                                                       // apply mass loss and mass transfer as necessary
+            if (HasStarsTouching()) {                                                                                   // if stars emerged from mass transfer as touching, it's a merger
+                m_Flags.stellarMerger = true;
+            }
         }
-    }
 
-    if (m_PrintExtraDetailedOutput == true && !StellarMerger()) { (void)PrintDetailedOutput(m_Id); }                    // print detailed output record if stellar type changed (except on merger, when detailed output is meaningless)
-    m_PrintExtraDetailedOutput = false;                                                                                 // reset detailed output printing flag for the next timestep
+        if (m_PrintExtraDetailedOutput == true && !StellarMerger()) { (void)PrintDetailedOutput(m_Id); }                // print detailed output record if stellar type changed (except on merger, when detailed output is meaningless)
+        m_PrintExtraDetailedOutput = false;                                                                             // reset detailed output printing flag for the next timestep
 
-    if ((m_Star1->IsSNevent() || m_Star2->IsSNevent())) {
-        EvaluateSupernovae();                                                                                           // evaluate supernovae (both stars) if mass changes are responsible for a supernova
+        if ((m_Star1->IsSNevent() || m_Star2->IsSNevent())) {
+            EvaluateSupernovae();                                                                                       // evaluate supernovae (both stars) if mass changes are responsible for a supernova
+        }
     }
 
     // assign new values to "previous" values, for following timestep
@@ -2272,11 +2825,546 @@ void BaseBinaryStar::EvolveOneTimestep(const double p_Dt) {
 }
 
 
+/*
+ * Evolve the binary through its detached evolution, on the track library
+ *
+ * Called by Evolve() for the first timestep of a binary when the track library is used (program option
+ * --track-library-mode INTERPOLATE - see TrackLibrary.h).
+ *
+ * The tracks of both stars are interpolated from the library, and the time until which the binary is predicted
+ * to stay detached (the handover time) is found from them: the time up to which the radius of each star is
+ * below TRACK_LIBRARY_ROCHE_LOBE_FRACTION of its Roche lobe at periastron, with the orbit widened by the mass
+ * lost (Jeans mode, as for winds), and which is before TRACK_LIBRARY_TIME_MARGIN of the end of the track of
+ * either star (so before either star forms a remnant).  Radii are interpolated linearly (in log) between the
+ * points of the tracks, so checking them at the points of both tracks bounds them in between.
+ *
+ * The stars are then evolved independently to the handover time (see EvolveDetachedStar()), in one timestep
+ * of the binary - the binary is not evaluated until the handover, when Evolve() evaluates it as usual and
+ * continues with the usual timestepping.  If either star reaches its Roche lobe bound, or evolves off its track
+ * (forms a remnant), before the handover, the stars are restored (and the binary takes the usual timestep).
+ *
+ * Detailed output records are not written for the time skipped.
+ *
+ *
+ * double EvolveDetachedOnTrackLibrary(const double p_Dt)
+ *
+ * @param   [IN]    p_Dt                        The timestep the binary would take (the detached evolution is skipped only if longer)
+ * @return                                      The timestep taken, or 0.0 if the detached evolution was not skipped (the binary is unchanged)
+ */
+double BaseBinaryStar::EvolveDetachedOnTrackLibrary(const double p_Dt) {
+
+    TrackT track1, track2;
+
+    bool onTracks = TrackLibrary::Phase(m_Star1->StellarType()) == 0 && TrackLibrary::Phase(m_Star2->StellarType()) == 0 &&      // both stars on the MS (not e.g. CH)
+                    TRACK_LIBRARY->Interpolate(m_Star1->MZAMS(), m_Star1->Metallicity(), track1) &&
+                    TRACK_LIBRARY->Interpolate(m_Star2->MZAMS(), m_Star2->Metallicity(), track2);
+
+    TRACK_LIBRARY->RecordBinary(onTracks);
+
+    if (!onTracks) return 0.0;                                                                          // stars not on the library - evolve as usual
+
+    // handover time
+
+    double end = std::min(track1.points.back().time, track2.points.back().time) * (1.0 - TRACK_LIBRARY_TIME_MARGIN);
+    end        = std::min(end, OPTIONS->MaxEvolutionTime());
+
+    DBL_VECTOR times;                                                                                   // times of the points of both tracks, up to the end
+    for (auto track : { &track1, &track2 }) {
+        for (auto &point : track->points) {
+            if (point.time > m_Time && point.time < end) times.push_back(point.time);
+        }
+    }
+    times.push_back(end);
+    std::sort(times.begin(), times.end());
+
+    double totalMass = m_Star1->Mass() + m_Star2->Mass();
+    double handover  = m_Time;
+    for (auto time : times) {
+        double mass1, radius1, mass2, radius2;
+        TrackLibrary::ValueAt(track1, time, mass1, radius1);
+        TrackLibrary::ValueAt(track2, time, mass2, radius2);
+
+        double periastron = m_SemiMajorAxis * (totalMass / (mass1 + mass2)) * (1.0 - m_Eccentricity) * AU_TO_RSOL;     // Rsol, orbit widened by mass lost (Jeans mode)
+        if (radius1 >= TRACK_LIBRARY_ROCHE_LOBE_FRACTION * periastron * CalculateRocheLobeRadius_Static(mass1, mass2) ||
+            radius2 >= TRACK_LIBRARY_ROCHE_LOBE_FRACTION * periastron * CalculateRocheLobeRadius_Static(mass2, mass1)) break;
+
+        handover = time;
+    }
+
+    double dt = handover - m_Time;
+    if (dt <= p_Dt) {                                                                                   // worth skipping?
+        TRACK_LIBRARY->RecordTooShort();                                                                // no - evolve as usual
+        return 0.0;
+    }
+
+    // evolve the stars independently to the handover
+
+    BinaryConstituentStar star1(*m_Star1);                                                              // save the stars, in case they interact before the handover
+    BinaryConstituentStar star2(*m_Star2);
+    RandStateT            randState = RAND->State();
+
+    double mass1 = m_Star1->Mass();
+    double mass2 = m_Star2->Mass();
+    double time1, time2, widening1, widening2;
+
+    bool detached = EvolveDetachedStar(m_Star1, &track1, mass2, totalMass, dt, randState, time1, widening1) && utils::Compare(time1, dt) >= 0 &&
+                    EvolveDetachedStar(m_Star2, &track2, mass1, totalMass, dt, randState, time2, widening2) && utils::Compare(time2, dt) >= 0;
+
+    if (!detached) {                                                                                    // stars stayed detached, on their tracks?
+        *m_Star1 = star1;                                                                               // no - restore the stars...
+        *m_Star2 = star2;
+        m_Star1->SetCompanion(m_Star2);
+        m_Star2->SetCompanion(m_Star1);
+        RAND->RestoreState(randState);
+
+        TRACK_LIBRARY->RecordRollBack();                                                                // ... and evolve as usual
+        return 0.0;
+    }
+
+    m_SemiMajorAxis     = m_SemiMajorAxis * widening1 * widening2;                                      // orbit widened by winds (see EvolveDetachedStar())
+    m_SemiMajorAxisPrev = m_SemiMajorAxis;
+
+    EvolveOneTimestepPreamble(dt);
+
+    TRACK_LIBRARY->RecordSkip(dt);
+
+    return dt;
+}
+
+
+/*
+ * Apply the winds mass loss of the last timestep of a star evolving independently of its companion
+ *
+ * As CalculateWindsMassLoss() and ResolveMassChanges() apply winds to the stars of the binary - the change
+ * to the orbit is left to the caller.
+ *
+ *
+ * void ApplyDetachedWinds(BinaryConstituentStar *p_Star)
+ *
+ * @param   [IN/OUT]    p_Star                  The star losing mass
+ */
+void BaseBinaryStar::ApplyDetachedWinds(BinaryConstituentStar *p_Star) {
+
+    double mass  = p_Star->Mass();
+    double mWind = p_Star->CalculateMassLossValues(true);
+    p_Star->SetMassLossDiff(mWind - mass);
+
+    (void)p_Star->UpdateAttributes(p_Star->MassPrev() - mass + p_Star->MassLossDiff(), 0.0);
+    p_Star->UpdateInitialMass();
+    p_Star->UpdateAgeAfterMassLoss();
+    p_Star->UpdateAttributes(0.0, 0.0, true);
+}
+
+
+/*
+ * Lower bound of the Roche lobe radius of a star at periastron while the binary is detached
+ *
+ * The stars of a detached binary only lose mass (winds), and the orbit widens as they do (Jeans mode, as
+ * for winds in CalculateWindsMassLoss()).  The Roche lobe radius of a star is bounded below, whatever the
+ * mass of its companion, by the radius with the companion at its mass at the start: the semi-major axis
+ * a = a0 * M0 / (m + mc) is smallest, and the Roche lobe fraction (Eggleton 1983) is smallest for mc largest.
+ * Widening the orbit step by step, as CalculateWindsMassLoss() does (a / (2 - M0/M)), widens it at least as
+ * much as the closed form used here.
+ *
+ *
+ * double CalculateDetachedRocheLobeBound(const double p_Mass, const double p_CompanionMass, const double p_TotalMass)
+ *
+ * @param   [IN]    p_Mass                      Mass of the star now (Msol)
+ * @param   [IN]    p_CompanionMass             Mass of the companion at the start (Msol)
+ * @param   [IN]    p_TotalMass                 Total mass of the binary at the start (Msol)
+ * @return                                      Lower bound of the Roche lobe radius at periastron (Rsol)
+ */
+double BaseBinaryStar::CalculateDetachedRocheLobeBound(const double p_Mass, const double p_CompanionMass, const double p_TotalMass) const {
+
+    double semiMajorAxis = m_SemiMajorAxis * p_TotalMass / (p_Mass + p_CompanionMass);                 // AU, widened by the mass lost by the star only
+
+    return semiMajorAxis * (1.0 - m_Eccentricity) * AU_TO_RSOL * CalculateRocheLobeRadius_Static(p_Mass, p_CompanionMass);
+}
+
+
+/*
+ * Evolve the binary to the first remnant, if its stars cannot interact before it (non-interacting fast path)
+ *
+ * Called by Evolve() for the first timestep of a binary when program option --non-interacting-fast-path is
+ * specified.  Many binaries are wide enough that neither star fills its Roche lobe before the first star forms
+ * a remnant (white dwarf, neutron star or black hole) - until then the stars evolve as single stars, and
+ * evaluating the binary at every timestep of the faster-evolving star is wasted.
+ *
+ * The check is conservative: each star is evolved independently (at its own timesteps, without evaluating the
+ * binary), and at every timestep its radius is checked against a lower bound of its Roche lobe radius at
+ * periastron, allowing for the widening of the orbit by winds (see CalculateDetachedRocheLobeBound()).  The
+ * star is evolved to just before it forms a remnant (the timestep in which it would form the remnant, or go
+ * supernova, is reverted - see EvolveDetachedStar()), or to the maximum evolution time; its companion is then
+ * evolved to the same time, or to just before it forms its own remnant if that is earlier (and the first star
+ * is then evolved again, to that time).  The binary continues with the usual timestepping from there - the
+ * formation of the remnant is the binary's next timestep, so the binary evaluates it (e.g. stops, or is culled,
+ * when it forms, and the coalescence time of a double white dwarf is measured from then).
+ *
+ * If either star reaches its Roche lobe bound, the stars are restored and the binary is evolved as usual.  When
+ * the track library is loaded (--track-library-mode INTERPOLATE), the radii on the tracks of the stars up to the
+ * first remnant on them are checked first, and binaries predicted to interact are not tried.
+ *
+ * Detailed output records are not written for the time skipped.
+ *
+ *
+ * double EvolveNonInteracting(const double p_Dt)
+ *
+ * @param   [IN]    p_Dt                        The timestep the binary would take (the fast path is taken only if longer)
+ * @return                                      The timestep taken, or 0.0 if the fast path was not taken (the binary is unchanged)
+ */
+double BaseBinaryStar::EvolveNonInteracting(const double p_Dt) {
+
+    if (!m_Star1->IsOneOf({ STELLAR_TYPE::MS_LTE_07, STELLAR_TYPE::MS_GT_07 }) ||                      // both stars must be on the MS (not e.g. CH)
+        !m_Star2->IsOneOf({ STELLAR_TYPE::MS_LTE_07, STELLAR_TYPE::MS_GT_07 })) return 0.0;
+
+    m_NonInteractingFastPath.binaries++;
+
+    double mass1     = m_Star1->Mass();
+    double mass2     = m_Star2->Mass();
+    double totalMass = mass1 + mass2;
+
+    TrackT tracks[2];                                                                                   // tracks of the stars, if the track library is loaded
+    bool   onTracks[2] = { false, false };
+
+    if (TRACK_LIBRARY->Enabled()) {                                                                     // track library loaded?
+        double firstRemnant = std::numeric_limits<double>::max();                                       // yes - check the maximum radii on the tracks, up to the first remnant
+        for (int i = 0; i < 2; i++) {
+            BinaryConstituentStar *star = i == 0 ? m_Star1 : m_Star2;
+            onTracks[i] = TRACK_LIBRARY->Interpolate(star->MZAMS(), star->Metallicity(), tracks[i]);
+            if (onTracks[i] && tracks[i].remnantStellarType != STELLAR_TYPE::NONE) {
+                firstRemnant = std::min(firstRemnant, tracks[i].remnantTime * (1.0 + TRACK_LIBRARY_TIME_MARGIN));
+            }
+        }
+        for (int i = 0; i < 2; i++) {
+            if (!onTracks[i]) continue;
+            double companionMass = i == 0 ? mass2 : mass1;
+            for (auto &point : tracks[i].points) {
+                if (point.time > firstRemnant) break;
+                if (point.radius >= CalculateDetachedRocheLobeBound(point.mass, companionMass, totalMass)) {
+                    m_NonInteractingFastPath.predictedToInteract++;
+                    return 0.0;                                                                         // predicted to interact - evolve as usual
+                }
+            }
+        }
+    }
+
+    BinaryConstituentStar star1(*m_Star1);                                                              // save the stars, in case they interact
+    BinaryConstituentStar star2(*m_Star2);
+    RandStateT            randState = RAND->State();                                                    // and the random number service (supernovae draw random numbers)
+
+    BinaryConstituentStar *first  = utils::Compare(mass1, mass2) >= 0 ? m_Star1 : m_Star2;             // the more massive star first - evolves faster, so is more likely to interact (and does so sooner)
+    BinaryConstituentStar *second = first == m_Star1 ? m_Star2 : m_Star1;
+    double                 firstCompanionMass  = first == m_Star1 ? mass2 : mass1;
+    double                 secondCompanionMass = first == m_Star1 ? mass1 : mass2;
+    const TrackT          *firstTrack          = onTracks[first == m_Star1 ? 0 : 1] ? &tracks[first == m_Star1 ? 0 : 1] : nullptr;
+    const TrackT          *secondTrack         = onTracks[first == m_Star1 ? 1 : 0] ? &tracks[first == m_Star1 ? 1 : 0] : nullptr;
+
+    double maximumTime    = OPTIONS->MaxEvolutionTime() - m_Time;
+    double timeFirst      = 0.0;
+    double timeSecond     = 0.0;
+    double wideningFirst  = 1.0;
+    double wideningSecond = 1.0;
+
+    bool detached = EvolveDetachedStar(first, firstTrack, firstCompanionMass, totalMass, maximumTime, randState, timeFirst, wideningFirst) &&
+                    EvolveDetachedStar(second, secondTrack, secondCompanionMass, totalMass, timeFirst, randState, timeSecond, wideningSecond);
+
+    if (detached && utils::Compare(timeSecond, timeFirst) < 0) {                                        // companion forms a remnant (or goes supernova) first?
+        *first = (first == m_Star1 ? star1 : star2);                                                    // yes - evolve the first star again, to that time
+        first->SetCompanion(second);
+        detached = EvolveDetachedStar(first, firstTrack, firstCompanionMass, totalMass, timeSecond, randState, timeFirst, wideningFirst);
+    }
+
+    double dt = std::min(timeFirst, timeSecond);
+
+    if (!detached || dt <= p_Dt) {                                                                      // stars stayed detached, long enough to skip?
+        *m_Star1 = star1;                                                                               // no - restore the stars...
+        *m_Star2 = star2;
+        m_Star1->SetCompanion(m_Star2);
+        m_Star2->SetCompanion(m_Star1);
+        RAND->RestoreState(randState);
+
+        if (detached) m_NonInteractingFastPath.tooShort++;                                              // ... and evolve as usual
+        else          m_NonInteractingFastPath.interacting++;
+        return 0.0;
+    }
+
+    m_SemiMajorAxis     = m_SemiMajorAxis * wideningFirst * wideningSecond;                             // orbit widened by winds (see EvolveDetachedStar())
+    m_SemiMajorAxisPrev = m_SemiMajorAxis;
+
+    EvolveOneTimestepPreamble(dt);
+
+    m_NonInteractingFastPath.fastPathed++;
+    m_NonInteractingFastPath.timeSkipped += dt;
+
+    return dt;
+}
+
+
+/*
+ * Evolve a star of a detached binary independently of its companion
+ *
+ * Used by EvolveDetachedOnTrackLibrary() and EvolveNonInteracting().  The star takes its usual timesteps (not
+ * those of the binary), and its radius is checked against the lower bound of its Roche lobe radius (see
+ * CalculateDetachedRocheLobeBound()) at each.  If the star has a track from the track library, and there are
+ * no winds, the star steps straight to (just before) the end of each phase on its track - without winds the
+ * evolution of a star on a phase depends on its age only, and the radii within the phase were checked on the
+ * track by the caller.
+ *
+ * Winds are applied as BSE applies them, at the start of the following timestep - so the winds of the last
+ * timestep are applied when Evolve() evaluates the binary.  The widening of the orbit by the winds is applied
+ * step by step as CalculateWindsMassLoss() applies it (a / (2 - M0/M), with the companion at its mass at the
+ * start), and returned as a factor for the caller to apply to the semi-major axis.
+ *
+ * If the star goes supernova, or forms a remnant (white dwarf, neutron star, black hole), the timestep is
+ * reverted (the state of the star is saved before the winds of the previous timestep are applied) and evolution
+ * stops - so the binary itself evaluates the formation of the remnant.
+ *
+ *
+ * bool EvolveDetachedStar(BinaryConstituentStar *p_Star, const TrackT *p_Track, const double p_CompanionMass, const double p_TotalMass,
+ *                         const double p_MaximumTime, const RandStateT &p_RandState, double &p_Time, double &p_Widening)
+ *
+ * @param   [IN/OUT]    p_Star                  The star to evolve
+ * @param   [IN]        p_Track                 The track of the star, interpolated from the track library (nullptr if none)
+ * @param   [IN]        p_CompanionMass         Mass of the companion at the start (Msol)
+ * @param   [IN]        p_TotalMass             Total mass of the binary at the start (Msol)
+ * @param   [IN]        p_MaximumTime           The maximum time to evolve the star (Myr)
+ * @param   [IN]        p_RandState             State of the random number service at the start (restored if the star goes supernova)
+ * @param   [OUT]       p_Time                  The time the star was evolved (Myr) - less than p_MaximumTime if it stopped before a remnant
+ * @param   [OUT]       p_Widening              Factor by which the winds of the star widen the orbit
+ * @return                                      Boolean flag indicating whether the star stayed within its Roche lobe bound
+ */
+bool BaseBinaryStar::EvolveDetachedStar(BinaryConstituentStar *p_Star,
+                                        const TrackT          *p_Track,
+                                        const double           p_CompanionMass,
+                                        const double           p_TotalMass,
+                                        const double           p_MaximumTime,
+                                        const RandStateT      &p_RandState,
+                                        double                &p_Time,
+                                        double                &p_Widening) {
+    p_Time     = 0.0;
+    p_Widening = 1.0;
+
+    bool winds = false;                                                                                 // winds of the previous timestep to be applied?
+
+    while (utils::Compare(p_Time, p_MaximumTime) < 0) {
+
+        p_Star->SaveState();                                                                            // save the state of the star - reverted if it forms a remnant this timestep
+
+        double widening = 1.0;
+        if (winds) {                                                                                    // winds of the previous timestep
+            double mass = p_Star->Mass();
+            ApplyDetachedWinds(p_Star);
+            widening = 1.0 / (2.0 - ((mass + p_CompanionMass) / (p_Star->Mass() + p_CompanionMass)));
+        }
+
+        double dt = std::max(p_Star->CalculateTimestep() * OPTIONS->TimestepMultiplier(), NUCLEAR_MINIMUM_TIMESTEP);   // usual timestep
+
+        if (p_Track && !OPTIONS->UseMassLoss()) {                                                       // track, and no winds?
+            double phaseEnd = TrackLibrary::PhaseEndTime(*p_Track, p_Star->StellarType()) * (1.0 - TRACK_LIBRARY_TIME_MARGIN);
+            dt = std::max(dt, phaseEnd - (m_Time + p_Time));                                            // step to just before the end of the phase
+        }
+        dt = std::min(dt, p_MaximumTime - p_Time);                                                      // but not beyond the end
+
+        (void)p_Star->AgeOneTimestep(dt, true);                                                         // age the star and switch to the new stellar type if necessary
+
+        if (p_Star->IsSNevent() || TrackLibrary::Phase(p_Star->StellarType()) < 0) {                   // supernova, or remnant formed?
+            (void)p_Star->RevertState();                                                                // yes - stop just before it
+            RAND->RestoreState(p_RandState);
+            break;
+        }
+
+        p_Time     += dt;
+        p_Widening *= widening;
+
+        if (p_Star->Radius() >= CalculateDetachedRocheLobeBound(p_Star->Mass(), p_CompanionMass, p_TotalMass)) return false;   // could interact
+
+        winds = OPTIONS->UseMassLoss();
+    }
+
+    return true;
+}
+
+
+/*
+ * Take a snapshot of the binary for kick resampling
+ *
+ * Kick resampling (program option --kick-resamples K, K > 1) amortises the evolution of a binary up to a
+ * supernova over K post-supernova outcomes.  The snapshot is taken by EvaluateSupernovae(), before the
+ * supernova is resolved - so the star has collapsed and the kick has been drawn, but the orbit has not
+ * been changed.  The binary taking the snapshot continues under its own kick draw; K - 1 branches are later
+ * continued from the snapshot, each under a new kick draw (see StartKickResampleBranch(), and BinaryStar::Evolve(),
+ * which evolves them).
+ *
+ * Each of the K trajectories gets 1/K of the weight of the binary at the snapshot: the weights of all
+ * trajectories evolved from a binary (KICK_RESAMPLE_WEIGHT) sum to 1.  Records logged after the snapshot
+ * are logged for each trajectory, with the branch number (KICK_RESAMPLE_BRANCH) and weight.
+ *
+ * Program option --kick-resample-supernovae determines whether only the first supernova of a binary is
+ * resampled (FIRST), or each supernova (EACH - branches are then also resampled at their next supernova).
+ *
+ *
+ * void TakeKickResampleSnapshot()
+ */
+void BaseBinaryStar::TakeKickResampleSnapshot() {
+
+    m_KickResample.supernovae++;                                                            // count the supernova in the snapshot too
+
+    m_KickResampleSnapshots.push_back(new BaseBinaryStar(*this));                           // snapshot has the weight of the binary before resampling
+
+    m_KickResample.weight /= OPTIONS->KickResamples();                                      // this binary is one of the K trajectories
+}
+
+
+/*
+ * Start a kick resampling branch
+ *
+ * Called for a copy of a snapshot taken by TakeKickResampleSnapshot(): sets the branch number and weight,
+ * redraws the kick of the star(s) undergoing a supernova, and flags the binary to resume evolution at the
+ * snapshot when Evolve() is called (see EvaluateBinary()).
+ *
+ *
+ * void StartKickResampleBranch(const int p_Branch)
+ *
+ * @param   [IN]    p_Branch                    Branch number (> 0)
+ */
+void BaseBinaryStar::StartKickResampleBranch(const int p_Branch) {
+
+    m_KickResample.branch  = p_Branch;
+    m_KickResample.weight /= OPTIONS->KickResamples();
+    m_KickResample.resume  = true;
+
+    if (m_Star1->IsSNevent()) m_Star1->ResampleSNKick();                                    // redraw kick(s)
+    if (m_Star2->IsSNevent()) m_Star2->ResampleSNKick();
+}
+
+
+/*
+ * Release the kick resampling snapshots taken by this binary
+ *
+ * Ownership of the snapshots passes to the caller.
+ *
+ *
+ * std::vector<BaseBinaryStar*> ReleaseKickResampleSnapshots()
+ *
+ * @return                                      Snapshots taken, in the order taken
+ */
+std::vector<BaseBinaryStar*> BaseBinaryStar::ReleaseKickResampleSnapshots() {
+
+    std::vector<BaseBinaryStar*> snapshots;
+    snapshots.swap(m_KickResampleSnapshots);
+
+    return snapshots;
+}
+
+
+/*
+ * Take a snapshot of the binary for forked evolution of option variations
+ *
+ * Forked evolution (program option --fork-variations) evolves each binary once up to the timestep in which
+ * a swept option - an option specified as a range or set on the commandline - is first read, then forks
+ * the binary for each variation of the swept options (see BinaryStar::EvolveFork()).  Until a swept option
+ * is read the evolution of the binary is the same for all variations, so only needs to be done once.
+ *
+ * Snapshots are taken lazily: while evolving the binary Evolve() only notes the timestep in which a swept
+ * option is first read.  The first fork is evolved from ZAMS, and takes the snapshot at the start of that
+ * timestep - with the timestep and timestep number, the state of the random number service, and the number
+ * of logfile records staged (the records staged before the snapshot was taken are shared by the forks).
+ * Subsequent forks are continued from the snapshot.
+ *
+ *
+ * void TakeForkSnapshot(const double p_Dt, const int p_StepNum)
+ *
+ * @param   [IN]    p_Dt                        Timestep at which the snapshot is taken
+ * @param   [IN]    p_StepNum                   Timestep number of the timestep at which the snapshot is taken
+ */
+void BaseBinaryStar::TakeForkSnapshot(const double p_Dt, const int p_StepNum) {
+
+    m_Fork.dt              = p_Dt;
+    m_Fork.stepNum         = p_StepNum;
+    m_Fork.snapshotStepNum = 0;                                                             // snapshot taken
+    m_Fork.randState       = RAND->State();
+    m_Fork.stagedRecords   = LOGGING->StagedRecordCount();
+
+    delete m_ForkSnapshot;
+    m_ForkSnapshot = new BaseBinaryStar(*this);
+}
+
+
+/*
+ * Start a fork
+ *
+ * Called for a copy of a snapshot taken by TakeForkSnapshot(): restores the state of the random number
+ * service and the logfile records staged when the snapshot was taken, and flags the binary to resume
+ * evolution at the snapshot when Evolve() is called - so the fork evolves as the binary would have
+ * evolved from ZAMS under the current option values.
+ *
+ *
+ * void StartFork()
+ */
+void BaseBinaryStar::StartFork() {
+
+    RAND->RestoreState(m_Fork.randState);
+    LOGGING->RestoreStagedRecords();
+
+    m_Fork.resume = true;
+}
+
+
+/*
+ * Determine whether the binary can be culled - its evolution stopped because it can no longer form the
+ * systems of interest (--culling-mode)
+ *
+ * The rules are conservative: a binary is culled only if it provably cannot form the systems of interest,
+ * whatever happens to it later.  For CULLING_MODE::DCO (double compact objects - NS or BH pairs) they rest on:
+ *
+ *     - the total mass of the binary never increases (winds, non-conservative mass transfer and common envelope
+ *       ejection only remove mass), and a star gains mass only from its companion - not from a NS or BH
+ *     - a star collapses to a NS or BH only if its mass is greater than MECS: for ONeWDs and HeHG stars the
+ *       condition is explicit, and for EAGB and TPAGB stars the CO core mass must exceed the core mass at
+ *       supernova, which is at least MECS (see GiantBranch::CalculateCoreMassAtSupernova_Static())
+ *     - HeWDs never change stellar type, and COWDs leave massless remnants
+ *
+ * so the binary is culled if:
+ *
+ *     - either star is a HeWD or a COWD (CULLING_RULE::WHITE_DWARF)
+ *     - one star is a NS or BH, and the other is not, with mass <= MECS (CULLING_RULE::COMPANION_MASS)
+ *     - neither star is a NS or BH, and the total mass is <= 2 MECS (CULLING_RULE::TOTAL_MASS)
+ *
+ *
+ * CULLING_RULE CullingRule()
+ *
+ * @return                                      The rule by which the binary can be culled (CULLING_RULE::NONE if it cannot)
+ */
+CULLING_RULE BaseBinaryStar::CullingRule() const {
+
+    if (OPTIONS->CullingMode() != CULLING_MODE::DCO) return CULLING_RULE::NONE;                     // no culling
+
+    if (HasOneOf({ STELLAR_TYPE::HELIUM_WHITE_DWARF, STELLAR_TYPE::CARBON_OXYGEN_WHITE_DWARF })) return CULLING_RULE::WHITE_DWARF;
+
+    bool compact1 = m_Star1->IsOneOf({ STELLAR_TYPE::NEUTRON_STAR, STELLAR_TYPE::BLACK_HOLE });
+    bool compact2 = m_Star2->IsOneOf({ STELLAR_TYPE::NEUTRON_STAR, STELLAR_TYPE::BLACK_HOLE });
+
+    if (compact1 && compact2) return CULLING_RULE::NONE;                                            // already a double compact object
+
+    if (compact1 || compact2) {                                                                     // one NS or BH
+        return (compact1 ? m_Star2 : m_Star1)->Mass() <= MECS ? CULLING_RULE::COMPANION_MASS : CULLING_RULE::NONE;
+    }
+
+    return m_Star1->Mass() + m_Star2->Mass() <= 2.0 * MECS ? CULLING_RULE::TOTAL_MASS : CULLING_RULE::NONE;
+}
+
+
 /*
  * Evolve the binary up to the maximum evolution time (and number of steps)
  *
  * The functional return is the status of the evolution (will indicate why the evolution stopped, and if an error occurred)
  *
+ * Kick resampling branches (see StartKickResampleBranch()) resume evolution at the timestep at which
+ * their snapshot was taken, with the stars already aged through that timestep, and the binary evaluated
+ * up to the supernova.
+ *
+ * Forks (see StartFork()) resume evolution at the start of the timestep at which their snapshot was taken.
+ *
  * JR: todo: flesh-out this documentation
  *
  *
@@ -2293,15 +3381,24 @@ EVOLUTION_STATUS BaseBinaryStar::Evolve() {
         return EVOLUTION_STATUS::ERROR;                                                                                                     // return without evolving
     }
 
-    if (HasStarsTouching()) {                                                                                                               // check if stars are touching
+    bool resume = m_KickResample.resume;                                                                                                    // kick resampling branch resuming at its snapshot?
+    bool fork   = m_Fork.resume;                                                                                                            // fork resuming at its snapshot?
+    m_Fork.resume = false;
+
+    bool detachedSkip   = !resume && !fork && (OPTIONS->NonInteractingFastPath() || TRACK_LIBRARY->Enabled()) &&                            // skip detached evolution (fast path, or on the track library)?
+                          !EVENTS->HasSubscribers(EVENT_TYPE::STELLAR_TYPE_SWITCH);                                                         // (not if switches are logged - they would be logged out of order)
+    bool skipped        = false;                                                                                                            // detached evolution skipped on the track library?
+
+    if (!resume && !fork && HasStarsTouching()) {                                                                                           // check if stars are touching
         m_Flags.stellarMerger        = true;
         m_Flags.stellarMergerAtBirth = true;
         evolutionStatus              = EVOLUTION_STATUS::STELLAR_MERGER_AT_BIRTH;                                                           // binary components are touching - merger at birth
+        PublishEvent(EVENT_TYPE::STELLAR_MERGER);                                                                                           // publish merger event
     }
 
     (void)PrintDetailedOutput(m_Id);                                                                                                        // print (log) detailed output for binary
 
-    if (OPTIONS->PopulationDataPrinting()) {
+    if (!resume && !fork && OPTIONS->PopulationDataPrinting()) {
         SAY("\nGenerating a new binary - " << m_Id);
         SAY("Binary has masses " << m_Star1->Mass() << " & " << m_Star2->Mass() << " Msol");
         SAY("Binary has initial semiMajorAxis " << m_SemiMajorAxis << " AU");
@@ -2310,35 +3407,61 @@ EVOLUTION_STATUS BaseBinaryStar::Evolve() {
 
     if (evolutionStatus == EVOLUTION_STATUS::CONTINUE) {                                                                                    // continue evolution
         // evolve the current binary up to the maximum evolution time (and number of steps)
-        double dt      = std::min(m_Star1->CalculateTimestep(), m_Star2->CalculateTimestep()) / 1000.0;                                     // initialise the timestep
-        int    stepNum = 1;                                                                                                                 // initialise step number
+        double dt      = resume ? m_Dt : (fork ? m_Fork.dt : std::min(m_Star1->CalculateTimestep(), m_Star2->CalculateTimestep()) / 1000.0);  // initialise the timestep
+        int    stepNum = resume ? m_KickResample.stepNum : (fork ? m_Fork.stepNum : 1);                                                     // initialise step number
         while (evolutionStatus == EVOLUTION_STATUS::CONTINUE) {                                                                             // perform binary evolution - iterate over timesteps until told to stop
 
-            EvolveOneTimestep(dt);                                                                                                          // evolve the binary system one timestep
+            m_KickResample.stepNum = stepNum;                                                                                               // current timestep number (for kick resampling snapshots)
+
+            if (OPTIONS->SweptOptionsWatched() && !OPTIONS->SweptOptionRead() && !IsKickResampleBranch()) {                                 // forked evolution, and no swept option read yet?
+                m_Fork.stepNum = stepNum;                                                                                                   // yes - note the timestep (the snapshot is taken by the first fork)
+            }
+            else if (stepNum == m_Fork.snapshotStepNum && !IsKickResampleBranch()) {                                                        // first fork, at the timestep in which the binary first read a swept option?
+                TakeForkSnapshot(dt, stepNum);                                                                                              // yes - snapshot at the start of the timestep
+            }
 
-            // check for problems
+            double dtSkipped = 0.0;                                                                                                         // detached evolution skipped (Myr)
+            if (detachedSkip) {                                                                                                             // first timestep - skip detached evolution?
+                if (OPTIONS->NonInteractingFastPath()) dtSkipped = EvolveNonInteracting(dt);                                                // evolve the stars independently to the first remnant if they cannot interact before it
+                if (dtSkipped <= 0.0 && TRACK_LIBRARY->Enabled()) {                                                                         // otherwise through the detached evolution on the track library if possible
+                    dtSkipped = EvolveDetachedOnTrackLibrary(dt);
+                    skipped   = dtSkipped > 0.0;
+                }
+                detachedSkip = false;
+            }
+            if (dtSkipped > 0.0) dt = dtSkipped;                                                                                            // skipped - the timestep taken
+            else if (!resume) EvolveOneTimestep(dt);                                                                                        // evolve the binary system one timestep (unless resuming - already aged)
+
+            // check for problems (unless resuming - checked before the snapshot was taken)
             if (m_Error != ERROR::NONE) {                                                                                                   // SSE error for either constituent star?
                 evolutionStatus = EVOLUTION_STATUS::SSE_ERROR;                                                                              // yes - stop evolution
             }
-            else if (HasOneOf({ STELLAR_TYPE::MASSLESS_REMNANT })) {                                                                        // at least one massless remnant?
+            else if (!resume && HasOneOf({ STELLAR_TYPE::MASSLESS_REMNANT })) {                                                             // at least one massless remnant?
                 evolutionStatus = EVOLUTION_STATUS::MASSLESS_REMNANT;                                                                       // yes - stop evolution
             }
-            else if (StellarMerger() ) {                                                                                                    // have stars merged?
+            else if (!resume && StellarMerger() ) {                                                                                         // have stars merged?
                 evolutionStatus = EVOLUTION_STATUS::STELLAR_MERGER;                                                                         // for now, stop evolution
             }
-            else if (HasStarsTouching()) {                                                                                                  // binary components touching? (should usually be avoided as MT or CE or merger should happen prior to this)
+            else if (!resume && HasStarsTouching()) {                                                                                       // binary components touching? (should usually be avoided as MT or CE or merger should happen prior to this)
                 evolutionStatus = EVOLUTION_STATUS::STARS_TOUCHING;                                                                         // yes - stop evolution
             }
-            else if (IsUnbound() && !OPTIONS->EvolveUnboundSystems()) {                                                                     // binary is unbound and we don't want unbound systems?
+            else if (!resume && IsUnbound() && !OPTIONS->EvolveUnboundSystems()) {                                                          // binary is unbound and we don't want unbound systems?
                 m_Unbound       = true;                                                                                                     // yes - set the unbound flag (should already be set)
                 evolutionStatus = EVOLUTION_STATUS::UNBOUND;                                                                                // stop evolution
             }
             else {                                                                                                                          // continue evolution
 
-                (void)PrintDetailedOutput(m_Id);                                                                                            // print (log) detailed output for binary
+                (void)PrintDetailedOutputSampled(m_Id);                                                                                     // print (log) detailed output for binary (subject to sampling policy)
+
+                bool massTransfer = m_Star1->IsRLOF() || m_Star2->IsRLOF();                                                                 // mass transfer (RLOF) state before evaluating the binary
 
                 EvaluateBinary(dt);                                                                                                         // evaluate the binary at this timestep
 
+                if ((m_Star1->IsRLOF() || m_Star2->IsRLOF()) != massTransfer) {                                                             // mass transfer (RLOF) started or ended?
+                    PublishEvent(massTransfer ? EVENT_TYPE::MASS_TRANSFER_END : EVENT_TYPE::MASS_TRANSFER_START);                           // yes - publish mass transfer start/end event
+                }
+                if (StellarMerger()) PublishEvent(EVENT_TYPE::STELLAR_MERGER);                                                              // publish merger event (evolution stops on merger, so only once)
+
                 (void)PrintRLOFParameters();                                                                                                // print (log) RLOF parameters
                 
                 // check for problems
@@ -2364,6 +3487,7 @@ EVOLUTION_STATUS BaseBinaryStar::Evolve() {
                         if (m_DCOFormationTime == DEFAULT_INITIAL_DOUBLE_VALUE) {                                                           // DCO not yet evaluated -- to ensure that the coalescence is only resolved once
                             ResolveCoalescence();                                                                                           // yes - resolve coalescence
                             m_DCOFormationTime = m_Time;                                                                                    // set the DCO formation time
+                            PublishEvent(EVENT_TYPE::DCO_FORMATION);                                                                        // publish DCO formation event
                         }
 
                         if (!(OPTIONS->EvolvePulsars() && HasOneOf({ STELLAR_TYPE::NEUTRON_STAR }))) {
@@ -2375,12 +3499,30 @@ EVOLUTION_STATUS BaseBinaryStar::Evolve() {
                     // check for problems
                     if (evolutionStatus == EVOLUTION_STATUS::CONTINUE) {                                                                    // continue evolution?
                              if (m_Error != ERROR::NONE)                                       evolutionStatus = EVOLUTION_STATUS::BINARY_ERROR; // error in binary evolution
-                        else if (IsWDandWD())                                                  evolutionStatus = EVOLUTION_STATUS::WD_WD;   // do not evolve double WD systems for now
+                        else if (IsWDandWD() &&                                                                                             // do not evolve double WD systems for now - unless fast-forwarding, and then only to coalescence
+                                 (!OPTIONS->FastForwardCompactBinaries() ||
+                                  (m_WDWDCoalescenceTime != DEFAULT_INITIAL_DOUBLE_VALUE && m_Time > m_WDWDCoalescenceTime))) evolutionStatus = EVOLUTION_STATUS::WD_WD;
                         else if (IsDCO() && m_Time>(m_DCOFormationTime + m_TimeToCoalescence) && !IsUnbound()){
                             evolutionStatus = EVOLUTION_STATUS::STOPPED; // evolution time exceeds DCO merger time
                         } 
                         else if (m_Time > OPTIONS->MaxEvolutionTime())                         evolutionStatus = EVOLUTION_STATUS::TIMES_UP;// evolution time exceeds maximum
                     }
+
+                    if (evolutionStatus == EVOLUTION_STATUS::CONTINUE) {                                                                    // continue evolution?
+                        CULLING_RULE cullingRule = CullingRule();                                                                           // yes - unless the binary can be culled
+                        if (cullingRule != CULLING_RULE::NONE) {
+                            if (!IsKickResampleBranch() && !IsFork()) {                                                                     // count each binary once (not its kick resampling branches or forks)
+                                switch (cullingRule) {
+                                    case CULLING_RULE::WHITE_DWARF   : m_Culling.whiteDwarf++;    break;
+                                    case CULLING_RULE::COMPANION_MASS: m_Culling.companionMass++; break;
+                                    case CULLING_RULE::TOTAL_MASS    : m_Culling.totalMass++;     break;
+                                    default                          :                            break;
+                                }
+                                m_Culling.timeAtCulling += m_Time;
+                            }
+                            evolutionStatus = EVOLUTION_STATUS::CULLED;                                                                     // stop evolution
+                        }
+                    }
                 }
             }
 
@@ -2388,11 +3530,18 @@ EVOLUTION_STATUS BaseBinaryStar::Evolve() {
 
             if (evolutionStatus == EVOLUTION_STATUS::CONTINUE) {                                                                            // continue evolution?
 
-                dt = std::min(m_Star1->CalculateTimestep(), m_Star2->CalculateTimestep()) * OPTIONS->TimestepMultiplier();                  // new timestep
-                if ((m_Star1->IsOneOf({ STELLAR_TYPE::MASSLESS_REMNANT }) || m_Star2->IsOneOf({ STELLAR_TYPE::MASSLESS_REMNANT })) || dt<NUCLEAR_MINIMUM_TIMESTEP)
-                    dt = NUCLEAR_MINIMUM_TIMESTEP;                                                                                          // but not less than minimum
+                if (OPTIONS->FastForwardCompactBinaries() && IsDetachedCompactBinary()) {                                                   // detached compact-object binary to be fast-forwarded?
+                    dt = CalculateFastForwardTimestep();                                                                                    // yes - step directly to the next event
+                }
+                else {                                                                                                                      // no - timestep as usual
+                    dt = std::min(m_Star1->CalculateTimestep(), m_Star2->CalculateTimestep()) * OPTIONS->TimestepMultiplier();              // new timestep
+                    if ((m_Star1->IsOneOf({ STELLAR_TYPE::MASSLESS_REMNANT }) || m_Star2->IsOneOf({ STELLAR_TYPE::MASSLESS_REMNANT })) || dt<NUCLEAR_MINIMUM_TIMESTEP)
+                        dt = NUCLEAR_MINIMUM_TIMESTEP;                                                                                      // but not less than minimum
+                }
                 stepNum++;                                                                                                                  // increment stepNum
             }
+
+            resume = false;                                                                                                                 // resumed (if resuming)
         }
         if (!StellarMerger())
             (void)PrintDetailedOutput(m_Id);                                                                                                // print (log) detailed output for binary
@@ -2400,10 +3549,23 @@ EVOLUTION_STATUS BaseBinaryStar::Evolve() {
         if (evolutionStatus == EVOLUTION_STATUS::STEPS_UP) {                                                                                // stopped because max timesteps reached?
             SHOW_ERROR(ERROR::BINARY_EVOLUTION_STOPPED);                                                                                    // show error
         }
+
+        if (OPTIONS->CullingMode() != CULLING_MODE::NONE && !IsKickResampleBranch() && !IsFork()) m_Culling.binaries++;                    // binary evolved with culling (counted once - not its kick resampling branches or forks)
+
+        if (skipped) TRACK_LIBRARY->RecordTimeEvolved(m_Time);                                                                              // time evolved by a binary with detached evolution skipped
     }
 
     (void)PrintBinarySystemParameters();                                                                                                    // print (log) binary system parameters
 
+    bool commit = evolutionStatus != EVOLUTION_STATUS::SSE_ERROR && evolutionStatus != EVOLUTION_STATUS::BINARY_ERROR;                      // roll back staged records if evolution ended in error
+
+    if (OPTIONS->ForkVariations() && !IsKickResampleBranch()) {                                                                             // forked evolution?
+        LOGGING->RetainStagedRecords(m_Fork.stagedRecords);                                                                                 // yes - retain the records shared by the forks
+    }
+    (void)LOGGING->CommitStagedRecords(commit, LOGGING->EvaluateLogfilePredicate(this));                                                    // write (or discard) staged records
+
+    if (SAMPLER->Enabled() && !IsKickResampleBranch()) SAMPLER->RecordOutcome(LOGGING->EvaluatePredicate(SAMPLER->HitPredicate(), this));   // adaptive importance sampling: record hit (or miss) - once per binary
+
     return evolutionStatus;
 }
 
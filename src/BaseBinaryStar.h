@@ -8,6 +8,8 @@
 #include "vector3d.h"
 
 #include "Log.h"
+#include "EventBus.h"
+#include "AdaptiveSampler.h"
 #include "Star.h"
 #include "BinaryConstituentStar.h"
 
@@ -50,6 +52,7 @@ public:
         m_Unbound                          = p_Star.m_Unbound;
 
         m_DCOFormationTime                 = p_Star.m_DCOFormationTime;
+        m_WDWDCoalescenceTime              = p_Star.m_WDWDCoalescenceTime;
         
         m_Dt                               = p_Star.m_Dt;
 
@@ -63,6 +66,14 @@ public:
         
         m_FractionAccreted                 = p_Star.m_FractionAccreted;
 
+        m_ImportanceWeight                 = p_Star.m_ImportanceWeight;
+
+        m_KickResample                     = p_Star.m_KickResample;
+        m_KickResampleSnapshots            = {};                    // snapshots are owned by the binary that took them - not copied
+
+        m_Fork                             = p_Star.m_Fork;
+        m_ForkSnapshot                     = nullptr;               // snapshot is owned by the binary that took it - not copied
+
         m_CosIPrime                        = p_Star.m_CosIPrime;
         m_IPrime                           = p_Star.m_IPrime;
 
@@ -85,6 +96,8 @@ public:
 
         m_PrintExtraDetailedOutput         = p_Star.m_PrintExtraDetailedOutput;
 
+        m_DetailedOutputSample             = p_Star.m_DetailedOutputSample;
+
         m_RLOFDetails                      = p_Star.m_RLOFDetails;
         m_RLOFDetails.currentProps         = p_Star.m_RLOFDetails.currentProps  == &(p_Star.m_RLOFDetails.props1) ? &(m_RLOFDetails.props1) : &(m_RLOFDetails.props2);
         m_RLOFDetails.previousProps        = p_Star.m_RLOFDetails.previousProps == &(p_Star.m_RLOFDetails.props1) ? &(m_RLOFDetails.props1) : &(m_RLOFDetails.props2);
@@ -129,6 +142,11 @@ public:
         m_Star1     = p_Star.m_Star1 ? new BinaryConstituentStar(*(p_Star.m_Star1)) : nullptr;
         m_Star2     = p_Star.m_Star2 ? new BinaryConstituentStar(*(p_Star.m_Star2)) : nullptr;
 
+        if (m_Star1 && m_Star2) {                                   // copied stars don't point at their source companions
+            m_Star1->SetCompanion(m_Star2);
+            m_Star2->SetCompanion(m_Star1);
+        }
+
         m_Donor     = p_Star.m_Donor    ? (p_Star.m_Donor    == p_Star.m_Star1 ? m_Star1 : m_Star2) : nullptr;
         m_Accretor  = p_Star.m_Accretor ? (p_Star.m_Accretor == p_Star.m_Star1 ? m_Star1 : m_Star2) : nullptr;
 
@@ -163,7 +181,7 @@ public:
     }
 
 
-    virtual ~BaseBinaryStar() { delete m_Star1; delete m_Star2; }
+    virtual ~BaseBinaryStar() { delete m_Star1; delete m_Star2; for (auto snapshot : m_KickResampleSnapshots) delete snapshot; delete m_ForkSnapshot; }
 
 
     // object identifiers - all classes have these
@@ -189,20 +207,28 @@ public:
     double              EccentricityPreSN() const                   { return m_EccentricityPreSN; }
     double              EccentricityPreCEE() const                  { return m_CEDetails.preCEE.eccentricity; }
     ERROR               Error() const                               { return m_Error; }
+    int                 ForkStepNum() const                         { return m_Fork.stepNum; }
+    int                 ForkVariation() const                       { return m_Fork.variation; }
     double              FractionAccreted() const                    { return m_FractionAccreted; }
     bool                HasOneOf(STELLAR_TYPE_LIST p_List) const;
     bool                HasStarsTouching() const                    { return (utils::Compare(m_SemiMajorAxis, 0.0) > 0) && (m_SemiMajorAxis <= RSOL_TO_AU * (m_Star1->Radius() + m_Star2->Radius())); }
     bool                HasTwoOf(STELLAR_TYPE_LIST p_List) const;
     bool                ImmediateRLOFPostCEE() const                { return m_RLOFDetails.immediateRLOFPostCEE; }
+    double              ImportanceWeight() const                    { return m_ImportanceWeight; }
     STELLAR_TYPE        InitialStellarType1() const                 { return m_Star1->InitialStellarType(); }
     STELLAR_TYPE        InitialStellarType2() const                 { return m_Star2->InitialStellarType(); }
+    bool                IsFork() const                              { return m_Fork.variation > 0; }
+    bool                IsKickResampleBranch() const                { return m_KickResample.branch > 0; }
     bool                IsBeBinary() const                          { return HasOneOf({STELLAR_TYPE::NEUTRON_STAR}) && HasOneOf({STELLAR_TYPE::MS_LTE_07, STELLAR_TYPE::MS_GT_07}); }
     bool                IsBHandBH() const                           { return HasTwoOf({STELLAR_TYPE::BLACK_HOLE}); }
     bool                IsDCO() const                               { return HasTwoOf({STELLAR_TYPE::NEUTRON_STAR, STELLAR_TYPE::BLACK_HOLE}); }
+    bool                IsDetachedCompactBinary() const             { return HasTwoOf({STELLAR_TYPE::HELIUM_WHITE_DWARF, STELLAR_TYPE::CARBON_OXYGEN_WHITE_DWARF, STELLAR_TYPE::OXYGEN_NEON_WHITE_DWARF, STELLAR_TYPE::NEUTRON_STAR, STELLAR_TYPE::BLACK_HOLE}) && !m_Star1->IsRLOF() && !m_Star2->IsRLOF() && !m_CEDetails.CEEnow; }
     bool                IsNSandBH() const                           { return HasOneOf({STELLAR_TYPE::NEUTRON_STAR}) && HasOneOf({STELLAR_TYPE::BLACK_HOLE}); }
     bool                IsNSandNS() const                           { return HasTwoOf({STELLAR_TYPE::NEUTRON_STAR}); }
     bool                IsUnbound() const                           { return (utils::Compare(m_SemiMajorAxis, 0.0) <= 0 || (utils::Compare(m_Eccentricity, 1.0) > 0)); }         // semi major axis <= 0.0 means unbound, presumably by SN)
     bool                IsWDandWD() const                           { return HasTwoOf({STELLAR_TYPE::HELIUM_WHITE_DWARF, STELLAR_TYPE::CARBON_OXYGEN_WHITE_DWARF, STELLAR_TYPE::OXYGEN_NEON_WHITE_DWARF}); }
+    int                 KickResampleBranch() const                  { return m_KickResample.branch; }
+    double              KickResampleWeight() const                  { return m_KickResample.weight; }
     double              Mass1Final() const                          { return m_Mass1Final; }
     double              Mass2Final() const                          { return m_Mass2Final; }
     double              Mass1PostCEE() const                        { return m_Star1->MassPostCEE(); }
@@ -269,12 +295,28 @@ public:
 
     static  double              CalculateRocheLobeRadius_Static(const double p_MassPrimary, const double p_MassSecondary);
 
+    static  std::string         CullingSummary();
+
+    static  std::string         DonorRadiusResponseSummary();
+
             EVOLUTION_STATUS    Evolve();
 
+    static  std::string         MassTransferOrbitSummary();
+
+    static  std::string         NonInteractingFastPathSummary();
+
+            BaseBinaryStar*     ReleaseForkSnapshot()                       { BaseBinaryStar *snapshot = m_ForkSnapshot; m_ForkSnapshot = nullptr; return snapshot; }
+            std::vector<BaseBinaryStar*> ReleaseKickResampleSnapshots();
+
             bool                PrintSwitchLog(const long int p_Id, const bool p_PrimarySwitching) { return OPTIONS->SwitchLog() ? LOGGING->LogBSESwitchLog(this, p_Id, p_PrimarySwitching) : true; }
 
             COMPAS_VARIABLE     PropertyValue(const T_ANY_PROPERTY p_Property) const;
 
+            void                SetForkVariation(const int p_Variation, const int p_SnapshotStepNum)   { m_Fork.variation = p_Variation; m_Fork.snapshotStepNum = p_SnapshotStepNum; }
+
+            void                StartFork();
+            void                StartKickResampleBranch(const int p_Branch);
+
             BinaryConstituentStar* Star1() { return m_Star1; }                              // Returns a pointer to the primary - here mainly to support the BSE Switch Log. Be careful!
             BinaryConstituentStar* Star2() { return m_Star2; }                              // Returns a pointer to the secondary - here mainly to support the BSE Switch Log. Be careful!
 
@@ -282,6 +324,52 @@ private:
 
     BaseBinaryStar() { }
 
+    // Comparison of the orbit integrators through mass transfer, over the run (--mass-transfer-orbit-integrator VALIDATE)
+    typedef struct MassTransferOrbitValidation {
+        unsigned long int   calls;                                                          // number of orbits integrated
+        unsigned long int   eulerSteps;                                                     // Euler steps taken
+        unsigned long int   adaptiveEvaluations;                                            // derivative evaluations by the adaptive integrator
+        double              maxRelativeDifferenceAnalytic;                                  // maximum |a(closed form) - a(Euler)| / a(Euler)
+        double              maxRelativeDifferenceAdaptive;                                  // maximum |a(adaptive) - a(Euler)| / a(Euler)
+        double              maxRelativeDifferenceAnalyticAdaptive;                          // maximum |a(adaptive) - a(closed form)| / a(closed form)
+    } MassTransferOrbitValidationT;
+
+    static MassTransferOrbitValidationT m_MassTransferOrbitValidation;
+
+    // Comparison of the modelled donor radius response with an updated copy of the donor, over the run (--mass-transfer-donor-radius-response VALIDATE)
+    typedef struct DonorRadiusValidation {
+        unsigned long int   calls;                                                          // number of donor radii evaluated
+        unsigned long int   modelled;                                                       // number of donor radii also modelled
+        double              maxRelativeDifference;                                          // maximum |R(model) - R(copy)| / R(copy)
+        double              cloneSeconds;                                                   // time spent copying and updating the donor
+        double              modelSeconds;                                                   // time spent modelling the radius
+    } DonorRadiusValidationT;
+
+    static DonorRadiusValidationT m_DonorRadiusValidation;
+
+    // Use of the non-interacting fast path, over the run (--non-interacting-fast-path)
+    typedef struct NonInteractingFastPath {
+        unsigned long int   binaries;                                                       // number of binaries tried
+        unsigned long int   predictedToInteract;                                            // number predicted to interact from the track library (not tried further)
+        unsigned long int   interacting;                                                    // number with a star reaching its Roche lobe bound
+        unsigned long int   tooShort;                                                       // number with a remnant forming too soon to skip any evolution
+        unsigned long int   fastPathed;                                                     // number evolved independently to the first remnant
+        double              timeSkipped;                                                    // total time skipped (Myr)
+    } NonInteractingFastPathT;
+
+    static NonInteractingFastPathT m_NonInteractingFastPath;
+
+    // Binaries culled, over the run (--culling-mode)
+    typedef struct Culling {
+        unsigned long int   binaries;                                                       // number of binaries evolved with culling
+        unsigned long int   whiteDwarf;                                                     // number culled with a helium or carbon-oxygen white dwarf
+        unsigned long int   companionMass;                                                  // number culled with a NS or BH and a companion too light to collapse
+        unsigned long int   totalMass;                                                      // number culled with neither a NS nor a BH, and total mass too low for two collapses
+        double              timeAtCulling;                                                  // total time at which binaries were culled (Myr)
+    } CullingT;
+
+    static CullingT m_Culling;
+
     OBJECT_ID    m_ObjectId;                                                                // Instantiated object's unique object id
     OBJECT_TYPE  m_ObjectType;                                                              // Instantiated object's object type
     STELLAR_TYPE m_StellarType;                                                             // Stellar type defined in Hurley et al. 2000
@@ -323,6 +411,34 @@ private:
 
     double	            m_FractionAccreted;	                                                // Fraction of mass accreted from the donor during mass transfer
 
+    double              m_ImportanceWeight;                                                 // Importance weight of the initial conditions (1.0 unless adaptive importance sampling)
+
+    struct KICK_RESAMPLE {                                                                  // Kick resampling state (see TakeKickResampleSnapshot())
+
+        int          branch;                                                                // Branch number: 0 = evolved from ZAMS, > 0 = continued from a pre-supernova snapshot under a new kick draw
+        double       weight;                                                                // Statistical weight of the branch (1/K for each resampled supernova, K = number of kick resamples)
+        int          supernovae;                                                            // Number of supernovae resampled so far
+        int          stepNum;                                                               // Timestep number of the current timestep (for a snapshot, the timestep at which it was taken)
+        bool         resume;                                                                // Resume evolution at the snapshot (branches only - set by StartKickResampleBranch())
+
+    }                   m_KickResample;
+
+    std::vector<BaseBinaryStar*> m_KickResampleSnapshots;                                   // Pre-supernova snapshots taken by this binary, from which branches are to be evolved (owned)
+
+    struct FORK {                                                                           // Forked evolution state (see TakeForkSnapshot())
+
+        int          variation;                                                             // Variation number - 0 is the binary evolved for the first variation
+        int          stepNum;                                                               // Timestep number of the timestep in which a swept option was first read (for a snapshot, the timestep at which it was taken)
+        int          snapshotStepNum;                                                       // Timestep number of the timestep at which the snapshot is to be taken (first fork only - 0 if none)
+        double       dt;                                                                    // Timestep at which the snapshot was taken
+        RandStateT   randState;                                                             // State of the random number service when the snapshot was taken
+        size_t       stagedRecords;                                                         // Number of logfile records staged when the snapshot was taken
+        bool         resume;                                                                // Resume evolution at the snapshot (forks only - set by StartFork())
+
+    }                   m_Fork;
+
+    BaseBinaryStar     *m_ForkSnapshot;                                                     // Snapshot taken by the first fork, from which subsequent forks are evolved (owned)
+
     double              m_CosIPrime;
     double              m_IPrime;
 
@@ -345,6 +461,24 @@ private:
 
     bool                m_PrintExtraDetailedOutput;                                         // Flag to ensure that detailed output only gets printed once per timestep
 
+    struct DETAILED_OUTPUT_SAMPLE {                                                         // Detailed output sampling state - as at the last detailed output record printed
+
+        int          stepsSincePrint;                                                       // Number of sampled timesteps since the last record was printed
+
+        double       mass1;                                                                 // Star1 mass
+        double       mass2;                                                                 // Star2 mass
+        double       radius1;                                                               // Star1 radius
+        double       radius2;                                                               // Star2 radius
+        double       semiMajorAxis;                                                         // Semi-major axis
+
+        STELLAR_TYPE stellarType1;                                                          // Star1 stellar type
+        STELLAR_TYPE stellarType2;                                                          // Star2 stellar type
+
+        bool         isRLOF1;                                                               // Star1 RLOF state
+        bool         isRLOF2;                                                               // Star2 RLOF state
+
+    }                   m_DetailedOutputSample;
+
     BinaryRLOFDetailsT  m_RLOFDetails;                                                      // RLOF details
 
     double              m_SemiMajorAxis;                                                    // Semi-major axis
@@ -366,6 +500,7 @@ private:
     double              m_TimePrev;                                                         // Previous simulation time
     double              m_TimeToCoalescence;                                                // Coalescence time
     double              m_DCOFormationTime;                                                 // Time of DCO formation
+    double              m_WDWDCoalescenceTime;                                              // Time of coalescence of a fast-forwarded double white dwarf (see CalculateFastForwardTimestep())
 
     double              m_TotalAngularMomentum;
 
@@ -429,6 +564,10 @@ private:
 
     void    CalculateEnergyAndAngularMomentum();
 
+    double  CalculateDonorRadiusAfterMassLoss(const BinaryConstituentStar* p_Donor, const double p_MassLost);
+
+    double  CalculateFastForwardTimestep();
+
     double  CalculateGammaAngularMomentumLoss(const double p_DonorMass, const double p_AccretorMass);
     double  CalculateGammaAngularMomentumLoss()                                 { return CalculateGammaAngularMomentumLoss(m_Donor->Mass(), m_Accretor->Mass()); }
 
@@ -441,6 +580,23 @@ private:
                                              BinaryConstituentStar& p_Accretor, 
                                        const double                 p_FractionAccreted);
 
+    double  CalculateMassTransferOrbitAdaptive(const double                 p_DonorMass,
+                                               const double                 p_DeltaMassDonor,
+                                                     BinaryConstituentStar& p_Accretor,
+                                               const double                 p_FractionAccreted,
+                                                     unsigned long int&     p_Evaluations);
+
+    double  CalculateMassTransferOrbitAnalytic(const double                 p_DonorMass,
+                                               const double                 p_DeltaMassDonor,
+                                                     BinaryConstituentStar& p_Accretor,
+                                               const double                 p_FractionAccreted);
+
+    double  CalculateMassTransferOrbitEuler(const double                 p_DonorMass,
+                                            const double                 p_DeltaMassDonor,
+                                                  BinaryConstituentStar& p_Accretor,
+                                            const double                 p_FractionAccreted,
+                                                  unsigned long int&     p_Steps);
+
     void    CalculateWindsMassLoss();
     void    InitialiseMassTransfer();
 
@@ -482,6 +638,17 @@ private:
 
     void    EvaluateSupernovae();
 
+    void    ApplyDetachedWinds(BinaryConstituentStar *p_Star);
+
+    double  CalculateDetachedRocheLobeBound(const double p_Mass, const double p_CompanionMass, const double p_TotalMass) const;
+
+    CULLING_RULE CullingRule() const;
+
+    double  EvolveDetachedOnTrackLibrary(const double p_Dt);
+    bool    EvolveDetachedStar(BinaryConstituentStar *p_Star, const TrackT *p_Track, const double p_CompanionMass, const double p_TotalMass, const double p_MaximumTime, const RandStateT &p_RandState, double &p_Time, double &p_Widening);
+
+    double  EvolveNonInteracting(const double p_Dt);
+
     void    EvolveOneTimestep(const double p_Dt);
     void    EvolveOneTimestepPreamble(const double p_Dt);
 
@@ -503,12 +670,23 @@ private:
     void    StashBeBinaryProperties();
     void    StashRLOFProperties();
 
+    void    TakeForkSnapshot(const double p_Dt, const int p_StepNum);
+    void    TakeKickResampleSnapshot();
+
     void    UpdateSystemicVelocity(Vector3d p_newVelocity);
 
+    // event publishing - costs a single check if there are no subscribers to the event type (see EventBus.h)
+    void PublishEvent(const EVENT_TYPE p_EventType, const BinaryConstituentStar* const p_Star = nullptr) const {
+        if (EVENTS->HasSubscribers(p_EventType)) {
+            EVENTS->Publish({ p_EventType, m_Id, p_Star ? p_Star->StarObjectId() : m_ObjectId, p_Star ? p_Star->StellarTypePrev() : STELLAR_TYPE::NONE, p_Star ? p_Star->StellarType() : STELLAR_TYPE::NONE, m_Time });
+        }
+    }
+
     // printing functions
     bool PrintRLOFParameters(const string p_Rec = "");
     bool PrintBinarySystemParameters(const string p_Rec = "") const              { return LOGGING->LogBSESystemParameters(this, p_Rec); }
-    bool PrintDetailedOutput(const long int p_Id, const string p_Rec = "") const { return OPTIONS->DetailedOutput() ? LOGGING->LogBSEDetailedOutput(this, p_Id, p_Rec) : true; }
+    bool PrintDetailedOutput(const long int p_Id, const string p_Rec = "");
+    bool PrintDetailedOutputSampled(const long int p_Id);
     bool PrintDoubleCompactObjects(const string p_Rec = "") const                { return LOGGING->LogDoubleCompactObject(this, p_Rec); }
     bool PrintCommonEnvelope(const string p_Rec = "") const                      { return LOGGING->LogCommonEnvelope(this, p_Rec); }
     bool PrintBeBinary(const string p_Rec = "");
@@ -538,21 +716,10 @@ private:
             double donorMass    = m_Donor->Mass();
             double accretorMass = m_Accretor->Mass();
 
-            BinaryConstituentStar* donorCopy = new BinaryConstituentStar(*m_Donor);
-            double semiMajorAxis = m_Binary->CalculateMassTransferOrbit(donorCopy->Mass(), -dM , donorCopy->CalculateThermalMassLossRate(), *m_Accretor, m_FractionAccreted);
+            double semiMajorAxis = m_Binary->CalculateMassTransferOrbit(donorMass, -dM , m_Donor->CalculateThermalMassLossRate(), *m_Accretor, m_FractionAccreted);
             double RLRadius      = semiMajorAxis * (1 - m_Binary->Eccentricity()) * CalculateRocheLobeRadius_Static(donorMass - dM, accretorMass + (m_Binary->FractionAccreted() * dM)) * AU_TO_RSOL;
             
-            (void)donorCopy->UpdateAttributes(-dM, -dM*donorCopy->Mass0()/donorCopy->Mass());
-            
-            // Modify donor Mass0 and Age for MS (including HeMS) and HG stars
-            donorCopy->UpdateInitialMass();         // update initial mass (MS, HG & HeMS)  JR: todo: fix this kludge - mass0 is overloaded, and isn't always "initial mass"
-            donorCopy->UpdateAgeAfterMassLoss();    // update age (MS, HG & HeMS)
-            
-            (void)donorCopy->AgeOneTimestep(0.0);   // recalculate radius of star - don't age - just update values
-            
-            double thisRadiusAfterMassLoss = donorCopy->Radius();
-            
-            delete donorCopy; donorCopy = nullptr;
+            double thisRadiusAfterMassLoss = m_Binary->CalculateDonorRadiusAfterMassLoss(m_Donor, dM);
             
             return (RLRadius-thisRadiusAfterMassLoss);
         }
@@ -1,13 +1,15 @@
 // gsl includes
 #include <gsl/gsl_roots.h>
-#include <gsl/gsl_cdf.h>
 
 // boost includes
 #include <boost/math/distributions.hpp>
 
 #include "Rand.h"
+#include "KickSampler.h"
 #include "BaseStar.h"
+#include "GiantBranch.h"
 #include "vector3d.h"
+#include "powers.h"
 
 using std::max;
 using std::min;
@@ -730,7 +732,7 @@ double BaseStar::CalculateAlpha1() const {
 #define b m_BnCoefficients                                              // for convenience and readability - undefined at end of function
 #define massCutoffs(x) m_MassCutoffs[static_cast<int>(MASS_CUTOFF::x)]  // for convenience and readability - undefined at end of function
 
-    double LHeI_MHeF = (b[11] + (b[12] * PPOW(massCutoffs(MHeF), 3.8))) / (b[13] + (massCutoffs(MHeF) * massCutoffs(MHeF)));
+    double LHeI_MHeF = (b[11] + (b[12] * powers::Pow<19, 5>(massCutoffs(MHeF)))) / (b[13] + (massCutoffs(MHeF) * massCutoffs(MHeF)));
     return ((b[9] * PPOW(massCutoffs(MHeF), b[10])) - LHeI_MHeF) / LHeI_MHeF;
 
 #undef massCutoffs
@@ -1208,11 +1210,30 @@ void BaseStar::CalculateLambdas(const double p_EnvMass) {
  * @return                                      Luminosity in Lsol (LZAMS)
  */
 double BaseStar::CalculateLuminosityAtZAMS(const double p_MZAMS) {
-#define coeff(x) m_LCoefficients[static_cast<int>(L_Coeff::x)]   // for convenience and readability - undefined at end of function
+    return CalculateLuminosityAtZAMS_Static(p_MZAMS, std::sqrt(p_MZAMS), m_LCoefficients.data());
+}
+
+
+/*
+ * Calculate luminosity at ZAMS (in Lsol)
+ * Tout et al. 1996, eq 1
+ *
+ * Static version shared by CalculateLuminosityAtZAMS() and CalculateLuminosityAtZAMS_Batch(), so the
+ * scalar and batch versions perform the same operations (and so return identical results)
+ *
+ *
+ * double CalculateLuminosityAtZAMS_Static(const double p_MZAMS, const double p_SqrtMass, const double *p_LCoefficients)
+ *
+ * @param   [IN]    p_MZAMS                     Zero age main sequence mass in Msol
+ * @param   [IN]    p_SqrtMass                  sqrt(p_MZAMS) - passed in so the batch version can take it out of its vectorised loop
+ * @param   [IN]    p_LCoefficients             Luminosity coefficients (indexed by L_Coeff)
+ * @return                                      Luminosity in Lsol (LZAMS)
+ */
+double BaseStar::CalculateLuminosityAtZAMS_Static(const double p_MZAMS, const double p_SqrtMass, const double *p_LCoefficients) {
+#define coeff(x) p_LCoefficients[static_cast<int>(L_Coeff::x)]  // for convenience and readability - undefined at end of function
 
     // pow() is slow - use multiplication where it makes sense
-    // sqrt() is much faster than pow()
-    double m_0_5 = sqrt(p_MZAMS);
+    double m_0_5 = p_SqrtMass;
     double m_2   = p_MZAMS * p_MZAMS;
     double m_3   = m_2 * p_MZAMS;
     double m_5   = m_3 * m_2;
@@ -1246,9 +1267,12 @@ double BaseStar::CalculateLuminosityAtBAGB(double p_Mass) const {
 #define b m_BnCoefficients                                              // for convenience and readability - undefined at end of function
 #define massCutoffs(x) m_MassCutoffs[static_cast<int>(MASS_CUTOFF::x)]  // for convenience and readability - undefined at end of function
 
-    return (utils::Compare(p_Mass, massCutoffs(MHeF)) < 0)
-            ? (b[29] * PPOW(p_Mass, b[30])) / (1.0 + (m_Alpha3 * exp(15.0 * (p_Mass - massCutoffs(MHeF)))))
-            : (b[31] + (b[32] * PPOW(p_Mass, (b[33] + 1.8)))) / (b[34] + PPOW(p_Mass, b[33]));
+    if (utils::Compare(p_Mass, massCutoffs(MHeF)) < 0) {
+        return (b[29] * PPOW(p_Mass, b[30])) / (1.0 + (m_Alpha3 * exp(15.0 * (p_Mass - massCutoffs(MHeF)))));
+    }
+
+    powers::SharedBase m(p_Mass);                                       // log2(mass) once for both powers
+    return (b[31] + (b[32] * m.Pow(b[33] + 1.8))) / (b[34] + m.Pow(b[33]));
 
 #undef massCutoffs
 #undef b
@@ -1292,11 +1316,30 @@ double BaseStar::CalculateLuminosityGivenCoreMass(const double p_CoreMass) const
  * Uses class member m_RCoefficients as radius coefficients
  */
 double BaseStar::CalculateRadiusAtZAMS(const double p_MZAMS) const {
-#define coeff(x) m_RCoefficients[static_cast<int>(R_Coeff::x)]  // for convenience and readability - undefined at end of function
+    return CalculateRadiusAtZAMS_Static(p_MZAMS, std::sqrt(p_MZAMS), m_RCoefficients.data());
+}
+
+
+/*
+ * Calculate radius at ZAMS in units of Rsol
+ * Tout et al. 1996, eq 2
+ *
+ * Static version shared by CalculateRadiusAtZAMS() and CalculateRadiusAtZAMS_Batch(), so the
+ * scalar and batch versions perform the same operations (and so return identical results)
+ *
+ *
+ * double CalculateRadiusAtZAMS_Static(const double p_MZAMS, const double p_SqrtMass, const double *p_RCoefficients)
+ *
+ * @param   [IN]    p_MZAMS                     Zero age main sequence mass in Msol
+ * @param   [IN]    p_SqrtMass                  sqrt(p_MZAMS) - passed in so the batch version can take it out of its vectorised loop
+ * @param   [IN]    p_RCoefficients             Radius coefficients (indexed by R_Coeff)
+ * @return                                      Radius in units of Rsol (RZAMS)
+ */
+double BaseStar::CalculateRadiusAtZAMS_Static(const double p_MZAMS, const double p_SqrtMass, const double *p_RCoefficients) {
+#define coeff(x) p_RCoefficients[static_cast<int>(R_Coeff::x)] // for convenience and readability - undefined at end of function
 
     // pow() is slow - use multiplication where it makes sense
-    // sqrt() is much faster than pow()
-    double m_0_5  = sqrt(p_MZAMS);
+    double m_0_5  = p_SqrtMass;
     double m_2    = p_MZAMS * p_MZAMS;
     double m_2_5  = m_2 * m_0_5;
     double m_6    = m_2 * m_2 * m_2;
@@ -1515,7 +1558,7 @@ double BaseStar::CalculateMassLossRateLBV(const LBV_PRESCRIPTION p_LBV_prescript
  * @return                                      LBV-like mass loss rate (in Msol yr^{-1})
  */
 double BaseStar::CalculateMassLossRateLBVHurley(const double p_HD_limit_factor) const {
-    return 0.1 * PPOW((p_HD_limit_factor - 1.0), 3.0) * ((m_Luminosity / 6.0E5) - 1.0);
+    return 0.1 * powers::Pow<3>(p_HD_limit_factor - 1.0) * ((m_Luminosity / 6.0E5) - 1.0);
 }
 
 
@@ -1551,7 +1594,7 @@ double BaseStar::CalculateMassLossRateWolfRayet(const double p_Mu) const {
     // can be set to zero to disable this particular part of winds. We instead opt for all winds on or off.
     double rate = 0.0;
     if (utils::Compare(p_Mu, 1.0) < 0) {
-        rate = PPOW(m_Luminosity, 1.5) * (1.0 - p_Mu) * 1.0E-13;
+        rate = powers::Pow<3, 2>(m_Luminosity) * (1.0 - p_Mu) * 1.0E-13;
     }
     return rate;
 }
@@ -1576,7 +1619,7 @@ double BaseStar::CalculateMassLossRateWolfRayetZDependent(const double p_Mu) con
     // TW - Haven't seen StarTrack but I think H&K gives the original equation and V&dK gives the Z dependence
     double rate = 0.0;
     if (utils::Compare(p_Mu, 1.0) < 0) {
-        rate = OPTIONS->WolfRayetFactor() * 1.0E-13 * PPOW(m_Luminosity, 1.5) * PPOW(m_Metallicity / ZSOL, 0.86) * (1.0 - p_Mu);
+        rate = OPTIONS->WolfRayetFactor() * 1.0E-13 * powers::Pow<3, 2>(m_Luminosity) * PPOW(m_Metallicity / ZSOL, 0.86) * (1.0 - p_Mu);
     }
     return rate;
 }
@@ -2018,21 +2061,58 @@ double BaseStar::CalculateOStarRotationalVelocityAnalyticCDFInverse_Static(doubl
 
 
 /*
- * Calculate rotational velocity from the analytic cumulative distribution function (CDF)
+ * Build the inverse-sampling table for the analytic cumulative distribution function (CDF)
  * for the equatorial rotational velocity of single O stars.
  *
- * Uses inverse sampling and root finding
+ * The table holds (vE, CDF(vE)) pairs, so x(y) interpolation on the table is the inverse CDF.
+ * It is built once per run (on the first call), by recursive bisection of [p_Xmin, vMax]
+ * (see TabulatedFunction::TabulateMonotone()) until linear interpolation of the inverse CDF is
+ * accurate to ROTATIONAL_VELOCITY_TABLE_TOLERANCE (relative; absolute ROTATIONAL_VELOCITY_TABLE_TOLERANCE
+ * km s^-1 for vE < 1 km s^-1) within every segment - tighter than the tolerance of the root solver in
+ * CalculateOStarRotationalVelocityExact_Static().
+ * vMax is p_Xmax, doubled until the CDF above it is < 1.0E-12.
+ *
+ * The bounds are those of the first call - subsequent calls return the same table.
  *
  * Ramirez-Agudelo et al. 2013 https://arxiv.org/abs/1309.2929
  *
  *
- * double CalculateOStarRotationalVelocity_Static(double p_U, double p_Xmin, double p_Xmax)
+ * const TabulatedFunction& CalculateOStarRotationalVelocityCDFTable_Static(const double p_Xmin, const double p_Xmax)
  *
+ * @param   [IN]    p_Xmin                      Minimum rotational velocity in km s^-1
+ * @param   [IN]    p_Xmax                      Initial maximum rotational velocity in km s^-1
+ * @return                                      The inverse-sampling table
+ */
+const TabulatedFunction& BaseStar::CalculateOStarRotationalVelocityCDFTable_Static(const double p_Xmin, const double p_Xmax) {
+
+    static const TabulatedFunction table = [p_Xmin, p_Xmax]() {
+        double xMax = p_Xmax;
+        while (CalculateOStarRotationalVelocityAnalyticCDF_Static(xMax) < 1.0 - 1.0E-12) xMax *= 2.0;   // leave this as an absolute compare
+        return TabulatedFunction::TabulateMonotone(CalculateOStarRotationalVelocityAnalyticCDF_Static, p_Xmin, xMax, ROTATIONAL_VELOCITY_TABLE_TOLERANCE);
+    }();
+
+    return table;
+}
+
+
+/*
+ * Calculate rotational velocity from the analytic cumulative distribution function (CDF)
+ * for the equatorial rotational velocity of single O stars, by root finding.
+ *
+ * This is the exact inverse - used if program option --rotational-velocity-exact-inverse is
+ * specified (e.g. to validate the precomputed table)
+ *
+ * Ramirez-Agudelo et al. 2013 https://arxiv.org/abs/1309.2929
+ *
+ *
+ * double CalculateOStarRotationalVelocityExact_Static(const double p_U, const double p_Xmin, const double p_Xmax)
+ *
+ * @param   [IN]    p_U                         CDF draw U(0,1)
  * @param   [IN]    p_Xmin                      Minimum value for root
  * @param   [IN]    p_Xmax                      Maximum value for root
  * @return                                      Rotational velocity in km s^-1
  */
-double BaseStar::CalculateOStarRotationalVelocity_Static(const double p_Xmin, const double p_Xmax) {
+double BaseStar::CalculateOStarRotationalVelocityExact_Static(const double p_U, const double p_Xmin, const double p_Xmax) {
 
     double xMin = p_Xmin;
     double xMax = p_Xmax;
@@ -2042,7 +2122,7 @@ double BaseStar::CalculateOStarRotationalVelocity_Static(const double p_Xmin, co
     double maximumInverse = CalculateOStarRotationalVelocityAnalyticCDF_Static(xMax);
     double minimumInverse = CalculateOStarRotationalVelocityAnalyticCDF_Static(xMin);
 
-    double rand = RAND->Random();
+    double rand = p_U;
 
     while (utils::Compare(rand, maximumInverse) > 0) {
         xMax          *= 2.0;
@@ -2087,6 +2167,34 @@ double BaseStar::CalculateOStarRotationalVelocity_Static(const double p_Xmin, co
 }
 
 
+/*
+ * Calculate rotational velocity from the analytic cumulative distribution function (CDF)
+ * for the equatorial rotational velocity of single O stars.
+ *
+ * Uses inverse sampling: from the precomputed table (see CalculateOStarRotationalVelocityCDFTable_Static()),
+ * or by root finding if program option --rotational-velocity-exact-inverse is specified
+ *
+ * Ramirez-Agudelo et al. 2013 https://arxiv.org/abs/1309.2929
+ *
+ *
+ * double CalculateOStarRotationalVelocity_Static(double p_Xmin, double p_Xmax)
+ *
+ * @param   [IN]    p_Xmin                      Minimum value for root
+ * @param   [IN]    p_Xmax                      Maximum value for root
+ * @return                                      Rotational velocity in km s^-1
+ */
+double BaseStar::CalculateOStarRotationalVelocity_Static(const double p_Xmin, const double p_Xmax) {
+
+    RAND->Stream(RANDOM_STREAM::ROTATION);                                                          // common random numbers: rotation substream (no-op unless --common-random-numbers)
+    double rand = RAND->Random();
+    RAND->StreamClear();
+
+    return OPTIONS->RotationalVelocityExactInverse()
+            ? CalculateOStarRotationalVelocityExact_Static(rand, p_Xmin, p_Xmax)
+            : CalculateOStarRotationalVelocityCDFTable_Static(p_Xmin, p_Xmax).InverseInterpolate(rand);
+}
+
+
 /*
  * Calculate the inital rotational velocity (in km s^-1 ) of a star with ZAMS mass MZAMS
  *
@@ -2125,7 +2233,9 @@ double BaseStar::CalculateRotationalVelocity(double p_MZAMS) const {
                 vRot = CalculateOStarRotationalVelocity_Static(0.0, 800.0);
             }
             else if (utils::Compare(p_MZAMS, 2.0) >= 0) {
-                vRot = utils::InverseSampleFromTabulatedCDF(RAND->Random(), BStarRotationalVelocityCDFTable);
+                RAND->Stream(RANDOM_STREAM::ROTATION);                                                      // common random numbers: rotation substream (no-op unless --common-random-numbers)
+                vRot = utils::InverseSampleFromTabulatedCDF(RAND->Random(), BStarRotationalVelocityCDFTable());
+                RAND->StreamClear();
             }
             else {
                 // Don't know what better to use for low mass stars so for now
@@ -2233,12 +2343,33 @@ double BaseStar::CalculateOmegaCHE(const double p_MZAMS, const double p_Metallic
  * @return                                      Lifetime to the Base of the Giant Branch in Myr
  */
 double BaseStar::CalculateLifetimeToBGB(const double p_Mass) const {
-#define a m_AnCoefficients    // for convenience and readability - undefined at end of function
+    return CalculateLifetimeToBGB_Static(p_Mass, std::sqrt(p_Mass), m_AnCoefficients.data());
+}
 
-    // pow() is slow - use multiplication (sqrt() is much faster than pow())
+
+/*
+ * Calculate lifetime to the Base of the Giant Branch (end of the Hertzsprung Gap)
+ *
+ * Hurley et al. 2000, eq 4
+ *
+ * Static version shared by CalculateLifetimeToBGB() and CalculateLifetimeToBGB_Batch(), so the
+ * scalar and batch versions perform the same operations (and so return identical results)
+ *
+ *
+ * double CalculateLifetimeToBGB_Static(const double p_Mass, const double p_SqrtMass, const double *p_AnCoefficients)
+ *
+ * @param   [IN]    p_Mass                      Mass in Msol
+ * @param   [IN]    p_SqrtMass                  sqrt(p_Mass) - passed in so the batch version can take it out of its vectorised loop
+ * @param   [IN]    p_AnCoefficients            a(n) coefficients (only a[1] - a[5] are used)
+ * @return                                      Lifetime to the Base of the Giant Branch in Myr
+ */
+double BaseStar::CalculateLifetimeToBGB_Static(const double p_Mass, const double p_SqrtMass, const double *p_AnCoefficients) {
+#define a p_AnCoefficients    // for convenience and readability - undefined at end of function
+
+    // pow() is slow - use multiplication
     double m_2   = p_Mass * p_Mass;
     double m_4   = m_2 * m_2;
-    double m_5_5 = m_4 * p_Mass * sqrt(p_Mass);
+    double m_5_5 = m_4 * p_Mass * p_SqrtMass;
     double m_7   = m_4 * m_2 * p_Mass;
 
     return (a[1] + (a[2] * m_4) + (a[3] * m_5_5) + m_7) / ((a[4] * m_2) + (a[5] * m_7));
@@ -2341,7 +2472,7 @@ double BaseStar::CalculateEddyTurnoverTimescale() {
 
 	double rEnv	= CalculateRadialExtentConvectiveEnvelope();
 
-	return 0.4311 * PPOW((m_Mass * rEnv * (m_Radius - (0.5 * rEnv))) / (3.0 * m_Luminosity), 1.0 / 3.0);
+	return 0.4311 * powers::Pow<1, 3>((m_Mass * rEnv * (m_Radius - (0.5 * rEnv))) / (3.0 * m_Luminosity));
 }
 
 
@@ -2414,7 +2545,7 @@ double BaseStar::CalculateEddyTurnoverTimescale() {
  * @return                                      Drawn kick magnitude (km s^-1)
  */
 double BaseStar::DrawKickMagnitudeDistributionMaxwell(const double p_Sigma, const double p_Rand) const {
-    return p_Sigma * sqrt(gsl_cdf_chisq_Pinv(p_Rand, 3)); // a Maxwellian is a chi distribution with three degrees of freedom
+    return p_Sigma * KICK_SAMPLER->MaxwellInverseCDF(p_Rand); // a Maxwellian is a chi distribution with three degrees of freedom - see KickSampler.h
 }
 
 
@@ -2518,7 +2649,7 @@ double BaseStar::DrawRemnantKickMullerMandel(const double p_COCoreMass,
 	}
 
 	while (remnantKick < 0.0) {
-		remnantKick = muKick * (1.0 + gsl_cdf_gaussian_Pinv(rand, MULLERMANDEL_SIGMAKICK));
+		remnantKick = muKick * (1.0 + (MULLERMANDEL_SIGMAKICK * KICK_SAMPLER->GaussianInverseCDF(rand)));
 		rand        = min(rand + p_Rand + 0.0001, 1.0);
 	}
 
@@ -2692,6 +2823,47 @@ double BaseStar::CalculateSNKickMagnitude(const double p_RemnantMass, const doub
 }
 
 
+/*
+ * Redraw the natal kick of the supernova happening now
+ *
+ * Used for kick resampling (program option --kick-resamples): a binary snapshotted just before a
+ * supernova is resolved is continued under several independent kick draws.  The random number used
+ * to draw the kick magnitude, the kick direction (theta, phi) and the mean anomaly of the orbit at
+ * the instant of the supernova are drawn again - except any the user specified - and the kick
+ * magnitude recalculated from the new random number exactly as it was at the supernova.
+ *
+ * Only core-collapse, electron-capture and ultra-stripped supernovae draw kicks - for other events
+ * (or if no supernova is happening now) this is a no-op.
+ *
+ *
+ * void ResampleSNKick()
+ */
+void BaseStar::ResampleSNKick() {
+
+    SN_EVENT snEvent = utils::SNEventType(m_SupernovaDetails.events.current);                      // supernova event happening now
+    if (snEvent != SN_EVENT::CCSN && snEvent != SN_EVENT::ECSN && snEvent != SN_EVENT::USSN) return; // no kick drawn - nothing to do
+
+    const KickParameters &initial = m_SupernovaDetails.initialKickParameters;                      // user-specified values are kept
+
+    RAND->Stream(RANDOM_STREAM::SUPERNOVA_KICK);                                                    // common random numbers: kick substream (no-op unless --common-random-numbers)
+
+    if (!initial.magnitudeRandomSpecified) m_SupernovaDetails.kickMagnitudeRandom = RAND->Random();
+
+    if (!initial.thetaSpecified || !initial.phiSpecified) {
+        double theta, phi;
+        std::tie(theta, phi) = utils::DrawKickDirection(OPTIONS->KickDirectionDistribution(), OPTIONS->KickDirectionPower());
+        if (!initial.thetaSpecified) m_SupernovaDetails.theta = theta;
+        if (!initial.phiSpecified)   m_SupernovaDetails.phi   = phi;
+    }
+
+    if (!initial.meanAnomalySpecified) m_SupernovaDetails.meanAnomaly = RAND->Random(0.0, _2_PI);
+
+    RAND->StreamClear();
+
+    (void)CalculateSNKickMagnitude(m_Mass, m_SupernovaDetails.totalMassAtCOFormation - m_Mass, m_StellarType);
+}
+
+
 /*
  * Calculate eccentric anomaly and true anomaly - uses kepler's equation
  *
@@ -2793,6 +2965,184 @@ void BaseStar::CalculateBindingEnergies(const double p_CoreMass, const double p_
 
 
 
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//                                 BATCH EVALUATION                                  //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+
+/*
+ * The batch functions evaluate a fitting formula for many masses at the metallicity of this star (the
+ * star itself is not changed), for callers that need the formula over a range of masses - e.g. block
+ * initialisation of single stars, generating tables of stellar tracks, post-processing.  Masses and
+ * results are passed as plain arrays (structure of arrays).
+ *
+ * Each batch function shares its arithmetic with the scalar function (via the _Static version), and
+ * none of the operations used (+, -, *, /, sqrt()) are contracted or reassociated (-std=c++11 implies
+ * -ffp-contract=off), so the batch results are identical to the scalar results, element by element.
+ *
+ * The rational fits (LZAMS, RZAMS, tBGB) are evaluated in blocks of BATCH_EVALUATION_BLOCK_SIZE masses:
+ * sqrt(mass) is calculated for the block first (sqrt() may set errno, which stops the compiler vectorising
+ * any loop that calls it), then the fit is evaluated for the block in a loop the compiler vectorises (SIMD).
+ * The coefficients are copied to local arrays first, so the compiler knows they cannot alias the results.
+ */
+
+
+/*
+ * Calculate luminosity at ZAMS (in Lsol) for an array of masses
+ *
+ *
+ * void CalculateLuminosityAtZAMS_Batch(const std::size_t p_N, const double *p_MZAMS, double *p_LZAMS) const
+ *
+ * @param   [IN]    p_N                         Number of masses
+ * @param   [IN]    p_MZAMS                     Zero age main sequence masses in Msol (p_N elements)
+ * @param   [OUT]   p_LZAMS                     Luminosities in Lsol (p_N elements)
+ */
+void BaseStar::CalculateLuminosityAtZAMS_Batch(const std::size_t p_N, const double *p_MZAMS, double *p_LZAMS) const {
+
+    double coeff[static_cast<int>(L_Coeff::ETA) + 1];                                           // local copy - can't alias p_LZAMS
+    std::copy(m_LCoefficients.begin(), m_LCoefficients.begin() + static_cast<int>(L_Coeff::ETA) + 1, coeff);
+
+    double sqrtMass[BATCH_EVALUATION_BLOCK_SIZE];
+    for (std::size_t first = 0; first < p_N; first += BATCH_EVALUATION_BLOCK_SIZE) {
+        std::size_t n = std::min(p_N - first, static_cast<std::size_t>(BATCH_EVALUATION_BLOCK_SIZE));
+
+        for (std::size_t i = 0; i < n; i++) sqrtMass[i] = std::sqrt(p_MZAMS[first + i]);                        // not vectorised - sqrt() may set errno
+        for (std::size_t i = 0; i < n; i++) p_LZAMS[first + i] = CalculateLuminosityAtZAMS_Static(p_MZAMS[first + i], sqrtMass[i], coeff);
+    }
+}
+
+
+/*
+ * Calculate radius at ZAMS (in Rsol) for an array of masses
+ *
+ *
+ * void CalculateRadiusAtZAMS_Batch(const std::size_t p_N, const double *p_MZAMS, double *p_RZAMS) const
+ *
+ * @param   [IN]    p_N                         Number of masses
+ * @param   [IN]    p_MZAMS                     Zero age main sequence masses in Msol (p_N elements)
+ * @param   [OUT]   p_RZAMS                     Radii in Rsol (p_N elements)
+ */
+void BaseStar::CalculateRadiusAtZAMS_Batch(const std::size_t p_N, const double *p_MZAMS, double *p_RZAMS) const {
+
+    double coeff[static_cast<int>(R_Coeff::PI) + 1];                                            // local copy - can't alias p_RZAMS
+    std::copy(m_RCoefficients.begin(), m_RCoefficients.begin() + static_cast<int>(R_Coeff::PI) + 1, coeff);
+
+    double sqrtMass[BATCH_EVALUATION_BLOCK_SIZE];
+    for (std::size_t first = 0; first < p_N; first += BATCH_EVALUATION_BLOCK_SIZE) {
+        std::size_t n = std::min(p_N - first, static_cast<std::size_t>(BATCH_EVALUATION_BLOCK_SIZE));
+
+        for (std::size_t i = 0; i < n; i++) sqrtMass[i] = std::sqrt(p_MZAMS[first + i]);                        // not vectorised - sqrt() may set errno
+        for (std::size_t i = 0; i < n; i++) p_RZAMS[first + i] = CalculateRadiusAtZAMS_Static(p_MZAMS[first + i], sqrtMass[i], coeff);
+    }
+}
+
+
+/*
+ * Calculate lifetime to the Base of the Giant Branch (in Myr) for an array of masses
+ *
+ *
+ * void CalculateLifetimeToBGB_Batch(const std::size_t p_N, const double *p_Mass, double *p_tBGB) const
+ *
+ * @param   [IN]    p_N                         Number of masses
+ * @param   [IN]    p_Mass                      Masses in Msol (p_N elements)
+ * @param   [OUT]   p_tBGB                      Lifetimes to the Base of the Giant Branch in Myr (p_N elements)
+ */
+void BaseStar::CalculateLifetimeToBGB_Batch(const std::size_t p_N, const double *p_Mass, double *p_tBGB) const {
+
+    double a[6];                                                                                // local copy of a[1] - a[5] - can't alias p_tBGB
+    std::copy(m_AnCoefficients.begin(), m_AnCoefficients.begin() + 6, a);
+
+    double sqrtMass[BATCH_EVALUATION_BLOCK_SIZE];
+    for (std::size_t first = 0; first < p_N; first += BATCH_EVALUATION_BLOCK_SIZE) {
+        std::size_t n = std::min(p_N - first, static_cast<std::size_t>(BATCH_EVALUATION_BLOCK_SIZE));
+
+        for (std::size_t i = 0; i < n; i++) sqrtMass[i] = std::sqrt(p_Mass[first + i]);                        // not vectorised - sqrt() may set errno
+        for (std::size_t i = 0; i < n; i++) p_tBGB[first + i] = CalculateLifetimeToBGB_Static(p_Mass[first + i], sqrtMass[i], a);
+    }
+}
+
+
+/*
+ * Calculate lifetime to the Base of the Asymptotic Giant Branch (in Myr) for arrays of timescales
+ * tBAGB = tHeI + tHe
+ *
+ *
+ * void CalculateLifetimeToBAGB_Batch(const std::size_t p_N, const double *p_tHeI, const double *p_tHe, double *p_tBAGB) const
+ *
+ * @param   [IN]    p_N                         Number of timescales
+ * @param   [IN]    p_tHeI                      Times to helium ignition (p_N elements)
+ * @param   [IN]    p_tHe                       Times to helium burning (p_N elements)
+ * @param   [OUT]   p_tBAGB                     Lifetimes to the Base of the Asymptotic Giant Branch in Myr (p_N elements)
+ */
+void BaseStar::CalculateLifetimeToBAGB_Batch(const std::size_t p_N, const double *p_tHeI, const double *p_tHe, double *p_tBAGB) const {
+    for (std::size_t i = 0; i < p_N; i++) p_tBAGB[i] = CalculateLifetimeToBAGB(p_tHeI[i], p_tHe[i]);
+}
+
+
+/*
+ * Calculate core mass at the Base of the Giant Branch (in Msol) for an array of masses
+ *
+ * See GiantBranch::CalculateCoreMassAtBGB_Batch_Static()
+ *
+ *
+ * void CalculateCoreMassAtBGB_Batch(const std::size_t p_N, const double *p_Mass, double *p_McBGB) const
+ *
+ * @param   [IN]    p_N                         Number of masses
+ * @param   [IN]    p_Mass                      Masses in Msol (p_N elements)
+ * @param   [OUT]   p_McBGB                     Core masses at the Base of the Giant Branch in Msol (p_N elements)
+ */
+void BaseStar::CalculateCoreMassAtBGB_Batch(const std::size_t p_N, const double *p_Mass, double *p_McBGB) const {
+    GiantBranch::CalculateCoreMassAtBGB_Batch_Static(p_N, p_Mass, m_LogMetallicityXi, m_MassCutoffs, m_AnCoefficients, m_BnCoefficients, p_McBGB);
+}
+
+
+/*
+ * Check the batch functions against the scalar functions
+ *
+ * Evaluates each batch function for the masses given, at the metallicity of this star, and compares the
+ * results with the results of the scalar functions, element by element.  The results should be identical
+ * (see above), so any difference is counted as a mismatch.  Called by the track library (CREATE mode) for
+ * the masses of the library grid at each metallicity of the library.
+ *
+ * The lifetime to BAGB is the sum of two timescales, so is checked with the lifetimes to BGB as both.
+ *
+ *
+ * std::size_t CountBatchEvaluationMismatches(const DBL_VECTOR &p_Masses)
+ *
+ * @param   [IN]    p_Masses                    Masses in Msol
+ * @return                                      Number of batch results that differ from the scalar results
+ */
+std::size_t BaseStar::CountBatchEvaluationMismatches(const DBL_VECTOR &p_Masses) {
+
+    std::size_t n = p_Masses.size();
+
+    DBL_VECTOR LZAMS(n), RZAMS(n), tBGB(n), tBAGB(n), McBGB(n);
+
+    CalculateLuminosityAtZAMS_Batch(n, p_Masses.data(), LZAMS.data());
+    CalculateRadiusAtZAMS_Batch(n, p_Masses.data(), RZAMS.data());
+    CalculateLifetimeToBGB_Batch(n, p_Masses.data(), tBGB.data());
+    CalculateLifetimeToBAGB_Batch(n, tBGB.data(), tBGB.data(), tBAGB.data());
+    CalculateCoreMassAtBGB_Batch(n, p_Masses.data(), McBGB.data());
+
+    DBL_VECTOR gbParams(static_cast<int>(GBP::COUNT), DEFAULT_INITIAL_DOUBLE_VALUE);
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        GiantBranch::CalculateGBParams_Static(p_Masses[i], m_LogMetallicityXi, m_MassCutoffs, m_AnCoefficients, m_BnCoefficients, gbParams);
+
+        if (LZAMS[i] != CalculateLuminosityAtZAMS(p_Masses[i]))                       mismatches++;     // JR: don't use utils::Compare() here - the results must be identical
+        if (RZAMS[i] != CalculateRadiusAtZAMS(p_Masses[i]))                           mismatches++;
+        if (tBGB[i]  != CalculateLifetimeToBGB(p_Masses[i]))                          mismatches++;
+        if (tBAGB[i] != CalculateLifetimeToBAGB(tBGB[i], tBGB[i]))                    mismatches++;
+        if (McBGB[i] != gbParams[static_cast<int>(GBP::McBGB)])                       mismatches++;
+    }
+
+    return mismatches;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////
 //                                                                                   //
 //                    MISCELLANEOUS FUNCTIONS / CONTROL FUNCTIONS                    //
@@ -145,10 +145,17 @@ public:
 
             void            CalculateBindingEnergies(const double p_CoreMass, const double p_EnvMass, const double p_Radius);
 
+            void            CalculateCoreMassAtBGB_Batch(const std::size_t p_N, const double *p_Mass, double *p_McBGB) const;                                                      // Batch evaluation at the metallicity of this star
+
             double          CalculateDynamicalTimescale() const                                                 { return CalculateDynamicalTimescale_Static(m_Mass, m_Radius); }         // Use class member variables
 
             double          CalculateEddyTurnoverTimescale();
 
+            void            CalculateLifetimeToBAGB_Batch(const std::size_t p_N, const double *p_tHeI, const double *p_tHe, double *p_tBAGB) const;                                // Batch evaluation at the metallicity of this star
+            void            CalculateLifetimeToBGB_Batch(const std::size_t p_N, const double *p_Mass, double *p_tBGB) const;                                                       // Batch evaluation at the metallicity of this star
+
+            void            CalculateLuminosityAtZAMS_Batch(const std::size_t p_N, const double *p_MZAMS, double *p_LZAMS) const;                                                  // Batch evaluation at the metallicity of this star
+
     virtual void            CalculateGBParams(const double p_Mass, DBL_VECTOR &p_GBParams) { }                                                                                      // Default is NO-OP
     virtual void            CalculateGBParams()                                                                 { CalculateGBParams(m_Mass0, m_GBParams); }                         // Use class member variables
 
@@ -172,6 +179,10 @@ public:
             double          CalculateRadialChange() const                                                       { return (utils::Compare(m_RadiusPrev,0)<=0)? 0 : std::abs(m_Radius - m_RadiusPrev) / m_RadiusPrev; }                    // Return fractional radial change (if previous radius is negative or zero, return 0 to avoid NaN
 
             double          CalculateRadialExpansionTimescale() const                                           { return CalculateRadialExpansionTimescale_Static(m_StellarType, m_StellarTypePrev, m_Radius, m_RadiusPrev, m_DtPrev); } // Use class member variables
+
+            void            CalculateRadiusAtZAMS_Batch(const std::size_t p_N, const double *p_MZAMS, double *p_RZAMS) const;                                                      // Batch evaluation at the metallicity of this star
+
+    virtual std::tuple<bool, double> CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0) const { return std::make_tuple(false, m_Radius); }  // Default is no radius response model - the star must be updated to find its radius
     
             void            CalculateSNAnomalies(const double p_Eccentricity);
 
@@ -189,12 +200,16 @@ public:
 
     virtual double          CalculateZeta(ZETA_PRESCRIPTION p_ZetaPrescription)                                 { return 0.0; }                                                     // Use inheritance hierarchy
 
+            std::size_t     CountBatchEvaluationMismatches(const DBL_VECTOR &p_Masses);                                                                                             // Check the batch functions against the scalar functions
+
             void            ClearCurrentSNEvent()                                                               { m_SupernovaDetails.events.current = SN_EVENT::NONE; }             // Clear supernova event/state for current timestep
 
     virtual ENVELOPE        DetermineEnvelopeType() const                                                       { return ENVELOPE::REMNANT; }                                       // Default is REMNANT - but should never be called
 
             void            IncrementOmega(const double p_OmegaDelta)                                           { m_Omega += p_OmegaDelta; }                                        // Apply delta to current m_Omega
 
+            void            ResampleSNKick();
+
             void            ResolveAccretion(const double p_AccretionMass)                                      { m_Mass = std::max(0.0, m_Mass + p_AccretionMass); }               // Handles donation and accretion - won't let mass go negative
 
     virtual STELLAR_TYPE    ResolveEnvelopeLoss(bool p_NoCheck = false)                                         { return m_StellarType; }
@@ -394,12 +409,14 @@ protected:
 
             double              CalculateLifetimeToBAGB(const double p_tHeI, const double p_tHe) const;
             double              CalculateLifetimeToBGB(const double p_Mass) const;
+    static  double              CalculateLifetimeToBGB_Static(const double p_Mass, const double p_SqrtMass, const double *p_AnCoefficients);
 
             double              CalculateLogBindingEnergyLoveridge(bool p_IsMassLoss) const;
 
             double              CalculateLuminosityAtBAGB(double p_Mass) const;
     virtual double              CalculateLuminosityAtPhaseEnd() const                                                   { return m_Luminosity; }                                                    // Default is NO-OP
             double              CalculateLuminosityAtZAMS(const double p_MZAMS);
+    static  double              CalculateLuminosityAtZAMS_Static(const double p_MZAMS, const double p_SqrtMass, const double *p_LCoefficients);
             double              CalculateLuminosityGivenCoreMass(const double p_CoreMass) const;
     virtual double              CalculateLuminosityOnPhase() const                                                      { return m_Luminosity; }                                                    // Default is NO-OP
 
@@ -431,6 +448,8 @@ protected:
 
     static  double              CalculateOStarRotationalVelocityAnalyticCDF_Static(const double p_Ve);
     static  double              CalculateOStarRotationalVelocityAnalyticCDFInverse_Static(double p_Ve, void *p_Params);
+    static  const TabulatedFunction& CalculateOStarRotationalVelocityCDFTable_Static(const double p_Xmin, const double p_Xmax);
+    static  double              CalculateOStarRotationalVelocityExact_Static(const double p_U, const double p_Xmin, const double p_Xmax);
     static  double              CalculateOStarRotationalVelocity_Static(const double p_Xmin, const double p_Xmax);
 
             double              CalculatePerturbationB(const double p_Mass) const;
@@ -452,6 +471,7 @@ protected:
 
     virtual double              CalculateRadiusAtPhaseEnd() const                                                       { return m_Radius; }                                                        // Default is NO-OP
             double              CalculateRadiusAtZAMS(const double p_MZAMS) const;
+    static  double              CalculateRadiusAtZAMS_Static(const double p_MZAMS, const double p_SqrtMass, const double *p_RCoefficients);
     virtual double              CalculateRadiusOnPhase() const                                                          { return m_Radius; }                                                        // Default is NO-OP
     virtual std::tuple <double, STELLAR_TYPE> CalculateRadiusAndStellarTypeOnPhase() const                              { return std::make_tuple(CalculateRadiusOnPhase(), m_StellarType); }
 
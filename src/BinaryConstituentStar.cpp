@@ -1,6 +1,7 @@
 #include "BinaryConstituentStar.h"
 
 #include "BaseBinaryStar.h"
+#include "powers.h"
 
 
 class BaseBinaryStar;
@@ -128,7 +129,9 @@ double BinaryConstituentStar::CalculateMassAccretedForNS(const double p_Companio
             break;
 
         case CE_ACCRETION_PRESCRIPTION::UNIFORM:                                                                // UNIFROM
+            RAND->Stream(RANDOM_STREAM::COMMON_ENVELOPE_ACCRETION);                                             // common random numbers: CE accretion substream (no-op unless --common-random-numbers)
             deltaMass = RAND->Random(OPTIONS->CommonEnvelopeMassAccretionMin(), OPTIONS->CommonEnvelopeMassAccretionMax()); // uniform random distribution - Oslowski+ (2011)
+            RAND->StreamClear();
             break;
 
         case CE_ACCRETION_PRESCRIPTION::MACLEOD: {                                                              // MACLEOD
@@ -339,7 +342,7 @@ double BinaryConstituentStar::CalculateCircularisationTimescale(const double p_S
 		    double	secondOrderTidalCoeff = 1.592E-09 * PPOW(Mass(), 2.84);                                                              // aka E_2.
 		    double	freeFallFactor        = sqrt(G1 * Mass() / rInAUPow3);
 		
-		    timescale                     = 1.0 / ((21.0 / 2.0) * freeFallFactor * q2 * PPOW(1.0 + q2, 11.0/6.0) * secondOrderTidalCoeff * rOverAPow21Over2);
+		    timescale                     = 1.0 / ((21.0 / 2.0) * freeFallFactor * q2 * powers::Pow<11, 6>(1.0 + q2) * secondOrderTidalCoeff * rOverAPow21Over2);
         } break;
 
         default:                                                                                                                        // all other envelope types (remnants?)
@@ -383,17 +386,17 @@ double BinaryConstituentStar::CalculateSynchronisationTimescale(const double p_S
 
         case ENVELOPE::RADIATIVE: {                                             // solve for stars with radiative envelope (see Hurley et al. 2002, subsection 2.3.2)
 
-            double coeff2          = 5.0 * PPOW(2.0, 5.0 / 3.0);                // JR: todo: replace this with a constant (calculated) value?
+            double coeff2          = 5.0 * powers::Pow<5, 3>(2.0);              // JR: todo: replace this with a constant (calculated) value?
             double e2              = 1.592E-9 * PPOW(Mass(), 2.84);             // second order tidal coefficient (a.k.a. E_2)
             double rAU             = Radius() * RSOL_TO_AU;
             double rAU_3           = rAU * rAU * rAU;
             double freeFallFactor  = sqrt(G1 * Mass() / rAU_3);
 
-		    timescale              = 1.0 / (coeff2 * freeFallFactor * gyrationRadiusSquared_1 * q2 * q2 * PPOW(1.0 + q2, 5.0 / 6.0) * e2 * PPOW(rOverA, 17.0 / 2.0));
+		    timescale              = 1.0 / (coeff2 * freeFallFactor * gyrationRadiusSquared_1 * q2 * q2 * powers::Pow<5, 6>(1.0 + q2) * e2 * powers::Pow<17, 2>(rOverA));
             } break;
 
         default:                                                                // all other envelope types (remnants?)
-            timescale = 1.0 / ((1.0 / 1.3E7) * PPOW(Luminosity() / Mass(), 5.0 / 7.0) * rOverA_6);
+            timescale = 1.0 / ((1.0 / 1.3E7) * powers::Pow<5, 7>(Luminosity() / Mass()) * rOverA_6);
 	}
 
 	return timescale;
@@ -112,6 +112,8 @@ public:
 
         if (this != &p_Star) {                                                  // make sure we're not not copying ourselves...
 
+            Star::operator = (p_Star);                                          // copy the underlying star
+
             m_ObjectId                 = globalObjectId++;                      // get unique object id (don't copy source)
             m_ObjectType               = OBJECT_TYPE::BINARY_CONSTITUENT_STAR;  // can only copy from BINARY_CONSTITUENT_STAR
 
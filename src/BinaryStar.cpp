@@ -1,14 +1,21 @@
+#include <deque>
+
 #include "BinaryStar.h"
+#include "EventBus.h"
 
 
 // binary is generated according to distributions specified in program options
-BinaryStar::BinaryStar(const unsigned long int p_Seed, const long int p_Id) : m_BinaryStar(new BaseBinaryStar(p_Seed, p_Id)) {
+BinaryStar::BinaryStar(const unsigned long int p_Seed, const long int p_Id) {
 
     m_ObjectId       = globalObjectId++;
     m_ObjectType     = OBJECT_TYPE::BINARY_STAR;
     m_StellarType    = STELLAR_TYPE::BINARY_STAR;
 
+    if (OPTIONS->ForkVariations()) m_RandStateAtConstruction = RAND->State();                  // forks not continued from a snapshot are constructed again (see EvolveFork())
+
+    m_BinaryStar     = new BaseBinaryStar(p_Seed, p_Id);
     m_SaveBinaryStar = nullptr;
+    m_ForkSnapshot   = nullptr;
 }
 
 
@@ -55,25 +62,153 @@ bool BinaryStar::RevertState() {
 }
 
 
+/*
+ * Evolve the binary
+ *
+ * If the BSE Switch Log is enabled, subscribes to the stellar type switch event for the duration
+ * of the evolution so that switches of the constituent stars are logged (see PrintSwitchLog()).
+ *
+ * If kick resampling is enabled, the branches continued from pre-supernova snapshots of the binary
+ * are evolved after the binary (see EvolveKickResampleBranches()).  The status returned is that of
+ * the binary evolved from ZAMS.
+ *
+ *
+ * EVOLUTION_STATUS Evolve()
+ *
+ * @return                                      Status of the evolution (EVOLUTION_STATUS)
+ */
+EVOLUTION_STATUS BinaryStar::Evolve() {
+
+    int subscriptionId = 0;
+    if (OPTIONS->SwitchLog()) {                                                                                         // switch log?
+        subscriptionId = EVENTS->Subscribe(EVENT_TYPE::STELLAR_TYPE_SWITCH,                                             // yes - subscribe to switch events
+                                           [this](const EventT& p_Event) { (void)PrintSwitchLog(p_Event.objectId); });
+    }
+
+    EVOLUTION_STATUS evolutionStatus = m_BinaryStar->Evolve();                                                          // evolve the binary
+
+    if (OPTIONS->KickResamples() > 1) EvolveKickResampleBranches();                                                     // evolve kick resampling branches
+
+    if (subscriptionId > 0) EVENTS->Unsubscribe(subscriptionId);                                                        // unsubscribe
+
+    return evolutionStatus;
+}
+
+
+/*
+ * Evolve a fork of the binary
+ *
+ * Forked evolution of option variations (program option --fork-variations): the binary is evolved (see Evolve())
+ * for the first variation of the swept options - the options specified as ranges or sets on the commandline - and
+ * a fork is then evolved for each subsequent variation, after the options have been advanced to the variation.
+ *
+ * Forks are numbered by variation (FORK_VARIATION - the binary evolved for the first variation is 0).  The first fork is
+ * constructed again, with the random number service restored to its state when the binary was constructed, and takes a
+ * snapshot at the start of the timestep in which the binary first read a swept option (see BaseBinaryStar::TakeForkSnapshot())
+ * - the evolution of the binary up to that timestep is the same for all variations.  Subsequent forks are continued from
+ * the snapshot.  If a swept option was read before evolution started (e.g. while the binary was constructed), there is no
+ * snapshot and every fork is constructed again.
+ *
+ * Either way the fork evolves as the binary would have evolved from ZAMS under the current option values: it has
+ * the random seed and id of the binary, and shares its logfile records staged before the snapshot.  The fork
+ * replaces the current binary.
+ *
+ *
+ * EVOLUTION_STATUS EvolveFork()
+ *
+ * @return                                      Status of the evolution of the fork (EVOLUTION_STATUS)
+ */
+EVOLUTION_STATUS BinaryStar::EvolveFork() {
+
+    if (!m_ForkSnapshot) m_ForkSnapshot = m_BinaryStar->ReleaseForkSnapshot();                                        // take ownership of the snapshot taken by the first fork (if any)
+
+    unsigned long int seed      = m_BinaryStar->RandomSeed();
+    long int          id        = m_BinaryStar->Id();
+    int               stepNum   = m_BinaryStar->ForkStepNum();                                                          // timestep in which the binary first read a swept option (0 if before evolution started)
+    int               variation = m_BinaryStar->ForkVariation() + 1;
+
+    delete m_BinaryStar;
+
+    if (m_ForkSnapshot) {                                                                                               // snapshot taken?
+        m_BinaryStar = new BaseBinaryStar(*m_ForkSnapshot);                                                             // yes - continue from the snapshot
+        m_BinaryStar->StartFork();
+        m_BinaryStar->SetForkVariation(variation, 0);
+    }
+    else {                                                                                                              // no - construct again
+        RAND->RestoreState(m_RandStateAtConstruction);                                                                  // (no staged records to restore - the first fork stages the records it shares with subsequent forks)
+        m_BinaryStar = new BaseBinaryStar(seed, id);
+        m_BinaryStar->SetForkVariation(variation, stepNum);                                                             // first fork takes the snapshot (if a swept option was read during evolution)
+    }
+
+    return Evolve();
+}
+
+
+/*
+ * Evolve the kick resampling branches of the binary
+ *
+ * For each pre-supernova snapshot taken while evolving the binary (see BaseBinaryStar::TakeKickResampleSnapshot()),
+ * OPTIONS->KickResamples() - 1 branches are continued from the snapshot, each under a new kick draw.  Snapshots
+ * taken by the branches (--kick-resample-supernovae EACH) are queued and their branches evolved in turn.
+ *
+ * While a branch evolves it is the current binary (m_BinaryStar), so that the BSE Switch Log records switches
+ * of its constituent stars.  The binary evolved from ZAMS is restored on return.
+ *
+ *
+ * void EvolveKickResampleBranches()
+ */
+void BinaryStar::EvolveKickResampleBranches() {
+
+    BaseBinaryStar *binary = m_BinaryStar;                                                                              // binary evolved from ZAMS
+
+    std::vector<BaseBinaryStar*> released = binary->ReleaseKickResampleSnapshots();
+    std::deque<BaseBinaryStar*>  snapshots(released.begin(), released.end());                                          // snapshots awaiting their branches
+
+    int branch = 0;                                                                                                     // branch number - 0 is the binary evolved from ZAMS
+    while (!snapshots.empty()) {
+
+        BaseBinaryStar *snapshot = snapshots.front();
+        snapshots.pop_front();
+
+        for (int k = 1; k < OPTIONS->KickResamples(); k++) {
+            m_BinaryStar = new BaseBinaryStar(*snapshot);                                                               // continue from the snapshot ...
+            m_BinaryStar->StartKickResampleBranch(++branch);                                                            // ... under a new kick draw
+
+            (void)m_BinaryStar->Evolve();                                                                               // evolve the branch
+
+            released = m_BinaryStar->ReleaseKickResampleSnapshots();                                                    // queue any snapshots taken by the branch
+            snapshots.insert(snapshots.end(), released.begin(), released.end());
+
+            delete m_BinaryStar;
+        }
+        delete snapshot;
+    }
+
+    m_BinaryStar = binary;                                                                                              // restore binary evolved from ZAMS
+}
+
+
 /*
  * Print BSE Switch Log record
  * 
- * Called from main() when SIGUSR1 received - raised by Star::SwitchTo() to indicate a stellar type switch.
- * Here we use the switch parameters stored in the LOGGING service singleton by Star:SwitchTo() to determine
- * whether it is the primary or the secondary switching, then call BinaryStar::PrintSwitchLog() with the
- * appropriate parameters to print the log file record.
+ * Called (via the EVENTS service) when Star::SwitchTo() publishes a stellar type switch event while the
+ * binary is evolving.  Here we use the object id of the star switching to determine whether it is the
+ * primary or the secondary switching, then call BaseBinaryStar::PrintSwitchLog() with the appropriate
+ * parameters to print the log file record (the switch parameters are stored in the LOGGING service
+ * singleton by Star:SwitchTo()).
  * 
- * BinaryStar::PrintSwitchLog()
+ * BinaryStar::PrintSwitchLog(const OBJECT_ID p_ObjectIdSwitching)
  *
+ * @param   [IN]    p_ObjectIdSwitching         Object id of the star switching
  * @return                                      Boolean flag indicating success/failure (true = success)
  */
-bool BinaryStar::PrintSwitchLog() { 
+bool BinaryStar::PrintSwitchLog(const OBJECT_ID p_ObjectIdSwitching) { 
     
     bool result = true;
 
     OBJECT_ID primaryObjectId   = m_BinaryStar->Star1()->StarObjectId();
     OBJECT_ID secondaryObjectId = m_BinaryStar->Star2()->StarObjectId();
-    OBJECT_ID objectIdSwitching = LOGGING->ObjectIdSwitching();
+    OBJECT_ID objectIdSwitching = p_ObjectIdSwitching;
 
          if (objectIdSwitching == primaryObjectId  ) result = m_BinaryStar->PrintSwitchLog(m_BinaryStar->Id(), true);   // primary
     else if (objectIdSwitching == secondaryObjectId) result = m_BinaryStar->PrintSwitchLog(m_BinaryStar->Id(), false);  // secondary
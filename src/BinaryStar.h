@@ -34,6 +34,9 @@ public:
 
         m_BinaryStar     = new BaseBinaryStar(*(p_Star.m_BinaryStar));                          // copy underlying BaseBinaryStar
         m_SaveBinaryStar = new BaseBinaryStar(*(p_Star.m_SaveBinaryStar));                      // copy underlying Saved BaseBinaryStar
+
+        m_ForkSnapshot   = nullptr;                                                             // snapshot is owned by the binary that took it - not copied
+        m_RandStateAtConstruction = p_Star.m_RandStateAtConstruction;
     }
 
 
@@ -54,7 +57,7 @@ public:
         return *this;
     }
 
-    virtual ~BinaryStar() { delete m_BinaryStar; delete m_SaveBinaryStar; }
+    virtual ~BinaryStar() { delete m_BinaryStar; delete m_SaveBinaryStar; delete m_ForkSnapshot; }
 
 
     // object identifiers - all classes have these
@@ -65,7 +68,8 @@ public:
 
     // member functions
     long int            Id()                        { return m_BinaryStar->Id(); }
-    EVOLUTION_STATUS    Evolve()                    { return m_BinaryStar->Evolve(); }
+    EVOLUTION_STATUS    Evolve();
+    EVOLUTION_STATUS    EvolveFork();
     bool                RevertState();
     void                SaveState();
     STELLAR_TYPE        Star1InitialType()          { return m_BinaryStar->InitialStellarType1(); }
@@ -73,12 +77,14 @@ public:
     STELLAR_TYPE        Star2InitialType()          { return m_BinaryStar->InitialStellarType2(); }
     STELLAR_TYPE        Star2Type()                 { return m_BinaryStar->StellarType2(); }
 
-    bool                PrintSwitchLog();
+    bool                PrintSwitchLog(const OBJECT_ID p_ObjectIdSwitching);
 
 private:
 
     BinaryStar() { }
 
+    void            EvolveKickResampleBranches();
+
     OBJECT_ID       m_ObjectId;                                                                 // Instantiated object's unique object id
     OBJECT_TYPE     m_ObjectType;                                                               // Instantiated object's object type
     STELLAR_TYPE    m_StellarType;                                                              // Stellar type defined in Hurley et al. 2000
@@ -86,6 +92,9 @@ private:
     BaseBinaryStar *m_BinaryStar;                                                               // Pointer to current binary star
     BaseBinaryStar *m_SaveBinaryStar;                                                           // Pointer to saved binary star
 
+    BaseBinaryStar *m_ForkSnapshot;                                                             // Pointer to snapshot from which forks are evolved (see EvolveFork())
+    RandStateT      m_RandStateAtConstruction;                                                  // State of the random number service when the binary was constructed (forked evolution only)
+
 };
 
 #endif // __BinaryStar_h__
@@ -0,0 +1,404 @@
+#include <cmath>
+
+#include "BlockSampler.h"
+#include "Options.h"
+
+BlockSampler* BlockSampler::m_Instance = nullptr;
+
+
+BlockSampler* BlockSampler::Instance() {
+
+    if (!m_Instance) {
+        m_Instance = new BlockSampler();
+    }
+    return m_Instance;
+}
+
+
+/*
+ * Return a uniform random number for the specified counter
+ *
+ * Counter-based generator: the SplitMix64 output function applied to (seed + counter x golden gamma).
+ * The result depends only on the seed and the counter, so any system's uniforms can be generated
+ * without generating those of any other system.
+ *
+ *
+ * double CounterUniform(const uint64_t p_Seed, const uint64_t p_Counter)
+ *
+ * @param   [IN]    p_Seed                      Seed (already mixed - see Initialise())
+ * @param   [IN]    p_Counter                   Counter
+ * @return                                      Floating point number uniformly distributed in the range (0.0, 1.0)
+ */
+double BlockSampler::CounterUniform(const uint64_t p_Seed, const uint64_t p_Counter) {
+
+    uint64_t z = p_Seed + (p_Counter + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z =  z ^ (z >> 31);
+
+    return (static_cast<double>(z >> 11) + 0.5) / 9007199254740992.0;                              // 53 bits, centre of cell - never exactly 0.0 or 1.0
+}
+
+
+/*
+ * Set up a piecewise power law for inversion
+ *
+ * The density is p(x) ~ x^(p_Powers[j]) between consecutive breaks (p_Powers has one more entry than
+ * p_Breaks), continuous at the breaks, truncated to [p_Min, p_Max] and normalised.  Only breaks strictly
+ * inside (p_Min, p_Max) start a new segment.
+ *
+ *
+ * bool SetPowerLaw(PowerLawT&                 p_Variate,
+ *                  const std::vector<double>& p_Breaks,
+ *                  const std::vector<double>& p_Powers,
+ *                  const double               p_Max,
+ *                  const double               p_Min)
+ *
+ * @param   [OUT]   p_Variate                   Power law to be set up
+ * @param   [IN]    p_Breaks                    Break points (ascending)
+ * @param   [IN]    p_Powers                    Power in each piece
+ * @param   [IN]    p_Max                       Distribution maximum
+ * @param   [IN]    p_Min                       Distribution minimum
+ * @return                                      Boolean - true if the power law can be inverted in blocks
+ */
+bool BlockSampler::SetPowerLaw(PowerLawT&                 p_Variate,
+                               const std::vector<double>& p_Breaks,
+                               const std::vector<double>& p_Powers,
+                               const double               p_Max,
+                               const double               p_Min) {
+
+    if (!(p_Min < p_Max) || p_Powers.size() != p_Breaks.size() + 1) return false;
+
+    double lo[MAX_SEGMENTS];
+    double hi[MAX_SEGMENTS];
+    double power[MAX_SEGMENTS];
+    double mass[MAX_SEGMENTS];
+
+    int    segments    = 0;
+    double coefficient = 1.0;                                                                       // density coefficient of the current piece (continuity at the breaks)
+    double start       = p_Min;
+
+    for (size_t piece = 0; piece < p_Powers.size(); piece++) {
+
+        double pieceMax = piece < p_Breaks.size() ? p_Breaks[piece] : p_Max;
+
+        if (pieceMax > start) {                                                                     // piece overlaps [start, p_Max]?
+            if (segments >= MAX_SEGMENTS) return false;
+
+            double end = std::min(pieceMax, p_Max);
+            double p   = p_Powers[piece];
+
+            if (start <= 0.0 && p <= -1.0) return false;                                           // not normalisable
+
+            lo[segments]    = start;
+            hi[segments]    = end;
+            power[segments] = p;
+            mass[segments]  = p == -1.0
+                                ? coefficient * std::log(end / start)
+                                : coefficient * (std::pow(end, p + 1.0) - std::pow(start, p + 1.0)) / (p + 1.0);
+            segments++;
+
+            start = end;
+            if (start >= p_Max) break;
+        }
+
+        if (piece < p_Breaks.size()) coefficient *= std::pow(p_Breaks[piece], p_Powers[piece] - p_Powers[piece + 1]);
+    }
+
+    double total = 0.0;
+    for (int segment = 0; segment < segments; segment++) total += mass[segment];
+    if (segments == 0 || !(total > 0.0)) return false;
+
+    double cdf = 0.0;
+    for (int segment = 0; segment < segments; segment++) {
+
+        p_Variate.cdf[segment]   = cdf;
+        p_Variate.width[segment] = mass[segment] / total;
+        cdf += p_Variate.width[segment];
+
+        if (power[segment] == -1.0) {                                                               // x = lo (hi/lo)^t
+            p_Variate.A[segment] = std::log(lo[segment]);
+            p_Variate.B[segment] = std::log(hi[segment] / lo[segment]);
+            p_Variate.C[segment] = 1.0;
+            p_Variate.D[segment] = 0.0;
+            p_Variate.E[segment] = 0.0;
+        }
+        else {                                                                                      // x = (lo^(p+1) + t (hi^(p+1) - lo^(p+1)))^(1/(p+1))
+            double loPlus1 = std::pow(lo[segment], power[segment] + 1.0);
+            p_Variate.A[segment] = 0.0;
+            p_Variate.B[segment] = 0.0;
+            p_Variate.C[segment] = loPlus1;
+            p_Variate.D[segment] = std::pow(hi[segment], power[segment] + 1.0) - loPlus1;
+            p_Variate.E[segment] = 1.0 / (power[segment] + 1.0);
+        }
+    }
+    p_Variate.segments = segments;
+
+    return true;
+}
+
+
+/*
+ * Set up a variate to be drawn in blocks
+ *
+ * p_Distribution, p_Max, p_Min and p_Power identify the distribution the variate is set up for - they
+ * must match the values passed to Value() for the block value to be taken.  p_SegmentMax and p_SegmentMin
+ * are the bounds of the power law actually inverted (which differ from p_Max and p_Min when the variate
+ * is transformed, e.g. exponentiated).
+ *
+ * The variate is left disabled if the distribution cannot be inverted in blocks.
+ *
+ *
+ * void SetVariate(const BLOCK_VARIATE        p_Variate,
+ *                 const int                  p_Distribution,
+ *                 const double               p_Max,
+ *                 const double               p_Min,
+ *                 const double               p_Power,
+ *                 const std::vector<double>& p_Breaks,
+ *                 const std::vector<double>& p_Powers,
+ *                 const double               p_SegmentMax,
+ *                 const double               p_SegmentMin,
+ *                 const bool                 p_Exponentiate)
+ *
+ * @param   [IN]    p_Variate                   The variate to set up
+ * @param   [IN]    p_Distribution              Distribution (as int) - key
+ * @param   [IN]    p_Max                       Distribution maximum - key
+ * @param   [IN]    p_Min                       Distribution minimum - key
+ * @param   [IN]    p_Power                     Distribution power - key
+ * @param   [IN]    p_Breaks                    Power law break points (ascending)
+ * @param   [IN]    p_Powers                    Power law power in each piece
+ * @param   [IN]    p_SegmentMax                Power law maximum
+ * @param   [IN]    p_SegmentMin                Power law minimum
+ * @param   [IN]    p_Exponentiate              Return exp(x) rather than x? (default = false)
+ */
+void BlockSampler::SetVariate(const BLOCK_VARIATE         p_Variate,
+                              const int                   p_Distribution,
+                              const double                p_Max,
+                              const double                p_Min,
+                              const double                p_Power,
+                              const std::vector<double>&  p_Breaks,
+                              const std::vector<double>&  p_Powers,
+                              const double                p_SegmentMax,
+                              const double                p_SegmentMin,
+                              const bool                  p_Exponentiate) {
+
+    PowerLawT& variate = m_Variates[static_cast<int>(p_Variate)];
+
+    variate.distribution = p_Distribution;
+    variate.max          = p_Max;
+    variate.min          = p_Min;
+    variate.power        = p_Power;
+    variate.exponentiate = p_Exponentiate;
+    variate.enabled      = SetPowerLaw(variate, p_Breaks, p_Powers, p_SegmentMax, p_SegmentMin);
+}
+
+
+/*
+ * Initialise the block sampler
+ *
+ * Sets up the variates to be drawn in blocks from the distributions specified by the program options.
+ * Variates whose distributions are not (piecewise) power laws are not drawn in blocks.  In SSE mode
+ * only the mass and metallicity are drawn.
+ *
+ *
+ * void Initialise(const unsigned long int p_Seed)
+ *
+ * @param   [IN]    p_Seed                      Seed for the counter-based generator
+ */
+void BlockSampler::Initialise(const unsigned long int p_Seed) {
+
+    m_Enabled    = true;
+    m_Seed       = static_cast<uint64_t>(p_Seed) * 0xD1B54A32D192ED03ULL;                          // spread the seed so nearby seeds give unrelated streams
+    m_BlockSize  = static_cast<size_t>(OPTIONS->InitialSamplingBlockSize());
+    m_BlockStart = -1;
+    m_Offset     = 0;
+
+    for (auto &variate : m_Variates) variate.enabled = false;
+
+    bool bse = OPTIONS->EvolutionMode() == EVOLUTION_MODE::BSE;
+
+    // mass
+    double max   = OPTIONS->InitialMassFunctionMax();
+    double min   = OPTIONS->InitialMassFunctionMin();
+    double power = OPTIONS->InitialMassFunctionPower();
+    int    imf   = static_cast<int>(OPTIONS->InitialMassFunction());
+    switch (OPTIONS->InitialMassFunction()) {
+        case INITIAL_MASS_FUNCTION::SALPETER: SetVariate(BLOCK_VARIATE::MASS, imf, max, min, power, {}, { SALPETER_POWER }, max, min); break;
+        case INITIAL_MASS_FUNCTION::POWERLAW: SetVariate(BLOCK_VARIATE::MASS, imf, max, min, power, {}, { power }, max, min); break;
+        case INITIAL_MASS_FUNCTION::UNIFORM:  SetVariate(BLOCK_VARIATE::MASS, imf, max, min, power, {}, { 0.0 }, max, min); break;
+        case INITIAL_MASS_FUNCTION::KROUPA:   SetVariate(BLOCK_VARIATE::MASS, imf, max, min, power, { KROUPA_BREAK_1, KROUPA_BREAK_2 }, { KROUPA_POWER_1, KROUPA_POWER_2, KROUPA_POWER_3 }, max, min); break;
+        default: break;
+    }
+
+    // metallicity
+    max = OPTIONS->MetallicityDistributionMax();
+    min = OPTIONS->MetallicityDistributionMin();
+    if (OPTIONS->MetallicityDistribution() == METALLICITY_DISTRIBUTION::LOGUNIFORM) {
+        SetVariate(BLOCK_VARIATE::METALLICITY, static_cast<int>(METALLICITY_DISTRIBUTION::LOGUNIFORM), max, min, 0.0, {}, { -1.0 }, max, min);
+    }
+
+    if (bse) {
+
+        // mass ratio
+        max = OPTIONS->MassRatioDistributionMax();
+        min = OPTIONS->MassRatioDistributionMin();
+        int qdist = static_cast<int>(OPTIONS->MassRatioDistribution());
+        switch (OPTIONS->MassRatioDistribution()) {
+            case MASS_RATIO_DISTRIBUTION::FLAT:     SetVariate(BLOCK_VARIATE::MASS_RATIO, qdist, max, min, 0.0, {}, { 0.0 }, max, min); break;
+            case MASS_RATIO_DISTRIBUTION::SANA2012: SetVariate(BLOCK_VARIATE::MASS_RATIO, qdist, max, min, 0.0, {}, { -0.1 }, max, min); break;
+            default: break;
+        }
+
+        // semi-major axis or orbital period - as chosen by the binary constructor
+        if (OPTIONS->OptionSpecified("semi-major-axis-distribution") == 1 || OPTIONS->OptionSpecified("orbital-period-distribution") == 0) {
+            max   = OPTIONS->SemiMajorAxisDistributionMax();
+            min   = OPTIONS->SemiMajorAxisDistributionMin();
+            power = OPTIONS->SemiMajorAxisDistributionPower();
+            int adist = static_cast<int>(OPTIONS->SemiMajorAxisDistribution());
+            switch (OPTIONS->SemiMajorAxisDistribution()) {
+                case SEMI_MAJOR_AXIS_DISTRIBUTION::FLATINLOG: SetVariate(BLOCK_VARIATE::SEMI_MAJOR_AXIS, adist, max, min, power, {}, { -1.0 }, max, min); break;
+                case SEMI_MAJOR_AXIS_DISTRIBUTION::CUSTOM:    SetVariate(BLOCK_VARIATE::SEMI_MAJOR_AXIS, adist, max, min, power, {}, { power }, max, min); break;
+                case SEMI_MAJOR_AXIS_DISTRIBUTION::SANA2012: {                                          // orbital period (days) - log period is a power law (see utils::SampleSemiMajorAxis())
+                    double pMax = OPTIONS->OrbitalPeriodDistributionMax();
+                    double pMin = OPTIONS->OrbitalPeriodDistributionMin();
+                    SetVariate(BLOCK_VARIATE::SEMI_MAJOR_AXIS, adist, pMax, pMin, power, {}, { -0.55 }, pMax > 1.0 ? std::log(pMax) : 0.0, pMin > 1.0 ? std::log(pMin) : 0.0, true);
+                } break;
+                default: break;
+            }
+        }
+        else if (OPTIONS->OrbitalPeriodDistribution() == ORBITAL_PERIOD_DISTRIBUTION::FLATINLOG) {
+            max = OPTIONS->OrbitalPeriodDistributionMax();
+            min = OPTIONS->OrbitalPeriodDistributionMin();
+            SetVariate(BLOCK_VARIATE::ORBITAL_PERIOD, static_cast<int>(ORBITAL_PERIOD_DISTRIBUTION::FLATINLOG), max, min, 0.0, {}, { -1.0 }, max, min);
+        }
+
+        // eccentricity
+        max = OPTIONS->EccentricityDistributionMax();
+        min = OPTIONS->EccentricityDistributionMin();
+        int edist = static_cast<int>(OPTIONS->EccentricityDistribution());
+        switch (OPTIONS->EccentricityDistribution()) {
+            case ECCENTRICITY_DISTRIBUTION::FLAT:     SetVariate(BLOCK_VARIATE::ECCENTRICITY, edist, max, min, 0.0, {}, { 0.0 }, max, min); break;
+            case ECCENTRICITY_DISTRIBUTION::THERMAL:  SetVariate(BLOCK_VARIATE::ECCENTRICITY, edist, max, min, 0.0, {}, { 1.0 }, max, min); break;
+            case ECCENTRICITY_DISTRIBUTION::SANA2012: SetVariate(BLOCK_VARIATE::ECCENTRICITY, edist, max, min, 0.0, {}, { -0.42 }, max, min); break;
+            default: break;
+        }
+    }
+
+    for (int variate = 0; variate < static_cast<int>(BLOCK_VARIATE::COUNT); variate++) {
+        m_Values[variate].assign(m_Variates[variate].enabled ? m_BlockSize : 0, 0.0);
+        m_Used[variate] = true;                                                                     // no system until NextSystem() is called
+    }
+}
+
+
+/*
+ * Draw the initial conditions of a block of systems
+ *
+ * One pass over each enabled variate: uniforms from the counter-based generator, then the segment
+ * lookup and inversion - branch-free, so the loops can be vectorised.
+ *
+ *
+ * void FillBlock(const long int p_BlockStart)
+ *
+ * @param   [IN]    p_BlockStart                Index of the first system in the block
+ */
+void BlockSampler::FillBlock(const long int p_BlockStart) {
+
+    const uint64_t variates = static_cast<uint64_t>(BLOCK_VARIATE::COUNT);
+
+    for (int variate = 0; variate < static_cast<int>(BLOCK_VARIATE::COUNT); variate++) {
+
+        const PowerLawT& law = m_Variates[variate];
+        if (!law.enabled) continue;
+
+        double* values = m_Values[variate].data();
+        const int segments = law.segments;
+
+        for (size_t i = 0; i < m_BlockSize; i++) {
+            values[i] = CounterUniform(m_Seed, (static_cast<uint64_t>(p_BlockStart) + i) * variates + static_cast<uint64_t>(variate));
+        }
+
+        for (size_t i = 0; i < m_BlockSize; i++) {
+            double u = values[i];
+            int    k = 0;
+            for (int segment = 1; segment < segments; segment++) k += u >= law.cdf[segment] ? 1 : 0;
+            double t = (u - law.cdf[k]) / law.width[k];
+            values[i] = std::exp(law.A[k] + law.B[k] * t + law.E[k] * std::log(law.C[k] + law.D[k] * t));
+        }
+
+        if (law.exponentiate) {
+            for (size_t i = 0; i < m_BlockSize; i++) values[i] = std::exp(values[i]);
+        }
+    }
+
+    m_BlockStart = p_BlockStart;
+}
+
+
+/*
+ * Move to the next system
+ *
+ * Called once per star/binary, before its initial conditions are sampled.  Draws a new block if the
+ * system is not in the current block.  No-op if block sampling is not enabled.
+ *
+ *
+ * void NextSystem(const unsigned long int p_Index)
+ *
+ * @param   [IN]    p_Index                     Index of the system (determines its uniforms)
+ */
+void BlockSampler::NextSystem(const unsigned long int p_Index) {
+
+    if (!m_Enabled) return;
+
+    long int blockStart = static_cast<long int>(p_Index - (p_Index % m_BlockSize));
+    if (blockStart != m_BlockStart) FillBlock(blockStart);
+
+    m_Offset = static_cast<size_t>(static_cast<long int>(p_Index) - blockStart);
+    for (auto &used : m_Used) used = false;
+}
+
+
+/*
+ * Take the block value of a variate for the current system
+ *
+ * The value is returned only if block sampling is enabled, the variate is drawn in blocks from the
+ * distribution identified by the parameters (which may differ from the commandline distribution for
+ * grid file lines, ranges and sets), and the value has not already been taken for the current system -
+ * so redraws by the caller fall back to the scalar samplers.
+ *
+ *
+ * std::tuple<bool, double> Value(const BLOCK_VARIATE p_Variate,
+ *                                const int           p_Distribution,
+ *                                const double        p_Max,
+ *                                const double        p_Min,
+ *                                const double        p_Power)
+ *
+ * @param   [IN]    p_Variate                   The variate
+ * @param   [IN]    p_Distribution              Distribution (as int)
+ * @param   [IN]    p_Max                       Distribution maximum
+ * @param   [IN]    p_Min                       Distribution minimum
+ * @param   [IN]    p_Power                     Distribution power (default = 0.0)
+ * @return                                      Tuple containing:
+ *                                                  - boolean indicating whether a block value was taken
+ *                                                  - the value (0.0 if none taken)
+ */
+std::tuple<bool, double> BlockSampler::Value(const BLOCK_VARIATE p_Variate,
+                                             const int           p_Distribution,
+                                             const double        p_Max,
+                                             const double        p_Min,
+                                             const double        p_Power) {
+
+    if (!m_Enabled || m_BlockStart < 0) return std::make_tuple(false, 0.0);
+
+    int variate = static_cast<int>(p_Variate);
+    const PowerLawT& law = m_Variates[variate];
+
+    if (!law.enabled || m_Used[variate] ||
+        law.distribution != p_Distribution || law.max != p_Max || law.min != p_Min || law.power != p_Power) {   // JR: don't use utils::Compare() here - exact match required
+        return std::make_tuple(false, 0.0);
+    }
+
+    m_Used[variate] = true;
+
+    return std::make_tuple(true, m_Values[variate][m_Offset]);
+}
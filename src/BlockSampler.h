@@ -0,0 +1,130 @@
+#ifndef __BlockSampler_h__
+#define __BlockSampler_h__
+
+#define BLOCK_SAMPLER BlockSampler::Instance()
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+/*
+ * BlockSampler Singleton - block (structure-of-arrays) sampling of initial conditions
+ *
+ * Enabled with program option --initial-sampling BLOCK.  Rather than drawing the initial conditions of
+ * each star/binary one scalar at a time, the initial conditions of --initial-sampling-block-size systems
+ * are drawn at once into one array per variate (BLOCK_VARIATE in constants.h), and the initial-condition
+ * samplers (utils::Sample*()) then take each system's values from those arrays.
+ *
+ * Only distributions that are (piecewise) power laws are drawn in blocks - SALPETER, POWERLAW, UNIFORM
+ * and KROUPA masses, FLAT and SANA2012 mass ratios, LOGUNIFORM metallicities, FLATINLOG, CUSTOM and
+ * SANA2012 semi-major axes, FLATINLOG orbital periods, and FLAT, THERMAL and SANA2012 eccentricities.
+ * All of these are inverted with the same branch-free expression
+ *
+ *     x = exp(A_k + B_k t + E_k ln(C_k + D_k t))
+ *
+ * with coefficients per power-law segment k (see PowerLawT below), so the fill loops are straight-line
+ * code over contiguous arrays that the compiler can vectorise.  Other distributions, user-specified
+ * values, and redraws by the binary constructor (e.g. stars touching at birth) use the scalar samplers
+ * and the pseudo-random stream as usual.
+ *
+ * The uniforms come from a counter-based generator: the uniform for variate v of system i is a hash of
+ * (seed, i, v), so the initial conditions of a system depend only on the seed and the system's index -
+ * not on the block size, nor on which other systems were drawn.
+ */
+
+class BlockSampler {
+
+private:
+
+    // Piecewise power law p(x) ~ c_k x^(p_k) on segment k, inverted as described above
+    // (t is the position of the uniform within segment k, rescaled to [0, 1))
+
+    static const int MAX_SEGMENTS = 3;
+
+    typedef struct PowerLaw {
+        bool   enabled;                                                                 // is this variate drawn in blocks?
+        int    distribution;                                                            // distribution (as int) the variate was set up for
+        double max;                                                                     // distribution maximum the variate was set up for
+        double min;                                                                     // distribution minimum the variate was set up for
+        double power;                                                                   // distribution power the variate was set up for
+        bool   exponentiate;                                                            // return exp(x) rather than x?
+        int    segments;                                                                // number of power-law segments
+        double cdf[MAX_SEGMENTS];                                                       // CDF at the start of each segment
+        double width[MAX_SEGMENTS];                                                     // probability of each segment
+        double A[MAX_SEGMENTS];                                                         // inversion coefficients
+        double B[MAX_SEGMENTS];
+        double C[MAX_SEGMENTS];
+        double D[MAX_SEGMENTS];
+        double E[MAX_SEGMENTS];
+    } PowerLawT;
+
+    BlockSampler() {
+        m_Enabled    = false;
+        m_Seed       = 0;
+        m_BlockSize  = 0;
+        m_BlockStart = -1;
+        m_Offset     = 0;
+        for (auto &variate : m_Variates) variate.enabled = false;
+        for (auto &used : m_Used) used = true;
+    };
+    BlockSampler(BlockSampler const&) = delete;
+    BlockSampler& operator = (BlockSampler const&) = delete;
+
+    static BlockSampler* m_Instance;
+
+    bool                    m_Enabled;                                                  // block sampling enabled?
+    uint64_t                m_Seed;                                                     // seed for the counter-based generator
+    size_t                  m_BlockSize;                                                // number of systems per block
+
+    long int                m_BlockStart;                                               // index of the first system in the current block (-1 = no block)
+    size_t                  m_Offset;                                                   // offset of the current system in the current block
+
+    PowerLawT               m_Variates[static_cast<int>(BLOCK_VARIATE::COUNT)];         // distribution of each variate
+    std::vector<double>     m_Values[static_cast<int>(BLOCK_VARIATE::COUNT)];           // values of each variate for the current block
+    bool                    m_Used[static_cast<int>(BLOCK_VARIATE::COUNT)];             // which variates of the current system have been taken
+
+    static double CounterUniform(const uint64_t p_Seed, const uint64_t p_Counter);
+
+    void          FillBlock(const long int p_BlockStart);
+
+    static bool   SetPowerLaw(PowerLawT&                 p_Variate,
+                              const std::vector<double>& p_Breaks,
+                              const std::vector<double>& p_Powers,
+                              const double               p_Max,
+                              const double               p_Min);
+
+    void          SetVariate(const BLOCK_VARIATE         p_Variate,
+                             const int                   p_Distribution,
+                             const double                p_Max,
+                             const double                p_Min,
+                             const double                p_Power,
+                             const std::vector<double>&  p_Breaks,
+                             const std::vector<double>&  p_Powers,
+                             const double                p_SegmentMax,
+                             const double                p_SegmentMin,
+                             const bool                  p_Exponentiate = false);
+
+
+public:
+
+    static BlockSampler* Instance();
+
+    void Initialise(const unsigned long int p_Seed);
+
+    bool Enabled() const                                                                { return m_Enabled; }
+
+    void NextSystem(const unsigned long int p_Index);
+
+    std::tuple<bool, double> Value(const BLOCK_VARIATE p_Variate,
+                                   const int           p_Distribution,
+                                   const double        p_Max,
+                                   const double        p_Min,
+                                   const double        p_Power = 0.0);
+};
+
+
+#endif // __BlockSampler_h__
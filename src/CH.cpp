@@ -18,3 +18,33 @@ STELLAR_TYPE CH::EvolveToNextPhase() {
 
     return stellarType;
 }
+
+
+/*
+ * Calculate the radius of the star after a change in mass, without updating the star
+ *
+ * The radius of a CH star is constant (m_RZAMS) while it remains on phase - the radius is modelled unless the
+ * star would evolve off phase (age beyond the Main Sequence lifetime for the new initial mass, or spun down).
+ *
+ *
+ * std::tuple<bool, double> CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0)
+ *
+ * @param   [IN]    p_DeltaMass                 Change in mass in Msol
+ * @param   [IN]    p_DeltaMass0                Change in initial mass (Mass0) in Msol
+ * @return                                      Tuple containing:
+ *                                                  - flag indicating whether the radius was modelled
+ *                                                  - radius after the mass change in Rsol (current radius if not modelled)
+ */
+std::tuple<bool, double> CH::CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0) const {
+
+    if (utils::Compare(p_DeltaMass, 0.0) == 0 && utils::Compare(p_DeltaMass0, 0.0) == 0) return std::make_tuple(true, m_Radius);    // no change - attributes would not be recalculated
+
+    double mass  = utils::Compare(p_DeltaMass,  0.0) != 0 ? std::max(0.0, m_Mass  + p_DeltaMass)  : m_Mass;                          // as UpdateAttributesAndAgeOneTimestepPreamble()
+    double mass0 = utils::Compare(p_DeltaMass0, 0.0) != 0 ? std::max(0.0, m_Mass0 + p_DeltaMass0) : m_Mass0;
+
+    double tMS   = CalculateLifetimeOnPhase(mass0, CalculateLifetimeToBGB(mass0));
+
+    if (mass <= 0.0 || m_Age >= tMS || !(OPTIONS->OptimisticCHE() || m_Omega >= m_OmegaCHE)) return std::make_tuple(false, m_Radius);  // would evolve off phase - not modelled
+
+    return std::make_tuple(true, CalculateRadiusOnPhase());
+}
@@ -37,6 +37,8 @@ protected:
     }
 
     // member functions
+    std::tuple<bool, double> CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0) const;
+
     double          CalculateRadiusOnPhase() const      { return m_RZAMS; }                                                                                                         // Constant from birth
     double          CalculateRadiusAtPhaseEnd() const   { return CalculateRadiusOnPhase(); }                                                                                        // Same as on phase
 
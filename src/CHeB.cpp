@@ -1,6 +1,7 @@
 #include "CHeB.h"
 #include "EAGB.h"
 #include "HeMS.h"
+#include "powers.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -484,9 +485,12 @@ double CHeB::CalculateMinimumLuminosityOnPhase(const double      p_Mass,
 #define b p_BnCoefficients  // for convenience and readability - undefined at end of function
 
     double LHeI = GiantBranch::CalculateLuminosityAtHeIgnition_Static(p_Mass, p_Alpha1, p_MHeF, p_BnCoefficients);
-    double c    = (b[17] / PPOW(p_MFGB, 0.1)) + (((b[16] * b[17]) - b[14]) / (PPOW(p_MFGB, (b[15] + 0.1))));
+    powers::SharedBase mFGB(p_MFGB);                                                    // log2() of the masses once for both powers of each
+    powers::SharedBase m(p_Mass);
 
-    return  LHeI * ((b[14] + (c * PPOW(p_Mass, (b[15] + 0.1)))) / (b[16] + PPOW(p_Mass, b[15])));
+    double c    = (b[17] / mFGB.Pow(0.1)) + (((b[16] * b[17]) - b[14]) / (mFGB.Pow(b[15] + 0.1)));
+
+    return  LHeI * ((b[14] + (c * m.Pow(b[15] + 0.1))) / (b[16] + m.Pow(b[15])));
 
 #undef b
 }
@@ -0,0 +1,374 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <sstream>
+
+#include "CoalescenceTime.h"
+#include "Options.h"
+#include "profiling.h"
+#include "utils.h"
+
+CoalescenceTime* CoalescenceTime::m_Instance = nullptr;
+
+
+CoalescenceTime* CoalescenceTime::Instance() {
+
+    if (!m_Instance) {
+        m_Instance = new CoalescenceTime();
+    }
+    return m_Instance;
+}
+
+
+/*
+ * Initialise the coalescence time kernel
+ *
+ * Reads the coalescence time kernel and, unless the kernel is INTEGRAL, builds the table of R(x)
+ * (see CoalescenceTime.h).  In VALIDATE mode the table and the Riemann sum are also checked against
+ * a high-accuracy integral, and timed.
+ *
+ * The table is built from x = 1 (e = 0) down, accumulating the integral of eq 5.14 of Peters 1964
+ * segment by segment.  In u = e^(48/19) the integral is
+ *
+ *     integral_0^e e'^(29/19) (1 + 121/304 e'^2)^(1181/2299) / (1 - e'^2)^(3/2) de' = (19/48) J(u),
+ *     J(u) = integral_0^u (1 + 121/304 e'^2)^(1181/2299) / (1 - e'^2)^(3/2) du'
+ *
+ * and the integrand of J is smooth (and 1 at u = 0), so J(u) / u -> 1 as e -> 0, and
+ *
+ *     R(x) = x (1 + 121/304 e^2)^(-3480/2299) J(u) / u
+ *
+ * Called from main() before evolution starts - TimeToCoalescence() calls it if it has not been called.
+ *
+ *
+ * void Initialise()
+ */
+void CoalescenceTime::Initialise() {
+
+    m_Kernel      = OPTIONS->CoalescenceTimeKernel();
+    m_Initialised = true;
+
+    if (m_Kernel == COALESCENCE_TIME_KERNEL::INTEGRAL) return;                                      // no table needed
+
+    const int    points = COALESCENCE_TIME_TABLE_SIZE;
+    const double xMin   = 0.14;                                                                     // sqrt(1 - 0.99^2) = 0.1411 - the table covers e <= 0.99
+    const double dx     = (1.0 - xMin) / (points - 1);
+
+    std::vector<double> x(points);
+    std::vector<double> r(points);
+
+    x[points - 1] = 1.0;                                                                            // e = 0
+    r[points - 1] = 1.0;
+
+    double J     = 0.0;
+    double uLast = 0.0;
+    for (int i = points - 2; i >= 0; i--) {
+        x[i] = xMin + (i * dx);
+
+        double e2 = (1.0 - x[i]) * (1.0 + x[i]);
+        double u  = std::pow(std::sqrt(e2), 48.0 / 19.0);
+
+        J     += IntegralU(uLast, u, 16);
+        uLast  = u;
+
+        r[i] = x[i] * std::pow(1.0 + (121.0 / 304.0) * e2, -3480.0 / 2299.0) * J / u;
+    }
+
+    m_Table = TabulatedFunction(x, r);
+
+    if (m_Kernel == COALESCENCE_TIME_KERNEL::VALIDATE) {
+        CheckTable();
+        Benchmark();
+    }
+}
+
+
+/*
+ * Peters 1964 beta (eq 5.9)
+ *
+ *
+ * double Beta(const double p_Mass1, const double p_Mass2)
+ *
+ * @param   [IN]    p_Mass1                     Primary mass in SI units
+ * @param   [IN]    p_Mass2                     Secondary mass in SI units
+ * @return                                      Beta in SI units
+ */
+double CoalescenceTime::Beta(const double p_Mass1, const double p_Mass2) {
+    return (64.0 / 5.0) * G * G * G * p_Mass1 * p_Mass2 * (p_Mass1 + p_Mass2) / (C * C * C * C * C);
+}
+
+
+/*
+ * Integrand of J(u) - see Initialise()
+ *
+ *
+ * double IntegrandU(const double p_U)
+ *
+ * @param   [IN]    p_U                         u = e^(48/19)
+ * @return                                      (1 + 121/304 e^2)^(1181/2299) / (1 - e^2)^(3/2)
+ */
+double CoalescenceTime::IntegrandU(const double p_U) {
+
+    double e        = std::pow(p_U, 19.0 / 48.0);
+    double e2       = e * e;
+    double _1_e_2   = 1.0 - e2;
+
+    return std::pow(1.0 + (121.0 / 304.0) * e2, 1181.0 / 2299.0) / (_1_e_2 * std::sqrt(_1_e_2));
+}
+
+
+/*
+ * Integral of J(u) between two values of u - Simpson's rule
+ *
+ *
+ * double IntegralU(const double p_U0, const double p_U1, const int p_Intervals)
+ *
+ * @param   [IN]    p_U0                        Lower limit
+ * @param   [IN]    p_U1                        Upper limit
+ * @param   [IN]    p_Intervals                 Number of intervals (even)
+ * @return                                      Integral
+ */
+double CoalescenceTime::IntegralU(const double p_U0, const double p_U1, const int p_Intervals) {
+
+    double h   = (p_U1 - p_U0) / p_Intervals;
+    double sum = IntegrandU(p_U0) + IntegrandU(p_U1);
+
+    for (int i = 1; i < p_Intervals; i++) sum += (i % 2 == 0 ? 2.0 : 4.0) * IntegrandU(p_U0 + (i * h));
+
+    return sum * h / 3.0;
+}
+
+
+/*
+ * Time to coalescence, with the Riemann sum for 0.01 <= e <= 0.99 (as before the table was introduced)
+ *
+ * Peters 1964 http://journals.aps.org/pr/pdf/10.1103/PhysRev.136.B1224, eq 5.14
+ *
+ *
+ * double TimeToCoalescenceIntegral(const double p_SemiMajorAxis,
+ *                                  const double p_Eccentricity,
+ *                                  const double p_Mass1,
+ *                                  const double p_Mass2)
+ *
+ * @param   [IN]    p_SemiMajorAxis             Initial semi-major axis in SI units
+ * @param   [IN]    p_Eccentricity              Initial eccentricity
+ * @param   [IN]    p_Mass1                     Primary mass in SI units
+ * @param   [IN]    p_Mass2                     Secondary mass in SI units
+ * @return                                      Time to coalescence in SI units (s)
+ */
+double CoalescenceTime::TimeToCoalescenceIntegral(const double p_SemiMajorAxis,
+                                                  const double p_Eccentricity,
+                                                  const double p_Mass1,
+                                                  const double p_Mass2) {
+
+    double beta    = Beta(p_Mass1, p_Mass2);
+    double _4_beta = 4.0 * beta;
+
+    double tC = p_SemiMajorAxis * p_SemiMajorAxis * p_SemiMajorAxis * p_SemiMajorAxis / _4_beta;                // time for a circular binary to merge
+
+    if (utils::Compare(p_Eccentricity, 0) != 0) {
+
+        double e0_2  = p_Eccentricity * p_Eccentricity;
+        double c0    = p_SemiMajorAxis * (1.0 - e0_2) * PPOW(p_Eccentricity, -12.0/19.0) * PPOW(1.0 + (121.0 * e0_2 / 304.0), -870.0/2299.0);
+
+        double _4_c0 = c0 * c0 * c0 * c0;
+
+        if (utils::Compare(p_Eccentricity, 0.01) < 0) {
+            tC = _4_c0 *PPOW(p_Eccentricity, 48.0/19.0) / _4_beta;
+        }
+        else if (utils::Compare(p_Eccentricity, 0.99) > 0) {
+
+            double _1_e0_2 = 1.0 - e0_2;
+            tC *= (768.0 / 425.0) * (_1_e0_2 * _1_e0_2 * _1_e0_2 * sqrt(_1_e0_2));                              // approximation of eq. 5.14 of Peters 1964, for high eccentricities
+        }
+        else {
+
+            double sum = 0.0;
+            double de  = p_Eccentricity / 10000;
+
+            for (double e = 0.0; utils::Compare(e, p_Eccentricity) < 0; e += de) {
+                double _1_e_2 = 1.0 - (e * e);
+                sum += de * PPOW(e, 29.0 / 19.0) * PPOW((1.0 + (121.0 / 304.0) * e * e), 1181.0 / 2299.0) / ( _1_e_2 * sqrt( _1_e_2));
+            }
+
+            tC = (12.0 / 19.0) * (_4_c0 / beta) * sum;
+        }
+    }
+
+    return tC;
+}
+
+
+/*
+ * Time to coalescence, with the table for 0.01 <= e <= 0.99
+ *
+ * Outside [0.01, 0.99] as TimeToCoalescenceIntegral().
+ *
+ *
+ * double TimeToCoalescenceTabulated(const double p_SemiMajorAxis,
+ *                                   const double p_Eccentricity,
+ *                                   const double p_Mass1,
+ *                                   const double p_Mass2)
+ *
+ * @param   [IN]    p_SemiMajorAxis             Initial semi-major axis in SI units
+ * @param   [IN]    p_Eccentricity              Initial eccentricity
+ * @param   [IN]    p_Mass1                     Primary mass in SI units
+ * @param   [IN]    p_Mass2                     Secondary mass in SI units
+ * @return                                      Time to coalescence in SI units (s)
+ */
+double CoalescenceTime::TimeToCoalescenceTabulated(const double p_SemiMajorAxis,
+                                                   const double p_Eccentricity,
+                                                   const double p_Mass1,
+                                                   const double p_Mass2) const {
+
+    if (utils::Compare(p_Eccentricity, 0.01) < 0 || utils::Compare(p_Eccentricity, 0.99) > 0) {
+        return TimeToCoalescenceIntegral(p_SemiMajorAxis, p_Eccentricity, p_Mass1, p_Mass2);
+    }
+
+    double a2  = p_SemiMajorAxis * p_SemiMajorAxis;
+    double x   = std::sqrt((1.0 - p_Eccentricity) * (1.0 + p_Eccentricity));
+    double x2  = x * x;
+    double x7  = x2 * x2 * x2 * x;
+
+    return a2 * a2 / (4.0 * Beta(p_Mass1, p_Mass2)) * x7 * m_Table.Interpolate(x);
+}
+
+
+/*
+ * Time to coalescence, with a high-accuracy integral for 0.01 <= e <= 0.99 (VALIDATE mode)
+ *
+ * Simpson's rule in u = e^(48/19) with 2^16 intervals - see Initialise()
+ *
+ *
+ * double TimeToCoalescenceReference(const double p_SemiMajorAxis,
+ *                                   const double p_Eccentricity,
+ *                                   const double p_Mass1,
+ *                                   const double p_Mass2)
+ *
+ * @param   [IN]    p_SemiMajorAxis             Initial semi-major axis in SI units
+ * @param   [IN]    p_Eccentricity              Initial eccentricity
+ * @param   [IN]    p_Mass1                     Primary mass in SI units
+ * @param   [IN]    p_Mass2                     Secondary mass in SI units
+ * @return                                      Time to coalescence in SI units (s)
+ */
+double CoalescenceTime::TimeToCoalescenceReference(const double p_SemiMajorAxis,
+                                                   const double p_Eccentricity,
+                                                   const double p_Mass1,
+                                                   const double p_Mass2) {
+
+    double e2 = p_Eccentricity * p_Eccentricity;
+    double x  = std::sqrt(1.0 - e2);
+    double u  = std::pow(p_Eccentricity, 48.0 / 19.0);
+    double a2 = p_SemiMajorAxis * p_SemiMajorAxis;
+
+    return a2 * a2 / (4.0 * Beta(p_Mass1, p_Mass2)) * std::pow(x, 8.0) * std::pow(1.0 + (121.0 / 304.0) * e2, -3480.0 / 2299.0) * IntegralU(0.0, u, 65536) / u;
+}
+
+
+/*
+ * Check the table and the Riemann sum against the high-accuracy integral on a grid of eccentricities (VALIDATE mode)
+ *
+ * The time to coalescence is proportional to a^4 / (m1 m2 (m1 + m2)), so relative errors depend on
+ * eccentricity only - the grid is 0.01 <= e <= 0.99 in steps of 0.001 (a = 1 AU, m1 = m2 = 1 Msol).
+ *
+ *
+ * void CheckTable()
+ */
+void CoalescenceTime::CheckTable() {
+
+    for (int i = 10; i <= 990; i++) {
+        double e         = i / 1000.0;
+        double reference = TimeToCoalescenceReference(AU, e, MSOL_TO_KG, MSOL_TO_KG);
+
+        m_GridMaxRelativeErrorTabulated = std::max(m_GridMaxRelativeErrorTabulated, std::abs(TimeToCoalescenceTabulated(AU, e, MSOL_TO_KG, MSOL_TO_KG) / reference - 1.0));
+        m_GridMaxRelativeErrorIntegral  = std::max(m_GridMaxRelativeErrorIntegral, std::abs(TimeToCoalescenceIntegral(AU, e, MSOL_TO_KG, MSOL_TO_KG) / reference - 1.0));
+        m_GridPoints++;
+    }
+}
+
+
+/*
+ * Time the tabulated kernel and the Riemann sum (VALIDATE mode)
+ *
+ * Eccentricities are spread over [0.01, 0.99] - the Riemann sum is timed over fewer calls (it is ~10^4 times slower).
+ *
+ *
+ * void Benchmark()
+ */
+void CoalescenceTime::Benchmark() {
+
+    auto time = [](const int p_Calls, const std::function<double(double)>& p_Kernel) {
+        double sink  = 0.0;
+        auto   start = std::chrono::steady_clock::now();
+        for (int i = 0; i < p_Calls; i++) sink += p_Kernel(0.01 + (0.98 * (i + 0.5) / p_Calls));
+        auto   stop  = std::chrono::steady_clock::now();
+        volatile double keep = sink; (void)keep;                                                    // so the calls are not optimised away
+        return std::chrono::duration<double, std::nano>(stop - start).count() / p_Calls;
+    };
+
+    m_NanosecondsPerCallTabulated = time(1000000, [this](const double p_E) { return TimeToCoalescenceTabulated(AU, p_E, MSOL_TO_KG, MSOL_TO_KG); });
+    m_NanosecondsPerCallIntegral  = time(200,     [](const double p_E)     { return TimeToCoalescenceIntegral(AU, p_E, MSOL_TO_KG, MSOL_TO_KG); });
+}
+
+
+/*
+ * Time to coalescence of a binary through gravitational radiation - per the coalescence time kernel
+ *
+ * Peters 1964 http://journals.aps.org/pr/pdf/10.1103/PhysRev.136.B1224, eq 5.14
+ *
+ *
+ * double TimeToCoalescence(const double p_SemiMajorAxis,
+ *                          const double p_Eccentricity,
+ *                          const double p_Mass1,
+ *                          const double p_Mass2)
+ *
+ * @param   [IN]    p_SemiMajorAxis             Initial semi-major axis in SI units
+ * @param   [IN]    p_Eccentricity              Initial eccentricity
+ * @param   [IN]    p_Mass1                     Primary mass in SI units
+ * @param   [IN]    p_Mass2                     Secondary mass in SI units
+ * @return                                      Time to coalescence in SI units (s)
+ */
+double CoalescenceTime::TimeToCoalescence(const double p_SemiMajorAxis,
+                                          const double p_Eccentricity,
+                                          const double p_Mass1,
+                                          const double p_Mass2) {
+
+    if (!m_Initialised) Initialise();
+
+    switch (m_Kernel) {
+        case COALESCENCE_TIME_KERNEL::TABULATED: return TimeToCoalescenceTabulated(p_SemiMajorAxis, p_Eccentricity, p_Mass1, p_Mass2);
+        case COALESCENCE_TIME_KERNEL::INTEGRAL : return TimeToCoalescenceIntegral(p_SemiMajorAxis, p_Eccentricity, p_Mass1, p_Mass2);
+        default: {                                                                                  // VALIDATE
+            double integral = TimeToCoalescenceIntegral(p_SemiMajorAxis, p_Eccentricity, p_Mass1, p_Mass2);
+            if (integral > 0.0 && std::isfinite(integral)) {
+                m_Comparisons++;
+                m_MaxRelativeDifference = std::max(m_MaxRelativeDifference,
+                                                   std::abs(TimeToCoalescenceTabulated(p_SemiMajorAxis, p_Eccentricity, p_Mass1, p_Mass2) / integral - 1.0));
+            }
+            return integral;
+        }
+    }
+}
+
+
+/*
+ * Summary of the coalescence time kernel's comparisons and timings, for the run details file (VALIDATE mode)
+ *
+ *
+ * std::string Summary()
+ *
+ * @return                                      Multi-line summary (empty unless VALIDATE mode)
+ */
+std::string CoalescenceTime::Summary() const {
+
+    if (m_Kernel != COALESCENCE_TIME_KERNEL::VALIDATE) return "";
+
+    std::ostringstream ss;
+    ss << "\nCoalescence time validation (0.01 <= e <= 0.99, " << COALESCENCE_TIME_TABLE_SIZE << "-point table vs 10,000-step Riemann sum):\n"
+       << "  Grid of " << m_GridPoints << " eccentricities, max relative error vs high-accuracy integral: table = " << m_GridMaxRelativeErrorTabulated
+       << ", Riemann sum = " << m_GridMaxRelativeErrorIntegral << "\n"
+       << "  Binaries compared = " << m_Comparisons << ", max relative difference (table vs Riemann sum) = " << m_MaxRelativeDifference << "\n"
+       << "  Time per call: table = " << m_NanosecondsPerCallTabulated << " ns, Riemann sum = " << m_NanosecondsPerCallIntegral << " ns\n";
+
+    return ss.str();
+}
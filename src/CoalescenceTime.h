@@ -0,0 +1,102 @@
+#ifndef __CoalescenceTime_h__
+#define __CoalescenceTime_h__
+
+#define COALESCENCE_TIME CoalescenceTime::Instance()
+
+#include <string>
+#include <vector>
+
+#include "constants.h"
+#include "typedefs.h"
+#include "TabulatedFunction.h"
+
+
+/*
+ * CoalescenceTime Singleton - fast time to coalescence of eccentric binaries through gravitational radiation
+ *
+ * Peters 1964 http://journals.aps.org/pr/pdf/10.1103/PhysRev.136.B1224, eq 5.14, gives the time to coalescence
+ * of a binary with semi-major axis a, eccentricity e and masses m1, m2 as an integral over eccentricity.
+ * The integral was evaluated as a 10,000-step Riemann sum (two calls to pow() per step) for every
+ * binary with 0.01 <= e <= 0.99.
+ *
+ * Writing x = sqrt(1 - e^2), the time to coalescence is
+ *
+ *     tC = tC_circ x^7 R(x),     tC_circ = a^4 / (4 beta)   (the time to coalescence of a circular binary)
+ *
+ * where R(x) depends on eccentricity only, with R(1) = 1 and R -> 768/425 as x -> 0 (the high-eccentricity
+ * limit).  R is smooth in x, so it is tabulated once per run (COALESCENCE_TIME_TABLE_SIZE equally spaced
+ * points in x, integrated with Simpson's rule in u = e^(48/19), in which the integrand is smooth) and
+ * interpolated - one sqrt() and a table lookup per binary.  Eccentricities outside [0.01, 0.99] use the
+ * low- and high-eccentricity approximations, as before.
+ *
+ * Program option --coalescence-time-kernel selects the kernel:
+ *
+ *     TABULATED: interpolated on the table (default)
+ *     INTEGRAL : the Riemann sum, as before the table was introduced
+ *     VALIDATE : the Riemann sum (so results are unchanged), but every time to coalescence is also evaluated
+ *                from the table and the two are compared.  At initialisation both kernels are checked against
+ *                a high-accuracy integral on a grid of eccentricities, and timed - the comparisons and timings
+ *                are written to the run details file.
+ */
+
+class CoalescenceTime {
+
+private:
+
+    CoalescenceTime() {
+        m_Initialised                    = false;
+        m_Kernel                         = COALESCENCE_TIME_KERNEL::TABULATED;
+        m_Comparisons                    = 0;
+        m_MaxRelativeDifference          = 0.0;
+        m_GridPoints                     = 0;
+        m_GridMaxRelativeErrorTabulated  = 0.0;
+        m_GridMaxRelativeErrorIntegral   = 0.0;
+        m_NanosecondsPerCallTabulated    = 0.0;
+        m_NanosecondsPerCallIntegral     = 0.0;
+    };
+    CoalescenceTime(CoalescenceTime const&) = delete;
+    CoalescenceTime& operator = (CoalescenceTime const&) = delete;
+
+    static CoalescenceTime* m_Instance;
+
+    bool                    m_Initialised;                                                  // table built?
+    COALESCENCE_TIME_KERNEL m_Kernel;                                                       // coalescence time kernel
+
+    TabulatedFunction       m_Table;                                                        // (x, R(x)), x = sqrt(1 - e^2) - see above
+
+    unsigned long int       m_Comparisons;                                                  // VALIDATE mode: number of times to coalescence compared
+    double                  m_MaxRelativeDifference;                                        // VALIDATE mode: maximum |tabulated - integral| / integral
+
+    int                     m_GridPoints;                                                   // VALIDATE mode: number of eccentricities checked at initialisation
+    double                  m_GridMaxRelativeErrorTabulated;                                // VALIDATE mode: maximum relative error of the table on the grid of eccentricities
+    double                  m_GridMaxRelativeErrorIntegral;                                 // VALIDATE mode: maximum relative error of the Riemann sum on the grid of eccentricities
+    double                  m_NanosecondsPerCallTabulated;                                  // VALIDATE mode: time per call of the tabulated kernel
+    double                  m_NanosecondsPerCallIntegral;                                   // VALIDATE mode: time per call of the Riemann sum
+
+    static double           Beta(const double p_Mass1, const double p_Mass2);
+    static double           IntegrandU(const double p_U);
+    static double           IntegralU(const double p_U0, const double p_U1, const int p_Intervals);
+
+    static double           TimeToCoalescenceIntegral(const double p_SemiMajorAxis, const double p_Eccentricity, const double p_Mass1, const double p_Mass2);
+    static double           TimeToCoalescenceReference(const double p_SemiMajorAxis, const double p_Eccentricity, const double p_Mass1, const double p_Mass2);
+    double                  TimeToCoalescenceTabulated(const double p_SemiMajorAxis, const double p_Eccentricity, const double p_Mass1, const double p_Mass2) const;
+
+    void                    CheckTable();
+    void                    Benchmark();
+
+
+public:
+
+    static CoalescenceTime* Instance();
+
+    void   Initialise();
+
+    COALESCENCE_TIME_KERNEL Kernel() const                                                  { return m_Kernel; }
+
+    double TimeToCoalescence(const double p_SemiMajorAxis, const double p_Eccentricity, const double p_Mass1, const double p_Mass2);
+
+    std::string Summary() const;
+};
+
+
+#endif // __CoalescenceTime_h__
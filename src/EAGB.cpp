@@ -1,6 +1,7 @@
 #include "EAGB.h"
 #include "HeMS.h"
 #include "HeGB.h"
+#include "powers.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -477,7 +478,8 @@ double EAGB::CalculateRadiusOnPhase_Static(const double      p_Mass,
     double b50;
 
     if (utils::Compare(p_Mass, p_MHeF) >= 0) {
-        A = std::min((b[51] * PPOW(p_Mass, -b[52])), (b[53] * PPOW(p_Mass, -b[54])));
+        powers::SharedBase m(p_Mass);                                                   // log2(mass) once for both powers
+        A = std::min((b[51] * m.Pow(-b[52])), (b[53] * m.Pow(-b[54])));
         b50 = b[55] * b[3];
     }
     else if (utils::Compare(p_Mass, (p_MHeF - 0.2)) <= 0) {
@@ -490,7 +492,8 @@ double EAGB::CalculateRadiusOnPhase_Static(const double      p_Mass,
         double x2_x1     = x2 - x1;
 
         double y1        = b[56] + (b[57] * x1);
-        double y2        = std::min((b[51] * PPOW(x2, -b[52])), (b[53] * PPOW(x2, -b[54])));
+        powers::SharedBase m(x2);                                                       // log2(x2) once for both powers
+        double y2        = std::min((b[51] * m.Pow(-b[52])), (b[53] * m.Pow(-b[54])));
         double gradient  = (y2 - y1) / x2_x1;
         double intercept = y2 - (gradient * x2);
                A         = (gradient * p_Mass) + intercept;
@@ -503,7 +506,8 @@ double EAGB::CalculateRadiusOnPhase_Static(const double      p_Mass,
     }
 
     // now calculate the radius
-    return A * (PPOW(p_Luminosity, b[1]) + (b[2] * PPOW(p_Luminosity, b50)));
+    powers::SharedBase l(p_Luminosity);                                                 // log2(luminosity) once for both powers
+    return A * (l.Pow(b[1]) + (b[2] * l.Pow(b50)));
 
 #undef b
 }
@@ -0,0 +1,74 @@
+#include <algorithm>
+
+#include "EventBus.h"
+
+EventBus* EventBus::m_Instance = nullptr;
+
+
+EventBus* EventBus::Instance() {
+
+    if (!m_Instance) {
+        m_Instance = new EventBus();
+    }
+    return m_Instance;
+}
+
+
+/*
+ * Subscribe to events of the specified type
+ *
+ *
+ * int Subscribe(const EVENT_TYPE p_EventType, const EventHandlerT p_Handler)
+ *
+ * @param   [IN]    p_EventType                 The type of event to subscribe to
+ * @param   [IN]    p_Handler                   The function to be called (synchronously) when an event of type p_EventType is published
+ * @return                                      Subscription id - to be passed to Unsubscribe()
+ */
+int EventBus::Subscribe(const EVENT_TYPE p_EventType, const EventHandlerT p_Handler) {
+
+    int subscriptionId = m_NextSubscriptionId++;
+    m_Subscribers[static_cast<int>(p_EventType)].push_back(std::make_tuple(subscriptionId, p_Handler));
+
+    return subscriptionId;
+}
+
+
+/*
+ * Cancel a subscription
+ *
+ * Unknown subscription ids are silently ignored.
+ *
+ *
+ * void Unsubscribe(const int p_SubscriptionId)
+ *
+ * @param   [IN]    p_SubscriptionId            The subscription id returned by Subscribe()
+ */
+void EventBus::Unsubscribe(const int p_SubscriptionId) {
+
+    for (auto &subscribers : m_Subscribers) {
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                         [p_SubscriptionId](const std::tuple<int, EventHandlerT>& p_Subscriber) { return std::get<0>(p_Subscriber) == p_SubscriptionId; }),
+                          subscribers.end());
+    }
+}
+
+
+/*
+ * Publish an event
+ *
+ * Calls the handler of each subscriber to the event type, in order of subscription.  The subscriber
+ * list is copied before dispatch so that handlers may subscribe or unsubscribe while being dispatched
+ * (changes take effect for the next event published).
+ *
+ *
+ * void Publish(const EventT& p_Event)
+ *
+ * @param   [IN]    p_Event                     The event to be published
+ */
+void EventBus::Publish(const EventT& p_Event) {
+
+    if (!HasSubscribers(p_Event.type)) return;                                          // no subscribers - nothing to do
+
+    SUBSCRIBER_VECTOR subscribers = m_Subscribers[static_cast<int>(p_Event.type)];       // copy - handlers may (un)subscribe
+    for (auto &subscriber : subscribers) std::get<1>(subscriber)(p_Event);
+}
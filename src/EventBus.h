@@ -0,0 +1,64 @@
+#ifndef __EventBus_h__
+#define __EventBus_h__
+
+#define EVENTS EventBus::Instance()
+
+#include <functional>
+#include <vector>
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+/*
+ * EventBus Singleton - synchronous dispatch of evolution events
+ *
+ * Evolution code publishes events (stellar type switch, supernova, common envelope, mass
+ * transfer start/end, stellar merger, double compact object formation - see EVENT_TYPE in
+ * constants.h); loggers and analyses subscribe to the event types they are interested in.
+ *
+ * Dispatch is synchronous: handlers are called, in order of subscription, on the publishing
+ * thread before Publish() returns.  There is no queueing and no signal delivery.
+ *
+ * Publishing an event type with no subscribers costs a single (inlined) vector empty() check:
+ * publishers should check HasSubscribers() before constructing the event, e.g.
+ *
+ *     if (EVENTS->HasSubscribers(EVENT_TYPE::SUPERNOVA)) EVENTS->Publish({ EVENT_TYPE::SUPERNOVA, ... });
+ *
+ * Subscribe() returns a subscription id that should be passed to Unsubscribe() when the
+ * subscriber is no longer interested (e.g. the handler captures an object that is about to
+ * be destroyed).  A handler may unsubscribe itself (or others) while being dispatched.
+ */
+
+typedef std::function<void(const EventT&)> EventHandlerT;
+
+class EventBus {
+
+private:
+
+    EventBus() { m_NextSubscriptionId = 1; }
+    EventBus(EventBus const&) = delete;
+    EventBus& operator = (EventBus const&) = delete;
+
+    static EventBus* m_Instance;
+
+    typedef std::vector<std::tuple<int, EventHandlerT>> SUBSCRIBER_VECTOR;
+
+    SUBSCRIBER_VECTOR m_Subscribers[static_cast<int>(EVENT_TYPE::SENTINEL)];            // subscribers per event type: <subscription id, handler>
+    int               m_NextSubscriptionId;                                             // next subscription id to be issued
+
+
+public:
+
+    static EventBus* Instance();
+
+    int  Subscribe(const EVENT_TYPE p_EventType, const EventHandlerT p_Handler);
+    void Unsubscribe(const int p_SubscriptionId);
+
+    bool HasSubscribers(const EVENT_TYPE p_EventType) const                             { return !m_Subscribers[static_cast<int>(p_EventType)].empty(); }
+
+    void Publish(const EventT& p_Event);
+};
+
+
+#endif // __EventBus_h__
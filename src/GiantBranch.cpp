@@ -3,6 +3,7 @@
 #include "WhiteDwarfs.h"
 #include "NS.h"
 #include "BH.h"
+#include "powers.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -87,7 +88,7 @@ void GiantBranch::CalculateTimescales(const double p_Mass, DBL_VECTOR &p_Timesca
  * @return                                      Core mass - Luminosity relation parameter B
  */
 double GiantBranch::CalculateCoreMass_Luminosity_B_Static(const double p_Mass) {
-    return std::max(3.0E4, (500.0 + (1.75E4 * PPOW(p_Mass, 0.6))));
+    return std::max(3.0E4, (500.0 + (1.75E4 * powers::Pow<3, 5>(p_Mass))));
 }
 
 
@@ -234,7 +235,8 @@ double GiantBranch::CalculateCoreMass_Luminosity_Lx_Static(const DBL_VECTOR &p_G
 #define gbParams(x) p_GBParams[static_cast<int>(GBP::x)]    // for convenience and readability - undefined at end of function
     // since the mass used here is the mass at crossover (Mx), these
     // should give the same answer - but we'll take the minimum anyway
-    return std::min((gbParams(B) * PPOW(gbParams(Mx), gbParams(q))), (gbParams(D) * PPOW(gbParams(Mx), gbParams(p))));
+    powers::SharedBase mx(gbParams(Mx));
+    return std::min((gbParams(B) * mx.Pow(gbParams(q))), (gbParams(D) * mx.Pow(gbParams(p))));
 
 #undef gbParams
 }
@@ -425,8 +427,10 @@ void GiantBranch::PerturbLuminosityAndRadius() { }
 double GiantBranch::CalculateLuminosityAtPhaseBase_Static(const double p_Mass, const DBL_VECTOR &p_AnCoefficients) {
 #define a p_AnCoefficients  // for convenience and readability - undefined at end of function
 
-    double top    = (a[27] * PPOW(p_Mass, a[31])) + (a[28] * PPOW(p_Mass, C_COEFF.at(2)));
-    double bottom = a[29] + (a[30] * PPOW(p_Mass, C_COEFF.at(3))) + PPOW(p_Mass, a[32]);
+    powers::SharedBase m(p_Mass);                                                                       // log2(mass) once for all four powers
+
+    double top    = (a[27] * m.Pow(a[31])) + (a[28] * m.Pow(C_COEFF.at(2)));
+    double bottom = a[29] + (a[30] * m.Pow(C_COEFF.at(3))) + m.Pow(a[32]);
 
     return top / bottom;
 
@@ -510,7 +514,7 @@ double GiantBranch::CalculateLuminosityAtHeIgnition_Static(const double      p_M
 
     return (utils::Compare(p_Mass, p_MHeF) < 0)
             ? (b[9] * PPOW(p_Mass, b[10])) / (1.0 + (p_Alpha1 * exp(15.0 * (p_Mass - p_MHeF))))
-            : (b[11] + (b[12] * PPOW(p_Mass, 3.8))) / (b[13] + (p_Mass * p_Mass));
+            : (b[11] + (b[12] * powers::Pow<19, 5>(p_Mass))) / (b[13] + (p_Mass * p_Mass));
 
 #undef b
 }
@@ -563,9 +567,12 @@ double GiantBranch::CalculateRemnantLuminosity() const {
 double GiantBranch::CalculateRadiusOnPhase_Static(const double p_Mass, const double p_Luminosity, const DBL_VECTOR &p_BnCoefficients) {
 #define b p_BnCoefficients  // for convenience and readability - undefined at end of function
 
-    double A = std::min((b[4] * PPOW(p_Mass, -b[5])), (b[6] * PPOW(p_Mass, -b[7])));  // Hurley et al. 2000, just before eq 47
+    powers::SharedBase m(p_Mass);                                                       // log2() of the mass and luminosity once for both powers of each
+    powers::SharedBase l(p_Luminosity);
+
+    double A = std::min((b[4] * m.Pow(-b[5])), (b[6] * m.Pow(-b[7])));                  // Hurley et al. 2000, just before eq 47
 
-    return A * (PPOW(p_Luminosity, b[1]) + (b[2] * PPOW(p_Luminosity, b[3])));        // Hurley et al. 2000, eq 46
+    return A * (l.Pow(b[1]) + (b[2] * l.Pow(b[3])));                                    // Hurley et al. 2000, eq 46
 
 #undef b
 }
@@ -814,6 +821,72 @@ double GiantBranch::CalculateCoreMassAtBGB_Static(const double      p_Mass,
 }
 
 
+/*
+ * Calculate core mass at the Base of the Giant Branch for an array of masses at one metallicity
+ *
+ * Hurley et al. 2000, eq 44
+ *
+ * Batch version of CalculateCoreMassAtBGB_Static(), performing the same operations for each mass - so
+ * the results are identical to the scalar results.  Calculates only the Giant Branch parameters eq 44
+ * needs (B, D, p, q, Mx, Lx, McBAGB - see CalculateGBParams_Static()), and the terms that depend only on
+ * the metallicity (the luminosity at the base of the Giant Branch for M = MHeF, and MHeF^MC_L_C2) once
+ * for the batch.  The fits use pow(), so the loop is not vectorised, but it is ~1.5 - 2x faster per mass than
+ * calling CalculateGBParams_Static() for each mass.
+ *
+ *
+ * void CalculateCoreMassAtBGB_Batch_Static(const std::size_t  p_N,
+ *                                          const double      *p_Mass,
+ *                                          const double       p_LogMetallicityXi,
+ *                                          const DBL_VECTOR  &p_MassCutoffs,
+ *                                          const DBL_VECTOR  &p_AnCoefficients,
+ *                                          const DBL_VECTOR  &p_BnCoefficients,
+ *                                                double      *p_McBGB)
+ *
+ * @param   [IN]    p_N                         Number of masses
+ * @param   [IN]    p_Mass                      Masses in Msol (p_N elements)
+ * @param   [IN]    p_LogMetallicityXi          log10(Metallicity / Zsol) - called xi in Hurley et al 2000
+ * @param   [IN]    p_MassCutoffs               Mass cutoffs
+ * @param   [IN]    p_AnCoefficients            a(n) coefficients
+ * @param   [IN]    p_BnCoefficients            b(n) coefficients
+ * @param   [OUT]   p_McBGB                     Core masses at the Base of the Giant Branch in Msol (p_N elements)
+ */
+void GiantBranch::CalculateCoreMassAtBGB_Batch_Static(const std::size_t  p_N,
+                                                      const double      *p_Mass,
+                                                      const double       p_LogMetallicityXi,
+                                                      const DBL_VECTOR  &p_MassCutoffs,
+                                                      const DBL_VECTOR  &p_AnCoefficients,
+                                                      const DBL_VECTOR  &p_BnCoefficients,
+                                                            double      *p_McBGB) {
+#define gbParams(x) params[static_cast<int>(GBP::x)]                    // for convenience and readability - undefined at end of function
+#define massCutoffs(x) p_MassCutoffs[static_cast<int>(MASS_CUTOFF::x)]  // for convenience and readability - undefined at end of function
+
+    DBL_VECTOR params(static_cast<int>(GBP::COUNT), 0.0);                                                       // only the parameters used by eq 44 are set
+
+    double luminosity = CalculateLuminosityAtPhaseBase_Static(massCutoffs(MHeF), p_AnCoefficients);             // independent of mass
+    double c_MHeF     = MC_L_C1 * PPOW(massCutoffs(MHeF), MC_L_C2);                                             // independent of mass
+
+    for (std::size_t i = 0; i < p_N; i++) {
+        double mass = p_Mass[i];
+
+        gbParams(B)      = CalculateCoreMass_Luminosity_B_Static(mass);
+        gbParams(D)      = CalculateCoreMass_Luminosity_D_Static(mass, p_LogMetallicityXi, p_MassCutoffs);
+        gbParams(p)      = CalculateCoreMass_Luminosity_p_Static(mass, p_MassCutoffs);
+        gbParams(q)      = CalculateCoreMass_Luminosity_q_Static(mass, p_MassCutoffs);
+        gbParams(Mx)     = CalculateCoreMass_Luminosity_Mx_Static(params);
+        gbParams(Lx)     = CalculateCoreMass_Luminosity_Lx_Static(params);
+        gbParams(McBAGB) = CalculateCoreMassAtBAGB_Static(mass, p_BnCoefficients);
+
+        double Mc_MHeF   = BaseStar::CalculateCoreMassGivenLuminosity_Static(luminosity, params);
+        double c         = (Mc_MHeF * Mc_MHeF * Mc_MHeF * Mc_MHeF) - c_MHeF;
+
+        p_McBGB[i] = std::min((0.95 * gbParams(McBAGB)), sqrt(sqrt(c + (MC_L_C1 * PPOW(mass, MC_L_C2)))));
+    }
+
+#undef massCutoffs
+#undef gbParams
+}
+
+
 /*
  * Calculate the core mass at which the Asymptotic Giant Branch phase is terminated in a SN/loss of envelope
  *
@@ -1156,6 +1229,8 @@ double GiantBranch::CalculateRemnantMassByMullerMandel(const double p_COCoreMass
     double remnantMass       = 0.0;   
     double pBH               = 0.0;
     double pCompleteCollapse = 0.0;
+
+    RAND->Stream(RANDOM_STREAM::REMNANT_MASS);                                              // common random numbers: remnant mass substream (no-op unless --common-random-numbers)
     
     if (utils::Compare(p_COCoreMass, MULLERMANDEL_M1) < 0) {
 	    pBH = 0.0;
@@ -1200,6 +1275,8 @@ double GiantBranch::CalculateRemnantMassByMullerMandel(const double p_COCoreMass
         }
     }
 
+    RAND->StreamClear();
+
     return remnantMass;
 }
 
@@ -20,6 +20,16 @@ public:
     GiantBranch(const BaseStar &baseStar) : BaseStar(baseStar), MainSequence(baseStar) {}
     GiantBranch& operator = (const BaseStar &baseStar) { static_cast<BaseStar&>(*this) = baseStar; return *this; }
 
+    static  void            CalculateCoreMassAtBGB_Batch_Static(const std::size_t  p_N,
+                                                                const double      *p_Mass,
+                                                                const double       p_LogMetallicityXi,
+                                                                const DBL_VECTOR  &p_MassCutoffs,
+                                                                const DBL_VECTOR  &p_AnCoefficients,
+                                                                const DBL_VECTOR  &p_BnCoefficients,
+                                                                      double      *p_McBGB);
+
+    static  void            CalculateGBParams_Static(const double p_Mass, const double p_LogMetallicityXi, const DBL_VECTOR &p_MassCutoffs, const DBL_VECTOR &p_AnCoefficients, const DBL_VECTOR &p_BnCoefficients, DBL_VECTOR &p_GBParams);
+
 
 protected:
 
@@ -41,7 +51,6 @@ protected:
     static  double          CalculateCoreMass_Luminosity_Mx_Static(const DBL_VECTOR &p_GBParams);
 
             void            CalculateGBParams(const double p_Mass, DBL_VECTOR &p_GBParams);
-    static  void            CalculateGBParams_Static(const double p_Mass, const double p_LogMetallicityXi, const DBL_VECTOR &p_MassCutoffs, const DBL_VECTOR &p_AnCoefficients, const DBL_VECTOR &p_BnCoefficients, DBL_VECTOR &p_GBParams);
             void            CalculateGBParams()                                                             { CalculateGBParams(m_Mass0, m_GBParams); }                         // Use class member variables
 
     static  double          CalculateHRateConstant_Static(const double p_Mass);
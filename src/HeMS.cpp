@@ -1,5 +1,6 @@
 #include "HeMS.h"
 #include "HeWD.h"
+#include "powers.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -126,7 +127,7 @@ double HeMS::CalculateRadiusAtZAMS_Static(const double p_Mass) {
     double m_3 = p_Mass * p_Mass * p_Mass;
     double m_4 = m_3 * p_Mass;
 
-    return (0.2391 * PPOW(p_Mass, 4.6)) / (m_4 + (0.162 * m_3) + 0.0065);
+    return (0.2391 * powers::Pow<23, 5>(p_Mass)) / (m_4 + (0.162 * m_3) + 0.0065);
 }
 
 
@@ -151,6 +152,38 @@ double HeMS::CalculateRadiusOnPhase_Static(const double p_Mass, const double p_T
 }
 
 
+/*
+ * Calculate the radius of the star after a change in mass, without updating the star
+ *
+ * Evaluates the radius the star would have if its attributes were updated for the mass changes (as by
+ * UpdateAttributes(p_DeltaMass, p_DeltaMass0)): tHeMS for the new initial mass, radius for the new mass
+ * at the resulting relative age.  If the star would leave the helium main sequence the radius is not
+ * modelled (the functional return flag is false) and the star must be updated to find its radius.
+ *
+ *
+ * std::tuple<bool, double> CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0)
+ *
+ * @param   [IN]    p_DeltaMass                 Change in mass in Msol
+ * @param   [IN]    p_DeltaMass0                Change in initial mass (Mass0) in Msol
+ * @return                                      Tuple containing:
+ *                                                  - flag indicating whether the radius was modelled
+ *                                                  - radius after the mass change in Rsol (current radius if not modelled)
+ */
+std::tuple<bool, double> HeMS::CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0) const {
+
+    if (utils::Compare(p_DeltaMass, 0.0) == 0 && utils::Compare(p_DeltaMass0, 0.0) == 0) return std::make_tuple(true, m_Radius);    // no change - attributes would not be recalculated
+
+    double mass  = utils::Compare(p_DeltaMass,  0.0) != 0 ? std::max(0.0, m_Mass  + p_DeltaMass)  : m_Mass;                          // as UpdateAttributesAndAgeOneTimestepPreamble()
+    double mass0 = utils::Compare(p_DeltaMass0, 0.0) != 0 ? std::max(0.0, m_Mass0 + p_DeltaMass0) : m_Mass0;
+
+    double tau   = m_Age / CalculateLifetimeOnPhase_Static(mass0);
+
+    if (mass <= 0.0 || !ShouldEvolveOnPhase() || utils::Compare(tau, 0.0) < 0 || utils::Compare(tau, 1.0) >= 0) return std::make_tuple(false, m_Radius); // would evolve off phase - not modelled
+
+    return std::make_tuple(true, CalculateRadiusOnPhase_Static(mass, tau));
+}
+
+
 /*
  * Calculate the radius at the end of the helium main sequence
  *
@@ -88,6 +88,8 @@ protected:
 
             double          CalculateRadialExtentConvectiveEnvelope() const                             { return BaseStar::CalculateRadialExtentConvectiveEnvelope(); }         // HeMS stars don't have a convective envelope
 
+            std::tuple<bool, double> CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0) const;
+
             double          CalculateRadiusAtPhaseEnd(const double p_Mass) const                        { return CalculateRadiusAtPhaseEnd_Static(p_Mass); }
             double          CalculateRadiusAtPhaseEnd() const                                           { return CalculateRadiusAtPhaseEnd(m_Mass); }                           // Use class member variables
     static  double          CalculateRadiusAtPhaseEnd_Static(const double p_Mass);
@@ -0,0 +1,282 @@
+// gsl includes
+#include <gsl/gsl_cdf.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "KickSampler.h"
+#include "Options.h"
+
+KickSampler* KickSampler::m_Instance = nullptr;
+
+
+KickSampler* KickSampler::Instance() {
+
+    if (!m_Instance) {
+        m_Instance = new KickSampler();
+    }
+    return m_Instance;
+}
+
+
+/*
+ * Initialise the kick sampler
+ *
+ * Reads the kick sampling mode and, unless the mode is EXACT, builds the inverse-CDF tables.
+ * In VALIDATE mode the tables are also checked against the exact inverses.
+ *
+ * Called from main() before evolution starts - the inverse-CDF functions call it if it has
+ * not been called.
+ *
+ *
+ * void Initialise()
+ */
+void KickSampler::Initialise() {
+
+    m_Mode        = OPTIONS->KickSampling();
+    m_Initialised = true;
+
+    if (m_Mode == KICK_SAMPLING::EXACT) return;                                                     // no tables needed
+
+    m_MaxwellMedian = MaxwellInverseCDFExact(0.5);
+
+    m_MaxwellLower  = TabulatedFunction::TabulateMonotone([](const double p_X) { return std::cbrt(MaxwellCDF(p_X)); },
+                                                          0.0, m_MaxwellMedian, KICK_SAMPLING_TABLE_TOLERANCE);
+
+    m_MaxwellUpper  = TabulatedFunction::TabulateMonotone([](const double p_X) { return -std::log(MaxwellSurvival(p_X)); },
+                                                          m_MaxwellMedian, 12.0, KICK_SAMPLING_TABLE_TOLERANCE);     // survival function ~ 1.0E-30 at 12 sigma
+
+    m_GaussianLower = TabulatedFunction::TabulateMonotone([](const double p_X) { return std::log(0.5 * std::erfc(-p_X / M_SQRT2)); },
+                                                          -9.0, 0.0, KICK_SAMPLING_TABLE_TOLERANCE);                 // CDF ~ 1.0E-19 at -9 sigma
+
+    if (m_Mode == KICK_SAMPLING::VALIDATE) CheckTables();
+}
+
+
+/*
+ * CDF of the unit Maxwellian (chi distribution with three degrees of freedom)
+ *
+ * CDF(x) = erf(x / sqrt(2)) - sqrt(2 / pi) x exp(-x^2 / 2), with the leading terms of its series for
+ * small x (where the two terms cancel)
+ *
+ *
+ * double MaxwellCDF(const double p_X)
+ *
+ * @param   [IN]    p_X                         Value at which to evaluate the CDF
+ * @return                                      CDF
+ */
+double KickSampler::MaxwellCDF(const double p_X) {
+
+    if (p_X <= 0.0) return 0.0;
+
+    double x2 = p_X * p_X;
+
+    return p_X < 1.0E-2
+            ? SQRT_M_2_PI * p_X * x2 * ((1.0 / 3.0) - (x2 / 10.0) + (x2 * x2 / 56.0))
+            : std::erf(p_X / M_SQRT2) - (SQRT_M_2_PI * p_X * std::exp(-0.5 * x2));
+}
+
+
+/*
+ * Survival function (1 - CDF) of the unit Maxwellian, accurate in the tail
+ *
+ *
+ * double MaxwellSurvival(const double p_X)
+ *
+ * @param   [IN]    p_X                         Value at which to evaluate the survival function
+ * @return                                      1 - CDF
+ */
+double KickSampler::MaxwellSurvival(const double p_X) {
+    return p_X <= 0.0 ? 1.0 : std::erfc(p_X / M_SQRT2) + (SQRT_M_2_PI * p_X * std::exp(-0.5 * p_X * p_X));
+}
+
+
+/*
+ * Exact inverse CDFs (GSL) - unit Maxwellian and standard normal
+ *
+ * A Maxwellian is a chi distribution with three degrees of freedom
+ */
+double KickSampler::MaxwellInverseCDFExact(const double p_U)  { return std::sqrt(gsl_cdf_chisq_Pinv(p_U, 3)); }
+double KickSampler::GaussianInverseCDFExact(const double p_U) { return gsl_cdf_gaussian_Pinv(p_U, 1.0); }
+
+
+/*
+ * Tabulated inverse CDF of the unit Maxwellian
+ *
+ * Falls back to the exact inverse beyond the end of the table
+ *
+ *
+ * double MaxwellInverseCDFTabulated(const double p_U)
+ *
+ * @param   [IN]    p_U                         Uniform random number in [0, 1]
+ * @return                                      Inverse CDF
+ */
+double KickSampler::MaxwellInverseCDFTabulated(const double p_U) const {
+
+    if (p_U <= 0.5) return m_MaxwellLower.InverseInterpolate(std::cbrt(std::max(p_U, 0.0)));
+
+    double y = -std::log(1.0 - p_U);                                                                // 1 - u exact for u >= 0.5
+
+    return y < m_MaxwellUpper.YAtXMax() ? m_MaxwellUpper.InverseInterpolate(y) : MaxwellInverseCDFExact(p_U);
+}
+
+
+/*
+ * Tabulated inverse CDF of the standard normal distribution
+ *
+ * Falls back to the exact inverse beyond the ends of the table
+ *
+ *
+ * double GaussianInverseCDFTabulated(const double p_U)
+ *
+ * @param   [IN]    p_U                         Uniform random number in [0, 1]
+ * @return                                      Inverse CDF
+ */
+double KickSampler::GaussianInverseCDFTabulated(const double p_U) const {
+
+    bool   upper = p_U > 0.5;
+    double u     = upper ? 1.0 - p_U : p_U;                                                         // 1 - u exact for u >= 0.5
+    double y     = u > 0.0 ? std::log(u) : -HUGE_VAL;
+
+    if (y <= m_GaussianLower.YAtXMin()) return GaussianInverseCDFExact(p_U);                        // beyond the table
+
+    double x = m_GaussianLower.InverseInterpolate(y);
+    return upper ? -x : x;
+}
+
+
+/*
+ * Inverse CDF of the unit Maxwellian - per the kick sampling mode
+ *
+ *
+ * double MaxwellInverseCDF(const double p_U)
+ *
+ * @param   [IN]    p_U                         Uniform random number in [0, 1]
+ * @return                                      Inverse CDF
+ */
+double KickSampler::MaxwellInverseCDF(const double p_U) {
+
+    if (!m_Initialised) Initialise();
+
+    switch (m_Mode) {
+        case KICK_SAMPLING::TABULATED: return MaxwellInverseCDFTabulated(p_U);
+        case KICK_SAMPLING::EXACT    : return MaxwellInverseCDFExact(p_U);
+        default: {                                                                                  // VALIDATE
+            double exact = MaxwellInverseCDFExact(p_U);
+            Record(m_MaxwellValidation, exact, MaxwellInverseCDFTabulated(p_U));
+            return exact;
+        }
+    }
+}
+
+
+/*
+ * Inverse CDF of the standard normal distribution - per the kick sampling mode
+ *
+ *
+ * double GaussianInverseCDF(const double p_U)
+ *
+ * @param   [IN]    p_U                         Uniform random number in [0, 1]
+ * @return                                      Inverse CDF
+ */
+double KickSampler::GaussianInverseCDF(const double p_U) {
+
+    if (!m_Initialised) Initialise();
+
+    switch (m_Mode) {
+        case KICK_SAMPLING::TABULATED: return GaussianInverseCDFTabulated(p_U);
+        case KICK_SAMPLING::EXACT    : return GaussianInverseCDFExact(p_U);
+        default: {                                                                                  // VALIDATE
+            double exact = GaussianInverseCDFExact(p_U);
+            Record(m_GaussianValidation, exact, GaussianInverseCDFTabulated(p_U));
+            return exact;
+        }
+    }
+}
+
+
+/*
+ * Record the difference between a tabulated draw and the corresponding exact draw (VALIDATE mode)
+ *
+ * The statistics are accumulated as the draws are made - the draws are not kept.
+ * Infinite draws (u = 0 or 1) are not recorded.
+ *
+ *
+ * void Record(ValidationT& p_Validation, const double p_Exact, const double p_Tabulated)
+ *
+ * @param   [IN/OUT]    p_Validation            The comparisons for the distribution
+ * @param   [IN]        p_Exact                 Exact draw
+ * @param   [IN]        p_Tabulated             Tabulated draw
+ */
+void KickSampler::Record(ValidationT& p_Validation, const double p_Exact, const double p_Tabulated) {
+
+    if (!std::isfinite(p_Exact) || !std::isfinite(p_Tabulated)) return;
+
+    double difference         = std::abs(p_Tabulated - p_Exact);
+    double relativeDifference = difference / std::max(1.0, std::abs(p_Exact));
+
+    p_Validation.draws++;
+    p_Validation.sumRelativeDifference += relativeDifference;
+    p_Validation.maxAbsoluteDifference  = std::max(p_Validation.maxAbsoluteDifference, difference);
+    p_Validation.maxRelativeDifference  = std::max(p_Validation.maxRelativeDifference, relativeDifference);
+}
+
+
+/*
+ * Check the tables against the exact inverse CDFs on a grid of uniforms (VALIDATE mode)
+ *
+ * The grid is uniform in u, plus geometric grids towards u = 0 and u = 1 (to check the tails).
+ *
+ *
+ * void CheckTables()
+ */
+void KickSampler::CheckTables() {
+
+    std::vector<double> grid;
+
+    const int points = 100000;
+    for (int i = 1; i < points; i++) grid.push_back(static_cast<double>(i) / points);
+    for (double u = 1.0E-5; u > 1.0E-16; u *= 0.9) {
+        grid.push_back(u);
+        grid.push_back(1.0 - u);
+    }
+
+    for (auto u : grid) {
+        double maxwell  = MaxwellInverseCDFExact(u);
+        double gaussian = GaussianInverseCDFExact(u);
+        m_MaxwellValidation.gridMaxRelativeDifference  = std::max(m_MaxwellValidation.gridMaxRelativeDifference,
+                                                                  std::abs(MaxwellInverseCDFTabulated(u) - maxwell) / std::max(1.0, std::abs(maxwell)));
+        m_GaussianValidation.gridMaxRelativeDifference = std::max(m_GaussianValidation.gridMaxRelativeDifference,
+                                                                  std::abs(GaussianInverseCDFTabulated(u) - gaussian) / std::max(1.0, std::abs(gaussian)));
+    }
+}
+
+
+/*
+ * Summary of the kick sampler's comparisons, for the run details file (VALIDATE mode)
+ *
+ *
+ * std::string Summary()
+ *
+ * @return                                      Multi-line summary (empty unless VALIDATE mode)
+ */
+std::string KickSampler::Summary() const {
+
+    if (m_Mode != KICK_SAMPLING::VALIDATE) return "";
+
+    std::ostringstream ss;
+    ss << "\nKick sampling validation (tabulated vs exact inverse CDFs, tolerance " << KICK_SAMPLING_TABLE_TOLERANCE << "):\n";
+
+    for (auto &distribution : { std::make_pair(std::string("Maxwellian"), &m_MaxwellValidation), std::make_pair(std::string("Gaussian  "), &m_GaussianValidation) }) {
+        const ValidationT& validation = *distribution.second;
+        ss << "  " << distribution.first << ": table check max relative difference = " << validation.gridMaxRelativeDifference
+           << "; draws = " << validation.draws
+           << ", max absolute difference = " << validation.maxAbsoluteDifference
+           << ", max relative difference = " << validation.maxRelativeDifference
+           << ", mean relative difference = " << (validation.draws > 0 ? validation.sumRelativeDifference / validation.draws : 0.0) << "\n";
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,111 @@
+#ifndef __KickSampler_h__
+#define __KickSampler_h__
+
+#define KICK_SAMPLER KickSampler::Instance()
+
+#include <string>
+
+#include "constants.h"
+#include "typedefs.h"
+#include "TabulatedFunction.h"
+
+
+/*
+ * KickSampler Singleton - fast inverse CDFs for supernova kick magnitudes
+ *
+ * The MAXWELLIAN (and MULLER2016MAXWELLIAN) kick magnitude distributions need the inverse CDF of the
+ * chi distribution with three degrees of freedom, and the MULLERMANDEL distribution the inverse CDF of
+ * the standard normal distribution.  GSL evaluates both iteratively (gsl_cdf_chisq_Pinv(),
+ * gsl_cdf_gaussian_Pinv()).  This sampler tabulates both once per run, in coordinates in which they are
+ * close to linear, and inverts them by interpolation on the tables:
+ *
+ *     Maxwellian, u <= 0.5: x(u^(1/3))          (x ~ u^(1/3) as u -> 0)
+ *     Maxwellian, u >  0.5: x(-ln(1 - u))       (1 - u is exact in double precision for u >= 0.5)
+ *     Gaussian,   u <= 0.5: x(ln u)             and x(u) = -x(1 - u) for u > 0.5
+ *
+ * The tables are refined until the interpolated inverse is within KICK_SAMPLING_TABLE_TOLERANCE x max(1, |x|)
+ * of the exact inverse (see TabulatedFunction::TabulateMonotone()).  Uniforms beyond the ends of the tables
+ * (probability < 1.0E-16) are inverted exactly.
+ *
+ * Program option --kick-sampling selects the mode:
+ *
+ *     TABULATED: inverse CDFs from the tables
+ *     EXACT    : inverse CDFs from GSL, as before the tables were introduced (default - so seeded runs
+ *                reproduce earlier results exactly)
+ *     VALIDATE : inverse CDFs from GSL (so results are unchanged), but every draw is also made from the
+ *                tables, and the differences between the two draws (same uniform) are accumulated as the
+ *                draws are made - the number of draws, and the maximum and mean differences, are written
+ *                to the run details file.  The tables are also checked against GSL on a grid of uniforms
+ *                at initialisation.
+ */
+
+class KickSampler {
+
+private:
+
+    // Comparison of tabulated and exact draws for one distribution (VALIDATE mode)
+    typedef struct Validation {
+        unsigned long int   draws;                                                          // number of draws compared
+        double              sumRelativeDifference;                                          // sum of |tabulated - exact| / max(1, |exact|)
+        double              maxAbsoluteDifference;                                          // maximum |tabulated - exact|
+        double              maxRelativeDifference;                                          // maximum |tabulated - exact| / max(1, |exact|)
+        double              gridMaxRelativeDifference;                                      // as above, on the grid of uniforms checked at initialisation
+    } ValidationT;
+
+    KickSampler() {
+        m_Initialised   = false;
+        m_Mode          = KICK_SAMPLING::EXACT;
+        m_MaxwellMedian = 0.0;
+        for (auto validation : { &m_MaxwellValidation, &m_GaussianValidation }) {
+            validation->draws                     = 0;
+            validation->sumRelativeDifference     = 0.0;
+            validation->maxAbsoluteDifference     = 0.0;
+            validation->maxRelativeDifference     = 0.0;
+            validation->gridMaxRelativeDifference = 0.0;
+        }
+    };
+    KickSampler(KickSampler const&) = delete;
+    KickSampler& operator = (KickSampler const&) = delete;
+
+    static KickSampler* m_Instance;
+
+    bool                m_Initialised;                                                      // tables built?
+    KICK_SAMPLING       m_Mode;                                                             // kick sampling mode
+
+    double              m_MaxwellMedian;                                                    // median of the unit Maxwellian (u = 0.5) - where the two Maxwellian tables meet
+    TabulatedFunction   m_MaxwellLower;                                                     // unit Maxwellian, (x, CDF(x)^(1/3)),  x in [0, median]
+    TabulatedFunction   m_MaxwellUpper;                                                     // unit Maxwellian, (x, -ln(1 - CDF(x))), x in [median, ...]
+    TabulatedFunction   m_GaussianLower;                                                    // standard normal, (x, ln(CDF(x))), x in [..., 0]
+
+    ValidationT         m_MaxwellValidation;                                                // VALIDATE mode comparisons - Maxwellian
+    ValidationT         m_GaussianValidation;                                               // VALIDATE mode comparisons - Gaussian
+
+    static double       MaxwellCDF(const double p_X);
+    static double       MaxwellSurvival(const double p_X);
+    static double       MaxwellInverseCDFExact(const double p_U);
+    static double       GaussianInverseCDFExact(const double p_U);
+
+    double              MaxwellInverseCDFTabulated(const double p_U) const;
+    double              GaussianInverseCDFTabulated(const double p_U) const;
+
+    static void         Record(ValidationT& p_Validation, const double p_Exact, const double p_Tabulated);
+
+    void                CheckTables();
+
+
+public:
+
+    static KickSampler* Instance();
+
+    void   Initialise();
+
+    KICK_SAMPLING Mode() const                                                              { return m_Mode; }
+
+    double MaxwellInverseCDF(const double p_U);
+    double GaussianInverseCDF(const double p_U);
+
+    std::string Summary() const;
+};
+
+
+#endif // __KickSampler_h__
@@ -7,6 +7,11 @@
 // JR: todo: clean up use of Squawk() vs SAY() etc
 
 #include "Log.h"
+#include "AdaptiveSampler.h"
+#include "KickSampler.h"
+#include "CoalescenceTime.h"
+#include "TrackLibrary.h"
+#include "BaseBinaryStar.h"
 
 Log* Log::m_Instance = nullptr;
 
@@ -107,6 +112,7 @@ bool Log::OpenHDF5RunDetailsFile(const string p_Filename) {
             //      - CPU (clock) time (DOUBLE: seconds)
             //      - Wall (elapsed) time (STRING: 'hhhh:mm:ss')
             //      - Actual random seed used (UNSIGNED LONG INT)
+            //      - HDF5 IO buffer memory high-water mark (UNSIGNED LONG INT: bytes - 0 if no IO buffer memory budget)
             //
             // We also create columns (datasets) for each of the program options.
             //
@@ -134,8 +140,9 @@ bool Log::OpenHDF5RunDetailsFile(const string p_Filename) {
                 size_t chunkSize = HDF5_MINIMUM_CHUNK_SIZE;                                                             // chunk size
                 size_t IOBufSize = OPTIONS->HDF5BufferSize() * chunkSize;                                               // IO buffer size
 
-                m_Run_Details_H5_File.chunkSize = chunkSize;                                                            // record chunk size for file
-                m_Run_Details_H5_File.IOBufSize = IOBufSize;                                                            // record IO buf size for file
+                m_Run_Details_H5_File.chunkSize    = chunkSize;                                                         // record chunk size for file
+                m_Run_Details_H5_File.IOBufSize    = IOBufSize;                                                         // record IO buf size for file
+                m_Run_Details_H5_File.IOBufSizeMax = IOBufSize;                                                         // record maximum IO buf size for file
 
                 // preamble/stats datasets
 
@@ -281,8 +288,44 @@ void Log::Start(const string              p_LogBasePath,
 
         m_OptionDetails = OPTIONS->CmdLineOptionsDetails();                                                                 // get commandline option details
 
+        m_HDF5BufferBudget             = OPTIONS->HDF5BufferMemory() * 1024 * 1024;                                         // HDF5 IO buffer memory budget (bytes)
+        m_HDF5BufferedBytes            = 0;                                                                                 // HDF5 IO buffer memory used
+        m_HDF5BufferHighWater          = 0;                                                                                 // HDF5 IO buffer memory high-water mark
+        m_HDF5BufferHighWaterByLogfile = {};                                                                                // HDF5 IO buffer memory high-water mark per logfile
+        m_HDF5BudgetFlushes            = 0;                                                                                 // HDF5 logfile flushes forced by the IO buffer memory budget
+
         m_Enabled = UpdateAllLogfileRecordSpecs();                                                                          // update all logfile record specifications - disable logging upon failure
 
+        auto addProperty = [](ANY_PROPERTY_VECTOR& p_Rec, const T_ANY_PROPERTY p_Property) {                               // add property to record specification if not already there
+            if (std::find(p_Rec.begin(), p_Rec.end(), p_Property) == p_Rec.end()) p_Rec.push_back(p_Property);
+        };
+
+        if (OPTIONS->InitialSampling() == INITIAL_SAMPLING::AIS) {                                                          // adaptive importance sampling?
+            addProperty(m_BSE_SysParms_Rec, BINARY_PROPERTY::IMPORTANCE_WEIGHT);                                            // yes - importance weights are required to use the output
+        }
+
+        if (OPTIONS->KickResamples() > 1) {                                                                                 // kick resampling?
+            for (auto rec : { &m_BSE_SysParms_Rec, &m_BSE_SNE_Rec, &m_BSE_DCO_Rec }) {                                      // yes - branch numbers and weights are required to use the output
+                addProperty(*rec, BINARY_PROPERTY::KICK_RESAMPLE_BRANCH);
+                addProperty(*rec, BINARY_PROPERTY::KICK_RESAMPLE_WEIGHT);
+            }
+        }
+
+        if (OPTIONS->ForkVariations()) {                                                                                    // forked evolution?
+            for (auto rec : { &m_BSE_SysParms_Rec, &m_BSE_SNE_Rec, &m_BSE_DCO_Rec }) {                                      // yes - forks share the seed and id of the binary: variation numbers are required to use the output
+                addProperty(*rec, BINARY_PROPERTY::FORK_VARIATION);
+            }
+        }
+
+        m_StagedRecords.clear();                                                                                            // no staged records
+        m_RetainedRecords.clear();                                                                                          // no retained records
+        m_StageSystemRecords = OPTIONS->StageSystemRecords() || OPTIONS->ForkVariations();                                  // stage all BSE logfile records per system? (forked evolution rewinds staged records)
+        m_SystemsRolledBack  = 0;                                                                                           // no systems rolled back
+        if (m_Enabled) {                                                                                                    // still ok?
+            m_Enabled = CompileLogfilePredicate(OPTIONS->LogfilePredicate(), OPTIONS->LogfilePredicateFiles());             // yes - compile logfile predicate - disable logging upon failure
+            if (!m_Enabled) Squawk("Logging disabled");                                                                     // show disabled warning
+        }
+
         if (m_Enabled) {                                                                                                    // still ok?
                                                                                                                             // yes
             // first create the container folder at p_LogBasePath
@@ -506,6 +549,10 @@ void Log::Stop(std::tuple<int, int> p_ObjectStats) {
                             m_Run_Details_H5_File.dataSets[dSetIdx].buf.push_back(actualRandomSeed);                                    // add write data to buffer
                             break;
 
+                        case RUN_DETAILS_COLUMNS::HDF5_BUFFER_HIGH_WATER_MARK:                                                          // HDF5_Buffer_High_Water_Mark (bytes)
+                            m_Run_Details_H5_File.dataSets[dSetIdx].buf.push_back((unsigned long int)m_HDF5BufferHighWater);            // add write data to buffer
+                            break;
+
                         default:                                                                                                        // unknown dataset - how did that happen?
                             Squawk("ERROR: Invalid HDF5 dataset with name " + h5DatasetName);                                           // announce error
                             ok = false;                                                                                                 // fail
@@ -616,6 +663,30 @@ void Log::Stop(std::tuple<int, int> p_ObjectStats) {
 
             m_RunDetailsFile << "Wall time  = " << wallTime << " (hhhh:mm:ss)" << std::endl;                                            // wall time 
 
+            if (m_LogfileType == LOGFILETYPE::HDF5 && m_HDF5BufferBudget > 0) {                                                        // logging to HDF5 files with a memory budget?
+                                                                                                                                        // yes - record HDF5 IO buffer memory usage
+                m_RunDetailsFile << "\nHDF5 IO buffer high-water mark = " << m_HDF5BufferHighWater << " bytes";                          // high-water mark for all logfiles
+                m_RunDetailsFile << " (budget = " << m_HDF5BufferBudget << " bytes, "                                                   // budget
+                                 << m_HDF5BudgetFlushes << " budget-forced flushes)" << std::endl;                                      // and number of flushes forced by budget
+                for (auto& iter : m_HDF5BufferHighWaterByLogfile) {                                                                     // high-water mark per logfile
+                    m_RunDetailsFile << "    " << std::get<0>(LOGFILE_DESCRIPTOR.at(iter.first)) << " = " << iter.second << " bytes" << std::endl;
+                }
+            }
+
+            if (m_StageSystemRecords) {                                                                                                 // per-system record staging?
+                m_RunDetailsFile << "\nSystems rolled back (evolution error) = " << m_SystemsRolledBack << std::endl;                   // yes - record number of systems rolled back
+            }
+
+            if (SAMPLER->Enabled()) m_RunDetailsFile << SAMPLER->Summary();                                                             // adaptive importance sampling summary
+            m_RunDetailsFile << KICK_SAMPLER->Summary();                                                                                // kick sampling validation summary (empty unless --kick-sampling VALIDATE)
+            m_RunDetailsFile << COALESCENCE_TIME->Summary();                                                                            // coalescence time validation summary (empty unless --coalescence-time-kernel VALIDATE)
+            m_RunDetailsFile << TRACK_LIBRARY->Summary();                                                                               // track library summary (empty unless --track-library-mode CREATE or INTERPOLATE)
+            if (OPTIONS->EvolutionMode() == EVOLUTION_MODE::SSE) m_RunDetailsFile << Star::TimestepSummary();                           // SSE timesteps and retries summary
+            if (OPTIONS->EvolutionMode() == EVOLUTION_MODE::BSE) m_RunDetailsFile << BaseBinaryStar::MassTransferOrbitSummary();        // mass transfer orbit validation summary (empty unless --mass-transfer-orbit-integrator VALIDATE)
+            if (OPTIONS->EvolutionMode() == EVOLUTION_MODE::BSE) m_RunDetailsFile << BaseBinaryStar::DonorRadiusResponseSummary();      // donor radius response validation summary (empty unless --mass-transfer-donor-radius-response VALIDATE)
+            if (OPTIONS->EvolutionMode() == EVOLUTION_MODE::BSE) m_RunDetailsFile << BaseBinaryStar::NonInteractingFastPathSummary();   // non-interacting fast path summary (empty unless --non-interacting-fast-path)
+            if (OPTIONS->EvolutionMode() == EVOLUTION_MODE::BSE) m_RunDetailsFile << BaseBinaryStar::CullingSummary();                  // culling summary (empty unless --culling-mode DCO)
+
             // add commandline options
             // moved this code here from Options.cpp
             // have to add a small kludge here to get it to look the same (someone might be relying on format)
@@ -1373,21 +1444,39 @@ bool Log::Write_(const int p_LogfileId, const std::vector<COMPAS_VARIABLE_TYPE>
             }
             else {
 
+                if (!p_Flush) {                                                                                             // flush only?
+                                                                                                                            // no - add write data to buffers
+                    size_t recordBytes = 0;                                                                                 // memory used by the record
+                    for (size_t idx = 0; idx < m_Logfiles[p_LogfileId].h5File.dataSets.size(); idx++) {                     // for each dataset
+                        if (m_Logfiles[p_LogfileId].h5File.dataSets[idx].dataSetId >= 0) {                                  // dataset open?
+                            m_Logfiles[p_LogfileId].h5File.dataSets[idx].buf.push_back(p_LogRecordValues[idx]);             // yes - add write data to buffer
+                            recordBytes += sizeof(COMPAS_VARIABLE_TYPE);
+                        }
+                    }
+                    m_Logfiles[p_LogfileId].h5File.recordsWritten++;                                                        // one more record written
+                    if (m_HDF5BufferBudget > 0) UpdateHDF5BufferedBytes(p_LogfileId, recordBytes, 0);                       // track IO buffer memory usage if budget specified
+                }
+
                 for (size_t idx = 0; idx < m_Logfiles[p_LogfileId].h5File.dataSets.size(); idx++) {                         // for each dataset
 
                     hid_t dSet  = m_Logfiles[p_LogfileId].h5File.dataSets[idx].dataSetId;                                   // dataset id
 
                     if (dSet >= 0) {                                                                                        // dataset open?
                                                                                                                             // yes
-                        if (!p_Flush) {                                                                                     // flush only?
-                            m_Logfiles[p_LogfileId].h5File.dataSets[idx].buf.push_back(p_LogRecordValues[idx]);             // no - add write data to buffer
-                        }
+                        size_t bufSize = m_Logfiles[p_LogfileId].h5File.dataSets[idx].buf.size();                           // values buffered
 
-                        if ((m_Logfiles[p_LogfileId].h5File.dataSets[idx].buf.size() >= m_Logfiles[p_LogfileId].h5File.IOBufSize) || p_Flush) { // need to write?
+                        if ((bufSize >= m_Logfiles[p_LogfileId].h5File.IOBufSize) || p_Flush) {                             // need to write?
                             ok = WriteHDF5_(m_Logfiles[p_LogfileId].h5File, m_Logfiles[p_LogfileId].name, idx);             // do the write 
+
+                            if (m_HDF5BufferBudget > 0) {                                                                   // tracking IO buffer memory usage?
+                                size_t written = bufSize - m_Logfiles[p_LogfileId].h5File.dataSets[idx].buf.size();         // yes - values written (buffer released)
+                                UpdateHDF5BufferedBytes(p_LogfileId, 0, written * sizeof(COMPAS_VARIABLE_TYPE));
+                            }
                         }
                     }
                 }
+
+                if (!p_Flush) EnforceHDF5BufferBudget();                                                                    // stay within IO buffer memory budget
             }
         }
     }
@@ -1410,6 +1499,184 @@ bool Log::Write_(const int p_LogfileId, const std::vector<COMPAS_VARIABLE_TYPE>
 }
 
 
+/*
+ * Update the memory used by the HDF5 IO buffers, and the high-water marks
+ *
+ * Keeps a running count of the memory used by the IO buffers of each HDF5 logfile, and of all
+ * open HDF5 logfiles.  Called by Write_() when a record is added to the IO buffers of a logfile
+ * (p_Added), and when buffered values are written to the file (p_Released).  Only called if an
+ * IO buffer memory budget is specified.
+ *
+ * The memory used is estimated as the number of buffered values multiplied by sizeof(COMPAS_VARIABLE_TYPE).
+ * The heap memory used by string values is not included.
+ *
+ *
+ * void UpdateHDF5BufferedBytes(const int p_LogfileId, const size_t p_Added, const size_t p_Released)
+ *
+ * @param   [IN]    p_LogfileId                 The id of the HDF5 log file
+ * @param   [IN]    p_Added                     Memory added to the IO buffers of the logfile (bytes)
+ * @param   [IN]    p_Released                  Memory released from the IO buffers of the logfile (bytes)
+ */
+void Log::UpdateHDF5BufferedBytes(const int p_LogfileId, const size_t p_Added, const size_t p_Released) {
+
+    size_t &logfileBytes = m_Logfiles[p_LogfileId].h5File.bufferedBytes;                                                    // memory used by this logfile
+
+    logfileBytes        += p_Added;
+    logfileBytes        -= std::min(logfileBytes, p_Released);
+    m_HDF5BufferedBytes += p_Added;
+    m_HDF5BufferedBytes -= std::min(m_HDF5BufferedBytes, p_Released);
+
+    if (p_Added > 0) {                                                                                                      // buffers grew?
+        size_t &logfileHighWater = m_HDF5BufferHighWaterByLogfile[m_Logfiles[p_LogfileId].logfiletype];                     // yes - high-water mark for this logfile - created if necessary
+        logfileHighWater         = std::max(logfileHighWater, logfileBytes);
+        m_HDF5BufferHighWater    = std::max(m_HDF5BufferHighWater, m_HDF5BufferedBytes);                                    // high-water mark for all logfiles
+    }
+}
+
+
+/*
+ * Share the HDF5 IO buffer memory budget amongst the open HDF5 logfiles
+ *
+ * The budget is shared in proportion to the number of records written to each logfile (a proxy for
+ * the write rate of the logfile).  The IO buffer size of each logfile is set to the number of records
+ * that fit in its share of the budget, but is never less than 1 record, or more than the maximum IO
+ * buffer size for the logfile (--hdf5-buffer-size chunks).
+ *
+ *
+ * void RebalanceHDF5Buffers()
+ */
+void Log::RebalanceHDF5Buffers() {
+
+    if (m_HDF5BufferBudget == 0) return;                                                                                    // no budget - nothing to do
+
+    unsigned long int totalRecords = 0;
+    for (size_t id = 0; id < m_Logfiles.size(); id++) {                                                                     // count records written to all open HDF5 logfiles
+        if (IsActiveId(id) && m_Logfiles[id].filetype == LOGFILETYPE::HDF5) totalRecords += m_Logfiles[id].h5File.recordsWritten;
+    }
+    if (totalRecords == 0) return;                                                                                          // nothing written yet
+
+    for (size_t id = 0; id < m_Logfiles.size(); id++) {                                                                     // for each open HDF5 logfile
+        if (IsActiveId(id) && m_Logfiles[id].filetype == LOGFILETYPE::HDF5 && !m_Logfiles[id].h5File.dataSets.empty()) {
+
+            double share          = (double)m_HDF5BufferBudget * (double)m_Logfiles[id].h5File.recordsWritten / (double)totalRecords; // share of budget (bytes)
+            size_t recordBytes    = m_Logfiles[id].h5File.dataSets.size() * sizeof(COMPAS_VARIABLE_TYPE);                   // memory used by one buffered record
+            size_t recordsInShare = (size_t)(share / (double)recordBytes);                                                  // records that fit in share of budget
+
+            m_Logfiles[id].h5File.IOBufSize = std::max((size_t)1, std::min(recordsInShare, m_Logfiles[id].h5File.IOBufSizeMax));
+        }
+    }
+}
+
+
+/*
+ * Keep the memory used by the HDF5 IO buffers within the budget
+ *
+ * If the memory used by the IO buffers of all open HDF5 logfiles exceeds the budget, the budget is
+ * re-shared amongst the open logfiles (see RebalanceHDF5Buffers()), then the logfiles with the largest
+ * IO buffers are flushed, largest first, until the memory used is within the budget.
+ *
+ *
+ * void EnforceHDF5BufferBudget()
+ */
+void Log::EnforceHDF5BufferBudget() {
+
+    if (m_HDF5BufferBudget == 0) return;                                                                                    // no budget - nothing to do
+
+    if (m_HDF5BufferedBytes <= m_HDF5BufferBudget) return;                                                                  // within budget - nothing to do
+
+    RebalanceHDF5Buffers();                                                                                                 // re-share the budget
+
+    while (m_HDF5BufferedBytes > m_HDF5BufferBudget) {                                                                      // flush largest buffers first until within budget
+
+        int    largestId    = -1;
+        size_t largestBytes = 0;
+        for (size_t id = 0; id < m_Logfiles.size(); id++) {                                                                 // find logfile with largest buffers
+            if (IsActiveId(id) && m_Logfiles[id].filetype == LOGFILETYPE::HDF5 && m_Logfiles[id].h5File.bufferedBytes > largestBytes) {
+                largestId    = id;
+                largestBytes = m_Logfiles[id].h5File.bufferedBytes;
+            }
+        }
+        if (largestId < 0) break;                                                                                           // nothing left to flush
+
+        if (!Flush_(largestId) || m_Logfiles[largestId].h5File.bufferedBytes >= largestBytes) {                             // flush the logfile (updates memory used) - ok?
+            Squawk(ERR_MSG(ERROR::FILE_WRITE_ERROR) + " while flushing logfile " + m_Logfiles[largestId].name);             // no - show warning
+            break;                                                                                                          // and stop
+        }
+        m_HDF5BudgetFlushes++;
+    }
+}
+
+
+/*
+ * Write (commit) or discard (roll back) staged records
+ *
+ * Records are staged by LogStandardRecord() while the binary is evolving if per-system record staging
+ * is enabled, or if the logfile is gated by the logfile predicate.  This function should be called once
+ * evolution of the binary is complete (and the logfile predicate, if any, has been evaluated):
+ *
+ *    - if p_Commit is false (e.g. evolution ended in error) all staged records are discarded, except
+ *      the system parameters record, which is always written (it records the error)
+ *    - otherwise staged records are written to their logfiles
+ *
+ * Either way, records for logfiles gated by the logfile predicate are discarded if p_PredicateSatisfied is false.
+ *
+ * Records are written in the order in which they were staged.  Records for CSV, TSV, and TXT files
+ * without timestamps or labels (e.g. standard logfiles) are joined and written to each logfile in a
+ * single write.  Either way, there are no staged records on return.
+ *
+ *
+ * bool CommitStagedRecords(const bool p_Commit, const bool p_PredicateSatisfied)
+ *
+ * @param   [IN]    p_Commit                    Boolean indicating whether the staged records should be written (true) or discarded (false - except the system parameters record)
+ * @param   [IN]    p_PredicateSatisfied        Boolean indicating whether the logfile predicate was satisfied (default true)
+ * @return                                      Boolean indicating whether all staged records were written successfully (true if discarded)
+ */
+bool Log::CommitStagedRecords(const bool p_Commit, const bool p_PredicateSatisfied) {
+
+    bool result = true;
+
+    if (!p_Commit && !m_StagedRecords.empty()) m_SystemsRolledBack++;                                                       // count systems rolled back
+
+    std::map<int, string> batched;                                                                                          // batched text records per logfile id
+
+    for (auto &staged : m_StagedRecords) {                                                                                  // for each staged record
+
+        if (staged.gated && !p_PredicateSatisfied) continue;                                                                // gated by predicate and predicate not satisfied - discard
+
+        if (!p_Commit && m_Logfiles[staged.id].logfiletype != LOGFILE::BSE_SYSTEM_PARAMETERS) continue;                     // rolled back - discard all but the system parameters record
+
+        bool ok = true;
+        if (m_Logfiles[staged.id].filetype == LOGFILETYPE::HDF5) {                                                          // HDF5 file?
+            ok = Put_(staged.id, staged.values);                                                                            // yes - write the record (to the dataset IO buffers)
+        }
+        else if (m_Logfiles[staged.id].timestamp || m_Logfiles[staged.id].label) {                                          // timestamps or labels?
+            ok = Put_(staged.id, staged.record);                                                                            // yes - write the record
+        }
+        else {                                                                                                              // CSV, TSV, or TXT file without timestamps or labels
+            string& batch = batched[staged.id];                                                                             // batch the record
+            if (!batch.empty()) batch += "\n";
+            batch += staged.record;
+        }
+
+        if (!ok) {                                                                                                          // written ok?
+            Squawk(ERR_MSG(ERROR::FILE_WRITE_ERROR) + " while writing to logfile " + m_Logfiles[staged.id].name);           // no - show warning
+            result = false;
+        }
+    }
+
+    for (auto &batch : batched) {                                                                                           // write batched records - one write per logfile
+        if (!Put_(batch.first, batch.second)) {                                                                             // written ok?
+            Squawk(ERR_MSG(ERROR::FILE_WRITE_ERROR) + " while writing to logfile " + m_Logfiles[batch.first].name);         // no - show warning
+            result = false;
+        }
+    }
+
+    m_StagedRecords.clear();                                                                                                // no staged records
+
+    return result;
+}
+
+
 /*
  * Write a minimally formatted record to the specified log file.
  *
@@ -2553,8 +2820,11 @@ LogfileDetailsT Log::StandardLogFileDetails(const LOGFILE p_Logfile, const strin
 
                             size_t IOBufSize = OPTIONS->HDF5BufferSize() * chunkSize;                                                           // IO buffer size
                 
-                            m_Logfiles[fileDetails.id].h5File.chunkSize = chunkSize;                                                            // record chunk size for file
-                            m_Logfiles[fileDetails.id].h5File.IOBufSize = IOBufSize;                                                            // record IO buf size for file
+                            m_Logfiles[fileDetails.id].h5File.chunkSize      = chunkSize;                                                       // record chunk size for file
+                            m_Logfiles[fileDetails.id].h5File.IOBufSize      = IOBufSize;                                                       // record IO buf size for file
+                            m_Logfiles[fileDetails.id].h5File.IOBufSizeMax   = IOBufSize;                                                       // record maximum IO buf size for file
+                            m_Logfiles[fileDetails.id].h5File.recordsWritten = 0;                                                               // no records written yet
+                            m_Logfiles[fileDetails.id].h5File.bufferedBytes  = 0;                                                               // nothing buffered yet
 
                             m_Logfiles[fileDetails.id].h5File.dataSets.push_back({-1, -1, TYPENAME::NONE, {}});                                 // create new dataset
 
@@ -3369,3 +3639,346 @@ bool Log::UpdateAllLogfileRecordSpecs() {
 
 	return (error == ERROR::NONE);
 }
+
+
+/*
+ * Compile a predicate
+ *
+ * Compiles a predicate over binary properties (e.g. the logfile predicate - program option
+ * --logfile-predicate) into a Reverse Polish Notation token vector for evaluation with
+ * EvaluatePredicate().  See Log.h for the predicate grammar.
+ *
+ * An empty predicate compiles to an empty token vector (always satisfied).
+ *
+ *
+ * bool CompilePredicate(const string p_Predicate, std::vector<PredicateTokenT>& p_CompiledPredicate)
+ *
+ * @param   [IN]    p_Predicate                 The predicate
+ * @param   [OUT]   p_CompiledPredicate         The compiled predicate (empty if the predicate is empty or could not be compiled)
+ * @return                                      Boolean indicating whether the predicate was compiled successfully
+ */
+bool Log::CompilePredicate(const string p_Predicate, std::vector<PredicateTokenT>& p_CompiledPredicate) {
+
+    p_CompiledPredicate.clear();
+
+    string predicate = p_Predicate;
+    if (utils::trim(predicate).empty()) return true;                                                                        // no predicate - nothing to do
+
+    // split the predicate into tokens
+    // operators and parentheses are tokens in their own right; anything else delimited by
+    // whitespace, operators, or parentheses is an operand (property specifier or number)
+
+    std::vector<string> tokens;
+    const string        opChars = "|&!()<>=";
+    size_t              pos     = 0;
+    while (pos < p_Predicate.size()) {
+        char ch = p_Predicate[pos];
+        if (std::isspace(static_cast<unsigned char>(ch))) {                                                                 // whitespace
+            pos++;
+        }
+        else if (opChars.find(ch) != string::npos) {                                                                        // operator or parenthesis
+            string op2 = p_Predicate.substr(pos, 2);
+            if (op2 == "||" || op2 == "&&" || op2 == "==" || op2 == "!=" || op2 == "<=" || op2 == ">=") {                   // two-character operator
+                tokens.push_back(op2);
+                pos += 2;
+            }
+            else if (ch == '|' || ch == '&' || ch == '=') {                                                                 // unknown operator
+                Squawk("ERROR: Invalid operator '" + op2.substr(0, 1) + "' in predicate: " + p_Predicate);                 // announce error
+                return false;
+            }
+            else {                                                                                                          // single-character operator
+                tokens.push_back(string(1, ch));
+                pos++;
+            }
+        }
+        else {                                                                                                              // operand
+            size_t start = pos;
+            while (pos < p_Predicate.size() && !std::isspace(static_cast<unsigned char>(p_Predicate[pos])) && opChars.find(p_Predicate[pos]) == string::npos) pos++;
+            tokens.push_back(p_Predicate.substr(start, pos - start));
+        }
+    }
+
+    // compile the tokens
+
+    pos = 0;
+    bool ok = CompilePredicateExpression(tokens, pos, p_CompiledPredicate);                                                 // compile
+    if (ok && pos < tokens.size()) {                                                                                        // ok, but tokens remaining?
+        Squawk("ERROR: Unexpected token '" + tokens[pos] + "' in predicate: " + p_Predicate);                              // yes - announce error
+        ok = false;
+    }
+    if (!ok) p_CompiledPredicate.clear();                                                                                   // compiled ok?  no - no predicate
+
+    return ok;
+}
+
+
+/*
+ * Compile the logfile predicate
+ *
+ * Compiles the logfile predicate specified by the user (program option --logfile-predicate) into a
+ * Reverse Polish Notation token vector (m_LogfilePredicate) for evaluation at the end of evolution of
+ * each binary (see EvaluateLogfilePredicate()), and records the logfiles gated by the predicate
+ * (program option --logfile-predicate-files).  See Log.h for the predicate grammar.
+ *
+ * If no predicate is specified there is nothing to compile, and no logfiles are gated.
+ *
+ *
+ * bool CompileLogfilePredicate(const string p_Predicate, const std::vector<string> p_PredicateLogfiles)
+ *
+ * @param   [IN]    p_Predicate                 The logfile predicate
+ * @param   [IN]    p_PredicateLogfiles         Short names of the logfiles gated by the predicate (e.g. BSE_SYSPARMS)
+ *                                              An empty vector indicates all BSE logfiles except BSE_DETAILED
+ * @return                                      Boolean indicating whether the predicate was compiled successfully
+ */
+bool Log::CompileLogfilePredicate(const string p_Predicate, const std::vector<string> p_PredicateLogfiles) {
+
+    m_LogfilePredicate.clear();
+    m_PredicateLogfiles.clear();
+
+    string predicate = p_Predicate;
+    if (utils::trim(predicate).empty()) return true;                                                                        // no predicate - nothing to do
+
+    if (!CompilePredicate(p_Predicate, m_LogfilePredicate)) return false;                                                   // compile the predicate
+
+    // record the logfiles gated by the predicate
+
+    if (p_PredicateLogfiles.empty()) {                                                                                      // logfiles specified?
+        for (auto& it: LOGFILE_DESCRIPTOR) {                                                                                // no - all BSE logfiles except detailed output
+            if (std::get<4>(it.second) == LOGFILE_TYPE::BINARY && it.first != LOGFILE::BSE_DETAILED_OUTPUT) m_PredicateLogfiles.push_back(it.first);
+        }
+    }
+    else {                                                                                                                  // logfiles specified
+        for (auto& name: p_PredicateLogfiles) {                                                                             // for each logfile specified
+            LOGFILE logfile = LOGFILE::NONE;
+            for (auto& it: LOGFILE_DESCRIPTOR) {                                                                            // look up short name
+                if (utils::Equals(std::get<2>(it.second), name)) logfile = it.first;
+            }
+            if (logfile == LOGFILE::NONE || std::get<4>(LOGFILE_DESCRIPTOR.at(logfile)) != LOGFILE_TYPE::BINARY) {          // known BSE logfile?
+                Squawk("ERROR: Unknown or non-BSE logfile '" + name + "' specified for logfile predicate");                 // no - announce error
+                m_LogfilePredicate.clear();
+                m_PredicateLogfiles.clear();
+                return false;
+            }
+            m_PredicateLogfiles.push_back(logfile);
+        }
+    }
+
+    return true;
+}
+
+
+/*
+ * Compile a predicate expression
+ *
+ * expression := and-term { '||' and-term }
+ *
+ *
+ * bool CompilePredicateExpression(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate)
+ *
+ * @param   [IN]    p_Tokens                    The predicate tokens
+ * @param   [IN/OUT]p_Pos                       Index of the next token to be compiled - updated
+ * @param   [IN/OUT]p_Predicate                 The compiled predicate - compiled tokens are appended
+ * @return                                      Boolean indicating whether the expression was compiled successfully
+ */
+bool Log::CompilePredicateExpression(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate) {
+
+    if (!CompilePredicateAndTerm(p_Tokens, p_Pos, p_Predicate)) return false;
+
+    while (p_Pos < p_Tokens.size() && p_Tokens[p_Pos] == "||") {
+        p_Pos++;
+        if (!CompilePredicateAndTerm(p_Tokens, p_Pos, p_Predicate)) return false;
+        p_Predicate.push_back({PREDICATE_OP::OR, {}, 0.0});
+    }
+
+    return true;
+}
+
+
+/*
+ * Compile a predicate and-term
+ *
+ * and-term := unary { '&&' unary }
+ *
+ *
+ * bool CompilePredicateAndTerm(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate)
+ *
+ * @param   [IN]    p_Tokens                    The predicate tokens
+ * @param   [IN/OUT]p_Pos                       Index of the next token to be compiled - updated
+ * @param   [IN/OUT]p_Predicate                 The compiled predicate - compiled tokens are appended
+ * @return                                      Boolean indicating whether the and-term was compiled successfully
+ */
+bool Log::CompilePredicateAndTerm(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate) {
+
+    if (!CompilePredicateUnary(p_Tokens, p_Pos, p_Predicate)) return false;
+
+    while (p_Pos < p_Tokens.size() && p_Tokens[p_Pos] == "&&") {
+        p_Pos++;
+        if (!CompilePredicateUnary(p_Tokens, p_Pos, p_Predicate)) return false;
+        p_Predicate.push_back({PREDICATE_OP::AND, {}, 0.0});
+    }
+
+    return true;
+}
+
+
+/*
+ * Compile a predicate unary
+ *
+ * unary      := '!' unary | '(' expression ')' | comparison
+ * comparison := operand [ relop operand ]
+ *
+ *
+ * bool CompilePredicateUnary(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate)
+ *
+ * @param   [IN]    p_Tokens                    The predicate tokens
+ * @param   [IN/OUT]p_Pos                       Index of the next token to be compiled - updated
+ * @param   [IN/OUT]p_Predicate                 The compiled predicate - compiled tokens are appended
+ * @return                                      Boolean indicating whether the unary was compiled successfully
+ */
+bool Log::CompilePredicateUnary(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate) {
+
+    const std::map<string, PREDICATE_OP> relops = {
+        { "==", PREDICATE_OP::EQ }, { "!=", PREDICATE_OP::NE },
+        { "<",  PREDICATE_OP::LT }, { "<=", PREDICATE_OP::LE },
+        { ">",  PREDICATE_OP::GT }, { ">=", PREDICATE_OP::GE }
+    };
+
+    if (p_Pos >= p_Tokens.size()) {                                                                                         // tokens remaining?
+        Squawk("ERROR: Unexpected end of predicate");                                                               // no - announce error
+        return false;
+    }
+
+    if (p_Tokens[p_Pos] == "!") {                                                                                           // not
+        p_Pos++;
+        if (!CompilePredicateUnary(p_Tokens, p_Pos, p_Predicate)) return false;
+        p_Predicate.push_back({PREDICATE_OP::NOT, {}, 0.0});
+        return true;
+    }
+
+    if (p_Tokens[p_Pos] == "(") {                                                                                           // parenthesised expression
+        p_Pos++;
+        if (!CompilePredicateExpression(p_Tokens, p_Pos, p_Predicate)) return false;
+        if (p_Pos >= p_Tokens.size() || p_Tokens[p_Pos] != ")") {                                                           // close parenthesis?
+            Squawk("ERROR: Expected ')' in predicate");                                                             // no - announce error
+            return false;
+        }
+        p_Pos++;
+        return true;
+    }
+
+    if (!CompilePredicateOperand(p_Tokens, p_Pos, p_Predicate)) return false;                                                            // comparison - lhs operand
+
+    if (p_Pos < p_Tokens.size() && relops.find(p_Tokens[p_Pos]) != relops.end()) {                                         // relational operator?
+        PREDICATE_OP op = relops.at(p_Tokens[p_Pos]);                                                                       // yes
+        p_Pos++;
+        if (!CompilePredicateOperand(p_Tokens, p_Pos, p_Predicate)) return false;                                                        // rhs operand
+        p_Predicate.push_back({op, {}, 0.0});
+    }
+
+    return true;
+}
+
+
+/*
+ * Compile a predicate operand
+ *
+ * operand := PROPERTY_TYPE::PROPERTY_NAME | number
+ *
+ * PROPERTY_TYPE must be one of STAR_1_PROPERTY, STAR_2_PROPERTY, BINARY_PROPERTY, or PROGRAM_OPTION,
+ * and the property must not be a string property.
+ *
+ *
+ * bool CompilePredicateOperand(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate)
+ *
+ * @param   [IN]    p_Tokens                    The predicate tokens
+ * @param   [IN/OUT]p_Pos                       Index of the next token to be compiled - updated
+ * @param   [IN/OUT]p_Predicate                 The compiled predicate - compiled tokens are appended
+ * @return                                      Boolean indicating whether the operand was compiled successfully
+ */
+bool Log::CompilePredicateOperand(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate) {
+
+    if (p_Pos >= p_Tokens.size()) {                                                                                         // tokens remaining?
+        Squawk("ERROR: Unexpected end of predicate");                                                               // no - announce error
+        return false;
+    }
+
+    string tokStr = p_Tokens[p_Pos];
+
+    size_t sepPos = tokStr.find("::");
+    if (sepPos == string::npos) {                                                                                           // property specifier?
+        try {                                                                                                               // no - must be a number
+            size_t lastChar;
+            double value = std::stod(tokStr, &lastChar);
+            if (lastChar != tokStr.size()) throw std::invalid_argument(tokStr);
+            p_Predicate.push_back({PREDICATE_OP::CONSTANT, {}, value});
+        }
+        catch (const std::exception& e) {                                                                                   // not a number
+            Squawk("ERROR: Expected property specifier or number in predicate, found '" + tokStr + "'");            // announce error
+            return false;
+        }
+        p_Pos++;
+        return true;
+    }
+
+    string propTypeStr = tokStr.substr(0, sepPos);                                                                          // property type
+    string propNameStr = tokStr.substr(sepPos + 2);                                                                         // property name
+
+    bool             found;
+    PROPERTY_TYPE    propertyType;
+    T_ANY_PROPERTY   property;
+    PROPERTY_DETAILS details;
+
+    std::tie(found, propertyType) = utils::GetMapKey(propTypeStr, PROPERTY_TYPE_LABEL, PROPERTY_TYPE::NONE);
+    if (found) {                                                                                                            // known property type?
+        switch (propertyType) {                                                                                             // yes
+
+            case PROPERTY_TYPE::STAR_1_PROPERTY:                                                                            // STAR_1_PROPERTY, or
+            case PROPERTY_TYPE::STAR_2_PROPERTY: {                                                                          // STAR_2_PROPERTY
+                STAR_PROPERTY starProperty;
+                std::tie(found, starProperty) = utils::GetMapKey(propNameStr, STAR_PROPERTY_LABEL, STAR_PROPERTY::ID);
+                if (found) {
+                    if (propertyType == PROPERTY_TYPE::STAR_1_PROPERTY) property = static_cast<STAR_1_PROPERTY>(starProperty);
+                    else                                                property = static_cast<STAR_2_PROPERTY>(starProperty);
+                    details = StellarPropertyDetails(static_cast<ANY_STAR_PROPERTY>(starProperty));
+                }
+                } break;
+
+            case PROPERTY_TYPE::BINARY_PROPERTY: {                                                                          // BINARY_PROPERTY
+                BINARY_PROPERTY binaryProperty;
+                std::tie(found, binaryProperty) = utils::GetMapKey(propNameStr, BINARY_PROPERTY_LABEL, BINARY_PROPERTY::ID);
+                if (found) {
+                    property = binaryProperty;
+                    details  = BinaryPropertyDetails(binaryProperty);
+                }
+                } break;
+
+            case PROPERTY_TYPE::PROGRAM_OPTION: {                                                                           // PROGRAM_OPTION
+                PROGRAM_OPTION programOption;
+                std::tie(found, programOption) = utils::GetMapKey(propNameStr, PROGRAM_OPTION_LABEL, PROGRAM_OPTION::RANDOM_SEED);
+                if (found) {
+                    property = programOption;
+                    details  = ProgramOptionDetails(programOption);
+                }
+                } break;
+
+            default:                                                                                                        // other property types not supported
+                found = false;
+        }
+    }
+
+    if (!found) {                                                                                                           // found supported property?
+        Squawk("ERROR: Unknown or unsupported property '" + tokStr + "' in predicate");                             // no - announce error
+        return false;
+    }
+
+    TYPENAME typeName = std::get<0>(details);
+    if (typeName == TYPENAME::NONE || typeName == TYPENAME::STRING) {                                                       // numeric property?
+        Squawk("ERROR: Non-numeric property '" + tokStr + "' in predicate");                                        // no - announce error
+        return false;
+    }
+
+    p_Predicate.push_back({PREDICATE_OP::PROPERTY, property, 0.0});
+    p_Pos++;
+
+    return true;
+}
@@ -206,6 +206,21 @@ using std::string;
  * Users should bear in mind that the combination of HDF5 chunk size and HDF5 IO buffer size affect performance,
  * storage space, and memory usage - so they may need to experiment to find a balance that suits their needs.
  * 
+ * Because the IO buffer is per open dataset, and there is a dataset per column per logfile, the memory used by
+ * the IO buffers can grow quickly (e.g. ~100 columns across a dozen BSE logfiles, each buffering a number of 
+ * chunks of COMPAS_VARIABLE_TYPE values).  I have added the program option --hdf5-buffer-memory to allow users
+ * to specify a budget (in MB) for the memory used by all HDF5 IO buffers.  If a budget is specified, the budget
+ * is shared amongst the open HDF5 logfiles in proportion to the number of records written to each logfile (a 
+ * proxy for the write rate of the logfile), and the IO buffer size of each logfile is capped at its share of the
+ * budget (but never more than --hdf5-buffer-size chunks).  If, after a record is buffered, the total memory used
+ * by the IO buffers exceeds the budget, the logfiles with the largest buffers are flushed first until the total
+ * is back within the budget.  The default is 0 - no budget (buffers are limited only by --hdf5-buffer-size).
+ * 
+ * Memory usage is estimated as the number of buffered values multiplied by sizeof(COMPAS_VARIABLE_TYPE) - the
+ * heap memory used by string values is not included.  Memory usage is tracked (with a running count updated as
+ * records are buffered and written) only if a budget is specified - the high-water mark of the IO buffer memory
+ * usage (in total, and per logfile) is then reported in the Run_Details file.
+ * 
  * 
  * String values stored in HDF5 files
  * ==================================
@@ -313,6 +328,40 @@ public:
 };
 
 
+/*
+ * Extract a boost::variant value as a double
+ *
+ * This is defined as a class for use with boost::apply_visitor().
+ * It is only ever used by the Log class (for logfile predicate evaluation), hence the reason it is defined here.
+ *
+ * Numeric, boolean, and enum class values are converted to double.  String values are not
+ * meaningful as numbers - they evaluate as 0.0 (string properties are rejected when the
+ * logfile predicate is compiled, so should never be seen here).
+ */
+class VariantValueAsDouble: public boost::static_visitor<double> {
+public:
+    double operator()(const bool                    v) const { return v ? 1.0 : 0.0; }
+    double operator()(const int                     v) const { return static_cast<double>(v); }
+    double operator()(const short int               v) const { return static_cast<double>(v); }
+    double operator()(const long int                v) const { return static_cast<double>(v); }
+    double operator()(const long long int           v) const { return static_cast<double>(v); }
+    double operator()(const unsigned int            v) const { return static_cast<double>(v); }
+    double operator()(const unsigned short int      v) const { return static_cast<double>(v); }
+    double operator()(const unsigned long int       v) const { return static_cast<double>(v); }  // also handles OBJECT_ID (typedef)
+    double operator()(const unsigned long long int  v) const { return static_cast<double>(v); }
+    double operator()(const float                   v) const { return static_cast<double>(v); }
+    double operator()(const double                  v) const { return v; }
+    double operator()(const long double             v) const { return static_cast<double>(v); }
+    double operator()(const string                  v) const { return 0.0; }
+    double operator()(const ERROR                   v) const { return static_cast<double>(static_cast<int>(v)); }
+    double operator()(const STELLAR_TYPE            v) const { return static_cast<double>(static_cast<int>(v)); }
+    double operator()(const MT_CASE                 v) const { return static_cast<double>(static_cast<int>(v)); }
+    double operator()(const MT_TRACKING             v) const { return static_cast<double>(static_cast<int>(v)); }
+    double operator()(const SN_EVENT                v) const { return static_cast<double>(static_cast<int>(v)); }
+    double operator()(const SN_STATE                v) const { return static_cast<double>(static_cast<int>(v)); }
+};
+
+
 class Log {
 
 private:
@@ -346,6 +395,20 @@ private:
         m_SSESupernova_LogRecordFmtVector  = {};                                    // SSE Supernova logfile format vector - initially empty
 
         m_OptionDetails = {};                                                       // option details retrieved from commandline - initially empty
+
+        m_HDF5BufferBudget             = 0;                                         // HDF5 IO buffer memory budget - default no budget
+        m_HDF5BufferedBytes            = 0;                                         // HDF5 IO buffer memory used - initially 0
+        m_HDF5BufferHighWater          = 0;                                         // HDF5 IO buffer memory high-water mark - initially 0
+        m_HDF5BufferHighWaterByLogfile = {};                                        // HDF5 IO buffer memory high-water mark per logfile - initially empty
+        m_HDF5BudgetFlushes            = 0;                                         // number of HDF5 logfile flushes forced by the IO buffer memory budget - initially 0
+
+        m_LogfilePredicate  = {};                                                   // compiled logfile predicate - default none
+        m_PredicateLogfiles = {};                                                   // logfiles gated by the logfile predicate - default none
+        m_StagedRecords     = {};                                                   // records staged pending the logfile predicate - initially none
+        m_RetainedRecords   = {};                                                   // staged records retained for forked evolution - initially none
+
+        m_StageSystemRecords = false;                                               // stage all BSE logfile records per system - default false
+        m_SystemsRolledBack  = 0;                                                   // systems rolled back - initially 0
     };
     Log(Log const&) = delete;                                                       // copy constructor does nothing, and not exposed publicly
     Log& operator = (Log const&) = delete;                                          // operator = does nothing, and not exposed publicly
@@ -387,7 +450,11 @@ private:
         hid_t   groupId;                                                            //    - group id
 
         size_t  chunkSize;                                                          //    - chunk size
-        size_t  IOBufSize;                                                          //    - IO buffer size
+        size_t  IOBufSize;                                                          //    - IO buffer size (may be reduced to fit the IO buffer memory budget)
+        size_t  IOBufSizeMax;                                                       //    - maximum IO buffer size (--hdf5-buffer-size chunks)
+
+        unsigned long int recordsWritten;                                           //    - number of records written - proxy for write rate
+        size_t            bufferedBytes;                                            //    - memory used by the IO buffers (bytes) - tracked only if IO buffer memory budget specified
 
         struct h5DataSetsT {                                                        // attributes of HDF5 datasets
             hid_t    dataSetId;                                                     //    - HDF5 dataset id
@@ -416,6 +483,12 @@ private:
 
     h5AttrT m_Run_Details_H5_File;                                                  // HDF5 attributes for run details in HDF5 container
 
+    size_t                    m_HDF5BufferBudget;                                   // HDF5 IO buffer memory budget (bytes, 0 = no budget)
+    size_t                    m_HDF5BufferedBytes;                                  // HDF5 IO buffer memory used (bytes, all open logfiles) - tracked only if budget specified
+    size_t                    m_HDF5BufferHighWater;                                // HDF5 IO buffer memory high-water mark (bytes, all open logfiles)
+    std::map<LOGFILE, size_t> m_HDF5BufferHighWaterByLogfile;                       // HDF5 IO buffer memory high-water mark per logfile (bytes)
+    unsigned long int         m_HDF5BudgetFlushes;                                  // number of HDF5 logfile flushes forced by the IO buffer memory budget
+
     COMPASUnorderedMap<LOGFILE, LogfileDetailsT> m_OpenStandardLogFileIds;          // currently open standard logfiles: id, filename, property details, field format strings
 
     ANY_PROPERTY_VECTOR m_BSE_BE_Binaries_Rec = BSE_BE_BINARIES_REC;                // default specification
@@ -455,6 +528,57 @@ private:
     std::vector<string> m_SSESupernova_LogRecordFmtVector;                          // SSE Supernova logfile format vector
     
   
+    // the following block of variables support predicate-filtered logging
+    //
+    // If the user specifies a logfile predicate (--logfile-predicate), records for the logfiles gated by the
+    // predicate (--logfile-predicate-files) are staged while the binary is evolving rather than written
+    // immediately.  At the end of evolution the predicate is evaluated over the properties of the binary, and
+    // the staged records are either written to the logfiles (predicate satisfied) or discarded.
+    //
+    // The predicate is compiled once, at startup, into a Reverse Polish Notation token vector that can be
+    // evaluated cheaply with a stack (see CompilePredicate() and EvaluatePredicate() - also used for other
+    // predicates over binary properties, e.g. the adaptive importance sampling hit predicate).  The grammar is:
+    //
+    //     expression := and-term { '||' and-term }
+    //     and-term   := unary { '&&' unary }
+    //     unary      := '!' unary | '(' expression ')' | comparison
+    //     comparison := operand [ relop operand ]
+    //     operand    := PROPERTY_TYPE::PROPERTY_NAME | number
+    //     relop      := '==' | '!=' | '<' | '<=' | '>' | '>='
+    //
+    // where PROPERTY_TYPE is one of STAR_1_PROPERTY, STAR_2_PROPERTY, BINARY_PROPERTY, or PROGRAM_OPTION (as in
+    // the logfile definitions file).  All values are evaluated as doubles; any non-zero value is 'true'.  e.g.
+    //
+    //     --logfile-predicate "BINARY_PROPERTY::MERGES_IN_HUBBLE_TIME || BINARY_PROPERTY::COMMON_ENVELOPE_EVENT_COUNT > 0"
+
+    // the following block of variables support per-system record staging
+    //
+    // If per-system record staging is enabled (--stage-system-records), records for all BSE logfiles except the
+    // detailed output file are staged while the binary is evolving, and are written (committed) or discarded (rolled
+    // back) together at the end of evolution of the binary.  Records for binaries whose evolution ends in error are
+    // rolled back, so logfiles contain no partial systems - but the system parameters record, which records the error,
+    // is always written.  The records for each system are written in one batched write per logfile.  Detailed output
+    // is not staged: a system can write many detailed output records, and staging them all would hold them all in memory.
+    //
+    // Staging shares the staged record buffer with predicate-filtered logging (above): records staged for logfiles
+    // gated by the logfile predicate are additionally discarded if the binary does not satisfy the predicate.
+
+    struct stagedRecordT {
+        int                               id;                                       // logfile id
+        bool                              gated;                                    // record is gated by the logfile predicate
+        string                            record;                                   // record for CSV, TSV, TXT files
+        std::vector<COMPAS_VARIABLE_TYPE> values;                                   // record values for HDF5 files
+    };
+
+    std::vector<PredicateTokenT> m_LogfilePredicate;                                // compiled (RPN) logfile predicate - empty = no predicate
+    std::vector<LOGFILE>         m_PredicateLogfiles;                               // logfiles written only if the logfile predicate is satisfied
+    std::vector<stagedRecordT>   m_StagedRecords;                                   // records staged pending evaluation of the logfile predicate and/or end of system evolution
+    std::vector<stagedRecordT>   m_RetainedRecords;                                 // staged records retained across a commit - restored when evolution is forked (see --fork-variations)
+
+    bool                         m_StageSystemRecords;                              // stage all BSE logfile records per system?
+    unsigned long int            m_SystemsRolledBack;                               // number of systems for which staged records were discarded because evolution ended in error
+
+
     // the following block of variables support the run details file
 
     std::ofstream                                      m_RunDetailsFile;            // run details file
@@ -477,6 +601,8 @@ private:
             m_Logfiles[p_LogfileId].label           = false;
             m_Logfiles[p_LogfileId].h5File.fileId   = -1;
             m_Logfiles[p_LogfileId].h5File.groupId  = -1;
+            m_Logfiles[p_LogfileId].h5File.recordsWritten = 0;
+            m_Logfiles[p_LogfileId].h5File.bufferedBytes  = 0;
             m_Logfiles[p_LogfileId].h5File.dataSets = {};
         }
     }
@@ -487,6 +613,10 @@ private:
     bool Write_(const int p_LogfileId, const std::vector<COMPAS_VARIABLE_TYPE> p_LogRecordValues, const bool p_Flush = false);
     bool WriteHDF5_(h5AttrT& p_H5file, const string p_H5filename, const size_t p_DataSetIdx);
     bool Flush_(const int p_LogfileId) { return Write_(p_LogfileId, {}, true); }
+
+    void   UpdateHDF5BufferedBytes(const int p_LogfileId, const size_t p_Added, const size_t p_Released);
+    void   RebalanceHDF5Buffers();
+    void   EnforceHDF5BufferBudget();
     bool Put_(const int p_LogfileId, const string p_LogStr, const string p_Label = "");
     bool Put_(const int p_LogfileId, const std::vector<COMPAS_VARIABLE_TYPE> p_LogRecordValues);
     bool Debug_(const string p_DbgStr);
@@ -502,6 +632,14 @@ private:
     std::tuple<bool, LOGFILE> GetStandardLogfileKey(const int p_FileId);
 
     bool  OpenHDF5RunDetailsFile(const string p_Filename = RUN_DETAILS_FILE_NAME);
+
+    bool  CompileLogfilePredicate(const string p_Predicate, const std::vector<string> p_PredicateLogfiles);
+    bool  CompilePredicateExpression(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate);
+    bool  CompilePredicateAndTerm(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate);
+    bool  CompilePredicateUnary(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate);
+    bool  CompilePredicateOperand(const std::vector<string>& p_Tokens, size_t& p_Pos, std::vector<PredicateTokenT>& p_Predicate);
+    bool  IsPredicateLogfile(const LOGFILE p_Logfile) { return !m_LogfilePredicate.empty() && std::find(m_PredicateLogfiles.begin(), m_PredicateLogfiles.end(), p_Logfile) != m_PredicateLogfiles.end(); }
+    bool  IsStagedLogfile(const LOGFILE p_Logfile)    { return IsPredicateLogfile(p_Logfile) || (m_StageSystemRecords && p_Logfile != LOGFILE::BSE_DETAILED_OUTPUT && std::get<4>(LOGFILE_DESCRIPTOR.at(p_Logfile)) == LOGFILE_TYPE::BINARY); }
     hid_t CreateHDF5Dataset(const string p_Filename, const hid_t p_GroupId, const string p_DatasetName, const hid_t p_H5DataType, const string p_UnitsStr, const size_t p_HDF5ChunkSize);
     hid_t GetHDF5DataType(const TYPENAME p_COMPASdatatype, const int p_FieldWidth = 0);
 
@@ -819,7 +957,10 @@ private:
                 logRecord = p_LogRecord;                                                                                                // use logfile record passed in
             }
 
-            if (ok) {                                                                                                                   // if all ok, write the record
+            if (ok && IsStagedLogfile(p_LogFile)) {                                                                                     // logfile staged (per system, or gated by logfile predicate)?
+                m_StagedRecords.push_back({fileDetails.id, IsPredicateLogfile(p_LogFile), logRecord, logRecordValues});                 // yes - stage the record until the system is committed or rolled back
+            }
+            else if (ok) {                                                                                                              // if all ok, write the record
                 if (m_Logfiles[fileDetails.id].filetype == LOGFILETYPE::HDF5) {                                                         // HDF5 file?
                     ok = Put_(fileDetails.id, logRecordValues);                                                                         // yes - write the record
                 }
@@ -907,6 +1048,79 @@ public:
 
     std::tuple<ANY_PROPERTY_VECTOR, std::vector<string>> GetStandardLogFileRecordDetails(const LOGFILE p_Logfile);
 
+
+    // predicate-filtered logging functions
+
+    bool CommitStagedRecords(const bool p_Commit, const bool p_PredicateSatisfied = true);
+
+    bool CompilePredicate(const string p_Predicate, std::vector<PredicateTokenT>& p_CompiledPredicate);
+
+    void RestoreStagedRecords()                                                     { m_StagedRecords = m_RetainedRecords; }
+    void RetainStagedRecords(const size_t p_Count)                                  { m_RetainedRecords.assign(m_StagedRecords.begin(), m_StagedRecords.begin() + std::min(p_Count, m_StagedRecords.size())); }
+    size_t StagedRecordCount() const                                                { return m_StagedRecords.size(); }
+
+
+    /*
+     * Evaluate a compiled predicate for the object passed
+     *
+     * The predicate is evaluated over the current property values of the object passed (generally
+     * a binary at the end of its evolution).  An empty predicate is always satisfied.
+     *
+     *
+     * template <class T>
+     * bool EvaluatePredicate(const std::vector<PredicateTokenT>& p_Predicate, const T* const p_Star)
+     *
+     * @param   [IN]    p_Predicate                 The compiled predicate (see CompilePredicate())
+     * @param   [IN]    p_Star                      The object (generally a binary) for which the predicate should be evaluated
+     * @return                                      Boolean result of predicate evaluation (true = predicate satisfied)
+     */
+    template <class T>
+    bool EvaluatePredicate(const std::vector<PredicateTokenT>& p_Predicate, const T* const p_Star) {
+
+        if (p_Predicate.empty()) return true;                                                                   // no predicate - always satisfied
+
+        std::vector<double> stack;
+        stack.reserve(p_Predicate.size());
+
+        for (auto &token : p_Predicate) {
+
+            if (token.op == PREDICATE_OP::PROPERTY) {                                                           // property value
+                bool                 ok;
+                COMPAS_VARIABLE_TYPE value;
+                std::tie(ok, value) = p_Star->PropertyValue(token.property);
+                stack.push_back(ok ? boost::apply_visitor(VariantValueAsDouble(), value) : 0.0);
+            }
+            else if (token.op == PREDICATE_OP::CONSTANT) {                                                      // constant
+                stack.push_back(token.value);
+            }
+            else if (token.op == PREDICATE_OP::NOT) {                                                           // unary operator
+                stack.back() = (stack.back() != 0.0) ? 0.0 : 1.0;
+            }
+            else {                                                                                              // binary operator
+                double rhs = stack.back(); stack.pop_back();
+                double lhs = stack.back();
+                bool   result;
+                switch (token.op) {
+                    case PREDICATE_OP::EQ : result = lhs == rhs; break;
+                    case PREDICATE_OP::NE : result = lhs != rhs; break;
+                    case PREDICATE_OP::LT : result = lhs <  rhs; break;
+                    case PREDICATE_OP::LE : result = lhs <= rhs; break;
+                    case PREDICATE_OP::GT : result = lhs >  rhs; break;
+                    case PREDICATE_OP::GE : result = lhs >= rhs; break;
+                    case PREDICATE_OP::AND: result = (lhs != 0.0) && (rhs != 0.0); break;
+                    case PREDICATE_OP::OR : result = (lhs != 0.0) || (rhs != 0.0); break;
+                    default               : result = false; break;                                              // avoids compiler warning
+                }
+                stack.back() = result ? 1.0 : 0.0;
+            }
+        }
+
+        return !stack.empty() && stack.back() != 0.0;
+    }
+
+    template <class T>
+    bool EvaluateLogfilePredicate(const T* const p_Star) { return EvaluatePredicate(m_LogfilePredicate, p_Star); }
+
     template <class T>
     bool LogBeBinary(const T* const p_Binary, const string p_Rec)                               { return LogStandardRecord(std::get<2>(LOGFILE_DESCRIPTOR.at(LOGFILE::BSE_BE_BINARIES)), 0, LOGFILE::BSE_BE_BINARIES, p_Binary, p_Rec); }
 
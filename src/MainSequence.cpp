@@ -1,4 +1,5 @@
 #include "MainSequence.h"
+#include "powers.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -66,7 +67,8 @@ double MainSequence::CalculateDeltaL(const double p_Mass) const {
         deltaL        = m_LConstants[static_cast<int>(L_CONSTANTS::B_DELTA_L)] * PPOW((top / bottom), 0.4);
     }
     else {
-        deltaL = std::min((a[34] / PPOW(p_Mass, a[35])), (a[36] / PPOW(p_Mass, a[37])));
+        powers::SharedBase m(p_Mass);                                   // log2(mass) once for both powers
+        deltaL = std::min((a[34] / m.Pow(a[35])), (a[36] / m.Pow(a[37])));
     }
 
     return deltaL;
@@ -128,7 +130,10 @@ double MainSequence::CalculateAlphaL(const double p_Mass) const {
     else if (utils::Compare(p_Mass, a[52]) < 0) alphaL = 0.3 + ((a[50] - 0.3) * (p_Mass - 0.7) / (a[52] - 0.7));
     else if (utils::Compare(p_Mass, a[53]) < 0) alphaL = a[50] + ((a[51] - a[50]) * (p_Mass - a[52]) / (a[53] - a[52]));
     else if (utils::Compare(p_Mass, 2.0)   < 0) alphaL = a[51] + ((m_LConstants[static_cast<int>(L_CONSTANTS::B_ALPHA_L)] - a[51]) * (p_Mass - a[53]) / (2.0 - a[53]));
-    else                                        alphaL = (a[45] + (a[46] * PPOW(p_Mass, a[48]))) / (PPOW(p_Mass, 0.4) + (a[47] * PPOW(p_Mass, 1.9)));
+    else {
+        powers::SharedBase m(p_Mass);                                                                   // log2(mass) once for all three powers
+        alphaL = (a[45] + (a[46] * m.Pow(a[48]))) / (m.Pow(0.4) + (a[47] * m.Pow(1.9)));
+    }
 
     return alphaL;
 
@@ -214,8 +219,10 @@ double MainSequence::CalculateLuminosityAtPhaseEnd(const double p_Mass) const {
     double m_4 = m_3 * p_Mass;
     double m_5 = m_4 * p_Mass;
 
-    double top    = (a[11] * m_3) + (a[12] * m_4) + (a[13] * PPOW(p_Mass, (a[16] + 1.8)));
-    double bottom = a[14] + (a[15] * m_5) + PPOW(p_Mass, a[16]);
+    powers::SharedBase m(p_Mass);                                       // log2(mass) once for both powers
+
+    double top    = (a[11] * m_3) + (a[12] * m_4) + (a[13] * m.Pow(a[16] + 1.8));
+    double bottom = a[14] + (a[15] * m_5) + m.Pow(a[16]);
 
     return top / bottom;
 
@@ -248,7 +255,8 @@ double MainSequence::CalculateLuminosityOnPhase(const double p_Time, const doubl
     double deltaL = CalculateDeltaL(p_Mass);
     double eta    = CalculateEta(p_Mass);
 
-    double mu     = std::max(0.5, (1.0 - (0.01 * std::max((a[6] / PPOW(p_Mass, a[7])), (a[8] + (a[9] / PPOW(p_Mass, a[10]))))))); // Hurley et al. 2000, eq 7
+    powers::SharedBase m(p_Mass);                                                                               // log2(mass) once for both powers
+    double mu     = std::max(0.5, (1.0 - (0.01 * std::max((a[6] / m.Pow(a[7])), (a[8] + (a[9] / m.Pow(a[10]))))))); // Hurley et al. 2000, eq 7
     double tHook  = mu * timescales(tBGB);                                                                                      // Hurley et al. 2000, just after eq 5
     double tau    = p_Time / timescales(tMS);                                                                                   // Hurley et al. 2000, eq 11
     double tau1   = std::min(1.0, (p_Time / tHook));                                                                            // Hurley et al. 2000, eq 14
@@ -260,7 +268,7 @@ double MainSequence::CalculateLuminosityOnPhase(const double p_Time, const doubl
            logLMS_LZAMS += (log10(LTMS / p_LZAMS) - alphaL - betaL) * tau * tau;                                                // Hurley et al. 2000, eq 12, part 3
            logLMS_LZAMS -= deltaL * ((tau1 * tau1) - (tau2 * tau2));                                                            // Hurley et al. 2000, eq 12, part 4
 
-    return p_LZAMS * PPOW(10.0, logLMS_LZAMS);                                                                                   // rewrite Hurley et al. 2000, eq 12 for L(t)
+    return p_LZAMS * powers::Exp10(logLMS_LZAMS);                                                                                // rewrite Hurley et al. 2000, eq 12 for L(t)
 
 #undef timescales
 #undef a
@@ -293,7 +301,10 @@ double MainSequence::CalculateAlphaR(const double p_Mass) const {
     else if (utils::Compare(p_Mass,  0.65) <  0) alphaR = a[62] + (a[63] - a[62]) * (p_Mass - 0.5) / 0.15;
     else if (utils::Compare(p_Mass, a[68]) <  0) alphaR = a[63] + (a[64] - a[63]) * (p_Mass - 0.65) / (a[68] - 0.65);
     else if (utils::Compare(p_Mass, a[66]) <  0) alphaR = a[64] + (m_RConstants[static_cast<int>(R_CONSTANTS::B_ALPHA_R)] - a[64]) * (p_Mass - a[68]) / (a[66] - a[68]);
-    else if (utils::Compare(p_Mass, a[67]) <= 0) alphaR = a[58] * PPOW(p_Mass, a[60]) / (a[59] + PPOW(p_Mass, a[61]));
+    else if (utils::Compare(p_Mass, a[67]) <= 0) {
+        powers::SharedBase m(p_Mass);                                                                   // log2(mass) once for both powers
+        alphaR = a[58] * m.Pow(a[60]) / (a[59] + m.Pow(a[61]));
+    }
     else                                         alphaR = m_RConstants[static_cast<int>(R_CONSTANTS::C_ALPHA_R)] + a[65] * (p_Mass - a[67]);
 
     return alphaR;
@@ -348,7 +359,7 @@ double MainSequence::CalculateDeltaR(const double p_Mass) const {
     double deltaR;
 
     if (utils::Compare(p_Mass, massCutoffs(MHook)) <= 0) deltaR = 0.0;   // this really is supposed to be 0
-    else if (utils::Compare(p_Mass, a[42])         <= 0) deltaR = a[43] * PPOW(((p_Mass - massCutoffs(MHook)) / (a[42] - massCutoffs(MHook))), 0.5);
+    else if (utils::Compare(p_Mass, a[42])         <= 0) deltaR = a[43] * powers::Pow<1, 2>((p_Mass - massCutoffs(MHook)) / (a[42] - massCutoffs(MHook)));
     else if (utils::Compare(p_Mass, 2.0)            < 0) deltaR = a[43] + ((m_RConstants[static_cast<int>(R_CONSTANTS::B_DELTA_R)] - a[43]) * PPOW(((p_Mass - a[42]) / (2.0 - a[42])), a[44]));
     else {
         // pow() is slow - use multiplication (sqrt() is faster than pow())
@@ -383,7 +394,8 @@ double MainSequence::CalculateRadiusAtPhaseEnd(const double p_Mass, const double
     double mAsterisk = a[17] + 0.1;
 
     if (utils::Compare(p_Mass, a[17]) <= 0) {
-        RTMS = (a[18] + (a[19] * PPOW(p_Mass, a[21]))) / (a[20] + PPOW(p_Mass, a[22]));
+        powers::SharedBase m(p_Mass);                                                                   // log2(mass) once for both powers
+        RTMS = (a[18] + (a[19] * m.Pow(a[21]))) / (a[20] + m.Pow(a[22]));
 
         if (utils::Compare(p_Mass, 0.5) < 0) {
             RTMS = std::max(RTMS, 1.5 * p_RZAMS);
@@ -394,7 +406,8 @@ double MainSequence::CalculateRadiusAtPhaseEnd(const double p_Mass, const double
         double m_3 = p_Mass * p_Mass * p_Mass;
         double m_5 = m_3 * p_Mass * p_Mass;
 
-        RTMS = ((C_COEFF.at(1) * m_3) + (a[23] * PPOW(p_Mass, a[26])) + (a[24] * PPOW(p_Mass, a[26] + 1.5))) / (a[25] + m_5);
+        powers::SharedBase m(p_Mass);                                                                   // log2(mass) once for both powers
+        RTMS = ((C_COEFF.at(1) * m_3) + (a[23] * m.Pow(a[26])) + (a[24] * m.Pow(a[26] + 1.5))) / (a[25] + m_5);
     }
     else{   // for stars with masses between a17, a17 + 0.1 interpolate between the end points (y = mx + c)
 
@@ -422,17 +435,21 @@ double MainSequence::CalculateRadiusAtPhaseEnd(const double p_Mass, const double
  *
  * Hurley et al. 2000, eq 13
  *
+ * The timescales are passed explicitly so the radius can be evaluated for timescales other than the star's
+ * own (see CalculateRadiusAfterMassChange())
  *
- * double CalculateRadiusOnPhase(const double p_Mass, const double, p_RZAMS, const double p_Time)
+ *
+ * double CalculateRadiusOnPhase(const double p_Mass, const double p_Time, const double p_RZAMS, const double p_TBGB, const double p_TMS)
  *
  * @param   [IN]    p_Mass                      Mass in Msol
  * @param   [IN]    p_Time                      Time (after ZAMS) in Myr
  * @param   [IN]    p_RZAMS                     Zero Age Main Sequence (ZAMS) Radius
+ * @param   [IN]    p_TBGB                      Lifetime to the base of the giant branch (tBGB) in Myr
+ * @param   [IN]    p_TMS                       Main sequence lifetime (tMS) in Myr
  * @return                                      Radius on the Main Sequence in Rsol
  */
-double MainSequence::CalculateRadiusOnPhase(const double p_Mass, const double p_Time, const double p_RZAMS) const {
+double MainSequence::CalculateRadiusOnPhase(const double p_Mass, const double p_Time, const double p_RZAMS, const double p_TBGB, const double p_TMS) const {
 #define a m_AnCoefficients                                          // for convenience and readability - undefined at end of function
-#define timescales(x) m_Timescales[static_cast<int>(TIMESCALE::x)]  // for convenience and readability - undefined at end of function
 
     const double epsilon = 0.01;
 
@@ -442,9 +459,10 @@ double MainSequence::CalculateRadiusOnPhase(const double p_Mass, const double p_
     double deltaR = CalculateDeltaR(p_Mass);
     double gamma  = CalculateGamma(p_Mass);
 
-    double mu     = std::max(0.5, (1.0 - (0.01 * std::max((a[6] / PPOW(p_Mass, a[7])), (a[8] + (a[9] / PPOW(p_Mass, a[10]))))))); // Hurley et al. 2000, eq 7
-    double tHook  = mu * timescales(tBGB);                                                                                      // Hurley et al. 2000, just after eq 5
-    double tau    = p_Time / timescales(tMS);                                                                                   // Hurley et al. 2000, eq 11
+    powers::SharedBase m(p_Mass);                                                                               // log2(mass) once for both powers
+    double mu     = std::max(0.5, (1.0 - (0.01 * std::max((a[6] / m.Pow(a[7])), (a[8] + (a[9] / m.Pow(a[10]))))))); // Hurley et al. 2000, eq 7
+    double tHook  = mu * p_TBGB;                                                                                                // Hurley et al. 2000, just after eq 5
+    double tau    = p_Time / p_TMS;                                                                                             // Hurley et al. 2000, eq 11
     double tau1   = std::min(1.0, (p_Time / tHook));                                                                            // Hurley et al. 2000, eq 14
     double tau2   = std::max(0.0, std::min(1.0, (p_Time - ((1.0 - epsilon) * tHook)) / (epsilon * tHook)));                     // Hurley et al. 2000, eq 15
 
@@ -461,13 +479,48 @@ double MainSequence::CalculateRadiusOnPhase(const double p_Mass, const double p_
            logRMS_RZAMS += (log10(RTMS / p_RZAMS) - alphaR - betaR - gamma) * tau_3;                                            // Hurley et al. 2000, eq 13, part 4
            logRMS_RZAMS -= deltaR * (tau1_3 - tau2_3);                                                                          // Hurley et al. 2000, eq 13, part 5
 
-    return p_RZAMS * PPOW(10.0, logRMS_RZAMS);                                                                                   // rewrite Hurley et al. 2000, eq 13 for R(t)
+    return p_RZAMS * powers::Exp10(logRMS_RZAMS);                                                                                // rewrite Hurley et al. 2000, eq 13 for R(t)
 
-#undef timescales
 #undef a
 }
 
 
+/*
+ * Calculate the radius of the star after a change in mass, without updating the star
+ *
+ * Evaluates the radius the star would have if its attributes were updated for the mass changes (as by
+ * UpdateAttributes(p_DeltaMass, p_DeltaMass0)): timescales and ZAMS radius for the new initial mass, radius
+ * on the Main Sequence for the new mass at the current age.  The result is exactly the radius of an updated
+ * copy of the star, at the cost of one radius evaluation.
+ *
+ * If the star would leave the Main Sequence the radius is not modelled (the functional return flag is false)
+ * and the star must be updated to find its radius.
+ *
+ *
+ * std::tuple<bool, double> CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0)
+ *
+ * @param   [IN]    p_DeltaMass                 Change in mass in Msol
+ * @param   [IN]    p_DeltaMass0                Change in initial mass (Mass0) in Msol
+ * @return                                      Tuple containing:
+ *                                                  - flag indicating whether the radius was modelled
+ *                                                  - radius after the mass change in Rsol (current radius if not modelled)
+ */
+std::tuple<bool, double> MainSequence::CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0) const {
+
+    if (utils::Compare(p_DeltaMass, 0.0) == 0 && utils::Compare(p_DeltaMass0, 0.0) == 0) return std::make_tuple(true, m_Radius);    // no change - attributes would not be recalculated
+
+    double mass  = utils::Compare(p_DeltaMass,  0.0) != 0 ? std::max(0.0, m_Mass  + p_DeltaMass)  : m_Mass;                          // as UpdateAttributesAndAgeOneTimestepPreamble()
+    double mass0 = utils::Compare(p_DeltaMass0, 0.0) != 0 ? std::max(0.0, m_Mass0 + p_DeltaMass0) : m_Mass0;
+
+    double tBGB  = CalculateLifetimeToBGB(mass0);
+    double tMS   = CalculateLifetimeOnPhase(mass0, tBGB);
+
+    if (mass <= 0.0 || m_Age >= tMS) return std::make_tuple(false, m_Radius);                                                          // would leave the Main Sequence - not modelled
+
+    return std::make_tuple(true, CalculateRadiusOnPhase(mass, m_Age, CalculateRadiusAtZAMS(mass0), tBGB, tMS));
+}
+
+
 /*
  * Calculate the radial extent of the star's convective envelope (if it has one)
  *
@@ -483,7 +536,7 @@ double MainSequence::CalculateRadiusOnPhase(const double p_Mass, const double p_
  * @return                                      Radial extent of the star's convective envelope in Rsol
  */
 double MainSequence::CalculateRadialExtentConvectiveEnvelope() const {
-    return utils::Compare(m_Mass, 0.35) <= 0 ? m_Radius * PPOW(1.0 - m_Tau, 1.0 / 4.0) : 0.0;
+    return utils::Compare(m_Mass, 0.35) <= 0 ? m_Radius * powers::Pow<1, 4>(1.0 - m_Tau) : 0.0;
 }
 
 
@@ -530,7 +583,8 @@ double MainSequence::CalculateLifetimeOnPhase(const double p_Mass, const double
 
     // Calculate time to Hook
     // Hurley et al. 2000, eqs 5, 6 & 7
-    double mu    = std::max(0.5, (1.0 - (0.01 * std::max((a[6] / PPOW(p_Mass, a[7])), (a[8] + (a[9] / PPOW(p_Mass, a[10])))))));
+    powers::SharedBase m(p_Mass);                                                                               // log2(mass) once for both powers
+    double mu    = std::max(0.5, (1.0 - (0.01 * std::max((a[6] / m.Pow(a[7])), (a[8] + (a[9] / m.Pow(a[10])))))));
     double tHook = mu * p_TBGB;
 
     // For mass < Mhook, x > mu (i.e. for stars without a hook)
@@ -622,7 +676,9 @@ double MainSequence::CalculateGyrationRadius() const {
 
     double radiusRatio = m_Radius / m_RZAMS;
 
-	return ((k0 - 0.025) * PPOW(radiusRatio, CUpper)) + (0.025 * PPOW(radiusRatio, -0.1));          // gyration radius
+    powers::SharedBase r(radiusRatio);                                                              // log2(radiusRatio) once for both powers
+
+	return ((k0 - 0.025) * r.Pow(CUpper)) + (0.025 * r.Pow(-0.1));                                  // gyration radius
 }
 
 
@@ -60,7 +60,10 @@ protected:
 
     double          CalculateRadialExtentConvectiveEnvelope() const;
 
-    double          CalculateRadiusOnPhase(const double p_Mass, const double p_Time, const double p_RZAMS) const;
+    std::tuple<bool, double> CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0) const;
+
+    double          CalculateRadiusOnPhase(const double p_Mass, const double p_Time, const double p_RZAMS, const double p_TBGB, const double p_TMS) const;
+    double          CalculateRadiusOnPhase(const double p_Mass, const double p_Time, const double p_RZAMS) const { return CalculateRadiusOnPhase(p_Mass, p_Time, p_RZAMS, m_Timescales[static_cast<int>(TIMESCALE::tBGB)], m_Timescales[static_cast<int>(TIMESCALE::tMS)]); }
     double          CalculateRadiusAtPhaseEnd(const double p_Mass, const double p_RZAMS) const;
     double          CalculateRadiusAtPhaseEnd() const                                       { return CalculateRadiusAtPhaseEnd(m_Mass, m_RZAMS); }                  // Use class member variables
     double          CalculateRadiusOnPhase() const                                          { return CalculateRadiusOnPhase(m_Mass, m_Age, m_RZAMS0); }             // Use class member variables
@@ -1,6 +1,7 @@
 #include "Rand.h"
 
 #include "NS.h"
+#include "powers.h"
 
 
 /*
@@ -44,15 +45,11 @@ double NS::CalculateRadiusOnPhaseInKM_Static(const double p_Mass) {
 
             // We don't extrapolate so masses outside table just set to extreme values
 
-            std::map<double, double>::const_iterator iter;
+            double ARP3MinimumMass         = ARP3MassRadiusRelation().XMin();
+            double ARP3RadiusAtMinimumMass = ARP3MassRadiusRelation().YAtXMin();
 
-            iter = ARP3MassRadiusRelation.begin();
-            double ARP3MinimumMass = iter->first;
-            double ARP3RadiusAtMinimumMass = iter->second;
-
-            iter = ARP3MassRadiusRelation.end();
-            double ARP3MaximumMass = (--iter)->first;
-            double ARP3RadiusAtMaximumMass = iter->second;
+            double ARP3MaximumMass         = ARP3MassRadiusRelation().XMax();
+            double ARP3RadiusAtMaximumMass = ARP3MassRadiusRelation().YAtXMax();
 
             if (utils::Compare(p_Mass, ARP3MinimumMass) < 0) {
                 radius = ARP3RadiusAtMinimumMass;
@@ -61,7 +58,7 @@ double NS::CalculateRadiusOnPhaseInKM_Static(const double p_Mass) {
                 radius = ARP3RadiusAtMaximumMass;
             }
             else{
-                radius = utils::SampleFromTabulatedCDF(p_Mass, ARP3MassRadiusRelation);
+                radius = utils::SampleFromTabulatedCDF(p_Mass, ARP3MassRadiusRelation());
             }
         } break;
 
@@ -127,7 +124,9 @@ double NS::CalculatePulsarBirthSpinPeriod_Static() {
             double maximum = OPTIONS->PulsarBirthSpinPeriodDistributionMax();
             double minimum = OPTIONS->PulsarBirthSpinPeriodDistributionMin();
 
+            RAND->Stream(RANDOM_STREAM::PULSAR);                                                                            // common random numbers: pulsar substream (no-op unless --common-random-numbers)
             pSpin = minimum + (RAND->Random() * (maximum - minimum));
+            RAND->StreamClear();
             } break;
 
         case PULSAR_BIRTH_SPIN_PERIOD_DISTRIBUTION::NORMAL: {                                                               // NORMAL distribution from Faucher-Giguere and Kaspi 2006 https://arxiv.org/abs/astro-ph/0512585
@@ -139,7 +138,9 @@ double NS::CalculatePulsarBirthSpinPeriod_Static() {
             double mean  = 300.0;
             double sigma = 150.0;
 
+            RAND->Stream(RANDOM_STREAM::PULSAR);                                                                            // common random numbers: pulsar substream (no-op unless --common-random-numbers)
             do { pSpin = RAND->RandomGaussian(sigma) + mean;} while (utils::Compare(pSpin, 0.0) < 0);
+            RAND->StreamClear();
 
             } break;
 
@@ -187,7 +188,9 @@ double NS::CalculatePulsarBirthMagneticField_Static() {
             double maximum = OPTIONS->PulsarBirthMagneticFieldDistributionMax();
             double minimum = OPTIONS->PulsarBirthMagneticFieldDistributionMin();
 
+            RAND->Stream(RANDOM_STREAM::PULSAR);                                                                        // common random numbers: pulsar substream (no-op unless --common-random-numbers)
             log10B = minimum + (RAND->Random() * (maximum - minimum));
+            RAND->StreamClear();
 
             } break;
 
@@ -197,7 +200,9 @@ double NS::CalculatePulsarBirthMagneticField_Static() {
             double maximum = PPOW(10.0, OPTIONS->PulsarBirthMagneticFieldDistributionMax());
             double minimum = PPOW(10.0, OPTIONS->PulsarBirthMagneticFieldDistributionMin());
 
+            RAND->Stream(RANDOM_STREAM::PULSAR);                                                                        // common random numbers: pulsar substream (no-op unless --common-random-numbers)
             log10B = log10(minimum + (RAND->Random() * (maximum - minimum)));
+            RAND->StreamClear();
             } break;
 
         case PULSAR_BIRTH_MAGNETIC_FIELD_DISTRIBUTION::LOGNORMAL: {                                                     // LOG NORMAL distribution from Faucher-Giguere and Kaspi 2006 https://arxiv.org/abs/astro-ph/0512585
@@ -209,7 +214,9 @@ double NS::CalculatePulsarBirthMagneticField_Static() {
             double mean  = 12.65;
             double sigma = 0.55;
 
+            RAND->Stream(RANDOM_STREAM::PULSAR);                                                                        // common random numbers: pulsar substream (no-op unless --common-random-numbers)
             log10B = RAND->RandomGaussian(sigma) + mean;
+            RAND->StreamClear();
             } break;
 
         default:                                                                                                        // unknown distribution
@@ -371,9 +378,9 @@ void NS::UpdateMagneticFieldAndSpin(const bool p_CommonEnvelope, const bool p_Re
         // calculate the Alfven radius for an accreting neutron star, see Equation 8 in  arXiv:0903.3538v2       
         double mDot         = p_MassGainPerTimeStep / p_Stepsize ;
         double p            = ((radius * radius * radius * radius * radius * radius) / (sqrt(mass) * mDot));
-        double q            = PPOW(p, 2.0 / 7.0);
-        double constant     = PPOW((2.0 * M_PI * M_PI) / (G * MU_0 * MU_0), 1.0 / 7.0);                                                         
-        double alfvenRadius = constant * q * PPOW(m_PulsarDetails.magneticField, 4.0 / 7.0);
+        double q            = powers::Pow<2, 7>(p);
+        double constant     = powers::Pow<1, 7>((2.0 * M_PI * M_PI) / (G * MU_0 * MU_0));                                                         
+        double alfvenRadius = constant * q * powers::Pow<4, 7>(m_PulsarDetails.magneticField);
   
         // calculate the difference in the keplerian angular velocity and surface angular velocity of the neutron star in m - see Equation 2 in 1994MNRAS.269..455J       
         double keplerianVelocityAtAlfvenRadius        = sqrt(G * mass) / sqrt(alfvenRadius / 2.0);
@@ -140,7 +140,17 @@ void Options::OptionValues::Initialise() {
     m_EvolvePulsars                                                 = false;
 	m_EvolveUnboundSystems                                          = false;
 
+    m_CommonRandomNumbers                                           = false;
+
+    m_ForkVariations                                                = false;
+
+    m_PowerKernels                                                  = false;
+
     m_DetailedOutput                                                = false;
+    m_DetailedOutputSampleInterval                                  = 1;
+    m_DetailedOutputMassDelta                                       = 0.0;
+    m_DetailedOutputRadiusDelta                                     = 0.0;
+    m_DetailedOutputSeparationDelta                                 = 0.0;
     m_PopulationDataPrinting                                        = false;
     m_PrintBoolAsString                                             = false;
     m_Quiet                                                         = false;
@@ -148,6 +158,8 @@ void Options::OptionValues::Initialise() {
 
     m_ShortHelp                                                     = true;
 
+    m_StageSystemRecords                                            = false;
+
     m_SwitchLog                                                     = false;
 
 
@@ -165,6 +177,13 @@ void Options::OptionValues::Initialise() {
     m_MaxEvolutionTime                                              = 13700.0;
     m_MaxNumberOfTimestepIterations                                 = 99999;
     m_TimestepMultiplier                                            = 1.0;
+    m_TimestepRadialChangePrediction                                = false;
+
+    // Fast-forward of detached compact-object binaries
+    m_FastForwardCompactBinaries                                    = false;
+    m_FastForwardOutputInterval                                     = 0.0;
+
+    m_NonInteractingFastPath                                        = false;
 
     // Initial mass options
     m_InitialMass                                                   = 5.0;
@@ -237,6 +256,11 @@ void Options::OptionValues::Initialise() {
     m_KickMagnitudeDistributionSigmaForECSN                         = 30.0;
     m_KickMagnitudeDistributionSigmaForUSSN   	                    = 30.0;
 	m_KickScalingFactor						                        = 1.0;
+    m_KickSampling.type                                             = KICK_SAMPLING::EXACT;
+    m_KickSampling.typeString                                       = KICK_SAMPLING_LABEL.at(m_KickSampling.type);
+    m_KickResamples                                                 = 1;
+    m_KickResampleSupernovae.type                                   = KICK_RESAMPLE_SUPERNOVAE::FIRST;
+    m_KickResampleSupernovae.typeString                             = KICK_RESAMPLE_SUPERNOVAE_LABEL.at(m_KickResampleSupernovae.type);
 
     // Kick direction option
     m_KickDirectionDistribution.type                                = KICK_DIRECTION_DISTRIBUTION::ISOTROPIC;
@@ -277,6 +301,15 @@ void Options::OptionValues::Initialise() {
     m_CheMode.type                                                  = CHE_MODE::NONE;
     m_CheMode.typeString                                            = CHE_MODE_LABEL.at(m_CheMode.type);
 
+    m_CoalescenceTimeKernel.type                                    = COALESCENCE_TIME_KERNEL::TABULATED;
+    m_CoalescenceTimeKernel.typeString                              = COALESCENCE_TIME_KERNEL_LABEL.at(m_CoalescenceTimeKernel.type);
+
+    m_CullingMode.type                                              = CULLING_MODE::NONE;
+    m_CullingMode.typeString                                        = CULLING_MODE_LABEL.at(m_CullingMode.type);
+
+    m_TrackLibraryMode.type                                         = TRACK_LIBRARY_MODE::NONE;
+    m_TrackLibraryMode.typeString                                   = TRACK_LIBRARY_MODE_LABEL.at(m_TrackLibraryMode.type);
+
 
     // Supernova remnant mass prescription options
     m_RemnantMassPrescription.type                                  = REMNANT_MASS_PRESCRIPTION::FRYER2012;
@@ -362,6 +395,15 @@ void Options::OptionValues::Initialise() {
     m_MassTransferAngularMomentumLossPrescription.type              = MT_ANGULAR_MOMENTUM_LOSS_PRESCRIPTION::ISOTROPIC_RE_EMISSION;
     m_MassTransferAngularMomentumLossPrescription.typeString        = MT_ANGULAR_MOMENTUM_LOSS_PRESCRIPTION_LABEL.at(m_MassTransferAngularMomentumLossPrescription.type);
 
+    // Mass transfer donor radius response
+    m_MassTransferDonorRadiusResponse.type                          = MT_DONOR_RADIUS_RESPONSE::MODEL;
+    m_MassTransferDonorRadiusResponse.typeString                    = MT_DONOR_RADIUS_RESPONSE_LABEL.at(m_MassTransferDonorRadiusResponse.type);
+
+    // Mass transfer orbit integration options
+    m_MassTransferOrbitIntegrator.type                              = MT_ORBIT_INTEGRATOR::EULER;
+    m_MassTransferOrbitIntegrator.typeString                        = MT_ORBIT_INTEGRATOR_LABEL.at(m_MassTransferOrbitIntegrator.type);
+    m_MassTransferOrbitTolerance                                    = 1.0E-8;
+
     // Mass transfer rejuvenation prescriptions
     m_MassTransferRejuvenationPrescription.type                     = MT_REJUVENATION_PRESCRIPTION::NONE;
     m_MassTransferRejuvenationPrescription.typeString               = MT_REJUVENATION_PRESCRIPTION_LABEL.at(m_MassTransferRejuvenationPrescription.type);
@@ -472,6 +514,7 @@ void Options::OptionValues::Initialise() {
     // Rotational velocity distribution options
     m_RotationalVelocityDistribution.type                           = ROTATIONAL_VELOCITY_DISTRIBUTION::ZERO;
     m_RotationalVelocityDistribution.typeString                     = ROTATIONAL_VELOCITY_DISTRIBUTION_LABEL.at(m_RotationalVelocityDistribution.type);
+    m_RotationalVelocityExactInverse                                = false;
 
     m_RotationalFrequency                                           = 0.0;
     m_RotationalFrequency1                                          = 0.0;
@@ -482,6 +525,8 @@ void Options::OptionValues::Initialise() {
 
 	m_GridFilename                                                  = "";
 
+    m_TrackLibraryFilename                                          = "";
+
 
     // debug and logging options
 
@@ -494,6 +539,8 @@ void Options::OptionValues::Initialise() {
     // Logfiles    
     m_LogfileDefinitionsFilename                                    = "";
     m_LogfileNamePrefix                                             = "";
+    m_LogfilePredicate                                              = "";
+    m_LogfilePredicateFiles.clear();
     m_LogfileType.type                                              = LOGFILETYPE::HDF5;
     m_LogfileType.typeString                                        = LOGFILETYPELabel.at(m_LogfileType.type);
 
@@ -511,8 +558,18 @@ void Options::OptionValues::Initialise() {
     m_AddOptionsToSysParms.typeString                               = ADD_OPTIONS_TO_SYSPARMS_LABEL.at(m_AddOptionsToSysParms.type);
     
     m_HDF5BufferSize                                                = HDF5_DEFAULT_IO_BUFFER_SIZE;
+    m_HDF5BufferMemory                                              = HDF5_DEFAULT_IO_BUFFER_MEMORY;
     m_HDF5ChunkSize                                                 = HDF5_DEFAULT_CHUNK_SIZE;
 
+    m_InitialSampling.type                                          = INITIAL_SAMPLING::PSEUDO_RANDOM;
+    m_InitialSampling.typeString                                    = INITIAL_SAMPLING_LABEL.at(m_InitialSampling.type);
+    m_InitialSamplingBlockSize                                      = 4096;
+
+    m_AISBatchSize                                                  = 1000;
+    m_AISExploratoryFraction                                        = 0.1;
+    m_AISHitPredicate                                               = "BINARY_PROPERTY::MERGES_IN_HUBBLE_TIME";
+    m_AISKappa                                                      = 1.0;
+
     po::variables_map vm;
     m_VM = vm;
 }
@@ -629,6 +686,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<bool>(&p_Options->m_AllowMainSequenceStarToSurviveCommonEnvelope)->default_value(p_Options->m_AllowMainSequenceStarToSurviveCommonEnvelope)->implicit_value(true),          
             ("Allow main sequence stars to survive common envelope evolution (default = " + std::string(p_Options->m_AllowMainSequenceStarToSurviveCommonEnvelope ? "TRUE" : "FALSE") + ")").c_str()
         )
+        (
+            "common-random-numbers",                                
+            po::value<bool>(&p_Options->m_CommonRandomNumbers)->default_value(p_Options->m_CommonRandomNumbers)->implicit_value(true),                                                            
+            ("Draw each random process (initial conditions, rotation, kicks, remnant masses, etc.) from its own random number substream, so option variations share random numbers where their histories coincide (default = " + std::string(p_Options->m_CommonRandomNumbers ? "TRUE" : "FALSE") + ")").c_str()
+        )
         (
             "cool-wind-mass-loss-multiplier",                           
             po::value<double>(&p_Options->m_CoolWindMassLossMultiplier)->default_value(p_Options->m_CoolWindMassLossMultiplier),                                                                  
@@ -664,11 +726,26 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<bool>(&p_Options->m_EvolveUnboundSystems)->default_value(p_Options->m_EvolveUnboundSystems)->implicit_value(true),                                                          
             ("Continue evolving stars even if the binary is disrupted (default = " + std::string(p_Options->m_EvolveUnboundSystems ? "TRUE" : "FALSE") + ")").c_str()
         )
+        (
+            "fast-forward-compact-binaries",                                      
+            po::value<bool>(&p_Options->m_FastForwardCompactBinaries)->default_value(p_Options->m_FastForwardCompactBinaries)->implicit_value(true),                                              
+            ("Jump detached compact-object binaries (WD, NS, BH) directly to their next event - coalescence, maximum evolution time, or output time - rather than timestepping (default = " + std::string(p_Options->m_FastForwardCompactBinaries ? "TRUE" : "FALSE") + ")").c_str()
+        )
+        (
+            "fork-variations",                                      
+            po::value<bool>(&p_Options->m_ForkVariations)->default_value(p_Options->m_ForkVariations)->implicit_value(true),                                                                      
+            ("Evolve the commandline option variations (ranges and sets) of each binary by forking the binary where a varied option is first read (default = " + std::string(p_Options->m_ForkVariations ? "TRUE" : "FALSE") + ")").c_str()
+        )
         (
             "mass-transfer",                                                
             po::value<bool>(&p_Options->m_UseMassTransfer)->default_value(p_Options->m_UseMassTransfer)->implicit_value(true),                                                                    
             ("Enable mass transfer (default = " + std::string(p_Options->m_UseMassTransfer ? "TRUE" : "FALSE") + ")").c_str()
         )
+        (
+            "non-interacting-fast-path",                                      
+            po::value<bool>(&p_Options->m_NonInteractingFastPath)->default_value(p_Options->m_NonInteractingFastPath)->implicit_value(true),                                                      
+            ("Evolve the stars of binaries that cannot interact before the first remnant forms independently up to just before it, rather than timestepping the binary (default = " + std::string(p_Options->m_NonInteractingFastPath ? "TRUE" : "FALSE") + ")").c_str()
+        )
         (
             "pair-instability-supernovae",                                 
             po::value<bool>(&p_Options->m_UsePairInstabilitySupernovae)->default_value(p_Options->m_UsePairInstabilitySupernovae)->implicit_value(true),                                          
@@ -679,6 +756,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<bool>(&p_Options->m_PopulationDataPrinting)->default_value(p_Options->m_PopulationDataPrinting)->implicit_value(true),                                                      
             ("Print details of population (default = " + std::string(p_Options->m_PopulationDataPrinting ? "TRUE" : "FALSE") + ")").c_str()
         )
+        (
+            "power-kernels",                                      
+            po::value<bool>(&p_Options->m_PowerKernels)->default_value(p_Options->m_PowerKernels)->implicit_value(true),                                                                          
+            ("Use the power function kernels rather than std::pow() for fixed exponents and shared bases at the most frequently called sites - faster, but results differ from std::pow() (default = " + std::string(p_Options->m_PowerKernels ? "TRUE" : "FALSE") + ")").c_str()
+        )
         (
             "print-bool-as-string",                                        
             po::value<bool>(&p_Options->m_PrintBoolAsString)->default_value(p_Options->m_PrintBoolAsString)->implicit_value(true),                                                                
@@ -704,11 +786,26 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<bool>(&p_Options->m_RlofPrinting)->default_value(p_Options->m_RlofPrinting)->implicit_value(true),                                                                          
             ("Enable output parameters before/after RLOF (default = " + std::string(p_Options->m_RlofPrinting ? "TRUE" : "FALSE") + ")").c_str()
         )
+        (
+            "rotational-velocity-exact-inverse",                                                
+            po::value<bool>(&p_Options->m_RotationalVelocityExactInverse)->default_value(p_Options->m_RotationalVelocityExactInverse)->implicit_value(true),                                                      
+            ("Sample O-star rotational velocities (VLTFLAMES) by root-solving the CDF for every star rather than from the precomputed inverse-CDF table (validation; default = " + std::string(p_Options->m_RotationalVelocityExactInverse ? "TRUE" : "FALSE") + ")").c_str()
+        )
+        (
+            "stage-system-records",                                                
+            po::value<bool>(&p_Options->m_StageSystemRecords)->default_value(p_Options->m_StageSystemRecords)->implicit_value(true),                                                              
+            ("Stage BSE logfile records (except detailed output) per system, discarding all but the system parameters of systems whose evolution ends in error (default = " + std::string(p_Options->m_StageSystemRecords ? "TRUE" : "FALSE") + ")").c_str()
+        )
         (
             "switch-log",                                                
             po::value<bool>(&p_Options->m_SwitchLog)->default_value(p_Options->m_SwitchLog)->implicit_value(true),                                                                          
             ("Print switch log to file (default = " + std::string(p_Options->m_SwitchLog ? "TRUE" : "FALSE") + ")").c_str()
         )
+        (
+            "timestep-radial-change-prediction",
+            po::value<bool>(&p_Options->m_TimestepRadialChangePrediction)->default_value(p_Options->m_TimestepRadialChangePrediction)->implicit_value(true),
+            ("Shorten SSE timesteps up front when the radial change predicted from the previous timestep is too large, rather than only by retrying them (default = " + std::string(p_Options->m_TimestepRadialChangePrediction ? "TRUE" : "FALSE") + ")").c_str()
+        )
         (
             "use-mass-loss",                                               
             po::value<bool>(&p_Options->m_UseMassLoss)->default_value(p_Options->m_UseMassLoss)->implicit_value(true),                                                                            
@@ -730,11 +827,21 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
 
         // int
 
+        (
+            "ais-batch-size",                                                 
+            po::value<int>(&p_Options->m_AISBatchSize)->default_value(p_Options->m_AISBatchSize),                                                                                                     
+            ("Adaptive importance sampling: number of binaries between proposal refits (default = " + std::to_string(p_Options->m_AISBatchSize) + ")").c_str()
+        )
         (
             "debug-level",                                                 
             po::value<int>(&p_Options->m_DebugLevel)->default_value(p_Options->m_DebugLevel),                                                                                                     
             ("Determines which print statements are displayed for debugging (default = " + std::to_string(p_Options->m_DebugLevel) + ")").c_str()
         )
+        (
+            "detailed-output-sample-interval",                                 
+            po::value<int>(&p_Options->m_DetailedOutputSampleInterval)->default_value(p_Options->m_DetailedOutputSampleInterval),                                                                 
+            ("Print a BSE detailed output record every this many timesteps - stellar type changes and events always printed (default = " + std::to_string(p_Options->m_DetailedOutputSampleInterval) + ")").c_str()
+        )
         (
             "hdf5-chunk-size",                                                 
             po::value<int>(&p_Options->m_HDF5ChunkSize)->default_value(p_Options->m_HDF5ChunkSize),                                                                                                     
@@ -745,6 +852,21 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<int>(&p_Options->m_HDF5BufferSize)->default_value(p_Options->m_HDF5BufferSize),                                                                                                     
             ("HDF5 file dataset IO buffer size (number of chunks, default = " + std::to_string(p_Options->m_HDF5BufferSize) + ")").c_str()
         )
+        (
+            "hdf5-buffer-memory",                                                 
+            po::value<int>(&p_Options->m_HDF5BufferMemory)->default_value(p_Options->m_HDF5BufferMemory),                                                                                                     
+            ("Memory budget for all HDF5 dataset IO buffers (MB, 0 = no budget, default = " + std::to_string(p_Options->m_HDF5BufferMemory) + ")").c_str()
+        )
+        (
+            "initial-sampling-block-size",                                                 
+            po::value<int>(&p_Options->m_InitialSamplingBlockSize)->default_value(p_Options->m_InitialSamplingBlockSize),                                                                                     
+            ("Number of systems whose initial conditions are drawn together with --initial-sampling BLOCK (default = " + std::to_string(p_Options->m_InitialSamplingBlockSize) + ")").c_str()
+        )
+        (
+            "kick-resamples",                                                 
+            po::value<int>(&p_Options->m_KickResamples)->default_value(p_Options->m_KickResamples),                                                                                                   
+            ("Continue each binary from its (first, or each) supernova under this many independent kick draws (1 = no resampling, default = " + std::to_string(p_Options->m_KickResamples) + ")").c_str()
+        )
         (
             "log-level",                                                   
             po::value<int>(&p_Options->m_LogLevel)->default_value(p_Options->m_LogLevel),                                                                                                         
@@ -764,6 +886,16 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
 
         // double
 
+        (
+            "ais-exploratory-fraction",                                       
+            po::value<double>(&p_Options->m_AISExploratoryFraction)->default_value(p_Options->m_AISExploratoryFraction),                                                                          
+            ("Adaptive importance sampling: fraction of binaries sampled from the prior in the exploration phase, and defensive fraction of the proposal (default = " + std::to_string(p_Options->m_AISExploratoryFraction) + ")").c_str()
+        )
+        (
+            "ais-kappa",                                       
+            po::value<double>(&p_Options->m_AISKappa)->default_value(p_Options->m_AISKappa),                                                                                                      
+            ("Adaptive importance sampling: proposal component width scale factor (default = " + std::to_string(p_Options->m_AISKappa) + ")").c_str()
+        )
         (
             "common-envelope-alpha",                                       
             po::value<double>(&p_Options->m_CommonEnvelopeAlpha)->default_value(p_Options->m_CommonEnvelopeAlpha),                                                                                
@@ -894,6 +1026,21 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
         )
         */
 
+        (
+            "detailed-output-mass-delta",                                  
+            po::value<double>(&p_Options->m_DetailedOutputMassDelta)->default_value(p_Options->m_DetailedOutputMassDelta),                                                                        
+            ("Also print a BSE detailed output record if either star's mass has changed by more than this fraction since the last record (0 = disabled, default = " + std::to_string(p_Options->m_DetailedOutputMassDelta) + ")").c_str()
+        )
+        (
+            "detailed-output-radius-delta",                                
+            po::value<double>(&p_Options->m_DetailedOutputRadiusDelta)->default_value(p_Options->m_DetailedOutputRadiusDelta),                                                                    
+            ("Also print a BSE detailed output record if either star's radius has changed by more than this fraction since the last record (0 = disabled, default = " + std::to_string(p_Options->m_DetailedOutputRadiusDelta) + ")").c_str()
+        )
+        (
+            "detailed-output-separation-delta",                            
+            po::value<double>(&p_Options->m_DetailedOutputSeparationDelta)->default_value(p_Options->m_DetailedOutputSeparationDelta),                                                            
+            ("Also print a BSE detailed output record if the semi-major axis has changed by more than this fraction since the last record (0 = disabled, default = " + std::to_string(p_Options->m_DetailedOutputSeparationDelta) + ")").c_str()
+        )
         (
             "eccentricity,e",                                            
             po::value<double>(&p_Options->m_Eccentricity)->default_value(p_Options->m_Eccentricity),                                                                
@@ -914,6 +1061,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<double>(&p_Options->m_EddingtonAccretionFactor)->default_value(p_Options->m_EddingtonAccretionFactor),                                                                      
             ("Multiplication factor for eddington accretion for NS & BH, i.e. >1 is super-eddington and 0. is no accretion (default = " + std::to_string(p_Options->m_EddingtonAccretionFactor) + ")").c_str()
         )
+        (
+            "fast-forward-output-interval",                                  
+            po::value<double>(&p_Options->m_FastForwardOutputInterval)->default_value(p_Options->m_FastForwardOutputInterval),                                                                    
+            ("Fast-forwarded binaries (--fast-forward-compact-binaries) also stop, and are logged, at multiples of this time in Myr (0 = disabled, default = " + std::to_string(p_Options->m_FastForwardOutputInterval) + ")").c_str()
+        )
 
         (
             "fix-dimensionless-kick-magnitude",                            
@@ -1079,6 +1231,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<double>(&p_Options->m_MassTransferJloss)->default_value(p_Options->m_MassTransferJloss),                                                                                    
             ("Specific angular momentum with which the non-accreted system leaves the system (default = " + std::to_string(p_Options->m_MassTransferJloss) + ")").c_str()
         )
+        (
+            "mass-transfer-orbit-tolerance",                                         
+            po::value<double>(&p_Options->m_MassTransferOrbitTolerance)->default_value(p_Options->m_MassTransferOrbitTolerance),                                                                  
+            ("Absolute and relative tolerance of the adaptive integration of the orbit (ln a) through mass transfer (default = " + std::to_string(p_Options->m_MassTransferOrbitTolerance) + ")").c_str()
+        )
         (
             "mass-transfer-thermal-limit-C",                               
             po::value<double>(&p_Options->m_MassTransferCParameter)->default_value(p_Options->m_MassTransferCParameter),                                                                          
@@ -1290,6 +1447,12 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             ("Add program options columns to BSE/SSE SysParms file (options: [ALWAYS, GRID, NEVER], default = " + p_Options->m_AddOptionsToSysParms.typeString + ")").c_str()
         )
 
+        (
+            "ais-hit-predicate",                                            
+            po::value<std::string>(&p_Options->m_AISHitPredicate)->default_value(p_Options->m_AISHitPredicate),                                                                              
+            ("Adaptive importance sampling: predicate a binary must satisfy to be a hit (default = " + p_Options->m_AISHitPredicate + ")").c_str()
+        )
+
         (
             "black-hole-kicks",                                            
             po::value<std::string>(&p_Options->m_BlackHoleKicks.typeString)->default_value(p_Options->m_BlackHoleKicks.typeString),                                                                              
@@ -1306,6 +1469,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_CheMode.typeString)->default_value(p_Options->m_CheMode.typeString),                                                                                                    
             ("Chemically Homogeneous Evolution (options: [NONE, OPTIMISTIC, PESSIMISTIC], default = " + p_Options->m_CheMode.typeString + ")").c_str()
         )
+        (
+            "coalescence-time-kernel",                                 
+            po::value<std::string>(&p_Options->m_CoalescenceTimeKernel.typeString)->default_value(p_Options->m_CoalescenceTimeKernel.typeString),                                                        
+            ("Evaluation of the time to coalescence of eccentric binaries (options: [TABULATED, INTEGRAL, VALIDATE], default = " + p_Options->m_CoalescenceTimeKernel.typeString + ")").c_str()
+        )
         (
             "common-envelope-lambda-prescription",                         
             po::value<std::string>(&p_Options->m_CommonEnvelopeLambdaPrescription.typeString)->default_value(p_Options->m_CommonEnvelopeLambdaPrescription.typeString),                                          
@@ -1316,6 +1484,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_CommonEnvelopeMassAccretionPrescription.typeString)->default_value(p_Options->m_CommonEnvelopeMassAccretionPrescription.typeString),                            
             ("Assumption about whether NS/BHs can accrete mass during common envelope evolution (options: [ZERO, CONSTANT, UNIFORM, MACLEOD], default = " + p_Options->m_CommonEnvelopeMassAccretionPrescription.typeString + ")").c_str()
         )
+        (
+            "culling-mode",
+            po::value<std::string>(&p_Options->m_CullingMode.typeString)->default_value(p_Options->m_CullingMode.typeString),
+            ("Stop the evolution of binaries that can no longer form the systems of interest (options: [NONE, DCO], default = " + p_Options->m_CullingMode.typeString + ")").c_str()
+        )
         
         (
             "eccentricity-distribution",                                 
@@ -1345,6 +1518,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_InitialMassFunction.typeString)->default_value(p_Options->m_InitialMassFunction.typeString),                                                                    
             ("Initial mass function (options: [SALPETER, POWERLAW, UNIFORM, KROUPA], default = " + p_Options->m_InitialMassFunction.typeString + ")").c_str()
         )
+        (
+            "initial-sampling",                                     
+            po::value<std::string>(&p_Options->m_InitialSampling.typeString)->default_value(p_Options->m_InitialSampling.typeString),                                                                    
+            ("Initial-condition sampling (options: [PSEUDO_RANDOM, QMC, AIS, BLOCK], default = " + p_Options->m_InitialSampling.typeString + ")").c_str()
+        )
 
         (
             "kick-direction",                                              
@@ -1356,6 +1534,16 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_KickMagnitudeDistribution.typeString)->default_value(p_Options->m_KickMagnitudeDistribution.typeString),                                                        
             ("Natal kick magnitude distribution (options: [ZERO, FIXED, FLAT, MAXWELLIAN, BRAYELDRIDGE, MULLER2016, MULLER2016MAXWELLIAN, MULLERMANDEL], default = " + p_Options->m_KickMagnitudeDistribution.typeString + ")").c_str()
         )
+        (
+            "kick-resample-supernovae",                                 
+            po::value<std::string>(&p_Options->m_KickResampleSupernovae.typeString)->default_value(p_Options->m_KickResampleSupernovae.typeString),                                                      
+            ("Supernovae resampled with --kick-resamples (options: [FIRST, EACH], default = " + p_Options->m_KickResampleSupernovae.typeString + ")").c_str()
+        )
+        (
+            "kick-sampling",                                 
+            po::value<std::string>(&p_Options->m_KickSampling.typeString)->default_value(p_Options->m_KickSampling.typeString),                                                                          
+            ("Kick magnitude inverse-CDF evaluation (options: [TABULATED, EXACT, VALIDATE], default = " + p_Options->m_KickSampling.typeString + ")").c_str()
+        )
 
         // Serena
         /*
@@ -1411,6 +1599,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_LogfileNamePrefix)->default_value(p_Options->m_LogfileNamePrefix)->implicit_value(""),                                                                
             ("Prefix for logfile names (default = " + p_Options->m_LogfileNamePrefix + ")").c_str()
         )
+        (
+            "logfile-predicate",                                           
+            po::value<std::string>(&p_Options->m_LogfilePredicate)->default_value(p_Options->m_LogfilePredicate)->implicit_value(""),                                                                  
+            ("Predicate a binary must satisfy for its records to be written to the predicate logfiles (default = " + p_Options->m_LogfilePredicate + ")").c_str()
+        )
         (
             "logfile-switch-log",                                      
             po::value<std::string>(&p_Options->m_LogfileSwitchLog)->default_value(p_Options->m_LogfileSwitchLog),                                                                                
@@ -1447,6 +1640,16 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_MassTransferAngularMomentumLossPrescription.typeString)->default_value(p_Options->m_MassTransferAngularMomentumLossPrescription.typeString),                    
             ("Mass Transfer Angular Momentum Loss prescription (options: [JEANS, ISOTROPIC, CIRCUMBINARY, ARBITRARY], default = " + p_Options->m_MassTransferAngularMomentumLossPrescription.typeString + ")").c_str()
         )
+        (
+            "mass-transfer-donor-radius-response",            
+            po::value<std::string>(&p_Options->m_MassTransferDonorRadiusResponse.typeString)->default_value(p_Options->m_MassTransferDonorRadiusResponse.typeString),                                            
+            ("Radius of a donor without an envelope after mass loss, in the Roche lobe root solver (options: [MODEL, CLONE, VALIDATE], default = " + p_Options->m_MassTransferDonorRadiusResponse.typeString + ")").c_str()
+        )
+        (
+            "mass-transfer-orbit-integrator",            
+            po::value<std::string>(&p_Options->m_MassTransferOrbitIntegrator.typeString)->default_value(p_Options->m_MassTransferOrbitIntegrator.typeString),                                                    
+            ("Evolution of the orbit through mass transfer (options: [ANALYTIC, ADAPTIVE, EULER, VALIDATE], default = " + p_Options->m_MassTransferOrbitIntegrator.typeString + ")").c_str()
+        )
         (
             "mass-transfer-rejuvenation-prescription",                     
             po::value<std::string>(&p_Options->m_MassTransferRejuvenationPrescription.typeString)->default_value(p_Options->m_MassTransferRejuvenationPrescription.typeString),                                  
@@ -1532,6 +1735,16 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<std::string>(&p_Options->m_StellarZetaPrescription.typeString)->default_value(p_Options->m_StellarZetaPrescription.typeString),                                                            
             ("Prescription for stellar zeta (default = " + p_Options->m_StellarZetaPrescription.typeString + ")").c_str()
         )
+        (
+            "track-library",
+            po::value<std::string>(&p_Options->m_TrackLibraryFilename)->default_value(p_Options->m_TrackLibraryFilename),
+            ("Single star track library filename (HDF5), written by --track-library-mode CREATE and read by --track-library-mode INTERPOLATE (default = " + p_Options->m_TrackLibraryFilename + ")").c_str()
+        )
+        (
+            "track-library-mode",
+            po::value<std::string>(&p_Options->m_TrackLibraryMode.typeString)->default_value(p_Options->m_TrackLibraryMode.typeString),
+            ("Single star track library mode: create the library, or skip the detached evolution of binaries by interpolation on it (options: [NONE, CREATE, INTERPOLATE], default = " + p_Options->m_TrackLibraryMode.typeString + ")").c_str()
+        )
 
 
         // vector (list) options - alphabetically
@@ -1546,6 +1759,11 @@ bool Options::AddOptions(OptionValues *p_Options, po::options_description *p_Opt
             po::value<vector<std::string>>(&p_Options->m_LogClasses)->multitoken()->default_value(p_Options->m_LogClasses),                                                                            
             ("Logging classes enabled (default = " + defaultLogClasses + ")").c_str()
         )
+        (
+            "logfile-predicate-files",                                     
+            po::value<vector<std::string>>(&p_Options->m_LogfilePredicateFiles)->multitoken()->default_value(p_Options->m_LogfilePredicateFiles),                                                      
+            "Logfiles gated by the logfile predicate (default = all BSE logfiles except BSE_DETAILED)"
+        )
     
         ;   // end the list of options to be added
 
@@ -1694,6 +1912,37 @@ std::string Options::OptionValues::SetCalculatedOptionDefaults(const bool p_Modi
 }
 
 
+/*
+ * Copy the option values calculated or drawn from distributions (see SetCalculatedOptionDefaults())
+ *
+ * Only values not specified by the user are copied.
+ *
+ * Note this is a class OptionValues function.
+ *
+ *
+ * void CopyCalculatedOptionDefaults(const OptionValues& p_OptionValues)
+ *
+ * @param   [IN]    p_OptionValues              Option values from which the calculated values are copied
+ */
+void Options::OptionValues::CopyCalculatedOptionDefaults(const OptionValues& p_OptionValues) {
+#define DEFAULTED(opt) m_VM[opt].defaulted()    // for convenience and readability - undefined at end of function
+
+    if (DEFAULTED("kick-magnitude-random"))   m_KickMagnitudeRandom  = p_OptionValues.m_KickMagnitudeRandom;
+    if (DEFAULTED("kick-magnitude-random-1")) m_KickMagnitudeRandom1 = p_OptionValues.m_KickMagnitudeRandom1;
+    if (DEFAULTED("kick-magnitude-random-2")) m_KickMagnitudeRandom2 = p_OptionValues.m_KickMagnitudeRandom2;
+
+    if (DEFAULTED("kick-mean-anomaly-1"))     m_KickMeanAnomaly1     = p_OptionValues.m_KickMeanAnomaly1;
+    if (DEFAULTED("kick-mean-anomaly-2"))     m_KickMeanAnomaly2     = p_OptionValues.m_KickMeanAnomaly2;
+
+    if (DEFAULTED("kick-phi-1"))              m_KickPhi1             = p_OptionValues.m_KickPhi1;
+    if (DEFAULTED("kick-theta-1"))            m_KickTheta1           = p_OptionValues.m_KickTheta1;
+    if (DEFAULTED("kick-phi-2"))              m_KickPhi2             = p_OptionValues.m_KickPhi2;
+    if (DEFAULTED("kick-theta-2"))            m_KickTheta2           = p_OptionValues.m_KickTheta2;
+
+#undef DEFAULTED
+}
+
+
 /*
  * Sanity check options and option values
  * 
@@ -1753,6 +2002,11 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             COMPLAIN_IF(!found, "Unknown Chemically Homogeneous Evolution Option");
         }
 
+        if (!DEFAULTED("coalescence-time-kernel")) {                                                                                // coalescence time kernel
+            std::tie(found, m_CoalescenceTimeKernel.type) = utils::GetMapKey(m_CoalescenceTimeKernel.typeString, COALESCENCE_TIME_KERNEL_LABEL, m_CoalescenceTimeKernel.type);
+            COMPLAIN_IF(!found, "Unknown Coalescence Time Kernel");
+        }
+
         if (!DEFAULTED("common-envelope-lambda-prescription")) {                                                                    // common envelope lambda prescription
             std::tie(found, m_CommonEnvelopeLambdaPrescription.type) = utils::GetMapKey(m_CommonEnvelopeLambdaPrescription.typeString, CE_LAMBDA_PRESCRIPTION_LABEL, m_CommonEnvelopeLambdaPrescription.type);
             COMPLAIN_IF(!found, "Unknown CE Lambda Prescription");
@@ -1762,6 +2016,11 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             std::tie(found, m_CommonEnvelopeMassAccretionPrescription.type) = utils::GetMapKey(m_CommonEnvelopeMassAccretionPrescription.typeString, CE_ACCRETION_PRESCRIPTION_LABEL, m_CommonEnvelopeMassAccretionPrescription.type);
             COMPLAIN_IF(!found, "Unknown CE Mass Accretion Prescription");
         }
+
+        if (!DEFAULTED("culling-mode")) {                                                                                           // culling mode
+            std::tie(found, m_CullingMode.type) = utils::GetMapKey(m_CullingMode.typeString, CULLING_MODE_LABEL, m_CullingMode.type);
+            COMPLAIN_IF(!found, "Unknown Culling Mode");
+        }
             
         if (!DEFAULTED("envelope-state-prescription")) {                                                                            // envelope state prescription
             std::tie(found, m_EnvelopeStatePrescription.type) = utils::GetMapKey(m_EnvelopeStatePrescription.typeString, ENVELOPE_STATE_PRESCRIPTION_LABEL, m_EnvelopeStatePrescription.type);
@@ -1783,6 +2042,11 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             COMPLAIN_IF(!found, "Unknown Initial Mass Function");
         }
 
+        if (!DEFAULTED("initial-sampling")) {                                                                                       // initial-condition sampling
+            std::tie(found, m_InitialSampling.type) = utils::GetMapKey(m_InitialSampling.typeString, INITIAL_SAMPLING_LABEL, m_InitialSampling.type);
+            COMPLAIN_IF(!found, "Unknown Initial Sampling mode");
+        }
+
         if (!DEFAULTED("kick-direction")) {                                                                                         // kick direction
             std::tie(found, m_KickDirectionDistribution.type) = utils::GetMapKey(m_KickDirectionDistribution.typeString, KICK_DIRECTION_DISTRIBUTION_LABEL, m_KickDirectionDistribution.type);
             COMPLAIN_IF(!found, "Unknown Kick Direction Distribution");
@@ -1793,6 +2057,16 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             COMPLAIN_IF(!found, "Unknown Kick Magnitude Distribution");
         }
 
+        if (!DEFAULTED("kick-resample-supernovae")) {                                                                               // kick resample supernovae
+            std::tie(found, m_KickResampleSupernovae.type) = utils::GetMapKey(m_KickResampleSupernovae.typeString, KICK_RESAMPLE_SUPERNOVAE_LABEL, m_KickResampleSupernovae.type);
+            COMPLAIN_IF(!found, "Unknown Kick Resample Supernovae option");
+        }
+
+        if (!DEFAULTED("kick-sampling")) {                                                                                          // kick sampling
+            std::tie(found, m_KickSampling.type) = utils::GetMapKey(m_KickSampling.typeString, KICK_SAMPLING_LABEL, m_KickSampling.type);
+            COMPLAIN_IF(!found, "Unknown Kick Sampling mode");
+        }
+
         if (!DEFAULTED("logfile-type")) {                                                                                           // logfile type
             std::tie(found, m_LogfileType.type) = utils::GetMapKey(m_LogfileType.typeString, LOGFILETYPELabel, m_LogfileType.type);
             COMPLAIN_IF(!found, "Unknown Logfile Type");
@@ -1823,6 +2097,16 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             COMPLAIN_IF(!found, "Unknown Mass Transfer Angular Momentum Loss Prescription");
         }
 
+        if (m_UseMassTransfer && !DEFAULTED("mass-transfer-donor-radius-response")) {                                               // mass transfer donor radius response
+            std::tie(found, m_MassTransferDonorRadiusResponse.type) = utils::GetMapKey(m_MassTransferDonorRadiusResponse.typeString, MT_DONOR_RADIUS_RESPONSE_LABEL, m_MassTransferDonorRadiusResponse.type);
+            COMPLAIN_IF(!found, "Unknown Mass Transfer Donor Radius Response");
+        }
+
+        if (m_UseMassTransfer && !DEFAULTED("mass-transfer-orbit-integrator")) {                                                    // mass transfer orbit integrator
+            std::tie(found, m_MassTransferOrbitIntegrator.type) = utils::GetMapKey(m_MassTransferOrbitIntegrator.typeString, MT_ORBIT_INTEGRATOR_LABEL, m_MassTransferOrbitIntegrator.type);
+            COMPLAIN_IF(!found, "Unknown Mass Transfer Orbit Integrator");
+        }
+
         if (m_UseMassTransfer && !DEFAULTED("mass-transfer-rejuvenation-prescription")) {                                           // mass transfer rejuvenation prescription
             std::tie(found, m_MassTransferRejuvenationPrescription.type) = utils::GetMapKey(m_MassTransferRejuvenationPrescription.typeString, MT_REJUVENATION_PRESCRIPTION_LABEL, m_MassTransferRejuvenationPrescription.type);
             COMPLAIN_IF(!found, "Unknown Mass Transfer Rejuvenation Prescription");
@@ -1896,8 +2180,17 @@ std::string Options::OptionValues::CheckAndSetOptions() {
             COMPLAIN_IF(!found, "Unknown stellar Zeta Prescription");
         }
 
+        if (!DEFAULTED("track-library-mode")) {                                                                                     // track library mode
+            std::tie(found, m_TrackLibraryMode.type) = utils::GetMapKey(m_TrackLibraryMode.typeString, TRACK_LIBRARY_MODE_LABEL, m_TrackLibraryMode.type);
+            COMPLAIN_IF(!found, "Unknown Track Library Mode");
+        }
+
         // constraint/value/range checks - alphabetically (where possible)
 
+        COMPLAIN_IF(m_AISBatchSize < 1, "Adaptive importance sampling batch size (--ais-batch-size) must be >= 1");
+        COMPLAIN_IF(m_AISExploratoryFraction <= 0.0 || m_AISExploratoryFraction >= 1.0, "Adaptive importance sampling exploratory fraction (--ais-exploratory-fraction) must be > 0 and < 1");
+        COMPLAIN_IF(m_AISKappa <= 0.0, "Adaptive importance sampling kappa (--ais-kappa) must be > 0");
+
         COMPLAIN_IF(m_CommonEnvelopeAlpha < 0.0, "CE alpha (--common-envelope-alpha) < 0");
         COMPLAIN_IF(m_CommonEnvelopeAlphaThermal < 0.0 || m_CommonEnvelopeAlphaThermal > 1.0, "CE alpha thermal (--common-envelope-alpha-thermal) must be between 0 and 1");
         COMPLAIN_IF(m_CommonEnvelopeLambdaMultiplier < 0.0, "CE lambda multiplie (--common-envelope-lambda-multiplier < 0");
@@ -1914,9 +2207,23 @@ std::string Options::OptionValues::CheckAndSetOptions() {
         COMPLAIN_IF(m_EccentricityDistributionMax < 0.0 || m_EccentricityDistributionMax > 1.0, "Maximum eccentricity (--eccentricity-max) must be between 0 and 1");
         COMPLAIN_IF(m_EccentricityDistributionMax <= m_EccentricityDistributionMin, "Maximum eccentricity (--eccentricity-max) must be > Minimum eccentricity (--eccentricity-min)");
 
+        COMPLAIN_IF(m_DetailedOutputSampleInterval < 1, "Detailed output sample interval (--detailed-output-sample-interval) must be >= 1");
+        COMPLAIN_IF(m_DetailedOutputMassDelta < 0.0, "Detailed output mass delta (--detailed-output-mass-delta) must be >= 0");
+        COMPLAIN_IF(m_DetailedOutputRadiusDelta < 0.0, "Detailed output radius delta (--detailed-output-radius-delta) must be >= 0");
+        COMPLAIN_IF(m_DetailedOutputSeparationDelta < 0.0, "Detailed output separation delta (--detailed-output-separation-delta) must be >= 0");
+
+        COMPLAIN_IF(m_HDF5BufferMemory < 0, "HDF5 IO buffer memory budget (--hdf5-buffer-memory) must be >= 0");
         COMPLAIN_IF(m_HDF5BufferSize < 1, "HDF5 IO buffer size (--hdf5-buffer-size) must be >= 1");
         COMPLAIN_IF(m_HDF5ChunkSize < HDF5_MINIMUM_CHUNK_SIZE, "HDF5 file dataset chunk size (--hdf5-chunk-size) must be >= minimum chunk size of " + std::to_string(HDF5_MINIMUM_CHUNK_SIZE));
 
+        COMPLAIN_IF(m_InitialSampling.type == INITIAL_SAMPLING::AIS && m_EvolutionMode.type != EVOLUTION_MODE::BSE, "Adaptive importance sampling (--initial-sampling AIS) is only available in BSE mode");
+        COMPLAIN_IF(m_InitialSamplingBlockSize < 1, "Initial sampling block size (--initial-sampling-block-size) must be >= 1");
+
+        COMPLAIN_IF(m_KickResamples < 1, "Number of kick resamples (--kick-resamples) must be >= 1");
+
+        COMPLAIN_IF(m_ForkVariations && m_InitialSampling.type == INITIAL_SAMPLING::AIS, "Forked evolution of option variations (--fork-variations) is not available with adaptive importance sampling (--initial-sampling AIS)");
+        COMPLAIN_IF(m_ForkVariations && m_DetailedOutput, "Forked evolution of option variations (--fork-variations) is not available with detailed output (--detailed-output)");
+
         COMPLAIN_IF(m_InitialMass < MINIMUM_INITIAL_MASS || m_InitialMass > MAXIMUM_INITIAL_MASS, "Initial mass (--initial-mass) must be between " + std::to_string(MINIMUM_INITIAL_MASS) + " and " + std::to_string(MAXIMUM_INITIAL_MASS) + " Msol");
         COMPLAIN_IF(m_InitialMass1 < MINIMUM_INITIAL_MASS || m_InitialMass1 > MAXIMUM_INITIAL_MASS, "Primary initial mass (--initial-mass-1) must be between " + std::to_string(MINIMUM_INITIAL_MASS) + " and " + std::to_string(MAXIMUM_INITIAL_MASS) + " Msol");
         COMPLAIN_IF(m_InitialMass2 < MINIMUM_INITIAL_MASS || m_InitialMass2 > MAXIMUM_INITIAL_MASS, "Secondary initial mass (--initial-mass-2) must be between " + std::to_string(MINIMUM_INITIAL_MASS) + " and " + std::to_string(MAXIMUM_INITIAL_MASS) + " Msol");
@@ -1941,6 +2248,10 @@ std::string Options::OptionValues::CheckAndSetOptions() {
 
         COMPLAIN_IF(m_MaxEvolutionTime <= 0.0, "Maximum evolution time in Myr (--maxEvolutionTime) must be > 0");
 
+        COMPLAIN_IF(m_FastForwardOutputInterval < 0.0, "Fast-forward output interval (--fast-forward-output-interval) < 0");
+
+        COMPLAIN_IF(m_MassTransferOrbitTolerance <= 0.0, "Mass transfer orbit tolerance (--mass-transfer-orbit-tolerance) <= 0");
+
         COMPLAIN_IF(m_Metallicity < MINIMUM_METALLICITY || m_Metallicity > MAXIMUM_METALLICITY, "Metallicity (--metallicity) should be absolute metallicity and must be between " + std::to_string(MINIMUM_METALLICITY) + " and " + std::to_string(MAXIMUM_METALLICITY));
         COMPLAIN_IF(m_MetallicityDistributionMin < MINIMUM_METALLICITY || m_MetallicityDistributionMin > MAXIMUM_METALLICITY, "Minimum metallicity (--metallicity-min) must be between " + std::to_string(MINIMUM_METALLICITY) + " and " + std::to_string(MAXIMUM_METALLICITY));
         COMPLAIN_IF(m_MetallicityDistributionMax < MINIMUM_METALLICITY || m_MetallicityDistributionMax > MAXIMUM_METALLICITY, "Maximum metallicity (--metallicity-max) must be between " + std::to_string(MINIMUM_METALLICITY) + " and " + std::to_string(MAXIMUM_METALLICITY));
@@ -1988,6 +2299,9 @@ std::string Options::OptionValues::CheckAndSetOptions() {
 
         COMPLAIN_IF(m_TimestepMultiplier <= 0.0, "Timestep multiplier (--timestep-multiplier) <= 0");
 
+        COMPLAIN_IF(m_TrackLibraryMode.type != TRACK_LIBRARY_MODE::NONE && m_TrackLibraryFilename.empty(), "Track library mode (--track-library-mode) " + m_TrackLibraryMode.typeString + " requires a track library filename (--track-library)");
+        COMPLAIN_IF(m_TrackLibraryMode.type == TRACK_LIBRARY_MODE::INTERPOLATE && m_EvolutionMode.type != EVOLUTION_MODE::BSE, "Interpolation on the track library (--track-library-mode INTERPOLATE) is only available in BSE mode");
+
         COMPLAIN_IF(m_WolfRayetFactor < 0.0, "WR multiplier (--wolf-rayet-multiplier) < 0");
 
         COMPLAIN_IF(!DEFAULTED("initial-mass")   && m_InitialMass  <= 0.0, "Initial mass (--initial-mass) <= 0");                   // initial mass must be > 0.0
@@ -2947,6 +3261,12 @@ bool Options::Initialise(int p_ArgCount, char *p_ArgStrings[]) {
 
                     m_CmdLineOptionsDetails = OptionDetails(m_CmdLine);                                             // yes - get Run_Details contents
 
+                    m_CmdLineFirstVariation           = m_CmdLine.optionValues;                                     // bookmark the first variation of the commandline options ...
+                    m_CmdLineFirstComplexOptionValues = m_CmdLine.complexOptionValues;                              // ... for RewindCmdLineOptionValues()
+
+                    m_SweptOptions.clear();                                                                         // options specified as ranges or sets on the commandline
+                    for (auto &complexOptionValue : m_CmdLine.complexOptionValues) m_SweptOptions.push_back(get<0>(complexOptionValue));
+
                     // initialise evolving object-level options.  The values of options specified in a grid file
                     // take precedence over the values of the same options specified on the commandline, but only
                     // for the object (star/binary) corresponding to the grid file record.
@@ -3211,6 +3531,155 @@ int Options::AdvanceOptionVariation(OptionsDescriptorT &p_OptionsDescriptor) {
 }
 
 
+/*
+ * Advance the commandline options to their next variation for forked evolution
+ *
+ * As AdvanceCmdLineOptionValues(), but the option values calculated or drawn from distributions (see
+ * SetCalculatedOptionDefaults() - e.g. the kick random numbers) are kept: all forks of a binary (see
+ * --fork-variations) are evolved with the values drawn for the binary.
+ *
+ *
+ * int AdvanceCmdLineForkVariation()
+ *
+ * @return                                      Int result:
+ *                                                  -1: an error occurred
+ *                                                   0: no more variations - all done
+ *                                                   1: new variation applied - option values are set
+ */
+int Options::AdvanceCmdLineForkVariation() {
+
+    OptionValues binaryOptionValues = m_CmdLine.optionValues;                               // values drawn for the binary
+
+    int retVal = AdvanceCmdLineOptionValues();
+    if (retVal > 0) m_CmdLine.optionValues.CopyCalculatedOptionDefaults(binaryOptionValues);
+
+    return retVal;
+}
+
+
+/*
+ * Rewind the commandline options to their first variation
+ *
+ * Restores the values of the commandline options, and the positions of the commandline ranges and sets,
+ * to those of the first variation - so the variations can be played out again by AdvanceCmdLineForkVariation() -
+ * then draws new calculated option values (see SetCalculatedOptionDefaults()), as AdvanceCmdLineOptionValues()
+ * does for each binary.  Used by forked evolution of option variations (--fork-variations), where the variations
+ * are played out for each binary.
+ *
+ *
+ * int RewindCmdLineOptionValues()
+ *
+ * @return                                      Int result:
+ *                                                  -1: an error occurred
+ *                                                   0: options rewound
+ */
+int Options::RewindCmdLineOptionValues() {
+
+    bool populated = m_CmdLine.optionValues.m_Populated;                                    // bookmark was taken before the options were flagged populated
+
+    m_CmdLine.optionValues             = m_CmdLineFirstVariation;
+    m_CmdLine.optionValues.m_Populated = populated;
+    m_CmdLine.complexOptionValues      = m_CmdLineFirstComplexOptionValues;
+
+    return m_CmdLine.optionValues.SetCalculatedOptionDefaults(false) == "" ? 0 : -1;
+}
+
+
+/*
+ * Count the variations of the command or grid line options
+ *
+ * A "variation" is a combination of options defined by the option values, ranges, and sets the user
+ * specified on the commandline or grid file line (see AdvanceOptionVariation()).  The number of variations
+ * is the product of the number of values in each range and set.
+ *
+ *
+ * long int CountOptionVariations(const OptionsDescriptorT &p_OptionsDescriptor)
+ *
+ * @param   [IN]    p_OptionsDescriptor         Commandline or grid line options descriptor
+ * @return                                      Number of variations (1 if no ranges or sets were specified)
+ */
+long int Options::CountOptionVariations(const OptionsDescriptorT &p_OptionsDescriptor) {
+
+    long int variations = 1;
+
+    for (auto &complexOptionValue : p_OptionsDescriptor.complexOptionValues) {
+        RangeOrSetDescriptorT details = get<1>(complexOptionValue);
+        variations *= details.type == COMPLEX_TYPE::SET ? (long int)details.parameters.size() : (long int)details.rangeParms[1].ulVal;
+    }
+
+    return variations;
+}
+
+
+/*
+ * Count the systems (stars or binaries) that will be evolved
+ *
+ * The number of systems evolved is not just the number of systems requested (--number-of-systems):
+ *
+ *    - if a grid file is being used, each line of the grid file is evolved for each variation of the
+ *      grid line options, and the whole grid file is evolved for each variation of the commandline options
+ *    - otherwise, if the user specified ranges or sets on the commandline, one system is evolved for each
+ *      variation of the commandline options
+ *    - otherwise, the number of systems requested is evolved
+ *
+ * Commandline options variations played out as forks of each system (--fork-variations) are not counted.
+ *
+ * If a grid file is being used it is read to count its lines and their variations, then rewound.  Applying a
+ * grid line can draw random numbers (for calculated option defaults), so the state of the random number
+ * service is restored after the count - the systems evolved are not changed by counting them.  The grid file
+ * must be open.
+ *
+ *
+ * long int CountSystemsToEvolve()
+ *
+ * @return                                      Number of systems that will be evolved (-1 if the grid file could not be read)
+ */
+long int Options::CountSystemsToEvolve() {
+
+    long int cmdLineVariations = ForkVariations() ? 1 : CountOptionVariations(m_CmdLine);
+
+    if (!m_Gridfile.handle.is_open()) {                                                     // using grid file?
+        return CommandLineGrid() && !ForkVariations() ? cmdLineVariations : (long int)nObjectsToEvolve();   // no
+    }
+
+    RandStateT randState = RAND->State();                                                   // yes - bookmark the random number state
+
+    long int gridSystems = 0;
+    int      status;
+    while ((status = ApplyNextGridLine()) > 0) gridSystems += CountOptionVariations(m_GridLine);   // count systems per grid line
+
+    RewindGridFile();                                                                       // ready for evolution
+    RAND->RestoreState(randState);                                                          // random number state as before the count
+
+    return status < 0 ? -1 : gridSystems * cmdLineVariations;
+}
+
+
+/*
+ * Note a read of a swept option
+ *
+ * Called (via NoteOptionRead(), from OPT_VALUE and CMDLINE_VALUE) for each option read while reads of the
+ * swept options - the options specified as ranges or sets on the commandline - are watched (see
+ * WatchSweptOptions()), until a swept option is read.  Forked evolution of option variations (--fork-variations)
+ * forks a binary at the start of the timestep in which a swept option is first read: until then the
+ * evolution of the binary is the same for all variations.
+ *
+ *
+ * void NoteSweptOptionRead(const char *p_OptionName) const
+ *
+ * @param   [IN]    p_OptionName                Name of the option read (as specified in Options::AddOptions())
+ */
+void Options::NoteSweptOptionRead(const char *p_OptionName) const {
+
+    for (auto &sweptOption : m_SweptOptions) {
+        if (sweptOption == p_OptionName) {
+            m_SweptOptionsWatch.read = true;
+            break;
+        }
+    }
+}
+
+
 /*
  * Initialise grid file options
  * 
@@ -95,10 +95,17 @@ namespace po = boost::program_options;
 // the option will be returned.
 
 
-#define OPT_VALUE(optName, optValue, fallback)  (m_GridLine.optionValues.m_Populated && \
+#define OPT_VALUE(optName, optValue, fallback)  (NoteOptionRead(optName), \
+                                                (m_GridLine.optionValues.m_Populated && \
                                                 (!m_GridLine.optionValues.m_VM[optName].defaulted() || !fallback)) \
                                                     ? m_GridLine.optionValues.optValue \
-                                                    : m_CmdLine.optionValues.optValue
+                                                    : m_CmdLine.optionValues.optValue)
+
+// CMDLINE_VALUE is for getters that always return the value specified on the commandline (see
+// above) for options that can be specified as ranges or sets on the commandline: like OPT_VALUE,
+// it notes the read for forked evolution of option variations (see WatchSweptOptions())
+
+#define CMDLINE_VALUE(optName, optValue)        (NoteOptionRead(optName), m_CmdLine.optionValues.optValue)
 
 /*
  * Options Singleton
@@ -147,20 +154,43 @@ private:
 
         "add-options-to-sysparms",
 
+        "ais-batch-size",
+        "ais-exploratory-fraction",
+        "ais-hit-predicate",
+        "ais-kappa",
+
+        "coalescence-time-kernel",
+        "common-random-numbers",
+        "culling-mode",
+
         "debug-level",
         "debug_classes",
         "debug-to-file",
         "detailed-output",
+        "detailed-output-mass-delta",
+        "detailed-output-radius-delta",
+        "detailed-output-sample-interval",
+        "detailed-output-separation-delta",
 
         "enable-warnings",
         "errors-to-file",
 
+        "fork-variations",
+
         "grid",
 
+        "hdf5-buffer-memory",
         "hdf5-buffer-size",
         "hdf5-chunk-size",
         "help", "h",
 
+        "initial-sampling",
+        "initial-sampling-block-size",
+
+        "kick-resample-supernovae",
+        "kick-resamples",
+        "kick-sampling",
+
         "log-level", 
         "log-classes",
 
@@ -172,6 +202,8 @@ private:
         "logfile-detailed-output",
         "logfile-double-compact-objects",
         "logfile-name-prefix",
+        "logfile-predicate",
+        "logfile-predicate-files",
         "logfile-pulsar-evolution",
         "logfile-rlof-parameters",
         "logfile-supernovae",
@@ -179,6 +211,9 @@ private:
         "logfile-system-parameters",
         "logfile-type",
 
+        "mass-transfer-donor-radius-response",
+        "mass-transfer-orbit-integrator",
+        "mass-transfer-orbit-tolerance",
         "maximum-evolution-time",
         "maximum-number-timestep-iterations",
         "mode",
@@ -189,15 +224,21 @@ private:
         "outputPath", "o",
 
         "population-data-printing",
+        "power-kernels",
         "print-bool-as-string",
 
         "quiet", 
 
         "rlof-printing",
+        "rotational-velocity-exact-inverse",
 
+        "stage-system-records",
         "switch-log",
 
         "timestep-multiplier",
+        "timestep-radial-change-prediction",
+        "track-library",
+        "track-library-mode",
 
         "version", "v"
     };
@@ -244,13 +285,20 @@ private:
         "kick-magnitude",
         "kick-magnitude-random",
 
-        "rotational-frequency"
+        "rotational-frequency",
+
+        "timestep-radial-change-prediction"
     };
 
     std::vector<std::string> m_BSEOnly = {
 
         // trying to keep entries alphabetical so easier to find specific entries
 
+        "ais-batch-size",
+        "ais-exploratory-fraction",
+        "ais-hit-predicate",
+        "ais-kappa",
+
         "allow-rlof-at-birth",
         "allow-touching-at-birth",
         "angular-momentum-conservation-during-circularisation", 
@@ -260,6 +308,7 @@ private:
 
         "case-BB-stability-prescription",
         "circularise-binary-during-mass-transfer",
+        "coalescence-time-kernel",
         "common-envelope-allow-main-sequence-survive",
         "common-envelope-alpha", 
         "common-envelope-alpha-thermal",
@@ -272,6 +321,7 @@ private:
         "common-envelope-mass-accretion-prescription",
         "common-envelope-recombination-energy-density",
         "common-envelope-slope-kruckow",
+        "culling-mode",
 
         // AVG
         /*
@@ -300,6 +350,10 @@ private:
         "evolve-pulsars",
         "evolve-unbound-systems",
 
+        "fast-forward-compact-binaries",
+        "fast-forward-output-interval",
+        "fork-variations",
+
         "initial-mass-1",
         "initial-mass-2",
 
@@ -311,6 +365,8 @@ private:
         "kick-mean-anomaly-2",
         "kick-phi-1",
         "kick-phi-2",
+        "kick-resample-supernovae",
+        "kick-resamples",
         "kick-theta-1",
         "kick-theta-2",
 
@@ -329,12 +385,17 @@ private:
         "mass-transfer-jloss",
         "mass-transfer-accretion-efficiency-prescription",
         "mass-transfer-angular-momentum-loss-prescription",
+        "mass-transfer-donor-radius-response",
+        "mass-transfer-orbit-integrator",
+        "mass-transfer-orbit-tolerance",
         "mass-transfer-rejuvenation-prescription",
         "mass-transfer-thermal-limit-accretor",
         "mass-transfer-thermal-limit-C",
         "maximum-mass-donor-nandez-ivanova",
         "minimum-secondary-mass",
 
+        "non-interacting-fast-path",
+
         "orbital-period",
         "orbital-period-distribution",
         "orbital-period-max",
@@ -368,6 +429,11 @@ private:
 
         "add-options-to-sysparms",
 
+        "ais-batch-size",
+        "ais-exploratory-fraction",
+        "ais-hit-predicate",
+        "ais-kappa",
+
         "allow-rlof-at-birth",
         "allow-touching-at-birth",
         "angular-momentum-conservation-during-circularisation",
@@ -381,14 +447,21 @@ private:
         "check-photon-tiring-limit",
         "chemically-homogeneous-evolution",
         "circularise-binary-during-mass-transfer",
+        "coalescence-time-kernel",
         "common-envelope-allow-main-sequence-survive",
         "common-envelope-lambda-prescription",
         "common-envelope-mass-accretion-prescription",
+        "common-random-numbers",
+        "culling-mode",
 
         "debug_classes",
         "debug-level",
         "debug-to-file",
         "detailed-output",
+        "detailed-output-mass-delta",
+        "detailed-output-radius-delta",
+        "detailed-output-sample-interval",
+        "detailed-output-separation-delta",
 
         "eccentricity-distribution",
         "enable-warnings",
@@ -397,18 +470,25 @@ private:
         "evolve-pulsars",
         "evolve-unbound-systems",
 
+        "fork-variations",
         "fryer-supernova-engine",
 
         "grid",
 
+        "hdf5-buffer-memory",
         "hdf5-buffer-size",
         "hdf5-chunk-size",
         "help", "h",
 
         "initial-mass-function", "i",
+        "initial-sampling",
+        "initial-sampling-block-size",
 
         "kick-direction",
         "kick-magnitude-distribution", 
+        "kick-resample-supernovae",
+        "kick-resamples",
+        "kick-sampling",
 
         "log-level", 
         "log-classes",
@@ -421,6 +501,8 @@ private:
         "logfile-detailed-output",
         "logfile-double-compact-objects",
         "logfile-name-prefix",
+        "logfile-predicate",
+        "logfile-predicate-files",
         "logfile-pulsar-evolution",
         "logfile-rlof-parameters",
         "logfile-supernovae",
@@ -434,6 +516,9 @@ private:
         "mass-transfer",
         "mass-transfer-accretion-efficiency-prescription",
         "mass-transfer-angular-momentum-loss-prescription",
+        "mass-transfer-donor-radius-response",
+        "mass-transfer-orbit-integrator",
+        "mass-transfer-orbit-tolerance",
         "mass-transfer-rejuvenation-prescription",
         "mass-transfer-thermal-limit-accretor",
         "metallicity-distribution",
@@ -448,6 +533,7 @@ private:
 
         "pair-instability-supernovae",
         "population-data-printing",
+        "power-kernels",
         "print-bool-as-string",
         "pulsar-birth-magnetic-field-distribution",
         "pulsar-birth-spin-period-distribution",
@@ -461,11 +547,16 @@ private:
         "revised-energy-formalism-nandez-ivanova",
         "rlof-printing",
         "rotational-velocity-distribution",
+        "rotational-velocity-exact-inverse",
 
         "semi-major-axis-distribution",
         "stellar-zeta-prescription",
+        "stage-system-records",
         "switch-log",
 
+        "track-library",
+        "track-library-mode",
+
         "use-mass-loss",
 
         "version", "v"
@@ -477,20 +568,43 @@ private:
 
         "add-options-to-sysparms",
 
+        "ais-batch-size",
+        "ais-exploratory-fraction",
+        "ais-hit-predicate",
+        "ais-kappa",
+
+        "coalescence-time-kernel",
+        "common-random-numbers",
+        "culling-mode",
+
         "debug_classes",
         "debug-level",
         "debug-to-file",
         "detailed-output",
+        "detailed-output-mass-delta",
+        "detailed-output-radius-delta",
+        "detailed-output-sample-interval",
+        "detailed-output-separation-delta",
 
         "enable-warnings",
         "errors-to-file",
 
+        "fork-variations",
+
         "grid",
 
+        "hdf5-buffer-memory",
         "hdf5-buffer-size",
         "hdf5-chunk-size",
         "help", "h",
 
+        "initial-sampling",
+        "initial-sampling-block-size",
+
+        "kick-resample-supernovae",
+        "kick-resamples",
+        "kick-sampling",
+
         "log-classes",
         "log-level", 
 
@@ -502,6 +616,8 @@ private:
         "logfile-detailed-output",
         "logfile-double-compact-objects",
         "logfile-name-prefix",
+        "logfile-predicate",
+        "logfile-predicate-files",
         "logfile-pulsar-evolution",
         "logfile-rlof-parameters",
         "logfile-supernovae",
@@ -509,21 +625,30 @@ private:
         "logfile-system-parameters",
         "logfile-type",
 
+        "mass-transfer-donor-radius-response",
+        "mass-transfer-orbit-integrator",
+        "mass-transfer-orbit-tolerance",
         "mode",
 
         "output-container", "c",
         "outputPath", "o",
 
         "population-data-printing",
+        "power-kernels",
         "print-bool-as-string",
 
         "quiet",
 
         "random-seed",
         "rlof-printing",
+        "rotational-velocity-exact-inverse",
 
+        "stage-system-records",
         "switch-log",
 
+        "track-library",
+        "track-library-mode",
+
         "version", "v"
     };
 
@@ -565,7 +690,17 @@ public:
             bool                                                m_EvolvePulsars;                                                // Whether to evolve pulsars or not
 	        bool                                                m_EvolveUnboundSystems;							                // Option to chose if unbound systems are evolved until death or the evolution stops after the system is unbound during a SN.
 
+            bool                                                m_CommonRandomNumbers;                                          // Draw each random process from its own substream, keyed by system, process, and event (default = false)
+
+            bool                                                m_ForkVariations;                                               // Evolve the commandline option variations of each binary by forking it where a varied option is first read (default = false)
+
+            bool                                                m_PowerKernels;                                                 // Use the power function kernels (powers.h) rather than std::pow() at the most frequently called sites (default = false)
+
             bool                                                m_DetailedOutput;                                               // Print detailed output details to file (default = false)
+            int                                                 m_DetailedOutputSampleInterval;                                 // BSE detailed output: print a record every this many timesteps (default = 1)
+            double                                              m_DetailedOutputMassDelta;                                      // BSE detailed output: also print if either star's mass changed by more than this fraction (default = 0.0 = disabled)
+            double                                              m_DetailedOutputRadiusDelta;                                    // BSE detailed output: also print if either star's radius changed by more than this fraction (default = 0.0 = disabled)
+            double                                              m_DetailedOutputSeparationDelta;                                // BSE detailed output: also print if the semi-major axis changed by more than this fraction (default = 0.0 = disabled)
             bool                                                m_PopulationDataPrinting;                                       // Print certain data for small populations, but not for larger one
             bool                                                m_PrintBoolAsString;                                            // flag used to indicate that boolean properties should be printed as "TRUE" or "FALSE" (default is 1 or 0)
             bool                                                m_Quiet;                                                        // suppress some output
@@ -573,6 +708,7 @@ public:
 
             bool                                                m_ShortHelp;                                                    // Flag to indicate whether user wants short help ('-h', just option names) or long help ('--help', plus descriptions)
 
+            bool                                                m_StageSystemRecords;                                           // Stage BSE logfile records per system, discarding systems whose evolution ends in error (default = false)
             bool                                                m_SwitchLog;                                                    // Print switch log details to file (default = false)
 
 
@@ -587,6 +723,12 @@ public:
             double                                              m_MaxEvolutionTime;                                             // Maximum time to evolve a binary by
             int                                                 m_MaxNumberOfTimestepIterations;                                // Maximum number of timesteps to evolve binary for before giving up
             double                                              m_TimestepMultiplier;                                           // Multiplier for time step size (<1 -- shorter timesteps, >1 -- longer timesteps)
+            bool                                                m_TimestepRadialChangePrediction;                               // Shorten SSE timesteps by the radial change predicted from the previous timestep before taking them (default = false)
+
+            bool                                                m_FastForwardCompactBinaries;                                   // Jump detached compact-object binaries directly to their next event rather than timestepping (default = false)
+            double                                              m_FastForwardOutputInterval;                                    // Fast-forwarded binaries are also stopped (and logged) at multiples of this interval in Myr (default = 0.0 = disabled)
+
+            bool                                                m_NonInteractingFastPath;                                       // Evolve the stars of binaries that cannot interact before the first remnant forms independently up to it (default = false)
 
             // Initial distribution variables
 
@@ -638,6 +780,9 @@ public:
 	        double                                              m_KickMagnitudeDistributionSigmaForECSN;			            // Kick magnitude sigma for ECSN in km s^-1 (default = "0" )
 	        double                                              m_KickMagnitudeDistributionSigmaForUSSN;			            // Kick magnitude sigma for USSN in km s^-1 (default = "20" )
 	        double                                              m_KickScalingFactor;								            // Arbitrary factor for scaling kicks
+            ENUM_OPT<KICK_SAMPLING>                             m_KickSampling;                                                 // How kick magnitude inverse CDFs are evaluated (tabulated, exact, or both for validation)
+            int                                                 m_KickResamples;                                                // Number of kick draws under which a binary is continued from each resampled supernova (1 = no resampling)
+            ENUM_OPT<KICK_RESAMPLE_SUPERNOVAE>                  m_KickResampleSupernovae;                                       // Which supernovae are resampled (first, or each)
 
             // Kick direction options
             ENUM_OPT<KICK_DIRECTION_DISTRIBUTION>               m_KickDirectionDistribution;                                    // Kick direction distribution
@@ -666,6 +811,12 @@ public:
             // CHE - Chemically Homogeneous Evolution
             ENUM_OPT<CHE_MODE>                                  m_CheMode;                                                      // Which Chemically Homogeneous Evolution mode
 
+            ENUM_OPT<COALESCENCE_TIME_KERNEL>                   m_CoalescenceTimeKernel;                                        // How times to coalescence of eccentric binaries are evaluated (tabulated, integral, or both for validation)
+
+            ENUM_OPT<CULLING_MODE>                              m_CullingMode;                                                  // Which binaries are culled (evolution stopped early) because they can no longer form the systems of interest
+
+            ENUM_OPT<TRACK_LIBRARY_MODE>                        m_TrackLibraryMode;                                             // Whether the single star track library is created, or used to skip detached evolution of binaries
+
             // Supernova remnant mass
             ENUM_OPT<REMNANT_MASS_PRESCRIPTION>                 m_RemnantMassPrescription;                                      // Which remnant mass prescription
 
@@ -730,6 +881,13 @@ public:
             double                                              m_MassTransferJloss;                                            // Specific angular momentum of the material leaving the system (not accreted)
             ENUM_OPT<MT_ANGULAR_MOMENTUM_LOSS_PRESCRIPTION>     m_MassTransferAngularMomentumLossPrescription;                  // Which mass transfer angular momentum loss prescription
 
+            // Mass transfer donor radius response
+            ENUM_OPT<MT_DONOR_RADIUS_RESPONSE>                  m_MassTransferDonorRadiusResponse;                              // How the radius of a donor without an envelope is found after mass loss (model, updated copy, or both for validation)
+
+            // Mass transfer orbit integration
+            ENUM_OPT<MT_ORBIT_INTEGRATOR>                       m_MassTransferOrbitIntegrator;                                  // How the orbit is evolved through mass transfer (closed form, adaptive integration, Euler, or all for validation)
+            double                                              m_MassTransferOrbitTolerance;                                   // Tolerance of the adaptive integration of the orbit through mass transfer
+
             // Mass transfer rejuvenation prescription
             ENUM_OPT<MT_REJUVENATION_PRESCRIPTION>              m_MassTransferRejuvenationPrescription;                         // Which mass transfer rejuvenation prescription
 
@@ -831,6 +989,7 @@ public:
 
             // Rotational Velocity distribution options
             ENUM_OPT<ROTATIONAL_VELOCITY_DISTRIBUTION>          m_RotationalVelocityDistribution;                               // Rotational velocity distribution
+            bool                                                m_RotationalVelocityExactInverse;                               // Sample O-star (VLTFLAMES) rotational velocities by root-solving the CDF for every star, rather than from the precomputed inverse-CDF table (validation)
             double                                              m_RotationalFrequency;                                          // Rotational frequency for single star (SSE)
             double                                              m_RotationalFrequency1;                                         // Rotational frequency for primary (BSE)
             double                                              m_RotationalFrequency2;                                         // Rotational frequency for secondary (BSE)
@@ -839,6 +998,8 @@ public:
 
             string                                              m_GridFilename;                                                 // Grid filename
 
+            string                                              m_TrackLibraryFilename;                                         // Single star track library filename
+
 
             // debug and logging options
 
@@ -852,6 +1013,8 @@ public:
             // Logfiles
             string                                              m_LogfileDefinitionsFilename;                                   // Filename for the logfile record definitions
             string                                              m_LogfileNamePrefix;                                            // Prefix for log file names
+            string                                              m_LogfilePredicate;                                             // Predicate a binary must satisfy for its records to be written to the predicate logfiles
+            vector<string>                                      m_LogfilePredicateFiles;                                        // Logfiles gated by the logfile predicate (short names, e.g. BSE_SYSPARMS)
             ENUM_OPT<LOGFILETYPE>                               m_LogfileType;                                                  // File type log files
 
             string                                              m_LogfileSystemParameters;                                      // output file name: system parameters
@@ -866,9 +1029,18 @@ public:
 
             ENUM_OPT<ADD_OPTIONS_TO_SYSPARMS>                   m_AddOptionsToSysParms;                                         // Whether/when to add program option columns to BSE/SSE sysparms file
 
+            int                                                 m_HDF5BufferMemory;                                             // HDF5 IO buffer memory budget for all open datasets (MB, 0 = no budget)
             int                                                 m_HDF5BufferSize;                                               // HDF5 file IO buffer size (number of chunks)
             int                                                 m_HDF5ChunkSize;                                                // HDF5 file chunk size (number of dataset entries)
 
+            ENUM_OPT<INITIAL_SAMPLING>                          m_InitialSampling;                                              // How initial conditions are sampled (pseudo-random, quasi-random, adaptive importance sampling or blocks)
+            int                                                 m_InitialSamplingBlockSize;                                     // Number of systems whose initial conditions are drawn together (BLOCK sampling)
+
+            int                                                 m_AISBatchSize;                                                 // Adaptive importance sampling: number of binaries between proposal refits
+            double                                              m_AISExploratoryFraction;                                       // Adaptive importance sampling: fraction of binaries in the exploration phase
+            string                                              m_AISHitPredicate;                                              // Adaptive importance sampling: predicate a binary must satisfy to be a hit
+            double                                              m_AISKappa;                                                     // Adaptive importance sampling: proposal component width scale factor
+
 
             // the boost variables map
             // this holds information on the options as specified by the user
@@ -889,6 +1061,8 @@ public:
                 vm[opt].value() = boost::any(val);
             }
 
+            void        CopyCalculatedOptionDefaults(const OptionValues& p_OptionValues);
+
             int         OptionSpecified(std::string p_OptionString);
 
             std::string SetCalculatedOptionDefaults(const bool p_ModifyMap);
@@ -981,14 +1155,33 @@ private:
 
     std::vector<std::tuple<std::string, std::string, std::string, std::string, TYPENAME>> m_CmdLineOptionsDetails;  // for Run_Details file
 
+    OptionValues            m_CmdLineFirstVariation;                                                // commandline option values of the first variation (see RewindCmdLineOptionValues())
+    COMPLEX_OPTION_VALUES   m_CmdLineFirstComplexOptionValues;                                      // commandline ranges and sets positioned at the first variation
+
+    // forked evolution of commandline option variations (--fork-variations): the options specified as
+    // ranges or sets on the commandline (the swept options), and whether any of them has been read since
+    // WatchSweptOptions(true) was called (noted by OPT_VALUE and CMDLINE_VALUE)
+
+    std::vector<std::string> m_SweptOptions;
+
+    mutable struct {
+        bool watching = false;                                                                      // reads of swept options being watched?
+        bool read     = false;                                                                      // swept option read while watching?
+    }                       m_SweptOptionsWatch;
+
 
     // member functions
 
     bool            AddOptions(OptionValues *p_Options, po::options_description *p_OptionsDescription);
     int             AdvanceOptionVariation(OptionsDescriptorT &p_OptionsDescriptor);
 
+    static long int CountOptionVariations(const OptionsDescriptorT &p_OptionsDescriptor);
+
     bool            IsSupportedNumericDataType(TYPENAME p_TypeName);
 
+    void            NoteOptionRead(const char *p_OptionName) const          { if (m_SweptOptionsWatch.watching && !m_SweptOptionsWatch.read) NoteSweptOptionRead(p_OptionName); }
+    void            NoteSweptOptionRead(const char *p_OptionName) const;
+
     ATTR            OptionAttributes(const po::variables_map p_VM, const po::variables_map::const_iterator p_IT);
 
     PROGRAM_STATUS  ParseCommandLineOptions(int argc, char * argv[]);
@@ -1003,6 +1196,7 @@ public:
 
 
 
+    int             AdvanceCmdLineForkVariation();
     int             AdvanceCmdLineOptionValues()            { return AdvanceOptionVariation(m_CmdLine); }
     int             AdvanceGridLineOptionValues()           { return AdvanceOptionVariation(m_GridLine); }
     int             ApplyNextGridLine();
@@ -1013,6 +1207,8 @@ public:
     bool            InitialiseEvolvingObject(const std::string p_OptionsString);
 
 
+    long int        CountSystemsToEvolve();
+
     ERROR           OpenGridFile(const std::string p_GridFilename);
     int             OptionSpecified(const std::string p_OptionString);
 
@@ -1020,11 +1216,20 @@ public:
 
     void            PrintOptionHelp(const bool p_Verbose);
 
+    int             RewindCmdLineOptionValues();
     void            RewindGridFile() { m_Gridfile.handle.clear(); m_Gridfile.handle.seekg(0); }
 
+    bool            SweptOptionRead() const                 { return m_SweptOptionsWatch.read; }
+    bool            SweptOptionsWatched() const             { return m_SweptOptionsWatch.watching; }
+    void            WatchSweptOptions(const bool p_Watch)   { m_SweptOptionsWatch.watching = p_Watch && !m_SweptOptions.empty(); m_SweptOptionsWatch.read = false; }
+
     // getters
 
     ADD_OPTIONS_TO_SYSPARMS                     AddOptionsToSysParms() const                                            { return m_CmdLine.optionValues.m_AddOptionsToSysParms.type; }
+    int                                         AISBatchSize() const                                                    { return m_CmdLine.optionValues.m_AISBatchSize; }
+    double                                      AISExploratoryFraction() const                                          { return m_CmdLine.optionValues.m_AISExploratoryFraction; }
+    string                                      AISHitPredicate() const                                                 { return m_CmdLine.optionValues.m_AISHitPredicate; }
+    double                                      AISKappa() const                                                        { return m_CmdLine.optionValues.m_AISKappa; }
 
     bool                                        AllowMainSequenceStarToSurviveCommonEnvelope() const                    { return OPT_VALUE("common-envelope-allow-main-sequence-survive", m_AllowMainSequenceStarToSurviveCommonEnvelope, true); }
     bool                                        AllowRLOFAtBirth() const                                                { return OPT_VALUE("allow-rlof-at-birth", m_AllowRLOFAtBirth, true); }
@@ -1060,12 +1265,20 @@ public:
     double                                      CommonEnvelopeRecombinationEnergyDensity() const                        { return OPT_VALUE("common-envelope-recombination-energy-density", m_CommonEnvelopeRecombinationEnergyDensity, true); }
     double                                      CommonEnvelopeSlopeKruckow() const                                      { return OPT_VALUE("common-envelope-slope-kruckow", m_CommonEnvelopeSlopeKruckow, true); }
 
+    COALESCENCE_TIME_KERNEL                     CoalescenceTimeKernel() const                                           { return m_CmdLine.optionValues.m_CoalescenceTimeKernel.type; }
+    bool                                        CommonRandomNumbers() const                                             { return m_CmdLine.optionValues.m_CommonRandomNumbers; }
+
     double                                      CoolWindMassLossMultiplier() const                                      { return OPT_VALUE("cool-wind-mass-loss-multiplier", m_CoolWindMassLossMultiplier, true); }
+    CULLING_MODE                                CullingMode() const                                                     { return m_CmdLine.optionValues.m_CullingMode.type; }
 
     vector<string>                              DebugClasses() const                                                    { return m_CmdLine.optionValues.m_DebugClasses; }
     int                                         DebugLevel() const                                                      { return m_CmdLine.optionValues.m_DebugLevel; }
     bool                                        DebugToFile() const                                                     { return m_CmdLine.optionValues.m_DebugToFile; }
     bool                                        DetailedOutput() const                                                  { return m_CmdLine.optionValues.m_DetailedOutput; }
+    double                                      DetailedOutputMassDelta() const                                         { return m_CmdLine.optionValues.m_DetailedOutputMassDelta; }
+    double                                      DetailedOutputRadiusDelta() const                                       { return m_CmdLine.optionValues.m_DetailedOutputRadiusDelta; }
+    int                                         DetailedOutputSampleInterval() const                                    { return m_CmdLine.optionValues.m_DetailedOutputSampleInterval; }
+    double                                      DetailedOutputSeparationDelta() const                                   { return m_CmdLine.optionValues.m_DetailedOutputSeparationDelta; }
 
     bool                                        EnableWarnings() const                                                  { return m_CmdLine.optionValues.m_EnableWarnings; }
     bool                                        ErrorsToFile() const                                                    { return m_CmdLine.optionValues.m_ErrorsToFile; }
@@ -1079,15 +1292,20 @@ public:
     bool                                        EvolvePulsars() const                                                   { return OPT_VALUE("evolve-pulsars", m_EvolvePulsars, true); }
     bool                                        EvolveUnboundSystems() const                                            { return OPT_VALUE("evolve-unbound-systems", m_EvolveUnboundSystems, true); }
 
+    bool                                        FastForwardCompactBinaries() const                                      { return OPT_VALUE("fast-forward-compact-binaries", m_FastForwardCompactBinaries, true); }
+    double                                      FastForwardOutputInterval() const                                       { return OPT_VALUE("fast-forward-output-interval", m_FastForwardOutputInterval, true); }
+
     bool                                        FixedRandomSeedCmdLine() const                                          { return m_CmdLine.optionValues.m_FixedRandomSeed; }
     bool                                        FixedRandomSeedGridLine() const                                         { return m_GridLine.optionValues.m_FixedRandomSeed; }
-    double                                      FixedUK() const                                                         { return m_GridLine.optionValues.m_UseFixedUK || m_CmdLine.optionValues.m_FixedUK; }
+    double                                      FixedUK() const                                                         { return (NoteOptionRead("fix-dimensionless-kick-magnitude"), m_GridLine.optionValues.m_UseFixedUK || m_CmdLine.optionValues.m_FixedUK); }
+    bool                                        ForkVariations() const                                                  { return m_CmdLine.optionValues.m_ForkVariations; }
     SN_ENGINE                                   FryerSupernovaEngine() const                                            { return OPT_VALUE("fryer-supernova-engine", m_FryerSupernovaEngine.type, true); }
 
     string                                      GridFilename() const                                                    { return m_CmdLine.optionValues.m_GridFilename; }
 
     size_t                                      HDF5ChunkSize() const                                                   { return m_CmdLine.optionValues.m_HDF5ChunkSize; }
     size_t                                      HDF5BufferSize() const                                                  { return m_CmdLine.optionValues.m_HDF5BufferSize; }
+    size_t                                      HDF5BufferMemory() const                                                { return m_CmdLine.optionValues.m_HDF5BufferMemory; }
 
     double                                      InitialMass() const                                                     { return OPT_VALUE("initial-mass", m_InitialMass, true); }
     double                                      InitialMass1() const                                                    { return OPT_VALUE("initial-mass-1", m_InitialMass1, true); }
@@ -1098,10 +1316,16 @@ public:
     double                                      InitialMassFunctionMin() const                                          { return OPT_VALUE("initial-mass-min", m_InitialMassFunctionMin, true); }
     double                                      InitialMassFunctionPower() const                                        { return OPT_VALUE("initial-mass-power", m_InitialMassFunctionPower, true); }
 
+    INITIAL_SAMPLING                            InitialSampling() const                                                 { return m_CmdLine.optionValues.m_InitialSampling.type; }
+    int                                         InitialSamplingBlockSize() const                                        { return m_CmdLine.optionValues.m_InitialSamplingBlockSize; }
+
     KICK_DIRECTION_DISTRIBUTION                 KickDirectionDistribution() const                                       { return OPT_VALUE("kick-direction", m_KickDirectionDistribution.type, true); }
     double                                      KickDirectionPower() const                                              { return OPT_VALUE("kick-direction-power", m_KickDirectionPower, true); }
     double                                      KickScalingFactor() const                                               { return OPT_VALUE("kick-scaling-factor", m_KickScalingFactor, true); }
     KICK_MAGNITUDE_DISTRIBUTION                 KickMagnitudeDistribution() const                                       { return OPT_VALUE("kick-magnitude-distribution", m_KickMagnitudeDistribution.type, true); }
+    int                                         KickResamples() const                                                   { return m_CmdLine.optionValues.m_KickResamples; }
+    KICK_RESAMPLE_SUPERNOVAE                    KickResampleSupernovae() const                                          { return m_CmdLine.optionValues.m_KickResampleSupernovae.type; }
+    KICK_SAMPLING                               KickSampling() const                                                    { return m_CmdLine.optionValues.m_KickSampling.type; }
 
     double                                      KickMagnitudeDistributionMaximum() const                                { return OPT_VALUE("kick-magnitude-max", m_KickMagnitudeDistributionMaximum, true); }
 
@@ -1131,6 +1355,8 @@ public:
                                                                                                                         }
     string                                      LogfileDoubleCompactObjects() const                                     { return m_CmdLine.optionValues.m_LogfileDoubleCompactObjects; }
     string                                      LogfileNamePrefix() const                                               { return m_CmdLine.optionValues.m_LogfileNamePrefix; }
+    string                                      LogfilePredicate() const                                                { return m_CmdLine.optionValues.m_LogfilePredicate; }
+    vector<string>                              LogfilePredicateFiles() const                                           { return m_CmdLine.optionValues.m_LogfilePredicateFiles; }
     string                                      LogfilePulsarEvolution() const                                          { return m_CmdLine.optionValues.m_LogfilePulsarEvolution; }
     string                                      LogfileRLOFParameters() const                                           { return m_CmdLine.optionValues.m_LogfileRLOFParameters; }
     string                                      LogfileSupernovae() const                                               { return m_CmdLine.optionValues.m_Populated && !m_CmdLine.optionValues.m_VM["logfile-supernovae"].defaulted()
@@ -1198,13 +1424,16 @@ public:
     double                                      MassTransferCriticalMassRatioWhiteDwarfDegenerateAccretor() const       { return OPT_VALUE("critical-mass-ratio-white-dwarf-degenerate-accretor", m_MassTransferCriticalMassRatioWhiteDwarfDegenerateAccretor, true); }
     double                                      MassTransferCriticalMassRatioWhiteDwarfNonDegenerateAccretor() const    { return OPT_VALUE("critical-mass-ratio-white-dwarf-non-degenerate-accretor", m_MassTransferCriticalMassRatioWhiteDwarfNonDegenerateAccretor, true); }
 
+    MT_DONOR_RADIUS_RESPONSE                    MassTransferDonorRadiusResponse() const                                 { return m_CmdLine.optionValues.m_MassTransferDonorRadiusResponse.type; }
     double                                      MassTransferFractionAccreted() const                                    { return OPT_VALUE("mass-transfer-fa", m_MassTransferFractionAccreted, true); }
+    MT_ORBIT_INTEGRATOR                         MassTransferOrbitIntegrator() const                                     { return m_CmdLine.optionValues.m_MassTransferOrbitIntegrator.type; }
+    double                                      MassTransferOrbitTolerance() const                                      { return m_CmdLine.optionValues.m_MassTransferOrbitTolerance; }
     double                                      MassTransferJloss() const                                               { return OPT_VALUE("mass-transfer-jloss", m_MassTransferJloss, true); }
     MT_REJUVENATION_PRESCRIPTION                MassTransferRejuvenationPrescription() const                            { return OPT_VALUE("mass-transfer-rejuvenation-prescription", m_MassTransferRejuvenationPrescription.type, true); }
     MT_THERMALLY_LIMITED_VARIATION              MassTransferThermallyLimitedVariation() const                           { return OPT_VALUE("mass-transfer-thermal-limit-accretor", m_MassTransferThermallyLimitedVariation.type, true); }
-    double                                      MaxEvolutionTime() const                                                { return m_CmdLine.optionValues.m_MaxEvolutionTime; }
+    double                                      MaxEvolutionTime() const                                                { return CMDLINE_VALUE("maximum-evolution-time", m_MaxEvolutionTime); }
     double                                      MaximumNeutronStarMass() const                                          { return OPT_VALUE("maximum-neutron-star-mass", m_MaximumNeutronStarMass, true); }
-    int                                         MaxNumberOfTimestepIterations() const                                   { return m_CmdLine.optionValues.m_MaxNumberOfTimestepIterations; }
+    int                                         MaxNumberOfTimestepIterations() const                                   { return CMDLINE_VALUE("maximum-number-timestep-iterations", m_MaxNumberOfTimestepIterations); }
     double                                      MaximumDonorMass() const                                                { return OPT_VALUE("maximum-mass-donor-nandez-ivanova", m_MaximumMassDonorNandezIvanova, true); }
     double                                      MCBUR1() const                                                          { return OPT_VALUE("mcbur1", m_mCBUR1, true); }
 
@@ -1223,6 +1452,8 @@ public:
 
     NS_EOS                                      NeutronStarEquationOfState() const                                      { return OPT_VALUE("neutron-star-equation-of-state", m_NeutronStarEquationOfState.type, true); }
 
+    bool                                        NonInteractingFastPath() const                                          { return OPT_VALUE("non-interacting-fast-path", m_NonInteractingFastPath, true); }
+
     size_t                                      nObjectsToEvolve() const                                                { return m_CmdLine.optionValues.m_ObjectsToEvolve; }
     bool                                        OptimisticCHE() const                                                   { CHE_MODE che = OPT_VALUE("chemically-homogeneous-evolution", m_CheMode.type, true); return che == CHE_MODE::OPTIMISTIC; }
 
@@ -1240,6 +1471,7 @@ public:
     double                                      PairInstabilityUpperLimit() const                                       { return OPT_VALUE("PISN-upper-limit", m_PairInstabilityUpperLimit, true); }
 
     bool                                        PopulationDataPrinting() const                                          { return m_CmdLine.optionValues.m_PopulationDataPrinting; }
+    bool                                        PowerKernels() const                                                    { return m_CmdLine.optionValues.m_PowerKernels; }
     bool                                        PrintBoolAsString() const                                               { return m_CmdLine.optionValues.m_PrintBoolAsString; }
 
     PULSAR_BIRTH_MAGNETIC_FIELD_DISTRIBUTION    PulsarBirthMagneticFieldDistribution() const                            { return OPT_VALUE("pulsar-birth-magnetic-field-distribution", m_PulsarBirthMagneticFieldDistribution.type, true); }
@@ -1269,6 +1501,7 @@ public:
     bool                                        RLOFPrinting() const                                                    { return m_CmdLine.optionValues.m_RlofPrinting; }
 
     ROTATIONAL_VELOCITY_DISTRIBUTION            RotationalVelocityDistribution() const                                  { return OPT_VALUE("rotational-velocity-distribution", m_RotationalVelocityDistribution.type, true); }
+    bool                                        RotationalVelocityExactInverse() const                                  { return m_CmdLine.optionValues.m_RotationalVelocityExactInverse; }
     double                                      RotationalFrequency() const                                             { return OPT_VALUE("rotational-frequency", m_RotationalFrequency, true); }
     double                                      RotationalFrequency1() const                                            { return OPT_VALUE("rotational-frequency-1", m_RotationalFrequency1, true); }
     double                                      RotationalFrequency2() const                                            { return OPT_VALUE("rotational-frequency-2", m_RotationalFrequency2, true); }
@@ -1291,11 +1524,16 @@ public:
     bool                                        RequestedHelp() const                                                   { return m_CmdLine.optionValues.m_VM["help"].as<bool>(); }
     bool                                        RequestedVersion() const                                                { return m_CmdLine.optionValues.m_VM["version"].as<bool>(); }
 
+    bool                                        StageSystemRecords() const                                              { return m_CmdLine.optionValues.m_StageSystemRecords; }
     bool                                        SwitchLog() const                                                       { return OPT_VALUE("switch-log", m_SwitchLog, true); }
 
     ZETA_PRESCRIPTION                           StellarZetaPrescription() const                                         { return OPT_VALUE("stellar-zeta-prescription", m_StellarZetaPrescription.type, true); }
 
-    double                                      TimestepMultiplier() const                                              { return m_CmdLine.optionValues.m_TimestepMultiplier; }
+    double                                      TimestepMultiplier() const                                              { return CMDLINE_VALUE("timestep-multiplier", m_TimestepMultiplier); }
+    bool                                        TimestepRadialChangePrediction() const                                  { return CMDLINE_VALUE("timestep-radial-change-prediction", m_TimestepRadialChangePrediction); }
+
+    string                                      TrackLibraryFilename() const                                            { return m_CmdLine.optionValues.m_TrackLibraryFilename; }
+    TRACK_LIBRARY_MODE                          TrackLibraryMode() const                                                { return m_CmdLine.optionValues.m_TrackLibraryMode.type; }
 
     bool                                        UseFixedUK() const                                                      { return (m_GridLine.optionValues.m_UseFixedUK || m_CmdLine.optionValues.m_UseFixedUK); }
     bool                                        UseMassLoss() const                                                     { return OPT_VALUE("use-mass-loss", m_UseMassLoss, true); }
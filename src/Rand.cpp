@@ -37,6 +37,10 @@ void Rand::Initialise() {
     if (!m_Rng) {
         m_Rng = gsl_rng_alloc(gsl_rng_default);
     }
+
+    if (!m_StreamRng) {
+        m_StreamRng = gsl_rng_alloc(gsl_rng_default);
+    }
 }
 
 
@@ -48,6 +52,150 @@ void Rand::Initialise() {
  */
 void Rand::Free() {
     gsl_rng_free(m_Rng);
+    gsl_rng_free(m_StreamRng);
+    if (m_Qrng) { gsl_qrng_free(m_Qrng); m_Qrng = NULL; }
+}
+
+
+/*
+ * Return the state of the random number service
+ *
+ * The state of the GSL random number generator, and of the current initial-condition point - so
+ * that a sequence of draws can be repeated by RestoreState() (e.g. to continue a binary forked from
+ * a snapshot as if it had been evolved from ZAMS - see BaseBinaryStar::TakeForkSnapshot()).
+ *
+ *
+ * RandStateT State() const
+ *
+ * @return                                      State of the random number service
+ */
+RandStateT Rand::State() const {
+
+    char *rngState       = static_cast<char*>(gsl_rng_state(m_Rng));
+    char *streamRngState = static_cast<char*>(gsl_rng_state(m_StreamRng));
+
+    return { std::vector<char>(rngState, rngState + gsl_rng_size(m_Rng)), m_QuasiRandomPoint, m_QuasiRandomUsed, m_QuasiRandomDimension,
+             std::vector<char>(streamRngState, streamRngState + gsl_rng_size(m_StreamRng)), m_Stream, m_SystemSeed, m_StreamEvents };
+}
+
+
+/*
+ * Restore the state of the random number service
+ *
+ *
+ * void RestoreState(const RandStateT& p_State)
+ *
+ * @param   [IN]    p_State                     State returned by State()
+ */
+void Rand::RestoreState(const RandStateT& p_State) {
+
+    std::copy(p_State.rng.begin(), p_State.rng.end(), static_cast<char*>(gsl_rng_state(m_Rng)));
+
+    m_QuasiRandomPoint     = p_State.quasiRandomPoint;
+    m_QuasiRandomUsed      = p_State.quasiRandomUsed;
+    m_QuasiRandomDimension = p_State.quasiRandomDimension;
+
+    std::copy(p_State.streamRng.begin(), p_State.streamRng.end(), static_cast<char*>(gsl_rng_state(m_StreamRng)));
+
+    m_Stream               = p_State.stream;
+    m_SystemSeed           = p_State.systemSeed;
+    m_StreamEvents         = p_State.streamEvents;
+}
+
+
+/*
+ * Seed the random number generator
+ *
+ * Also starts the substreams (see Stream()) of the system (star or binary) seeded: the seed keys the
+ * substreams, no substream is selected, and no events have been drawn from any substream.
+ *
+ *
+ * unsigned long int Seed(const unsigned long p_Seed)
+ *
+ * @param   [IN]    p_Seed                      Seed
+ * @return                                      Seed
+ */
+unsigned long int Rand::Seed(const unsigned long p_Seed) {
+
+    gsl_rng_set(m_Rng, p_Seed);
+
+    m_SystemSeed = p_Seed;
+    m_Stream     = -1;
+    m_StreamEvents.assign(static_cast<int>(RANDOM_STREAM::COUNT), 0);
+
+    return p_Seed;
+}
+
+
+/*
+ * Select the substream for the next event of a random process
+ *
+ * Common random numbers (program option --common-random-numbers): each physical random process (see
+ * RANDOM_STREAM) draws from its own substream, and each event of the process (e.g. each supernova kick)
+ * from its own segment of the substream, seeded from the random seed of the system, the process, and the
+ * number of events of the process already drawn for the system.  The draws of a process then do not
+ * depend on how many random numbers other processes have drawn, so variations of the program options
+ * evolving the same system (same random seed) draw the same random numbers wherever their histories
+ * coincide - and the differences between the variations are not swamped by Monte Carlo noise.
+ *
+ * Draws come from the substream until StreamClear() is called.  No-op (draws come from the main
+ * generator) unless common random numbers are enabled (see EnableStreams()), or p_Always is true.
+ *
+ * p_Always selects the substream whether or not common random numbers are enabled - for draws that
+ * must neither depend on nor disturb the draws from the main generator (e.g. the kick values drawn
+ * when a star or binary is constructed - see BaseBinaryStar::BaseBinaryStar()).
+ *
+ *
+ * void Stream(const RANDOM_STREAM p_Stream, const bool p_Always)
+ *
+ * @param   [IN]    p_Stream                    The random process
+ * @param   [IN]    p_Always                    Select the substream even if common random numbers are not enabled
+ */
+void Rand::Stream(const RANDOM_STREAM p_Stream, const bool p_Always) {
+
+    if (!m_StreamsEnabled && !p_Always) return;
+
+    m_Stream = static_cast<int>(p_Stream);
+
+    uint64_t key = static_cast<uint64_t>(m_SystemSeed) * 0x9E3779B97F4A7C15ULL ^                // mix seed, process, and event (splitmix64 finaliser)
+                   static_cast<uint64_t>(m_Stream + 1) * 0xBF58476D1CE4E5B9ULL ^
+                   static_cast<uint64_t>(m_StreamEvents[m_Stream]++ + 1) * 0x94D049BB133111EBULL;
+    key ^= key >> 30; key *= 0xBF58476D1CE4E5B9ULL;
+    key ^= key >> 27; key *= 0x94D049BB133111EBULL;
+    key ^= key >> 31;
+
+    gsl_rng_set(m_StreamRng, static_cast<unsigned long>(key));
+}
+
+
+/*
+ * Return the next uniform variate in the range [0.0, 1.0)
+ *
+ * If a QMC dimension has been selected (see QuasiRandomDimension()), and that dimension of the
+ * current quasi-random point has not yet been consumed, the coordinate of the quasi-random point
+ * for that dimension is returned (and the dimension marked as consumed).  Otherwise a pseudo-random
+ * number is drawn from the GSL random number generator (of the selected substream, if any - see Stream()) - so rejection loops and retries in the
+ * samplers fall back to the pseudo-random stream once their quasi-random coordinate is used.
+ *
+ * The dimension selection applies to the next draw only.
+ *
+ *
+ * double Uniform()
+ *
+ * @return                                      Floating point number uniformly distributed in the range [0.0, 1.0)
+ */
+double Rand::Uniform() {
+
+    if (m_QuasiRandomDimension >= 0) {                                                          // QMC dimension selected?
+        int dimension = m_QuasiRandomDimension;                                                 // yes
+        m_QuasiRandomDimension = -1;                                                            // next draw only
+        if (!m_QuasiRandomUsed[dimension]) {                                                    // already consumed?
+            m_QuasiRandomUsed[dimension] = true;                                                // no - consume it
+            return m_QuasiRandomPoint[dimension];
+        }
+    }
+
+    return gsl_rng_uniform(Generator());
 }
 
 
@@ -60,7 +208,7 @@ void Rand::Free() {
  * @return                                      Random floating point number uniformly distributed in the range [0.0, 1.0)
  */
 double Rand::Random() {
-    return gsl_rng_uniform(m_Rng);
+    return Uniform();
 }
 
 
@@ -80,7 +228,7 @@ double Rand::Random(const double p_Lower, const double p_Upper) {
     double lower = std::min(p_Lower, p_Upper);
     double upper = std::max(p_Lower, p_Upper);
 
-    return (gsl_rng_uniform(m_Rng) * (upper - lower)) + lower;
+    return (Uniform() * (upper - lower)) + lower;
 }
 
 
@@ -100,7 +248,7 @@ int Rand::RandomInt(const int p_Lower, const int p_Upper) {
     int lower = std::min(p_Lower, p_Upper);
     int upper = std::max(p_Lower, p_Upper);
 
-    return gsl_rng_uniform_int(m_Rng, (upper - lower)) + lower;
+    return gsl_rng_uniform_int(Generator(), (upper - lower)) + lower;
 }
 
 
@@ -114,5 +262,90 @@ int Rand::RandomInt(const int p_Lower, const int p_Upper) {
  * @return                                      Gaussian random variate, with mean zero and standard deviation p_Sigma
  */
 double Rand::RandomGaussian(const double p_Sigma) {
-    return gsl_ran_gaussian(m_Rng, p_Sigma);
+    return gsl_ran_gaussian(Generator(), p_Sigma);
+}
+
+
+/*
+ * Initialise the quasi-random number generator used for QMC initial-condition sampling
+ *
+ * Allocates a Sobol generator with one dimension per sampled initial condition (see QMC_DIMENSION),
+ * and draws a random digital shift for each dimension from the pseudo-random stream seeded with
+ * p_Seed.  The digital shift (XOR of the 32-bit binary expansion of each coordinate) scrambles the
+ * sequence while preserving its (t,s)-net structure, so different seeds give statistically
+ * independent QMC estimates.
+ *
+ * The pseudo-random generator is left seeded with p_Seed - callers reseed per object anyway.
+ *
+ *
+ * void QuasiRandomInitialise(const unsigned long p_Seed)
+ *
+ * @param   [IN]    p_Seed                      Seed used to draw the digital shift
+ */
+void Rand::QuasiRandomInitialise(const unsigned long p_Seed) {
+
+    const size_t dimensions = static_cast<size_t>(QMC_DIMENSION::COUNT);
+
+    if (m_Qrng) gsl_qrng_free(m_Qrng);
+    m_Qrng = gsl_qrng_alloc(gsl_qrng_sobol, dimensions);
+
+    (void)Seed(p_Seed);
+
+    m_QuasiRandomShift.resize(dimensions);
+    for (size_t dimension = 0; dimension < dimensions; dimension++) {
+        m_QuasiRandomShift[dimension] = static_cast<uint32_t>(gsl_rng_uniform(m_Rng) * 4294967296.0);
+    }
+
+    m_QuasiRandomPoint.assign(dimensions, 0.0);
+    m_QuasiRandomUsed.assign(dimensions, true);                                                 // no point until QuasiRandomNextPoint() is called
+    m_QuasiRandomDimension = -1;
+}
+
+
+/*
+ * Advance to the next point of the (scrambled) quasi-random sequence
+ *
+ * Called once per object (star or binary) before its initial conditions are sampled.
+ * No-op if QMC sampling has not been initialised.
+ *
+ * Coordinates are returned at the centre of their 2^-32 cell so that they are never exactly 0.0
+ * (some samplers take the log of the uniform draw).
+ *
+ *
+ * void QuasiRandomNextPoint()
+ */
+void Rand::QuasiRandomNextPoint() {
+
+    if (!m_Qrng) return;
+
+    std::vector<double> point(m_QuasiRandomPoint.size());
+    gsl_qrng_get(m_Qrng, point.data());
+
+    for (size_t dimension = 0; dimension < point.size(); dimension++) {
+        uint32_t bits = static_cast<uint32_t>(point[dimension] * 4294967296.0) ^ m_QuasiRandomShift[dimension];
+        m_QuasiRandomPoint[dimension] = (static_cast<double>(bits) + 0.5) / 4294967296.0;
+        m_QuasiRandomUsed[dimension]  = false;
+    }
+
+    m_QuasiRandomDimension = -1;
+}
+
+
+/*
+ * Set the initial-condition point to be used for the next object (star or binary)
+ *
+ * Used by the adaptive importance sampler to supply the point drawn from its proposal distribution.
+ * The point is consumed one dimension at a time by the initial-condition samplers exactly as a
+ * quasi-random point is (see Uniform()).
+ *
+ *
+ * void QuasiRandomPoint(const std::vector<double>& p_Point)
+ *
+ * @param   [IN]    p_Point                     The point - one coordinate in [0.0, 1.0) per QMC_DIMENSION
+ */
+void Rand::QuasiRandomPoint(const std::vector<double>& p_Point) {
+
+    m_QuasiRandomPoint = p_Point;
+    m_QuasiRandomUsed.assign(m_QuasiRandomPoint.size(), false);
+    m_QuasiRandomDimension = -1;
 }
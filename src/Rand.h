@@ -5,6 +5,25 @@
 
 #include <gsl/gsl_rng.h>                                    // GSL random number generator
 #include <gsl/gsl_randist.h>
+#include <gsl/gsl_qrng.h>                                   // GSL quasi-random number generator
+
+#include <cstdint>
+#include <vector>
+
+#include "constants.h"
+
+
+// State of the random number service - see Rand::State() and Rand::RestoreState()
+typedef struct RandState {
+    std::vector<char>   rng;                                                                      // GSL random number generator state
+    std::vector<double> quasiRandomPoint;                                                         // current initial-condition point
+    std::vector<bool>   quasiRandomUsed;                                                          // which dimensions of the current point have been consumed
+    int                 quasiRandomDimension;                                                     // dimension to be used for the next uniform draw
+    std::vector<char>   streamRng;                                                                // substream random number generator state (common random numbers)
+    int                 stream;                                                                   // selected substream
+    unsigned long int   systemSeed;                                                               // random seed of the current system
+    std::vector<int>    streamEvents;                                                             // number of events drawn from each substream for the current system
+} RandStateT;
 
 
 /*
@@ -19,7 +38,7 @@ class Rand {
 
 private:
 
-   Rand() { m_Rng = NULL; };
+   Rand() { m_Rng = NULL; m_Qrng = NULL; m_QuasiRandomDimension = -1; m_StreamRng = NULL; m_StreamsEnabled = false; m_SystemSeed = 0; m_Stream = -1; m_StreamEvents.assign(static_cast<int>(RANDOM_STREAM::COUNT), 0); };
    Rand(Rand const&) = delete;
    Rand& operator = (Rand const&) = delete;
 
@@ -27,6 +46,22 @@ private:
 
    gsl_rng*      m_Rng;                                                                           // GSL random number generator
 
+   gsl_qrng*             m_Qrng;                                                                  // GSL quasi-random number generator (QMC initial-condition sampling) - NULL if not sampling QMC
+   std::vector<uint32_t> m_QuasiRandomShift;                                                      // random digital shift (scramble) applied to each dimension
+   std::vector<double>   m_QuasiRandomPoint;                                                      // current initial-condition point (scrambled quasi-random, or supplied by the adaptive sampler) - empty = none
+   std::vector<bool>     m_QuasiRandomUsed;                                                       // which dimensions of the current point have been consumed
+   int                   m_QuasiRandomDimension;                                                  // dimension to be used for the next uniform draw (-1 = none)
+
+   gsl_rng*              m_StreamRng;                                                             // GSL random number generator for the selected substream (common random numbers)
+   bool                  m_StreamsEnabled;                                                        // substreams enabled? (program option --common-random-numbers)
+   unsigned long int     m_SystemSeed;                                                            // random seed of the current system (star or binary) - substreams are keyed by it
+   int                   m_Stream;                                                                // substream selected for draws (-1 = none - draws come from m_Rng)
+   std::vector<int>      m_StreamEvents;                                                          // number of events drawn from each substream for the current system
+
+   gsl_rng*      Generator() const { return m_Stream >= 0 ? m_StreamRng : m_Rng; }
+
+   double        Uniform();
+
 
 public:
 
@@ -36,13 +71,27 @@ public:
    void          Free();
 
    unsigned long int DefaultSeed()                      { return gsl_rng_default_seed; }
-   unsigned long int Seed(const unsigned long p_Seed)   { gsl_rng_set(m_Rng, p_Seed); return p_Seed; }
+   unsigned long int Seed(const unsigned long p_Seed);
+
+   RandStateT    State() const;
+   void          RestoreState(const RandStateT& p_State);
 
    double        Random();
    double        Random(const double p_Lower, const double p_Upper);
    int           RandomInt(const int p_Lower, const int p_Upper);
    int           RandomInt(const int p_Upper) { return p_Upper < 0 ? 0 : RandomInt(0, p_Upper); }
    double        RandomGaussian(const double p_Sigma);
+
+   void          EnableStreams(const bool p_Enable) { m_StreamsEnabled = p_Enable; }
+   void          Stream(const RANDOM_STREAM p_Stream, const bool p_Always = false);
+   void          StreamClear()                      { m_Stream = -1; }
+
+   void          QuasiRandomInitialise(const unsigned long p_Seed);
+   void          QuasiRandomNextPoint();
+   void          QuasiRandomPoint(const std::vector<double>& p_Point);
+   void          QuasiRandomDimension(const QMC_DIMENSION p_Dimension) { if (!m_QuasiRandomPoint.empty()) m_QuasiRandomDimension = static_cast<int>(p_Dimension); }
+   void          QuasiRandomDimensionClear()                           { m_QuasiRandomDimension = -1; }
+   bool          QuasiRandomDimensionUsed(const QMC_DIMENSION p_Dimension) const { return !m_QuasiRandomPoint.empty() && m_QuasiRandomUsed[static_cast<int>(p_Dimension)]; }
 };
 
 
@@ -1,6 +1,9 @@
 #include "Star.h"
+#include "EventBus.h"
 #include <algorithm>
-#include <csignal>
+#include <sstream>
+
+Star::TimestepStatisticsT Star::m_TimestepStatistics = { 0, 0, 0, 0, 0 };
 
 // Default constructor
 Star::Star() : m_Star(new BaseStar()) {
@@ -160,16 +163,19 @@ STELLAR_TYPE Star::SwitchTo(const STELLAR_TYPE p_StellarType, bool p_SetInitialT
             if (p_SetInitialType) m_Star->SetInitialType(p_StellarType);
         }
 
-        // write to switch log file if required
+        // write to switch log file if required, and publish the switch event
 
-        if (utils::IsOneOf(stellarTypePrev, EVOLVABLE_TYPES) && OPTIONS->SwitchLog()) {     // star should be evolving from one of the evolvable types (We don't want the initial switch from Star->MS.  Not necessary for BSE (handled differently), but no harm)
-        
-            LOGGING->SetSwitchParameters(m_ObjectId, stellarTypePrev, p_StellarType);       // store switch details to LOGGING service
-            if (OPTIONS->EvolutionMode() == EVOLUTION_MODE::BSE) {                          // BSE?
-                raise(SIGUSR1);                                                             // signal to BSE that switch is occurring
+        if (utils::IsOneOf(stellarTypePrev, EVOLVABLE_TYPES)) {                             // star should be evolving from one of the evolvable types (We don't want the initial switch from Star->MS.  Not necessary for BSE (handled differently), but no harm)
+
+            if (OPTIONS->SwitchLog()) {                                                     // switch log?
+                LOGGING->SetSwitchParameters(m_ObjectId, stellarTypePrev, p_StellarType);   // yes - store switch details to LOGGING service
+                if (OPTIONS->EvolutionMode() == EVOLUTION_MODE::SSE) {                      // SSE?
+                    (void)m_Star->PrintSwitchLog(m_Id);                                     // yes - just call the function (BSE subscribes to the switch event - see BinaryStar::Evolve())
+                }
             }
-            else {                                                                          // SSE
-                (void)m_Star->PrintSwitchLog(m_Id);                                         // no need for the BSE signal shenaningans - just call the function
+
+            if (EVENTS->HasSubscribers(EVENT_TYPE::STELLAR_TYPE_SWITCH)) {                  // anyone interested in the switch?
+                EVENTS->Publish({ EVENT_TYPE::STELLAR_TYPE_SWITCH, m_Id, m_ObjectId, stellarTypePrev, p_StellarType, m_Star->Age() });
             }
         }
     }
@@ -387,14 +393,69 @@ STELLAR_TYPE Star::AgeOneTimestep(const double p_DeltaTime, bool p_Switch) {
 }
 
 
+/*
+ * Predict the timestep over which the radial change of the star will be less than MAXIMUM_RADIAL_CHANGE
+ *
+ * EvolveOneTimestep() takes a timestep only if the radial change over it is less than MAXIMUM_RADIAL_CHANGE -
+ * otherwise it reverts the star, halves the timestep and tries again, and each retry costs a copy of the star,
+ * an age and a revert.  Here the radial change over the suggested timestep is predicted from the rate of change
+ * of the radius over the previous timestep, if that was taken on the current phase:
+ *
+ *     dlnR/dt = ln(R / R_prev) / dt_prev
+ *
+ *     predicted radial change = |exp(dlnR/dt * dt) - 1|
+ *
+ * and the timestep is halved, as by the retries, until the predicted radial change is less than MAXIMUM_RADIAL_CHANGE
+ * (or the timestep reaches the minimum timestep, or the number of halvings reaches MAX_TIMESTEP_RETRIES).  So when
+ * the prediction is right the timestep taken is the one the retries would have found, without the retries.
+ *
+ * The radius is extrapolated log-linearly in time.  That is exact on the Hertzsprung Gap, where ln R is linear in
+ * the relative age tau (Hurley et al. 2000, eq 27), and close to it elsewhere over a single timestep.  The timestep
+ * choosers (ChooseTimestep()) end timesteps at the end of the phase (m_Timescales), so the extrapolation does not
+ * cross into the next phase.  When the prediction is too low EvolveOneTimestep() retries as usual; when it is too
+ * high the timestep is shorter than necessary.
+ *
+ *
+ * double PredictTimestep(const double p_Dt, const double p_MinTimestep, int &p_Halvings)
+ *
+ * @param   [IN]    p_Dt                        The suggested timestep (Myr)
+ * @param   [IN]    p_MinTimestep               The minimum timestep (Myr) - the timestep is not halved below this
+ * @param   [OUT]   p_Halvings                  The number of times the timestep was halved
+ * @return                                      The predicted timestep (Myr)
+ */
+double Star::PredictTimestep(const double p_Dt, const double p_MinTimestep, int &p_Halvings) const {
+
+    p_Halvings = 0;
+
+    double radiusPrev = m_Star->RadiusPrev();
+    double dtPrev     = m_Star->Dt();                                                                           // the previous timestep
+
+    if (m_Star->StellarTypePrev() != m_Star->StellarType() || radiusPrev <= 0.0 || dtPrev <= 0.0) return p_Dt; // no previous timestep on this phase - no prediction
+
+    double dlnRdt = std::log(m_Star->Radius() / radiusPrev) / dtPrev;                                           // rate of change of ln R over the previous timestep
+
+    double dt = p_Dt;
+    while (std::abs(std::expm1(dlnRdt * dt)) >= MAXIMUM_RADIAL_CHANGE &&                                        // predicted radial change too large?
+           utils::Compare(dt, p_MinTimestep) > 0 && p_Halvings < MAX_TIMESTEP_RETRIES) {                        // and timestep can be shortened?
+        dt = dt / 2.0;                                                                                          // yes - halve the timestep
+        p_Halvings++;
+    }
+
+    return dt;
+}
+
+
 /*
  * Evolve the star a single timestep - suggested timestep is provided
  *
+ *    - if required, shorten the timestep by the predicted radial change (see PredictTimestep())
  *    - save current state
  *    - age star timestep
  *    - if ageing caused too much change, revert state, shorten timestep and try again
  *    - loop until suitable timestep found (and taken)
  *
+ * The number of timesteps taken and retried is written to the run details file (see TimestepSummary()).
+ *
  * The functional return is the timestep actually taken (in Myr)
  *
  * double EvolveOneTimestep(const double p_Dt)
@@ -410,6 +471,16 @@ double Star::EvolveOneTimestep(const double p_Dt) {
 
     bool         takeTimestep = false;
     int          retryCount   = 0;
+    int          halvings     = 0;
+
+    if (OPTIONS->TimestepRadialChangePrediction()) {                                                            // shorten the timestep by the predicted radial change?
+        dt = PredictTimestep(dt, std::max(m_Star->CalculateDynamicalTimescale(), ABSOLUTE_MINIMUM_TIMESTEP), halvings);
+        if (halvings > 0) {
+            m_TimestepStatistics.predicted++;
+            m_TimestepStatistics.halvings += halvings;
+        }
+        retryCount = halvings;                                                                                  // halvings count towards the maximum retries - as if retried
+    }
 
     while (!takeTimestep) {                                                                                     // do this until a suitable timestep is found (or the maximum retry count is reached)
         
@@ -432,6 +503,7 @@ double Star::EvolveOneTimestep(const double p_Dt) {
             }
             else {                                                                                              // not at or below dynamical - reduce timestep and try again
                 retryCount++;                                                                                   // increment retry count
+                m_TimestepStatistics.retries++;
                 if (retryCount > MAX_TIMESTEP_RETRIES) {                                                        // too many retries?
                     takeTimestep = true;                                                                        // yes - take the last timestep anyway
                     SHOW_WARN(ERROR::TIMESTEP_BELOW_MINIMUM);                                                   // announce the problem if required and plough on regardless...
@@ -452,6 +524,9 @@ double Star::EvolveOneTimestep(const double p_Dt) {
 
     // take the timestep
 
+    m_TimestepStatistics.steps++;
+    if (retryCount > halvings) m_TimestepStatistics.stepsRetried++;
+
     (void)m_Star->PrintStashedSupernovaDetails();                                                               // print stashed SSE Supernova log record if necessary
 
     (void)SwitchTo(stellarType);                                                                                // switch phase if required  JR: whether this goes before or after the log record is a little problematic, but in the end probably doesn't matter too much
@@ -462,6 +537,37 @@ double Star::EvolveOneTimestep(const double p_Dt) {
 }
 
 
+/*
+ * Summarise the timesteps taken by EvolveOneTimestep() over the run, and the retries
+ *
+ * Written to the run details file.
+ *
+ *
+ * std::string TimestepSummary()
+ *
+ * @return                                      Multi-line summary (empty if no timesteps were taken)
+ */
+std::string Star::TimestepSummary() {
+
+    const TimestepStatisticsT& stats = m_TimestepStatistics;
+
+    if (stats.steps == 0) return "";
+
+    std::ostringstream ss;
+    ss << "\nSSE timesteps:\n"
+       << "  Timesteps taken = " << stats.steps
+       << "; retried (radial change too large) = " << stats.retries
+       << ", timesteps taken after a retry = " << stats.stepsRetried
+       << ", retries per timestep = " << (double)stats.retries / stats.steps << "\n";
+    if (OPTIONS->TimestepRadialChangePrediction()) {
+        ss << "  Timesteps shortened by the radial change prediction = " << stats.predicted
+           << "; halvings = " << stats.halvings << "\n";
+    }
+
+    return ss.str();
+}
+
+
 /*
  * Evolve the star through its entire lifetime
  *
@@ -160,6 +160,8 @@ public:
     double          CalculateMomentOfInertia(const double p_RemnantRadius = 0.0) const                              { return m_Star->CalculateMomentOfInertia(p_RemnantRadius); }
     double          CalculateMomentOfInertiaAU(const double p_RemnantRadius = 0.0) const                            { return m_Star->CalculateMomentOfInertiaAU(p_RemnantRadius); }
 
+    std::tuple<bool, double> CalculateRadiusAfterMassChange(const double p_DeltaMass, const double p_DeltaMass0) const { return m_Star->CalculateRadiusAfterMassChange(p_DeltaMass, p_DeltaMass0); }
+
     void            CalculateSNAnomalies(const double p_Eccentricity)                                               { m_Star->CalculateSNAnomalies(p_Eccentricity); }
     
     double          CalculateSNKickMagnitude(const double p_RemnantMass, 
@@ -179,6 +181,8 @@ public:
 
     void            ClearCurrentSNEvent()                                                                           { m_Star->ClearCurrentSNEvent(); }
 
+    std::size_t     CountBatchEvaluationMismatches(const DBL_VECTOR &p_Masses)                                      { return m_Star->CountBatchEvaluationMismatches(p_Masses); }
+
     BaseStar*       Clone(const BaseStar& p_Star);
 
     ENVELOPE        DetermineEnvelopeType() const                                                                   { return m_Star->DetermineEnvelopeType(); }
@@ -189,6 +193,8 @@ public:
 
     void            IncrementOmega(const double p_OmegaDelta)                                                       { m_Star->IncrementOmega(p_OmegaDelta); }
 
+    void            ResampleSNKick()                                                                                { m_Star->ResampleSNKick(); }
+
     void            ResolveAccretion(const double p_AccretionMass)                                                  { m_Star->ResolveAccretion(p_AccretionMass); }
 
     void            ResolveEnvelopeLossAndSwitch()                                                                  { (void)SwitchTo(m_Star->ResolveEnvelopeLoss(true)); }
@@ -208,6 +214,8 @@ public:
 
     STELLAR_TYPE    SwitchTo(const STELLAR_TYPE p_StellarType, bool p_SetInitialType = false);
 
+    static std::string TimestepSummary();
+
     void            UpdateAgeAfterMassLoss()                                                                        { m_Star->UpdateAgeAfterMassLoss(); }
 
     void            UpdateAttributes()                                                                              { (void)UpdateAttributes(0.0, 0.0, true); }
@@ -245,6 +253,19 @@ private:
     BaseStar   *m_Star;                                                                                         // pointer to current star
     BaseStar   *m_SaveStar;                                                                                     // pointer to saved star
 
+    // Timesteps taken by EvolveOneTimestep(), and retries, over the run
+    typedef struct TimestepStatistics {
+        unsigned long int   steps;                                                                              // number of timesteps taken
+        unsigned long int   retries;                                                                            // number of timesteps discarded (radial change too large) and retried
+        unsigned long int   stepsRetried;                                                                       // number of timesteps taken after at least one retry
+        unsigned long int   predicted;                                                                          // number of timesteps shortened by the radial change prediction (--timestep-radial-change-prediction)
+        unsigned long int   halvings;                                                                           // total number of halvings of the timestep by the prediction
+    } TimestepStatisticsT;
+
+    static TimestepStatisticsT m_TimestepStatistics;
+
+    double      PredictTimestep(const double p_Dt, const double p_MinTimestep, int &p_Halvings) const;
+
 };
 
 #endif // __Star_h__
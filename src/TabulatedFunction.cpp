@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cmath>
+
+#include "TabulatedFunction.h"
+
+
+/*
+ * Construct a tabulated function from (x, y) pairs
+ *
+ * Pairs are sorted by x (so may be supplied in any order, as they could be in a std::map initialiser).
+ *
+ *
+ * TabulatedFunction(std::initializer_list<std::pair<double, double>> p_Table)
+ *
+ * @param   [IN]    p_Table                     (x, y) pairs
+ */
+TabulatedFunction::TabulatedFunction(std::initializer_list<std::pair<double, double>> p_Table) {
+
+    std::vector<std::pair<double, double>> table(p_Table);
+    std::sort(table.begin(), table.end());
+
+    m_X.reserve(table.size());
+    m_Y.reserve(table.size());
+    for (auto &entry : table) {
+        m_X.push_back(entry.first);
+        m_Y.push_back(entry.second);
+    }
+
+    Build();
+}
+
+
+/*
+ * Construct a tabulated function from x and y arrays
+ *
+ *
+ * TabulatedFunction(const std::vector<double>& p_X, const std::vector<double>& p_Y)
+ *
+ * @param   [IN]    p_X                         x values (ascending)
+ * @param   [IN]    p_Y                         y values (same size as p_X)
+ */
+TabulatedFunction::TabulatedFunction(const std::vector<double>& p_X, const std::vector<double>& p_Y) {
+
+    m_X = p_X;
+    m_Y = p_Y;
+    m_Y.resize(m_X.size(), 0.0);
+
+    Build();
+}
+
+
+/*
+ * Tabulate a non-decreasing function, for inverse interpolation
+ *
+ * [p_XMin, p_XMax] is divided into p_InitialSegments equal segments, and each segment is bisected
+ * until x(y) interpolated on the segment at the function values of the segment's quartiles is
+ * within p_Tolerance x max(1, |x|) of the quartiles (so the tolerance is relative for |x| > 1 and
+ * absolute below).  Bisection stops at segments narrower than p_Tolerance x 1.0E-3 (where the
+ * function is too steep to resolve in double precision).  Rounding that would make the tabulated
+ * values decrease is removed, so the table is monotone.
+ *
+ *
+ * TabulatedFunction TabulateMonotone(const std::function<double(double)>& p_Function,
+ *                                    const double                         p_XMin,
+ *                                    const double                         p_XMax,
+ *                                    const double                         p_Tolerance,
+ *                                    const int                            p_InitialSegments)
+ *
+ * @param   [IN]    p_Function                  The (non-decreasing) function to tabulate
+ * @param   [IN]    p_XMin                      Start of the table
+ * @param   [IN]    p_XMax                      End of the table
+ * @param   [IN]    p_Tolerance                 Tolerance of x(y) interpolation (see above)
+ * @param   [IN]    p_InitialSegments           Number of segments before bisection
+ * @return                                      The table
+ */
+TabulatedFunction TabulatedFunction::TabulateMonotone(const std::function<double(double)>& p_Function,
+                                                      const double                         p_XMin,
+                                                      const double                         p_XMax,
+                                                      const double                         p_Tolerance,
+                                                      const int                            p_InitialSegments) {
+
+    // segment [x0, x1] is accurate enough if x(y) interpolated at the
+    // function values of its quartiles is within tolerance of the quartiles
+    auto accurate = [&p_Function, p_Tolerance](const double p_X0, const double p_Y0, const double p_X1, const double p_Y1) {
+        if (p_Y1 <= p_Y0) return true;                                                          // flat - nothing to invert
+        for (int quartile = 1; quartile <= 3; quartile++) {
+            double x       = p_X0 + 0.25 * quartile * (p_X1 - p_X0);
+            double xInterp = p_X0 + (p_Function(x) - p_Y0) * (p_X1 - p_X0) / (p_Y1 - p_Y0);
+            if (std::abs(xInterp - x) > p_Tolerance * std::max(1.0, std::abs(x))) return false;
+        }
+        return true;
+    };
+
+    int segments = std::max(1, p_InitialSegments);
+
+    std::vector<double> x = { p_XMin };
+    std::vector<double> y = { p_Function(p_XMin) };
+
+    for (int segment = 1; segment <= segments; segment++) {
+
+        double xEnd = segment == segments ? p_XMax : p_XMin + (p_XMax - p_XMin) * segment / segments;
+
+        std::vector<std::pair<double, double>> pending = {{ xEnd, p_Function(xEnd) }};         // right-hand ends of segments still to be accepted - nearest last
+
+        while (!pending.empty()) {
+            double x1 = pending.back().first;
+            double y1 = pending.back().second;
+            if ((x1 - x.back()) <= p_Tolerance * 1.0E-3 || accurate(x.back(), y.back(), x1, y1)) {
+                x.push_back(x1);
+                y.push_back(std::max(y1, y.back()));                                            // keep the table monotone through rounding
+                pending.pop_back();
+            }
+            else {
+                double xMid = 0.5 * (x.back() + x1);
+                pending.push_back({ xMid, p_Function(xMid) });
+            }
+        }
+    }
+
+    return TabulatedFunction(x, y);
+}
+
+
+/*
+ * Precompute segment slopes and the equal-spacing shortcut
+ *
+ *
+ * void Build()
+ */
+void TabulatedFunction::Build() {
+
+    size_t segments = m_X.size() > 1 ? m_X.size() - 1 : 0;
+
+    m_Slope.assign(segments, 0.0);
+
+    for (size_t i = 0; i < segments; i++) {
+        double dx = m_X[i + 1] - m_X[i];
+        double dy = m_Y[i + 1] - m_Y[i];
+        m_Slope[i] = dx > 0.0 ? dy / dx : 0.0;
+    }
+
+    m_EquallySpaced = false;
+    m_OneOverDx     = 0.0;
+    if (segments > 0 && m_X.back() > m_X.front()) {
+        double dx = (m_X.back() - m_X.front()) / static_cast<double>(segments);
+        m_EquallySpaced = true;
+        for (size_t i = 0; i < segments && m_EquallySpaced; i++) {
+            m_EquallySpaced = std::abs((m_X[i + 1] - m_X[i]) - dx) <= 1.0E-12 * std::max(std::abs(dx), std::abs(m_X[i]));
+        }
+        if (m_EquallySpaced) m_OneOverDx = 1.0 / dx;
+    }
+}
+
+
+/*
+ * Branch-free binary search: index of the first value >= p_Value (p_Values.size() if none)
+ *
+ *
+ * size_t LowerBound(const std::vector<double>& p_Values, const double p_Value)
+ *
+ * @param   [IN]    p_Values                    Values to search (ascending)
+ * @param   [IN]    p_Value                     Value to search for
+ * @return                                      Index
+ */
+size_t TabulatedFunction::LowerBound(const std::vector<double>& p_Values, const double p_Value) {
+
+    if (p_Values.empty()) return 0;
+
+    const double* first = p_Values.data();
+    const double* base  = first;
+    size_t        n     = p_Values.size();
+
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (base[half - 1] < p_Value) ? base + half : base;                                 // compiles to a conditional move
+        n   -= half;
+    }
+
+    return static_cast<size_t>(base - first) + (*base < p_Value ? 1 : 0);
+}
+
+
+/*
+ * Interpolate y(x)
+ *
+ * Values of x outside the table are clamped to the ends of the table.
+ *
+ *
+ * double Interpolate(const double p_X)
+ *
+ * @param   [IN]    p_X                         The x value at which to interpolate
+ * @return                                      Interpolated y value (0.0 if the table is empty)
+ */
+double TabulatedFunction::Interpolate(const double p_X) const {
+
+    if (m_X.empty())        return 0.0;
+    if (p_X <= m_X.front()) return m_Y.front();
+    if (p_X >= m_X.back())  return m_Y.back();
+
+    size_t segment = m_EquallySpaced
+                        ? std::min(static_cast<size_t>((p_X - m_X.front()) * m_OneOverDx), m_Slope.size() - 1)
+                        : LowerBound(m_X, p_X) - 1;                                             // p_X > x[0], so index >= 1
+
+    return m_Y[segment] + (p_X - m_X[segment]) * m_Slope[segment];
+}
+
+
+/*
+ * Interpolate x(y) - y must be non-decreasing in x
+ *
+ * Values of y outside the table are clamped to the ends of the table.
+ *
+ *
+ * double InverseInterpolate(const double p_Y)
+ *
+ * @param   [IN]    p_Y                         The y value at which to interpolate
+ * @return                                      Interpolated x value (0.0 if the table is empty)
+ */
+double TabulatedFunction::InverseInterpolate(const double p_Y) const {
+
+    if (m_Y.empty()) return 0.0;
+
+    size_t index = LowerBound(m_Y, p_Y);                                                        // first y >= p_Y
+    if (index == 0)           return m_X.front();
+    if (index >= m_Y.size())  return m_X.back();
+
+    size_t segment = index - 1;                                                                 // y[segment] < p_Y <= y[segment + 1], so dy > 0
+    return m_X[segment] + ((p_Y - m_Y[segment]) / m_Slope[segment]);
+}
+
+
+/*
+ * Inverse sample from the tabulated CDF
+ *
+ * p_U in [0, 1) is mapped linearly to [yMin, yMax), and x(y) interpolated - so the result is
+ * monotone in p_U.
+ *
+ *
+ * double InverseSampleCDF(const double p_U)
+ *
+ * @param   [IN]    p_U                         Uniform random number in [0, 1)
+ * @return                                      Sampled x value (0.0 if the table is empty or p_U is not in [0, 1))
+ */
+double TabulatedFunction::InverseSampleCDF(const double p_U) const {
+
+    if (m_Y.empty() || p_U < 0.0 || p_U >= 1.0) return 0.0;
+
+    double yMin = m_Y.front();
+    double yMax = m_Y.back();
+
+    return InverseInterpolate(yMin + (p_U * (std::max(yMin, yMax) - std::min(yMin, yMax))));
+}
@@ -0,0 +1,74 @@
+#ifndef __TabulatedFunction_h__
+#define __TabulatedFunction_h__
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+// Note: this header is included by constants.h - it must not include any COMPAS headers
+
+
+///////////////////////////////////////////////////////////
+//
+// TabulatedFunction object
+//
+// Tabulated function y(x), linearly interpolated.  The table
+// is held as contiguous sorted arrays with precomputed
+// segment slopes, built once when the table is constructed:
+//
+//     Interpolate()        : y(x)      - clamped to the end values outside the table
+//     InverseInterpolate() : x(y)      - y must be non-decreasing in x
+//     InverseSampleCDF()   : x(u)      - y is a CDF (need not be normalised), u in [0, 1) mapped to [yMin, yMax)
+//
+// Segments are found with a branch-free binary search, or
+// directly if the x values are equally spaced.
+//
+///////////////////////////////////////////////////////////
+
+class TabulatedFunction {
+
+public:
+
+    TabulatedFunction() : m_EquallySpaced(false), m_OneOverDx(0.0) {}
+    TabulatedFunction(std::initializer_list<std::pair<double, double>> p_Table);
+    TabulatedFunction(const std::vector<double>& p_X, const std::vector<double>& p_Y);
+
+    static TabulatedFunction   TabulateMonotone(const std::function<double(double)>& p_Function,
+                                                const double                         p_XMin,
+                                                const double                         p_XMax,
+                                                const double                         p_Tolerance,
+                                                const int                            p_InitialSegments = 64);
+
+    // getters
+    const std::vector<double>& X() const                    { return m_X; }
+    const std::vector<double>& Y() const                    { return m_Y; }
+    size_t                     Size() const                 { return m_X.size(); }
+
+    double                     XMax() const                 { return m_X.back(); }
+    double                     XMin() const                 { return m_X.front(); }
+    double                     YAtXMax() const              { return m_Y.back(); }
+    double                     YAtXMin() const              { return m_Y.front(); }
+
+    // member functions
+    double                     Interpolate(const double p_X) const;
+    double                     InverseInterpolate(const double p_Y) const;
+    double                     InverseSampleCDF(const double p_U) const;
+
+private:
+
+    std::vector<double> m_X;                                // x values (ascending)
+    std::vector<double> m_Y;                                // y values
+    std::vector<double> m_Slope;                            // dy/dx of segment i (between x[i] and x[i+1])
+
+    bool                m_EquallySpaced;                    // x values equally spaced? (segment found directly)
+    double              m_OneOverDx;                        // 1 / spacing of x values (if equally spaced)
+
+    void                Build();
+
+    static size_t       LowerBound(const std::vector<double>& p_Values, const double p_Value);
+};
+
+
+#endif // __TabulatedFunction_h__
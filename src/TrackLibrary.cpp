@@ -0,0 +1,638 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+
+#include "hdf5.h"
+#include "hdf5_hl.h"
+
+#include "TrackLibrary.h"
+#include "Options.h"
+#include "Log.h"
+#include "Star.h"
+#include "profiling.h"
+#include "utils.h"
+
+TrackLibrary* TrackLibrary::m_Instance = nullptr;
+
+
+TrackLibrary* TrackLibrary::Instance() {
+
+    if (!m_Instance) {
+        m_Instance = new TrackLibrary();
+    }
+    return m_Instance;
+}
+
+
+/*
+ * Initialise the track library
+ *
+ * Reads the track library mode and, in INTERPOLATE mode, reads the library from the file named by
+ * program option --track-library.
+ *
+ * Called from main() before evolution starts.
+ *
+ *
+ * bool Initialise()
+ *
+ * @return                                      Boolean flag indicating success (errors are shown here)
+ */
+bool TrackLibrary::Initialise() {
+
+    m_Mode    = OPTIONS->TrackLibraryMode();
+    m_Enabled = false;
+
+    if (m_Mode != TRACK_LIBRARY_MODE::INTERPOLATE) return true;                                     // nothing to read
+
+    if (!Read(OPTIONS->TrackLibraryFilename())) return false;                                       // error already shown
+
+    if (m_UseMassLoss != OPTIONS->UseMassLoss()) {                                                  // library evolved under the same mass loss?
+        SHOW_ERROR(ERROR::FILE_READ_ERROR, "Track library '" + OPTIONS->TrackLibraryFilename() + "' was created with --use-mass-loss " + (m_UseMassLoss ? "TRUE" : "FALSE"));
+        return false;
+    }
+
+    m_Enabled = true;
+
+    return true;
+}
+
+
+/*
+ * Allocate the arrays of the library for the grid of masses and metallicities
+ *
+ *
+ * void Allocate()
+ */
+void TrackLibrary::Allocate() {
+
+    std::size_t tracks = m_LogMasses.size() * m_LogMetallicities.size();
+    std::size_t points = tracks * TRACK_LIBRARY_PHASES * m_PointsPerPhase;
+
+    for (auto values : { &m_Time, &m_Mass, &m_CoreMass, &m_HeCoreMass, &m_COCoreMass, &m_Luminosity, &m_Radius }) values->assign(points, -1.0);
+    m_StellarType.assign(points, static_cast<int>(STELLAR_TYPE::NONE));
+
+    m_Valid.assign(tracks, 0);
+    m_RemnantStellarType.assign(tracks, static_cast<int>(STELLAR_TYPE::NONE));
+    m_RemnantTime.assign(tracks, -1.0);
+    m_RemnantMass.assign(tracks, -1.0);
+}
+
+
+/*
+ * Map a stellar type to the phase (slot) of the track library in which it is recorded
+ *
+ * Both MS types are recorded in the first phase; types other than the nuclear burning types
+ * MS to HeGB are not recorded.
+ *
+ *
+ * int Phase(const STELLAR_TYPE p_StellarType)
+ *
+ * @param   [IN]    p_StellarType               Stellar type
+ * @return                                      Phase, 0 .. TRACK_LIBRARY_PHASES - 1, or -1 if the type is not recorded
+ */
+int TrackLibrary::Phase(const STELLAR_TYPE p_StellarType) {
+
+    int stellarType = static_cast<int>(p_StellarType);
+
+    if (stellarType < static_cast<int>(STELLAR_TYPE::MS_LTE_07) || stellarType > static_cast<int>(STELLAR_TYPE::NAKED_HELIUM_STAR_GIANT_BRANCH)) return -1;
+
+    return std::max(0, stellarType - 1);
+}
+
+
+/*
+ * Evolve one track of the library
+ *
+ * The star is evolved as a single star (as SSE does, with the same timesteps) until it is no longer a
+ * nuclear burning star, or the maximum evolution time is reached.  Each phase the star passes through is
+ * then resampled at the points of the library (equally spaced in time from the first to the last timestep
+ * on the phase - linear interpolation, in log for luminosity and radius).
+ *
+ *
+ * bool EvolveTrack(const std::size_t p_Track, const double p_Mass, const double p_Metallicity)
+ *
+ * @param   [IN]    p_Track                     Index of the track
+ * @param   [IN]    p_Mass                      ZAMS mass (Msol)
+ * @param   [IN]    p_Metallicity               Metallicity
+ * @return                                      Boolean flag indicating whether the track is valid
+ */
+bool TrackLibrary::EvolveTrack(const std::size_t p_Track, const double p_Mass, const double p_Metallicity) {
+
+    typedef struct Sample {
+        double time;
+        double mass;
+        double coreMass;
+        double heCoreMass;
+        double coCoreMass;
+        double logLuminosity;
+        double logRadius;
+        int    stellarType;
+    } SampleT;
+
+    KickParameters kickParameters = {};                                                             // no kicks specified - supernovae are not part of the library
+
+    Star star(p_Track, p_Mass, p_Metallicity, kickParameters);
+
+    if (p_Track % m_LogMasses.size() == 0) {                                                        // first track at this metallicity?
+        DBL_VECTOR masses(m_LogMasses.size());                                                      // yes - check the batch fitting formulae over the masses of the grid
+        for (std::size_t i = 0; i < masses.size(); i++) masses[i] = PPOW(10.0, m_LogMasses[i]);
+        m_BatchMismatches += star.CountBatchEvaluationMismatches(masses);
+    }
+
+    std::vector<std::vector<SampleT>> samples(TRACK_LIBRARY_PHASES);                                // samples on each phase
+
+    auto sample = [&star](const double p_Time) -> SampleT {
+        return { p_Time, star.Mass(), star.CoreMass(), star.HeCoreMass(), star.COCoreMass(), std::log10(star.Luminosity()), std::log10(star.Radius()), static_cast<int>(star.StellarType()) };
+    };
+
+    bool   valid     = true;
+    int    lastPhase = Phase(star.StellarType());
+    double time      = 0.0;
+
+    if (lastPhase < 0) valid = false;                                                               // not a nuclear burning star at ZAMS (e.g. chemically homogeneous)
+    else {
+        samples[lastPhase].push_back(sample(time));
+
+        while (utils::Compare(time, OPTIONS->MaxEvolutionTime()) < 0) {
+            double dt = star.CalculateTimestep() * OPTIONS->TimestepMultiplier();
+            time     += star.EvolveOneTimestep(dt);
+
+            int phase = Phase(star.StellarType());
+            if (phase < 0) break;                                                                   // end of nuclear burning
+
+            if (phase < lastPhase) { valid = false; break; }                                        // not the usual sequence of phases
+
+            samples[phase].push_back(sample(time));
+            lastPhase = phase;
+        }
+    }
+
+    m_Valid[p_Track] = valid ? 1 : 0;
+    if (!valid) return false;
+
+    if (Phase(star.StellarType()) < 0) {                                                            // remnant formed?
+        m_RemnantStellarType[p_Track] = static_cast<int>(star.StellarType());                       // yes
+        m_RemnantTime[p_Track]        = time;
+        m_RemnantMass[p_Track]        = star.Mass();
+    }
+
+    for (int phase = 0; phase < TRACK_LIBRARY_PHASES; phase++) {                                    // resample each phase
+        const std::vector<SampleT> &onPhase = samples[phase];
+        if (onPhase.empty()) continue;                                                              // phase not passed through
+
+        double      start = onPhase.front().time;
+        double      end   = onPhase.back().time;
+        std::size_t s     = 0;
+        for (int point = 0; point < m_PointsPerPhase; point++) {
+            double t = m_PointsPerPhase > 1 ? start + ((end - start) * point) / (m_PointsPerPhase - 1) : end;
+            if (point == m_PointsPerPhase - 1) t = end;                                             // exactly
+
+            while (s + 1 < onPhase.size() && onPhase[s + 1].time < t) s++;                          // onPhase[s].time <= t <= onPhase[s + 1].time
+
+            const SampleT &a = onPhase[s];
+            const SampleT &b = onPhase[std::min(s + 1, onPhase.size() - 1)];
+            double         w = b.time > a.time ? std::min(1.0, std::max(0.0, (t - a.time) / (b.time - a.time))) : 0.0;
+
+            std::size_t i   = PointIndex(p_Track, phase, point);
+            m_Time[i]       = t;
+            m_Mass[i]       = a.mass       + (w * (b.mass       - a.mass));
+            m_CoreMass[i]   = a.coreMass   + (w * (b.coreMass   - a.coreMass));
+            m_HeCoreMass[i] = a.heCoreMass + (w * (b.heCoreMass - a.heCoreMass));
+            m_COCoreMass[i] = a.coCoreMass + (w * (b.coCoreMass - a.coCoreMass));
+            m_Luminosity[i] = PPOW(10.0, a.logLuminosity + (w * (b.logLuminosity - a.logLuminosity)));
+            m_Radius[i]     = PPOW(10.0, a.logRadius     + (w * (b.logRadius     - a.logRadius)));
+            m_StellarType[i]= w < 0.5 ? a.stellarType : b.stellarType;
+        }
+    }
+
+    return true;
+}
+
+
+/*
+ * Create the track library
+ *
+ * Evolves the grid of tracks and writes the library to the file named by program option --track-library.
+ * The grid is TRACK_LIBRARY_MASSES ZAMS masses, equally spaced in log from TRACK_LIBRARY_MINIMUM_MASS to
+ * TRACK_LIBRARY_MAXIMUM_MASS, at TRACK_LIBRARY_METALLICITIES metallicities, equally spaced in log over the
+ * range of --metallicity-distribution LOGUNIFORM - or at --metallicity only, for other distributions.
+ *
+ * The batch fitting formulae (see BaseStar.cpp, BATCH EVALUATION) are checked against the scalar fitting formulae
+ * over the masses of the grid at each metallicity of the grid (a warning is shown if any result differs).
+ *
+ * Called from main() instead of evolving stars or binaries (CREATE mode).
+ *
+ *
+ * bool Create()
+ *
+ * @return                                      Boolean flag indicating success (errors are shown here)
+ */
+bool TrackLibrary::Create() {
+
+    auto start = std::chrono::steady_clock::now();
+
+    m_PointsPerPhase = TRACK_LIBRARY_POINTS_PER_PHASE;
+    m_UseMassLoss    = OPTIONS->UseMassLoss();
+
+    double logMinMass = std::log10(TRACK_LIBRARY_MINIMUM_MASS);
+    double logMaxMass = std::log10(TRACK_LIBRARY_MAXIMUM_MASS);
+    m_LogMasses.resize(TRACK_LIBRARY_MASSES);
+    for (int i = 0; i < TRACK_LIBRARY_MASSES; i++) m_LogMasses[i] = logMinMass + ((logMaxMass - logMinMass) * i) / (TRACK_LIBRARY_MASSES - 1);
+
+    if (OPTIONS->MetallicityDistribution() == METALLICITY_DISTRIBUTION::LOGUNIFORM) {
+        double logMinZ = std::log10(OPTIONS->MetallicityDistributionMin());
+        double logMaxZ = std::log10(OPTIONS->MetallicityDistributionMax());
+        m_LogMetallicities.resize(TRACK_LIBRARY_METALLICITIES);
+        for (int i = 0; i < TRACK_LIBRARY_METALLICITIES; i++) m_LogMetallicities[i] = logMinZ + ((logMaxZ - logMinZ) * i) / (TRACK_LIBRARY_METALLICITIES - 1);
+    }
+    else {
+        m_LogMetallicities = { std::log10(OPTIONS->Metallicity()) };
+    }
+
+    Allocate();
+
+    for (std::size_t z = 0; z < m_LogMetallicities.size(); z++) {
+        for (std::size_t m = 0; m < m_LogMasses.size(); m++) {
+            (void)EvolveTrack(TrackIndex(z, m), PPOW(10.0, m_LogMasses[m]), PPOW(10.0, m_LogMetallicities[z]));
+        }
+    }
+
+    m_CreateSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (m_BatchMismatches > 0) SHOW_WARN(ERROR::BATCH_EVALUATION_MISMATCH, std::to_string(m_BatchMismatches) + " results");
+
+    return Write(OPTIONS->TrackLibraryFilename());
+}
+
+
+/*
+ * Write the track library to an HDF5 file
+ *
+ * Datasets: Masses and Metallicities (the grid); Time, Mass, Core_Mass, He_Core_Mass, CO_Core_Mass, Luminosity,
+ * Radius and Stellar_Type (the points, dimensions [metallicities, masses, TRACK_LIBRARY_PHASES * points per phase]);
+ * Valid, Remnant_Stellar_Type, Remnant_Time and Remnant_Mass (the tracks, dimensions [metallicities, masses]).
+ * Attributes: Points_Per_Phase and Use_Mass_Loss.
+ *
+ *
+ * bool Write(const std::string &p_Filename)
+ *
+ * @param   [IN]    p_Filename                  Name of the file (overwritten if it exists)
+ * @return                                      Boolean flag indicating success (errors are shown here)
+ */
+bool TrackLibrary::Write(const std::string &p_Filename) const {
+
+    hid_t file = H5Fcreate(p_Filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if (file < 0) {
+        SHOW_ERROR(ERROR::FILE_OPEN_ERROR, "Creating track library '" + p_Filename + "'");
+        return false;
+    }
+
+    hsize_t gridDims[1]   = { m_LogMasses.size() };
+    hsize_t trackDims[2]  = { m_LogMetallicities.size(), m_LogMasses.size() };
+    hsize_t pointDims[3]  = { m_LogMetallicities.size(), m_LogMasses.size(), static_cast<hsize_t>(TRACK_LIBRARY_PHASES * m_PointsPerPhase) };
+
+    DBL_VECTOR masses(m_LogMasses.size());
+    for (std::size_t i = 0; i < masses.size(); i++) masses[i] = PPOW(10.0, m_LogMasses[i]);
+    DBL_VECTOR metallicities(m_LogMetallicities.size());
+    for (std::size_t i = 0; i < metallicities.size(); i++) metallicities[i] = PPOW(10.0, m_LogMetallicities[i]);
+
+    int pointsPerPhase = m_PointsPerPhase;
+    int useMassLoss    = m_UseMassLoss ? 1 : 0;
+
+    bool ok = H5LTmake_dataset_double(file, "Masses", 1, gridDims, masses.data()) >= 0;
+    gridDims[0] = m_LogMetallicities.size();
+    ok = ok && H5LTmake_dataset_double(file, "Metallicities", 1, gridDims, metallicities.data()) >= 0;
+
+    ok = ok && H5LTmake_dataset_double(file, "Time",         3, pointDims, m_Time.data())       >= 0;
+    ok = ok && H5LTmake_dataset_double(file, "Mass",         3, pointDims, m_Mass.data())       >= 0;
+    ok = ok && H5LTmake_dataset_double(file, "Core_Mass",    3, pointDims, m_CoreMass.data())   >= 0;
+    ok = ok && H5LTmake_dataset_double(file, "He_Core_Mass", 3, pointDims, m_HeCoreMass.data()) >= 0;
+    ok = ok && H5LTmake_dataset_double(file, "CO_Core_Mass", 3, pointDims, m_COCoreMass.data()) >= 0;
+    ok = ok && H5LTmake_dataset_double(file, "Luminosity",   3, pointDims, m_Luminosity.data()) >= 0;
+    ok = ok && H5LTmake_dataset_double(file, "Radius",       3, pointDims, m_Radius.data())     >= 0;
+    ok = ok && H5LTmake_dataset_int   (file, "Stellar_Type", 3, pointDims, m_StellarType.data())>= 0;
+
+    ok = ok && H5LTmake_dataset_int   (file, "Valid",                2, trackDims, m_Valid.data())              >= 0;
+    ok = ok && H5LTmake_dataset_int   (file, "Remnant_Stellar_Type", 2, trackDims, m_RemnantStellarType.data()) >= 0;
+    ok = ok && H5LTmake_dataset_double(file, "Remnant_Time",         2, trackDims, m_RemnantTime.data())        >= 0;
+    ok = ok && H5LTmake_dataset_double(file, "Remnant_Mass",         2, trackDims, m_RemnantMass.data())        >= 0;
+
+    ok = ok && H5LTset_attribute_int(file, "/", "Points_Per_Phase", &pointsPerPhase, 1) >= 0;
+    ok = ok && H5LTset_attribute_int(file, "/", "Use_Mass_Loss",    &useMassLoss,    1) >= 0;
+
+    if (H5Fclose(file) < 0) ok = false;
+
+    if (!ok) SHOW_ERROR(ERROR::FILE_WRITE_ERROR, "Writing track library '" + p_Filename + "'");
+
+    return ok;
+}
+
+
+/*
+ * Read the track library from an HDF5 file written by Write()
+ *
+ * The rank and dimensions of every dataset are checked against the grid (Masses, Metallicities) and the
+ * Points_Per_Phase attribute before any dataset is read - the file is rejected if any differ (e.g. a library
+ * created by a build with different TRACK_LIBRARY_ constants, or a truncated or edited file).
+ *
+ *
+ * bool Read(const std::string &p_Filename)
+ *
+ * @param   [IN]    p_Filename                  Name of the file
+ * @return                                      Boolean flag indicating success (errors are shown here)
+ */
+bool TrackLibrary::Read(const std::string &p_Filename) {
+
+    hid_t file = H5Fopen(p_Filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file < 0) {
+        SHOW_ERROR(ERROR::FILE_OPEN_ERROR, "Opening track library '" + p_Filename + "'");
+        return false;
+    }
+
+    auto datasetDims = [file](const char *p_Name) -> std::vector<hsize_t> {                        // dimensions of a dataset - empty if not found
+        int rank = 0;
+        if (H5LTget_dataset_ndims(file, p_Name, &rank) < 0 || rank < 1) return {};
+        std::vector<hsize_t> dims(rank);
+        if (H5LTget_dataset_info(file, p_Name, dims.data(), NULL, NULL) < 0) return {};
+        return dims;
+    };
+
+    std::vector<hsize_t> massDims        = datasetDims("/Masses");
+    std::vector<hsize_t> metallicityDims = datasetDims("/Metallicities");
+    int                  useMassLoss     = 0;
+
+    bool ok = massDims.size() == 1 && metallicityDims.size() == 1 &&
+              H5LTget_attribute_int(file, "/", "Points_Per_Phase", &m_PointsPerPhase) >= 0 &&
+              H5LTget_attribute_int(file, "/", "Use_Mass_Loss",    &useMassLoss)      >= 0;
+
+    ok = ok && massDims[0] >= 2 && metallicityDims[0] >= 1 && m_PointsPerPhase >= 2;
+
+    if (ok) {                                                                                       // check the dimensions of the datasets before reading them
+        std::vector<hsize_t> trackDims = { metallicityDims[0], massDims[0] };
+        std::vector<hsize_t> pointDims = { metallicityDims[0], massDims[0], static_cast<hsize_t>(TRACK_LIBRARY_PHASES) * static_cast<hsize_t>(m_PointsPerPhase) };
+
+        for (auto name : { "/Time", "/Mass", "/Core_Mass", "/He_Core_Mass", "/CO_Core_Mass", "/Luminosity", "/Radius", "/Stellar_Type" }) ok = ok && datasetDims(name) == pointDims;
+        for (auto name : { "/Valid", "/Remnant_Stellar_Type", "/Remnant_Time", "/Remnant_Mass" }) ok = ok && datasetDims(name) == trackDims;
+    }
+
+    if (ok) {
+        m_UseMassLoss = useMassLoss != 0;
+
+        m_LogMasses.resize(massDims[0]);
+        m_LogMetallicities.resize(metallicityDims[0]);
+        Allocate();
+
+        ok = H5LTread_dataset_double(file, "/Masses",        m_LogMasses.data())        >= 0 &&
+             H5LTread_dataset_double(file, "/Metallicities", m_LogMetallicities.data()) >= 0;
+
+        ok = ok && H5LTread_dataset_double(file, "/Time",         m_Time.data())       >= 0;
+        ok = ok && H5LTread_dataset_double(file, "/Mass",         m_Mass.data())       >= 0;
+        ok = ok && H5LTread_dataset_double(file, "/Core_Mass",    m_CoreMass.data())   >= 0;
+        ok = ok && H5LTread_dataset_double(file, "/He_Core_Mass", m_HeCoreMass.data()) >= 0;
+        ok = ok && H5LTread_dataset_double(file, "/CO_Core_Mass", m_COCoreMass.data()) >= 0;
+        ok = ok && H5LTread_dataset_double(file, "/Luminosity",   m_Luminosity.data()) >= 0;
+        ok = ok && H5LTread_dataset_double(file, "/Radius",       m_Radius.data())     >= 0;
+        ok = ok && H5LTread_dataset_int   (file, "/Stellar_Type", m_StellarType.data())>= 0;
+
+        ok = ok && H5LTread_dataset_int   (file, "/Valid",                m_Valid.data())              >= 0;
+        ok = ok && H5LTread_dataset_int   (file, "/Remnant_Stellar_Type", m_RemnantStellarType.data()) >= 0;
+        ok = ok && H5LTread_dataset_double(file, "/Remnant_Time",         m_RemnantTime.data())        >= 0;
+        ok = ok && H5LTread_dataset_double(file, "/Remnant_Mass",         m_RemnantMass.data())        >= 0;
+
+        for (auto &mass : m_LogMasses) mass = std::log10(mass);
+        for (auto &metallicity : m_LogMetallicities) metallicity = std::log10(metallicity);
+    }
+
+    (void)H5Fclose(file);
+
+    if (!ok) SHOW_ERROR(ERROR::FILE_READ_ERROR, "Reading track library '" + p_Filename + "'");
+
+    return ok;
+}
+
+
+/*
+ * Locate a value in an ascending grid
+ *
+ *
+ * bool Bracket(const DBL_VECTOR &p_Grid, const double p_Value, std::size_t &p_Index, double &p_Weight)
+ *
+ * @param   [IN]    p_Grid                      Grid (ascending, at least two values)
+ * @param   [IN]    p_Value                     Value
+ * @param   [OUT]   p_Index                     Index i of the grid interval [p_Grid[i], p_Grid[i + 1]] that contains the value
+ * @param   [OUT]   p_Weight                    Weight of p_Grid[i + 1] in the linear interpolation of the value
+ * @return                                      Boolean flag indicating whether the value is within the grid
+ */
+bool TrackLibrary::Bracket(const DBL_VECTOR &p_Grid, const double p_Value, std::size_t &p_Index, double &p_Weight) {
+
+    if (p_Grid.size() < 2 || p_Value < p_Grid.front() || p_Value > p_Grid.back()) return false;
+
+    p_Index  = std::min(static_cast<std::size_t>(std::upper_bound(p_Grid.begin(), p_Grid.end(), p_Value) - p_Grid.begin()), p_Grid.size() - 1) - 1;
+    p_Weight = (p_Value - p_Grid[p_Index]) / (p_Grid[p_Index + 1] - p_Grid[p_Index]);
+
+    return true;
+}
+
+
+/*
+ * Interpolate the track of a star from the library
+ *
+ * Bilinear interpolation in log ZAMS mass and log metallicity (see TrackLibrary.h).  The interpolated track ends
+ * at the first phase not passed through by all of the library tracks around the star.  The stellar type of each
+ * point is that of the library track with the largest weight; the remnant is known only if the interpolated track
+ * was not truncated, and all library tracks around the star form the same type of remnant.
+ *
+ *
+ * bool Interpolate(const double p_Mass, const double p_Metallicity, TrackT &p_Track)
+ *
+ * @param   [IN]    p_Mass                      ZAMS mass (Msol)
+ * @param   [IN]    p_Metallicity               Metallicity
+ * @param   [OUT]   p_Track                     Interpolated track
+ * @return                                      Boolean flag indicating whether a track was interpolated
+ */
+bool TrackLibrary::Interpolate(const double p_Mass, const double p_Metallicity, TrackT &p_Track) const {
+
+    p_Track.points.clear();
+    p_Track.remnantStellarType = STELLAR_TYPE::NONE;
+    p_Track.remnantTime        = -1.0;
+    p_Track.remnantMass        = -1.0;
+
+    if (!m_Enabled) return false;
+
+    std::size_t m, z = 0;
+    double      wM, wZ = 0.0;
+
+    if (!Bracket(m_LogMasses, std::log10(p_Mass), m, wM)) return false;                             // out of range of the library
+
+    double logZ = std::log10(p_Metallicity);
+    if (m_LogMetallicities.size() > 1) {
+        if (!Bracket(m_LogMetallicities, logZ, z, wZ)) return false;                                // out of range of the library
+    }
+    else if (std::abs(logZ - m_LogMetallicities[0]) > TRACK_LIBRARY_METALLICITY_TOLERANCE) return false;   // not the metallicity of the library
+
+    // library tracks around the star, with their weights
+    std::vector<std::pair<std::size_t, double>> corners;
+    for (std::size_t dZ = 0; dZ < (m_LogMetallicities.size() > 1 ? 2u : 1u); dZ++) {
+        for (std::size_t dM = 0; dM < 2; dM++) {
+            double w = (dZ == 0 ? 1.0 - wZ : wZ) * (dM == 0 ? 1.0 - wM : wM);
+            if (w > 0.0) corners.push_back(std::make_pair(TrackIndex(z + dZ, m + dM), w));
+        }
+    }
+
+    std::size_t heaviest = 0;
+    for (std::size_t c = 0; c < corners.size(); c++) {
+        if (m_Valid[corners[c].first] == 0) return false;                                           // no track
+        if (corners[c].second > corners[heaviest].second) heaviest = c;
+    }
+
+    bool truncated = false;
+    for (int phase = 0; phase < TRACK_LIBRARY_PHASES && !truncated; phase++) {
+
+        int present = 0;
+        for (auto &corner : corners) {
+            if (m_Time[PointIndex(corner.first, phase, 0)] >= 0.0) present++;
+        }
+        if (present == 0) continue;                                                                 // not passed through
+        if (present < static_cast<int>(corners.size())) { truncated = true; break; }                // not passed through by all - truncate
+
+        for (int point = 0; point < m_PointsPerPhase; point++) {
+            TrackPointT trackPoint = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, STELLAR_TYPE::NONE };
+            double      logL       = 0.0;
+            double      logR       = 0.0;
+            for (auto &corner : corners) {
+                std::size_t i = PointIndex(corner.first, phase, point);
+                double      w = corner.second;
+                trackPoint.time       += w * m_Time[i];
+                trackPoint.mass       += w * m_Mass[i];
+                trackPoint.coreMass   += w * m_CoreMass[i];
+                trackPoint.heCoreMass += w * m_HeCoreMass[i];
+                trackPoint.coCoreMass += w * m_COCoreMass[i];
+                logL                  += w * std::log10(m_Luminosity[i]);
+                logR                  += w * std::log10(m_Radius[i]);
+            }
+            trackPoint.luminosity  = PPOW(10.0, logL);
+            trackPoint.radius      = PPOW(10.0, logR);
+            trackPoint.stellarType = static_cast<STELLAR_TYPE>(m_StellarType[PointIndex(corners[heaviest].first, phase, point)]);
+
+            if (!p_Track.points.empty() && trackPoint.time < p_Track.points.back().time) { truncated = true; break; }    // times not in order - truncate
+
+            p_Track.points.push_back(trackPoint);
+        }
+    }
+
+    if (!truncated) {                                                                               // remnant known?
+        int remnant = m_RemnantStellarType[corners[0].first];
+        for (auto &corner : corners) {
+            if (m_RemnantStellarType[corner.first] != remnant) remnant = static_cast<int>(STELLAR_TYPE::NONE);
+        }
+        if (remnant != static_cast<int>(STELLAR_TYPE::NONE)) {                                      // yes - all form the same type of remnant
+            p_Track.remnantStellarType = static_cast<STELLAR_TYPE>(remnant);
+            p_Track.remnantTime        = 0.0;
+            p_Track.remnantMass        = 0.0;
+            for (auto &corner : corners) {
+                p_Track.remnantTime += corner.second * m_RemnantTime[corner.first];
+                p_Track.remnantMass += corner.second * m_RemnantMass[corner.first];
+            }
+        }
+    }
+
+    return !p_Track.points.empty();
+}
+
+
+/*
+ * Time of the end of a phase on an interpolated track
+ *
+ *
+ * double PhaseEndTime(const TrackT &p_Track, const STELLAR_TYPE p_StellarType)
+ *
+ * @param   [IN]    p_Track                     Interpolated track
+ * @param   [IN]    p_StellarType               Stellar type (determines the phase)
+ * @return                                      Time of the last point of the phase on the track (Myr), or -1.0 if the phase is not on the track
+ */
+double TrackLibrary::PhaseEndTime(const TrackT &p_Track, const STELLAR_TYPE p_StellarType) {
+
+    int    phase = Phase(p_StellarType);
+    double end   = -1.0;
+
+    if (phase >= 0) {
+        for (auto &point : p_Track.points) {
+            if (Phase(point.stellarType) == phase) end = point.time;
+        }
+    }
+
+    return end;
+}
+
+
+/*
+ * Mass and radius at a time on an interpolated track
+ *
+ * Linear interpolation between the points of the track (in log for the radius), clamped to the ends of the track.
+ *
+ *
+ * void ValueAt(const TrackT &p_Track, const double p_Time, double &p_Mass, double &p_Radius)
+ *
+ * @param   [IN]    p_Track                     Interpolated track (at least one point)
+ * @param   [IN]    p_Time                      Time (Myr)
+ * @param   [OUT]   p_Mass                      Mass at p_Time (Msol)
+ * @param   [OUT]   p_Radius                    Radius at p_Time (Rsol)
+ */
+void TrackLibrary::ValueAt(const TrackT &p_Track, const double p_Time, double &p_Mass, double &p_Radius) {
+
+    const std::vector<TrackPointT> &points = p_Track.points;
+
+    std::size_t i = std::upper_bound(points.begin(), points.end(), p_Time, [](const double p_T, const TrackPointT &p_Point) { return p_T < p_Point.time; }) - points.begin();
+
+    if (i == 0)             { p_Mass = points.front().mass; p_Radius = points.front().radius; return; }
+    if (i == points.size()) { p_Mass = points.back().mass;  p_Radius = points.back().radius;  return; }
+
+    const TrackPointT &a = points[i - 1];
+    const TrackPointT &b = points[i];
+    double             w = b.time > a.time ? (p_Time - a.time) / (b.time - a.time) : 1.0;
+
+    p_Mass   = a.mass + (w * (b.mass - a.mass));
+    p_Radius = a.radius * PPOW(b.radius / a.radius, w);
+}
+
+
+/*
+ * Summary of the use of the track library, for the run details file
+ *
+ *
+ * std::string Summary()
+ *
+ * @return                                      Multi-line summary (empty unless CREATE or INTERPOLATE mode)
+ */
+std::string TrackLibrary::Summary() const {
+
+    std::ostringstream ss;
+
+    if (m_Mode == TRACK_LIBRARY_MODE::CREATE) {
+        int valid = 0;
+        for (auto v : m_Valid) valid += v;
+
+        ss << "\nTrack library created ('" << OPTIONS->TrackLibraryFilename() << "'):\n"
+           << "  Tracks = " << m_LogMasses.size() << " masses x " << m_LogMetallicities.size() << " metallicities"
+           << ", valid = " << valid
+           << "; points per phase = " << m_PointsPerPhase
+           << "; time to evolve = " << m_CreateSeconds << " s\n"
+           << "  Batch fitting formulae checked at " << m_LogMasses.size() << " masses x " << m_LogMetallicities.size() << " metallicities"
+           << ", results differing from scalar results = " << m_BatchMismatches << "\n";
+    }
+    else if (m_Mode == TRACK_LIBRARY_MODE::INTERPOLATE) {
+        const StatisticsT &s = m_Statistics;
+
+        ss << "\nTrack library ('" << OPTIONS->TrackLibraryFilename() << "', " << m_LogMasses.size() << " masses x " << m_LogMetallicities.size() << " metallicities):\n"
+           << "  Binaries = " << s.binaries
+           << ", not on the library = " << s.noTrack
+           << "; detached evolution skipped = " << s.skipped
+           << ", predicted to interact too soon to skip = " << s.tooShort
+           << ", skips rolled back = " << s.rolledBack << "\n"
+           << "  Time skipped = " << s.timeSkipped << " Myr ("
+           << (s.timeEvolved > 0.0 ? 100.0 * s.timeSkipped / s.timeEvolved : 0.0) << "% of the evolution of the binaries skipped)\n";
+    }
+
+    return ss.str();
+}
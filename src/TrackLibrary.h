@@ -0,0 +1,155 @@
+#ifndef __TrackLibrary_h__
+#define __TrackLibrary_h__
+
+#define TRACK_LIBRARY TrackLibrary::Instance()
+
+#include <string>
+#include <vector>
+
+#include "constants.h"
+#include "typedefs.h"
+
+
+/*
+ * TrackLibrary Singleton - precomputed single star tracks, for skipping the detached evolution of binaries
+ *
+ * Most binaries spend most of their lives detached: until one of the stars fills its Roche lobe the stars evolve
+ * as single stars, but BSE still takes every timestep of the faster-evolving star for both stars, and evaluates
+ * the binary at each of them.  The track library is a dense grid of single star (SSE) tracks, in (log) ZAMS mass
+ * and (log) metallicity, from which the evolution of any star in the range of the grid can be interpolated without
+ * evolving it.  From the tracks of the two stars of a binary BSE predicts how long the binary stays detached, and
+ * evolves the stars through that time independently, in as few steps as possible, before handing over to the usual
+ * timestepping (see BaseBinaryStar::EvolveDetachedOnTrackLibrary()).
+ *
+ * Each track records the nuclear burning phases of the star (stellar types MS to HeGB - TRACK_LIBRARY_PHASES
+ * slots, with both MS types in the first slot).  Each phase the star passes through is resampled at
+ * TRACK_LIBRARY_POINTS_PER_PHASE points equally spaced in time, from the start to the end of the phase, so points
+ * of the same index in tracks of neighbouring masses are at the same relative position in the phase (equivalent
+ * evolutionary points) - and can be interpolated.  At each point the track records:
+ *
+ *     time (the age of the star, Myr), mass, core mass, He core mass, CO core mass, luminosity, radius, stellar type
+ *
+ * and for the track as a whole: the stellar type of the remnant, the time of its formation, and its mass.  Tracks
+ * that do not follow the usual sequence of phases (e.g. chemically homogeneous stars) are flagged as not valid.
+ *
+ * A star is interpolated bilinearly in log ZAMS mass and log metallicity (linearly in log ZAMS mass if the library
+ * is for a single metallicity) from the four tracks around it: times, masses, core masses, log luminosity and log
+ * radius are interpolated point by point.  The interpolated track ends at the first phase not passed through by all
+ * four tracks, so it is truncated around the masses at which the sequence of phases changes.
+ *
+ * Program option --track-library-mode selects the mode:
+ *
+ *     NONE       : no track library (default)
+ *     CREATE     : evolve the grid of tracks and write the library to the HDF5 file named by --track-library.  The
+ *                  grid spans the range of metallicities of the run (a single metallicity unless
+ *                  --metallicity-distribution is LOGUNIFORM).  No binaries are evolved.
+ *     INTERPOLATE: read the library from the file named by --track-library, and skip the detached evolution of
+ *                  binaries by interpolation on the library (BSE only).  The library must have been created with
+ *                  the same value of --use-mass-loss.
+ *
+ * The number of binaries interpolated, the handovers to the usual timestepping and the time skipped are written
+ * to the run details file.
+ */
+
+class TrackLibrary {
+
+private:
+
+    TrackLibrary() {
+        m_Mode             = TRACK_LIBRARY_MODE::NONE;
+        m_Enabled          = false;
+        m_UseMassLoss      = false;
+        m_CreateSeconds    = 0.0;
+        m_BatchMismatches  = 0;
+        m_Statistics       = { 0, 0, 0, 0, 0, 0.0, 0.0 };
+    };
+    TrackLibrary(TrackLibrary const&) = delete;
+    TrackLibrary& operator = (TrackLibrary const&) = delete;
+
+    static TrackLibrary* m_Instance;
+
+    // Use of the library, over the run
+    typedef struct Statistics {
+        unsigned long int   binaries;                                                       // number of binaries with both stars in the range of the library
+        unsigned long int   noTrack;                                                        // number of binaries for which a track could not be interpolated
+        unsigned long int   skipped;                                                        // number of binaries for which detached evolution was skipped
+        unsigned long int   tooShort;                                                       // number of binaries predicted to interact too soon to skip any evolution
+        unsigned long int   rolledBack;                                                     // number of skips abandoned (stars interacted, or evolved off their tracks, before the handover)
+        double              timeSkipped;                                                    // total time skipped (Myr)
+        double              timeEvolved;                                                    // total time evolved by the binaries skipped (Myr, up to the end of evolution)
+    } StatisticsT;
+
+    TRACK_LIBRARY_MODE  m_Mode;                                                             // track library mode
+    bool                m_Enabled;                                                          // library loaded?  (INTERPOLATE mode)
+
+    DBL_VECTOR          m_LogMasses;                                                        // log10 of the ZAMS masses of the grid (ascending)
+    DBL_VECTOR          m_LogMetallicities;                                                 // log10 of the metallicities of the grid (ascending)
+    int                 m_PointsPerPhase;                                                   // number of points per phase
+    bool                m_UseMassLoss;                                                      // value of --use-mass-loss with which the library was created
+
+    // track points - index [((metallicity * number of masses) + mass) * (TRACK_LIBRARY_PHASES * m_PointsPerPhase) + (phase * m_PointsPerPhase) + point]
+    // times are -1.0 for the points of phases a track does not pass through
+    DBL_VECTOR          m_Time;
+    DBL_VECTOR          m_Mass;
+    DBL_VECTOR          m_CoreMass;
+    DBL_VECTOR          m_HeCoreMass;
+    DBL_VECTOR          m_COCoreMass;
+    DBL_VECTOR          m_Luminosity;
+    DBL_VECTOR          m_Radius;
+    std::vector<int>    m_StellarType;
+
+    // tracks - index [(metallicity * number of masses) + mass]
+    std::vector<int>    m_Valid;                                                            // 1 if the track is valid, otherwise 0
+    std::vector<int>    m_RemnantStellarType;                                               // stellar type of the remnant (STELLAR_TYPE::NONE if not formed by the maximum evolution time)
+    DBL_VECTOR          m_RemnantTime;                                                      // time of formation of the remnant (Myr)
+    DBL_VECTOR          m_RemnantMass;                                                      // mass of the remnant (Msol)
+
+    double              m_CreateSeconds;                                                    // CREATE mode: time taken to evolve the grid
+    std::size_t         m_BatchMismatches;                                                  // CREATE mode: number of batch fitting formulae results that differ from the scalar results
+
+    StatisticsT         m_Statistics;
+
+    std::size_t         TrackIndex(const std::size_t p_MetallicityIndex, const std::size_t p_MassIndex) const { return (p_MetallicityIndex * m_LogMasses.size()) + p_MassIndex; }
+    std::size_t         PointIndex(const std::size_t p_Track, const int p_Phase, const int p_Point) const    { return (p_Track * TRACK_LIBRARY_PHASES + p_Phase) * m_PointsPerPhase + p_Point; }
+
+    void                Allocate();
+    bool                EvolveTrack(const std::size_t p_Track, const double p_Mass, const double p_Metallicity);
+
+    static bool         Bracket(const DBL_VECTOR &p_Grid, const double p_Value, std::size_t &p_Index, double &p_Weight);
+
+    bool                Read(const std::string &p_Filename);
+    bool                Write(const std::string &p_Filename) const;
+
+
+public:
+
+    static TrackLibrary* Instance();
+
+    OBJECT_ID    ObjectId() const    { return static_cast<int>(OBJECT_TYPE::TRACKLIBRARY); }           // object id for the track library - ordinal value from enum
+    OBJECT_TYPE  ObjectType() const  { return OBJECT_TYPE::TRACKLIBRARY; }                         // object type for the track library - always "TRACKLIBRARY"
+    STELLAR_TYPE StellarType() const { return STELLAR_TYPE::NONE; }                                 // stellar type for the track library - always "NONE"
+
+    bool   Initialise();
+
+    bool   Create();
+
+    bool   Enabled() const                                                                  { return m_Enabled; }
+    TRACK_LIBRARY_MODE Mode() const                                                         { return m_Mode; }
+
+    bool   Interpolate(const double p_Mass, const double p_Metallicity, TrackT &p_Track) const;
+
+    static int    Phase(const STELLAR_TYPE p_StellarType);
+    static double PhaseEndTime(const TrackT &p_Track, const STELLAR_TYPE p_StellarType);
+    static void   ValueAt(const TrackT &p_Track, const double p_Time, double &p_Mass, double &p_Radius);
+
+    void   RecordBinary(const bool p_HasTracks)                                             { m_Statistics.binaries++; if (!p_HasTracks) m_Statistics.noTrack++; }
+    void   RecordSkip(const double p_TimeSkipped)                                           { m_Statistics.skipped++; m_Statistics.timeSkipped += p_TimeSkipped; }
+    void   RecordTooShort()                                                                 { m_Statistics.tooShort++; }
+    void   RecordRollBack()                                                                 { m_Statistics.rolledBack++; }
+    void   RecordTimeEvolved(const double p_Time)                                           { m_Statistics.timeEvolved += p_Time; }
+
+    std::string Summary() const;
+};
+
+
+#endif // __TrackLibrary_h__
@@ -1,4 +1,5 @@
 #include "WhiteDwarfs.h"
+#include "powers.h"
 
 /*
  * Calculate the luminosity of a White Dwarf as it cools
@@ -31,5 +32,5 @@ double WhiteDwarfs::CalculateLuminosityOnPhase_Static(const double p_Mass, const
  * @return                                      Radius of a White Dwarf in Rsol (since WD is ~ Earth sized, expect answer around 0.009)
  */
 double WhiteDwarfs::CalculateRadiusOnPhase_Static(const double p_Mass) {
-    return std::max(NEUTRON_STAR_RADIUS, 0.0115 * sqrt(PPOW(MCH / p_Mass, 2.0 / 3.0) - PPOW(p_Mass / MCH, 2.0 / 3.0)));
+    return std::max(NEUTRON_STAR_RADIUS, 0.0115 * sqrt(powers::Pow<2, 3>(MCH / p_Mass) - powers::Pow<2, 3>(p_Mass / MCH)));
 }
@@ -745,8 +745,193 @@
 //                                      - Avoid possibility of exceeding total mass in Farmer PPISN prescription
 // 02.19.03     TW - May 18, 2021    - Enhancement:
 //                                      - Change default LBV wind prescription to HURLEY_ADD
+// 02.19.04     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added '--hdf5-buffer-memory' option - a memory budget (MB) for all HDF5 dataset IO buffers (default 0 = no budget)
+//                                          - the budget is shared amongst open HDF5 logfiles in proportion to the number of records written to each
+//                                          - the largest buffers are flushed first when the budget is exceeded
+//                                      - HDF5 IO buffer high-water marks (total and per logfile) now reported in Run_Details (new HDF5 column 'HDF5-Buffer-High-Water-Mark')
+//                                        if a budget is specified - memory usage is not tracked otherwise
+// 02.19.05     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added predicate-filtered logging for BSE logfiles
+//                                          - new option '--logfile-predicate': an expression over binary, star, and program option properties
+//                                            (e.g. "BINARY_PROPERTY::MERGES_IN_HUBBLE_TIME || BINARY_PROPERTY::COMMON_ENVELOPE_EVENT_COUNT > 0")
+//                                          - new option '--logfile-predicate-files': the logfiles gated by the predicate (default all BSE logfiles except BSE_DETAILED)
+//                                          - records for gated logfiles are staged while the binary evolves, then written only if the binary satisfies the predicate
+//                                          - the predicate is compiled once, at startup, and evaluated with a small stack machine at the end of evolution of each binary
+// 02.19.06     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added per-system record staging for BSE logfiles (new option '--stage-system-records', default FALSE)
+//                                          - records for all BSE logfiles except detailed output are staged while the binary evolves, then committed or rolled back together
+//                                            at the end of BaseBinaryStar::Evolve()
+//                                          - records for binaries whose evolution ends in error (SSE_ERROR or BINARY_ERROR) are rolled back - no partial systems in logfiles -
+//                                            except the system parameters record, which is always written (it records the error)
+//                                          - committed CSV/TSV/TXT records are written in one batched write per logfile per system
+//                                          - number of systems rolled back reported in Run_Details
+// 02.19.07     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added sampling policies for BSE detailed output (the per-timestep record only)
+//                                          - new option '--detailed-output-sample-interval': print a record every N timesteps (default 1 = every timestep)
+//                                          - new options '--detailed-output-mass-delta', '--detailed-output-radius-delta', '--detailed-output-separation-delta':
+//                                            also print a record if mass, radius, or semi-major axis changed by more than the fraction specified since the last record (default 0 = disabled)
+//                                          - records at the start and end of evolution, at stellar type changes, and at changes in RLOF state are always printed
+// 02.19.08     JR - Oct 18, 2026   - Enhancement:
+//                                      - Replaced the SIGUSR1 signal mechanism for the BSE Switch Log with an in-process event bus (new EVENTS service singleton, EventBus.h/.cpp)
+//                                          - typed, synchronous dispatch of evolution events: stellar type switch, supernova, common envelope, mass transfer start/end,
+//                                            stellar merger, and double compact object formation (EVENT_TYPE in constants.h, EventT in typedefs.h)
+//                                          - BinaryStar::Evolve() subscribes to stellar type switch events for the BSE Switch Log; no signal handler or global binary pointer in main.cpp
+//                                          - publishing an event type with no subscribers costs a single check
+// 02.19.09     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added quasi-Monte Carlo initial-condition sampling (new option '--initial-sampling', options PSEUDO_RANDOM (default), QMC)
+//                                          - QMC: one point of a scrambled (digitally shifted) Sobol sequence per star/binary, one dimension per sampled initial condition (QMC_DIMENSION in constants.h)
+//                                          - the first uniform drawn by each of the utils::Sample*() functions comes from the quasi-random point; rejection loops and retries fall back to the pseudo-random stream
+//                                          - kicks and all other in-evolution randomness stay on the pseudo-random stream
+// 02.19.10     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added in-process adaptive importance sampling of binary initial conditions ('--initial-sampling AIS', BSE only; new AdaptiveSampler service singleton, AdaptiveSampler.h/.cpp)
+//                                          - STROOPWAFEL-style: exploration phase sampled from the prior, then a defensive mixture of the prior and truncated Gaussians centred on the hits so far,
+//                                            refitted after every batch - all in the unit hypercube of initial-condition uniforms (reuses the QMC point plumbing in Rand)
+//                                          - exploration phase sized from the number of binaries evolved (Options::CountSystemsToEvolve() - allows for grid files and option ranges/sets)
+//                                          - new options '--ais-hit-predicate' (logfile predicate syntax, default BINARY_PROPERTY::MERGES_IN_HUBBLE_TIME), '--ais-exploratory-fraction',
+//                                            '--ais-kappa', '--ais-batch-size'
+//                                          - new binary property IMPORTANCE_WEIGHT, added to the BSE system parameters logfile when AIS is used
+//                                          - sampler summary (hits per phase, estimated hit fraction) reported in Run_Details
+//                                          - predicate compiler in Log made reusable: Log::CompilePredicate() and Log::EvaluatePredicate()
+// 02.19.11     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added block sampling of initial conditions ('--initial-sampling BLOCK', new option '--initial-sampling-block-size'; new BlockSampler service singleton, BlockSampler.h/.cpp)
+//                                          - initial conditions of a block of systems drawn at once into one array per variate (BLOCK_VARIATE in constants.h); utils::Sample*() take each system's values from the arrays
+//                                          - (piecewise) power-law distributions only (incl. KROUPA), all inverted with one branch-free expression so the fill loops vectorise; other distributions sampled as before
+//                                          - counter-based uniforms (SplitMix64 of seed and system index) - a system's initial conditions do not depend on the block size
+// 02.19.12     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added TabulatedFunction (TabulatedFunction.h/.cpp) - tabulated functions held as flat sorted arrays with precomputed slopes
+//                                          - BStarRotationalVelocityCDFTable and ARP3MassRadiusRelation (constants.h) now TabulatedFunction rather than std::map, built once
+//                                            on first use (function-local statics - BStarRotationalVelocityCDFTable() and ARP3MassRadiusRelation())
+//                                          - utils::InverseSampleFromTabulatedCDF() and utils::SampleFromTabulatedCDF() take the table by reference (the map was copied on every call), and
+//                                            use a branch-free binary search (or direct indexing for equally-spaced tables) rather than a linear scan - results unchanged
+// 02.19.13     JR - Oct 18, 2026   - Enhancement:
+//                                      - O-star rotational velocities (VLTFLAMES) now sampled from an inverse-CDF table precomputed once per run (BaseStar::CalculateOStarRotationalVelocityCDFTable_Static())
+//                                        rather than by a GSL Brent root-solve for every star - table refined until interpolation is accurate to a relative ROTATIONAL_VELOCITY_TABLE_TOLERANCE (1.0E-4)
+//                                      - Added program option '--rotational-velocity-exact-inverse' to use the root-solve (validation)
+// 02.19.14     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added KickSampler service singleton (KickSampler.h/.cpp) - inverse CDFs of the unit Maxwellian and standard normal distributions, either from
+//                                        gsl_cdf_chisq_Pinv()/gsl_cdf_gaussian_Pinv() as before, or interpolated on tables built once per run (accurate to a relative KICK_SAMPLING_TABLE_TOLERANCE = 1.0E-6)
+//                                          - used by BaseStar::DrawKickMagnitudeDistributionMaxwell() and BaseStar::DrawRemnantKickMullerMandel()
+//                                      - Added program option '--kick-sampling' (TABULATED, EXACT, VALIDATE; default EXACT, so seeded runs are unchanged) - VALIDATE accumulates the differences
+//                                        between tabulated and exact draws as kicks are drawn, and writes them to the run details file
+//                                      - Added TabulatedFunction::TabulateMonotone() (also now used for the O-star rotational velocity table)
+// 02.19.15     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added supernova kick resampling (BSE only): new program options '--kick-resamples' (K, default 1 = no resampling) and '--kick-resample-supernovae' (FIRST, EACH)
+//                                          - the binary is evolved once to its supernova, where a snapshot is taken (stars collapsed, kick drawn, orbit not yet changed); K - 1 branches are
+//                                            continued from the snapshot, each under a new draw of the kick magnitude, direction and mean anomaly (BaseStar::ResampleSNKick()) - values specified by the user are not redrawn
+//                                          - new binary properties KICK_RESAMPLE_BRANCH and KICK_RESAMPLE_WEIGHT, added to the BSE system parameters, supernovae and double compact objects logfiles
+//                                          - branches do not write detailed output; the adaptive importance sampler counts each binary once
+//                                      - Defect repair: copying a BaseBinaryStar left the companion pointers of the copied constituent stars null
+// 02.19.16     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added forked evolution of commandline option variations (BSE only): new program option '--fork-variations'
+//                                          - each binary is evolved for the first variation of the options specified as ranges or sets on the commandline (the swept options), then
+//                                            forked for each subsequent variation from a snapshot taken at the start of the timestep in which a swept option was first read
+//                                          - the snapshot is taken by the first fork, evolved from ZAMS - the binary only notes the timestep
+//                                          - forks have the random seed, id, and drawn kick option values of the binary (the random number state is restored at the snapshot), and share its logfile records
+//                                            staged before the snapshot - BSE logfile records are staged per system
+//                                          - new binary property FORK_VARIATION, added to the BSE system parameters, supernovae and double compact objects logfiles
+//                                          - number-of-systems binaries are each evolved for all commandline variations; not available with adaptive importance sampling or detailed output
+//                                      - Added Rand::State() and Rand::RestoreState()
+// 02.19.17     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added common random numbers for paired evolution of commandline option variations: new program option '--common-random-numbers'
+//                                          - the systems of each commandline variation are seeded as the systems of the first variation
+//                                          - each physical random process draws from its own substream (see RANDOM_STREAM in constants.h), seeded from the system's
+//                                            random seed, the process, and the event number - so the draws of a process do not depend on the draws of other processes
+//                                          - kick random values not specified by the user are drawn from the kick substream (rather than taken from the program options)
+//                                      - Added Rand::EnableStreams(), Rand::Stream() and Rand::StreamClear()
+//                                      - Defect repair: kick random values not specified by the user (kick magnitude random number, theta, phi, mean anomaly) are drawn
+//                                        from the kick substream of the binary (or single star) whether or not common random numbers are enabled (new Rand::Stream()
+//                                        parameter p_Always).  They were taken from the program options, which draw them from the main generator as the previous system
+//                                        left it, so the evolution of a system depended on the systems evolved before it.  Default output changes: the kick values for a
+//                                        given random seed are different (and so the evolution after a supernova) - the initial conditions are unchanged
+// 02.19.18     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added fast-forward of detached compact-object binaries (BSE only): new program options '--fast-forward-compact-binaries' and '--fast-forward-output-interval'
+//                                          - once both stars are WD, NS or BH and neither is overflowing its Roche lobe, the binary is stepped directly to the next of coalescence,
+//                                            the maximum evolution time, or the next multiple of the output interval - rather than timestepping (pulsar spin-down is closed-form in the timestep)
+//                                          - double white dwarfs are fast-forwarded to their coalescence (Peters 1964) rather than stopped when formed
+//                                      - Added BaseBinaryStar::CalculateFastForwardTimestep() and BaseBinaryStar::IsDetachedCompactBinary()
+// 02.19.19     JR - Oct 18, 2026   - Enhancement:
+//                                      - Times to coalescence (Peters 1964, eq 5.14) for 0.01 <= e <= 0.99 are interpolated on a table of their eccentricity dependence, built once
+//                                        per run (see CoalescenceTime.h), rather than integrated with a 10,000-step Riemann sum for every binary
+//                                          - the table is accurate to a relative ~1.0E-7; the Riemann sum was accurate to a relative ~3.0E-3
+//                                      - Added program option '--coalescence-time-kernel' (TABULATED, INTEGRAL, VALIDATE) - VALIDATE compares the table and the Riemann sum, checks both
+//                                        against a high-accuracy integral, times both, and writes the results to the run details file
+//                                      - Default output changes: Coalescence_Time in the BSE double compact objects file changes for every DCO with 0.01 <= e <= 0.99 (by up to
+//                                        a relative ~3.0E-3, the error of the Riemann sum) - '--coalescence-time-kernel INTEGRAL' reproduces earlier versions
+// 02.19.20     JR - Oct 18, 2026   - Enhancement:
+//                                      - The orbit can be evolved through stable mass transfer in closed form (for each mass transfer angular momentum loss prescription),
+//                                        rather than with explicit Euler steps of 0.1% of the donor mass (see BaseBinaryStar::CalculateMassTransferOrbit())
+//                                          - the Euler steps are accurate to ~1% in the semi-major axis; CalculateMassTransferOrbit() is also called by the Roche lobe root solver
+//                                          - opt-in ('--mass-transfer-orbit-integrator ANALYTIC'): the default is EULER, so default output is unchanged.  ANALYTIC (and ADAPTIVE)
+//                                            change results, not only in the last digits - post-mass-transfer and pre-supernova separations change, and the outcome of some
+//                                            binaries (e.g. a later common envelope, or the final stellar types) can change
+//                                      - Added program options '--mass-transfer-orbit-integrator' (ANALYTIC, ADAPTIVE, EULER, VALIDATE) and '--mass-transfer-orbit-tolerance'
+//                                          - ADAPTIVE integrates with an adaptive Runge-Kutta (Cash-Karp) stepper (boost odeint)
+//                                          - VALIDATE compares the three and writes the differences, and the work done, to the run details file
+// 02.19.21     JR - Oct 18, 2026   - Enhancement:
+//                                      - The Roche lobe root solver (RadiusEqualsRocheLobeFunctor) no longer copies and updates the donor to find its radius after mass loss
+//                                        for MS, CH and HeMS donors - added CalculateRadiusAfterMassChange(), which evaluates the on-phase radius for the changed mass
+//                                        and initial mass without updating the star (exactly the radius of an updated copy).  Other stellar types, and donors that
+//                                        would evolve off phase, are still copied and updated (see BaseBinaryStar::CalculateDonorRadiusAfterMassLoss())
+//                                      - MainSequence::CalculateRadiusOnPhase() takes the timescales explicitly (the existing signature uses the star's own)
+//                                      - Added program option '--mass-transfer-donor-radius-response' (MODEL, CLONE, VALIDATE) - VALIDATE compares the model with the
+//                                        updated copy, times both, and writes the results to the run details file
+// 02.19.22     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added powers.h - power function kernels: powers::Pow<N, D>() raises to a fixed rational power (integer powers
+//                                        by repeated squaring, roots from sqrt()/cbrt(), exp2()/log2() otherwise), powers::Exp10(), and powers::SharedBase,
+//                                        which calculates log2() of a base once for several powers
+//                                      - Replaced the hot PPOW() calls found with the profiling build (the Hurley et al. 2000 fits that raise the mass to
+//                                        several powers, MS luminosity and radius, gyration radius) and the fixed rational powers (Alfven radius, Roche
+//                                        lobe radius, tidal timescales etc.) with the kernels
+//                                      - Added program option '--power-kernels' (default FALSE) - the kernels are only used if it is set; otherwise they return
+//                                        std::pow(), and results are unchanged
+//                                      - With '--power-kernels' each power is within 1.0E-14 (relative) of std::pow(), but the differences grow as binaries
+//                                        evolve: SSE output is unchanged, BSE times of DCO formation and supernovae differ by up to 2.3E-4 (relative), and the
+//                                        Loveridge CE lambdas and binding energies by up to 5.0E-3 (relative) - BSE runs ~17% faster, SSE runs ~13% faster
+// 02.19.23     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added batch (structure of arrays) versions of fitting formulae, evaluated for many masses at the metallicity of
+//                                        a star: BaseStar::CalculateLuminosityAtZAMS_Batch(), CalculateRadiusAtZAMS_Batch(), CalculateLifetimeToBGB_Batch(),
+//                                        CalculateLifetimeToBAGB_Batch(), CalculateCoreMassAtBGB_Batch() (GiantBranch::CalculateCoreMassAtBGB_Batch_Static())
+//                                      - The scalar and batch versions share their arithmetic (new _Static versions), so results are identical - the rational
+//                                        fits are evaluated in blocks of BATCH_EVALUATION_BLOCK_SIZE masses, in loops the compiler vectorises
+//                                      - Added BaseStar::CountBatchEvaluationMismatches(): checks the batch versions against the scalar versions, element by element -
+//                                        the track library (02.19.24) checks them over its mass grid at each of its metallicities when it is created, warns
+//                                        (BATCH_EVALUATION_MISMATCH) if any result differs, and reports the number of differing results in the run details
+// 02.19.24     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added the track library (TrackLibrary.h/.cpp): a grid of single star tracks in (log) ZAMS mass and (log) metallicity,
+//                                        resampled at equivalent evolutionary points, written to and read from an HDF5 file
+//                                      - Added program options '--track-library-mode' (NONE, CREATE, INTERPOLATE) and '--track-library' (filename)
+//                                      - CREATE evolves the grid (instead of evolving stars or binaries); INTERPOLATE (BSE only) interpolates the tracks of
+//                                        both stars of each binary, predicts from them how long the binary stays detached, and evolves the stars independently
+//                                        through that time in a single binary timestep (see BaseBinaryStar::EvolveDetachedOnTrackLibrary()) - the stars are
+//                                        restored, and the binary evolved as usual, if they interact or form a remnant before the handover
+//                                      - Use of the library is written to the run details file
+//                                      - Defect repair: BinaryConstituentStar assignment did not copy the underlying star (Star::operator= was not called)
+// 02.19.25     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added program option '--non-interacting-fast-path' (BSE only): binaries whose stars cannot fill their Roche lobes before the
+//                                        first remnant (WD, NS or BH) forms are evolved to just before it with the stars evolving independently, at their own
+//                                        timesteps, and the binary is not evaluated until then (see BaseBinaryStar::EvolveNonInteracting())
+//                                      - The stars are evolved by BaseBinaryStar::EvolveDetachedStar(), shared with the track library (02.19.24), which applies the
+//                                        widening of the orbit by winds step by step, as CalculateWindsMassLoss() does
+//                                      - The check is conservative: the radius of each star is checked at each timestep against a lower bound of its Roche lobe
+//                                        radius at periastron, allowing for the widening of the orbit by winds - if either star could fill its Roche lobe the
+//                                        binary is restored and evolved as usual.  With the track library loaded, the maximum radii on the tracks are checked first
+//                                      - Use of the fast path is written to the run details file
+// 02.19.26     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added program option '--culling-mode' (options: [NONE, DCO], default = NONE): binaries that can no longer form the systems
+//                                        of interest stop evolving, with new evolution status EVOLUTION_STATUS::CULLED (see BaseBinaryStar::CullingRule())
+//                                      - DCO mode culls binaries that provably cannot form a double compact object: binaries with a HeWD or COWD, binaries with a
+//                                        NS or BH and a companion of mass <= MECS, and binaries with neither and total mass <= 2 MECS
+//                                      - The number of binaries culled by each rule is written to the run details file (each binary counted once - kick resampling
+//                                        branches and forks are not counted)
+// 02.19.27     JR - Oct 18, 2026   - Enhancement:
+//                                      - Added program option '--timestep-radial-change-prediction' (SSE only, default = FALSE): Star::EvolveOneTimestep() predicts
+//                                        the radial change over the suggested timestep from the rate of change of the radius over the previous timestep, and halves
+//                                        the timestep up front until the predicted change is less than MAXIMUM_RADIAL_CHANGE, rather than only by reverting the
+//                                        star and retrying (see Star::PredictTimestep())
+//                                      - The numbers of SSE timesteps taken, retried, and shortened by the prediction are written to the run details file
 
 
-const std::string VERSION_STRING = "02.19.03";
+const std::string VERSION_STRING = "02.19.27";
 
 # endif // __changelog_h__
@@ -10,6 +10,8 @@
 
 #include <boost/variant.hpp>
 
+#include "TabulatedFunction.h"
+
 
 typedef unsigned long int                                               OBJECT_ID;                  // OBJECT_ID type
 
@@ -280,6 +282,21 @@ constexpr double LAMBDA_NANJING_ZLIMIT                  = 0.0105;
 constexpr int    MAX_KEPLER_ITERATIONS                  = 1000;                                                     // Maximum number of iterations to solve Kepler's equation
 constexpr double NEWTON_RAPHSON_EPSILON                 = 1.0E-5;                                                   // Accuracy for Newton-Raphson method
 
+constexpr double ROTATIONAL_VELOCITY_TABLE_TOLERANCE    = 1.0E-4;                                                   // Relative accuracy of the precomputed O-star rotational velocity inverse-CDF table (see BaseStar::CalculateOStarRotationalVelocityCDFTable_Static())
+constexpr double KICK_SAMPLING_TABLE_TOLERANCE          = 1.0E-6;                                                   // Relative accuracy of the precomputed kick magnitude inverse-CDF tables (see KickSampler.h)
+constexpr int    COALESCENCE_TIME_TABLE_SIZE            = 4096;                                                     // Number of points in the precomputed Peters (1964) time to coalescence table (see CoalescenceTime.h)
+constexpr int    BATCH_EVALUATION_BLOCK_SIZE            = 256;                                                      // Number of masses evaluated per block by the batch fitting formulae (see BaseStar.cpp, BATCH EVALUATION)
+
+constexpr int    TRACK_LIBRARY_PHASES                   = 9;                                                        // Number of phases recorded by the single star track library - stellar types MS to HeGB, both MS types in one phase (see TrackLibrary.h)
+constexpr int    TRACK_LIBRARY_POINTS_PER_PHASE         = 16;                                                       // Number of points (equally spaced in time) per phase in the track library
+constexpr int    TRACK_LIBRARY_MASSES                   = 256;                                                      // Number of ZAMS masses (equally spaced in log) in the track library
+constexpr double TRACK_LIBRARY_MINIMUM_MASS             = 0.1;                                                      // Minimum ZAMS mass in the track library (Msol)
+constexpr double TRACK_LIBRARY_MAXIMUM_MASS             = 150.0;                                                    // Maximum ZAMS mass in the track library (Msol)
+constexpr int    TRACK_LIBRARY_METALLICITIES            = 16;                                                       // Number of metallicities (equally spaced in log) in a track library for a range of metallicities
+constexpr double TRACK_LIBRARY_METALLICITY_TOLERANCE    = 1.0E-6;                                                   // Maximum |log10(Z / Z(library))| for interpolation on a track library for a single metallicity
+constexpr double TRACK_LIBRARY_ROCHE_LOBE_FRACTION      = 0.8;                                                      // Detached evolution is skipped only while the (interpolated) radii of both stars are below this fraction of their Roche lobes at periastron
+constexpr double TRACK_LIBRARY_TIME_MARGIN              = 0.02;                                                     // Detached evolution is skipped only up to this fraction before the (interpolated) end of the tracks of both stars
+
 constexpr double EPSILON_PULSAR                         = 1.0;                                                      // JR: todo: description
 
 constexpr double ADAPTIVE_RLOF_FRACTION_DONOR_GUESS     = 0.001;                                                    // Fraction of donor mass to use as guess in MassLossToFitInsideRocheLobe()
@@ -302,6 +319,7 @@ const std::string RUN_DETAILS_FILE_NAME                 = "Run_Details";
 
 constexpr int    HDF5_DEFAULT_CHUNK_SIZE                = 100000;                                                   // default HDF5 chunk size (number of dataset entries)
 constexpr int    HDF5_DEFAULT_IO_BUFFER_SIZE            = 1;                                                        // number of HDF5 chunks to buffer for IO (per open dataset)
+constexpr int    HDF5_DEFAULT_IO_BUFFER_MEMORY          = 0;                                                        // HDF5 IO buffer memory budget for all open datasets (MB) - 0 = no budget
 constexpr int    HDF5_MINIMUM_CHUNK_SIZE                = 1000;                                                     // minimum HDF5 chunk size (number of dataset entries)
 
 // option constraints
@@ -373,12 +391,13 @@ constexpr double MULLERMANDEL_KICKBH                    = 200.0;
 constexpr double MULLERMANDEL_SIGMAKICK                 = 0.3; 
 
 // object types
-enum class OBJECT_TYPE: int { NONE, MAIN, PROFILING, UTILS, STAR, BASE_STAR, BINARY_STAR, BASE_BINARY_STAR, BINARY_CONSTITUENT_STAR };    //  if BASE_STAR, check STELLAR_TYPE
+enum class OBJECT_TYPE: int { NONE, MAIN, PROFILING, UTILS, TRACKLIBRARY, STAR, BASE_STAR, BINARY_STAR, BASE_BINARY_STAR, BINARY_CONSTITUENT_STAR };    //  if BASE_STAR, check STELLAR_TYPE
 const COMPASUnorderedMap<OBJECT_TYPE, std::string> OBJECT_TYPE_LABEL = {
     { OBJECT_TYPE::NONE,                    "Not_an_Object!" },
     { OBJECT_TYPE::MAIN,                    "Main" },
     { OBJECT_TYPE::PROFILING,               "Profiling" },
     { OBJECT_TYPE::UTILS,                   "Utils" },
+    { OBJECT_TYPE::TRACKLIBRARY,            "TrackLibrary" },
     { OBJECT_TYPE::STAR,                    "Star" },
     { OBJECT_TYPE::BASE_STAR,               "BaseStar" },
     { OBJECT_TYPE::BINARY_STAR,             "BinaryStar" },
@@ -410,6 +429,7 @@ enum class ERROR: int {
     ARGUMENT_SET_EXPECTED_NUMERIC,                                  // all parameters of argument set must be numeric for option
     ARGUMENT_SET_NOT_SUPPORTED,                                     // argument set not supported for option
     BAD_LOGFILE_RECORD_SPECIFICATIONS,                              // error in logfile record specifications
+    BATCH_EVALUATION_MISMATCH,                                      // batch evaluation of fitting formulae differs from scalar evaluation
     BINARY_EVOLUTION_STOPPED,                                       // evolution of current binary stopped
     BINARY_SIMULATION_STOPPED,                                      // binary simulation stopped
     BOOST_OPTION_CMDLINE,                                           // failed to initialise Boost options descriptions for commandline options
@@ -540,6 +560,7 @@ const COMPASUnorderedMap<ERROR, std::tuple<ERROR_SCOPE, std::string>> ERROR_CATA
     { ERROR::ARGUMENT_SET_EXPECTED_NUMERIC,                         { ERROR_SCOPE::ALWAYS,              "All parameters of argument set must be numeric for option" }},
     { ERROR::ARGUMENT_SET_NOT_SUPPORTED,                            { ERROR_SCOPE::ALWAYS,              "Argument set not supported for option" }},
     { ERROR::BAD_LOGFILE_RECORD_SPECIFICATIONS,                     { ERROR_SCOPE::ALWAYS,              "Logfile record specifications error" }},
+    { ERROR::BATCH_EVALUATION_MISMATCH,                             { ERROR_SCOPE::ALWAYS,              "Batch evaluation of fitting formulae differs from scalar evaluation" }},
     { ERROR::BINARY_EVOLUTION_STOPPED,                              { ERROR_SCOPE::ALWAYS,              "Evolution of current binary stopped" }},
     { ERROR::BINARY_SIMULATION_STOPPED,                             { ERROR_SCOPE::ALWAYS,              "Binaries simulation stopped" }},
     { ERROR::BOOST_OPTION_CMDLINE,                                  { ERROR_SCOPE::ALWAYS,              "Failed to initialise Boost options descriptions for commandline options" }},
@@ -641,6 +662,33 @@ const COMPASUnorderedMap<ERROR, std::tuple<ERROR_SCOPE, std::string>> ERROR_CATA
 };
 
 
+// Evolution event types - see EventBus.h
+enum class EVENT_TYPE: int {
+    STELLAR_TYPE_SWITCH,
+    SUPERNOVA,
+    COMMON_ENVELOPE,
+    MASS_TRANSFER_START,
+    MASS_TRANSFER_END,
+    STELLAR_MERGER,
+    DCO_FORMATION,
+    SENTINEL                                                                // must be last - used to size the subscriber table
+};
+
+const COMPASUnorderedMap<EVENT_TYPE, std::string> EVENT_TYPE_LABEL = {
+    { EVENT_TYPE::STELLAR_TYPE_SWITCH,               "Stellar type switch" },
+    { EVENT_TYPE::SUPERNOVA,                         "Supernova" },
+    { EVENT_TYPE::COMMON_ENVELOPE,                   "Common envelope" },
+    { EVENT_TYPE::MASS_TRANSFER_START,               "Mass transfer start" },
+    { EVENT_TYPE::MASS_TRANSFER_END,                 "Mass transfer end" },
+    { EVENT_TYPE::STELLAR_MERGER,                    "Stellar merger" },
+    { EVENT_TYPE::DCO_FORMATION,                     "Double compact object formation" }
+};
+
+
+// Predicate operations - predicates (e.g. the logfile predicate) are compiled to Reverse Polish Notation - see Log.h
+enum class PREDICATE_OP: int { PROPERTY, CONSTANT, EQ, NE, LT, LE, GT, GE, AND, OR, NOT };
+
+
 // Binary evolution status constants
 enum class EVOLUTION_STATUS: int {
     DONE,
@@ -656,7 +704,8 @@ enum class EVOLUTION_STATUS: int {
     WD_WD,
     TIMES_UP,
     STEPS_UP,
-    STOPPED
+    STOPPED,
+    CULLED
 };
 
 // JR: deliberately kept these message succinct (where I could) so running status doesn't scroll off the page...
@@ -674,7 +723,8 @@ const COMPASUnorderedMap<EVOLUTION_STATUS, std::string> EVOLUTION_STATUS_LABEL =
     { EVOLUTION_STATUS::WD_WD,                       "Double White Dwarf" },
     { EVOLUTION_STATUS::TIMES_UP,                    "Allowed time exceeded" },
     { EVOLUTION_STATUS::STEPS_UP,                    "Allowed timesteps exceeded" },
-    { EVOLUTION_STATUS::STOPPED,                     "Evolution stopped" }
+    { EVOLUTION_STATUS::STOPPED,                     "Evolution stopped" },
+    { EVOLUTION_STATUS::CULLED,                      "Culled" }
 };
 
 
@@ -838,6 +888,48 @@ const COMPASUnorderedMap<KICK_MAGNITUDE_DISTRIBUTION, std::string> KICK_MAGNITUD
     { KICK_MAGNITUDE_DISTRIBUTION::MULLERMANDEL,         "MULLERMANDEL" }
 };
 
+// Kick sampling - how the inverse CDFs of the kick magnitude distributions are evaluated (see KickSampler.h)
+enum class KICK_SAMPLING: int { TABULATED, EXACT, VALIDATE };
+const COMPASUnorderedMap<KICK_SAMPLING, std::string> KICK_SAMPLING_LABEL = {
+    { KICK_SAMPLING::TABULATED, "TABULATED" },
+    { KICK_SAMPLING::EXACT,     "EXACT" },
+    { KICK_SAMPLING::VALIDATE,  "VALIDATE" }
+};
+
+// Coalescence time kernel - how the time to coalescence of an eccentric binary is evaluated (see CoalescenceTime.h)
+enum class COALESCENCE_TIME_KERNEL: int { TABULATED, INTEGRAL, VALIDATE };
+const COMPASUnorderedMap<COALESCENCE_TIME_KERNEL, std::string> COALESCENCE_TIME_KERNEL_LABEL = {
+    { COALESCENCE_TIME_KERNEL::TABULATED, "TABULATED" },
+    { COALESCENCE_TIME_KERNEL::INTEGRAL,  "INTEGRAL" },
+    { COALESCENCE_TIME_KERNEL::VALIDATE,  "VALIDATE" }
+};
+
+// Track library mode - precomputed single star tracks for skipping the detached evolution of binaries (see TrackLibrary.h)
+enum class TRACK_LIBRARY_MODE: int { NONE, CREATE, INTERPOLATE };
+const COMPASUnorderedMap<TRACK_LIBRARY_MODE, std::string> TRACK_LIBRARY_MODE_LABEL = {
+    { TRACK_LIBRARY_MODE::NONE,        "NONE" },
+    { TRACK_LIBRARY_MODE::CREATE,      "CREATE" },
+    { TRACK_LIBRARY_MODE::INTERPOLATE, "INTERPOLATE" }
+};
+
+// Culling mode - early termination of binaries that can no longer form the systems of interest (see BaseBinaryStar::CullingRule())
+enum class CULLING_MODE: int { NONE, DCO };
+const COMPASUnorderedMap<CULLING_MODE, std::string> CULLING_MODE_LABEL = {
+    { CULLING_MODE::NONE, "NONE" },
+    { CULLING_MODE::DCO,  "DCO" }
+};
+
+// Culling rules - the rule by which a binary is culled
+enum class CULLING_RULE: int { NONE, WHITE_DWARF, COMPANION_MASS, TOTAL_MASS };
+
+
+// Kick resampling - which supernovae of a binary are resampled under multiple kick draws (see BaseBinaryStar::TakeKickResampleSnapshot())
+enum class KICK_RESAMPLE_SUPERNOVAE: int { FIRST, EACH };
+const COMPASUnorderedMap<KICK_RESAMPLE_SUPERNOVAE, std::string> KICK_RESAMPLE_SUPERNOVAE_LABEL = {
+    { KICK_RESAMPLE_SUPERNOVAE::FIRST, "FIRST" },
+    { KICK_RESAMPLE_SUPERNOVAE::EACH,  "EACH" }
+};
+
 
 // Kick direction distribution
 enum class KICK_DIRECTION_DISTRIBUTION: int { ISOTROPIC, INPLANE, PERPENDICULAR, POWERLAW, WEDGE, POLES };
@@ -860,6 +952,27 @@ const COMPASUnorderedMap<INITIAL_MASS_FUNCTION, std::string> INITIAL_MASS_FUNCTI
     { INITIAL_MASS_FUNCTION::KROUPA,   "KROUPA" }
 };
 
+// Initial-condition sampling modes
+enum class INITIAL_SAMPLING: int { PSEUDO_RANDOM, QMC, AIS, BLOCK };
+const COMPASUnorderedMap<INITIAL_SAMPLING, std::string> INITIAL_SAMPLING_LABEL = {
+    { INITIAL_SAMPLING::PSEUDO_RANDOM, "PSEUDO_RANDOM" },
+    { INITIAL_SAMPLING::QMC,           "QMC" },
+    { INITIAL_SAMPLING::AIS,           "AIS" },
+    { INITIAL_SAMPLING::BLOCK,         "BLOCK" }
+};
+
+// Dimensions of the quasi-random point used for QMC initial-condition sampling - one per sampled initial condition
+// (semi-major axis and orbital period share the SEPARATION dimension - only one of them is ever sampled for a system)
+enum class QMC_DIMENSION: int { MASS, MASS_RATIO, METALLICITY, SEPARATION, ECCENTRICITY, COUNT };
+
+// Random number substreams used for common random numbers (program option --common-random-numbers) - one per physical random process
+// (each event of a process - e.g. each supernova kick - draws from its own substream, keyed by the system's random seed, the process, and the event number)
+enum class RANDOM_STREAM: int { INITIAL_CONDITIONS, ROTATION, SUPERNOVA_KICK, REMNANT_MASS, SUPERNOVA_ORIENTATION, PULSAR, COMMON_ENVELOPE_ACCRETION, COUNT };
+
+// Variates drawn by the block initial-condition sampler - one array per variate
+// (SEMI_MAJOR_AXIS is the orbital period in days for the SANA2012 semi-major axis distribution - converted once the masses are known)
+enum class BLOCK_VARIATE: int { MASS, MASS_RATIO, METALLICITY, SEMI_MAJOR_AXIS, ORBITAL_PERIOD, ECCENTRICITY, COUNT };
+
 // LBV Mass loss prescriptions
 enum class LBV_PRESCRIPTION: int { NONE, HURLEY_ADD, HURLEY, BELCZYNSKI };
 const COMPASUnorderedMap<LBV_PRESCRIPTION, std::string> LBV_PRESCRIPTION_LABEL = {
@@ -915,6 +1028,23 @@ const COMPASUnorderedMap<MT_ANGULAR_MOMENTUM_LOSS_PRESCRIPTION, std::string> MT_
     { MT_ANGULAR_MOMENTUM_LOSS_PRESCRIPTION::ARBITRARY,             "ARBITRARY" }
 };
 
+// Mass transfer donor radius response - how the radius of a donor without an envelope is found after mass loss (see BaseBinaryStar::CalculateDonorRadiusAfterMassLoss())
+enum class MT_DONOR_RADIUS_RESPONSE: int { MODEL, CLONE, VALIDATE };
+const COMPASUnorderedMap<MT_DONOR_RADIUS_RESPONSE, std::string> MT_DONOR_RADIUS_RESPONSE_LABEL = {
+    { MT_DONOR_RADIUS_RESPONSE::MODEL,    "MODEL" },
+    { MT_DONOR_RADIUS_RESPONSE::CLONE,    "CLONE" },
+    { MT_DONOR_RADIUS_RESPONSE::VALIDATE, "VALIDATE" }
+};
+
+// Mass transfer orbit integrator - how the orbit is evolved through mass transfer (see BaseBinaryStar::CalculateMassTransferOrbit())
+enum class MT_ORBIT_INTEGRATOR: int { ANALYTIC, ADAPTIVE, EULER, VALIDATE };
+const COMPASUnorderedMap<MT_ORBIT_INTEGRATOR, std::string> MT_ORBIT_INTEGRATOR_LABEL = {
+    { MT_ORBIT_INTEGRATOR::ANALYTIC, "ANALYTIC" },
+    { MT_ORBIT_INTEGRATOR::ADAPTIVE, "ADAPTIVE" },
+    { MT_ORBIT_INTEGRATOR::EULER,    "EULER" },
+    { MT_ORBIT_INTEGRATOR::VALIDATE, "VALIDATE" }
+};
+
 
 // Mass transfer cases
 enum class MT_CASE: int { NONE, A, B, C, OTHER };
@@ -1796,8 +1926,12 @@ enum class BINARY_PROPERTY: int {
     ECCENTRICITY_PRE_SUPERNOVA,
     ECCENTRICITY_PRE_COMMON_ENVELOPE,
     ERROR,
+    FORK_VARIATION,
     ID,
     IMMEDIATE_RLOF_POST_COMMON_ENVELOPE,
+    IMPORTANCE_WEIGHT,
+    KICK_RESAMPLE_BRANCH,
+    KICK_RESAMPLE_WEIGHT,
     MASS_1_FINAL,
     MASS_1_POST_COMMON_ENVELOPE,
     MASS_1_PRE_COMMON_ENVELOPE,
@@ -1922,8 +2056,12 @@ const COMPASUnorderedMap<BINARY_PROPERTY, std::string> BINARY_PROPERTY_LABEL = {
     { BINARY_PROPERTY::ECCENTRICITY_PRE_SUPERNOVA,                         "ECCENTRICITY_PRE_SUPERNOVA" },
     { BINARY_PROPERTY::ECCENTRICITY_PRE_COMMON_ENVELOPE,                   "ECCENTRICITY_PRE_COMMON_ENVELOPE" },
     { BINARY_PROPERTY::ERROR,                                              "ERROR" },
+    { BINARY_PROPERTY::FORK_VARIATION,                                     "FORK_VARIATION" },
     { BINARY_PROPERTY::ID,                                                 "ID" },
     { BINARY_PROPERTY::IMMEDIATE_RLOF_POST_COMMON_ENVELOPE,                "IMMEDIATE_RLOF_POST_COMMON_ENVELOPE" },
+    { BINARY_PROPERTY::IMPORTANCE_WEIGHT,                                  "IMPORTANCE_WEIGHT" },
+    { BINARY_PROPERTY::KICK_RESAMPLE_BRANCH,                               "KICK_RESAMPLE_BRANCH" },
+    { BINARY_PROPERTY::KICK_RESAMPLE_WEIGHT,                               "KICK_RESAMPLE_WEIGHT" },
     { BINARY_PROPERTY::MASS_1_FINAL,                                       "MASS_1_FINAL" },
     { BINARY_PROPERTY::MASS_1_POST_COMMON_ENVELOPE,                        "MASS_1_POST_COMMON_ENVELOPE" },
     { BINARY_PROPERTY::MASS_1_PRE_COMMON_ENVELOPE,                         "MASS_1_PRE_COMMON_ENVELOPE" },
@@ -2623,8 +2761,12 @@ const std::map<BINARY_PROPERTY, PROPERTY_DETAILS> BINARY_PROPERTY_DETAIL = {
     { BINARY_PROPERTY::ECCENTRICITY_PRE_SUPERNOVA,                          { TYPENAME::DOUBLE,         "Eccentricity<SN",      "-",                14, 6 }},
     { BINARY_PROPERTY::ECCENTRICITY_PRE_COMMON_ENVELOPE,                    { TYPENAME::DOUBLE,         "Eccentricity<CE",      "-",                14, 6 }},
     { BINARY_PROPERTY::ERROR,                                               { TYPENAME::ERROR,          "Error",                "-",                 4, 1 }},
+    { BINARY_PROPERTY::FORK_VARIATION,                                      { TYPENAME::INT,            "Fork_Variation",       "-",                 4, 1 }},
     { BINARY_PROPERTY::ID,                                                  { TYPENAME::OBJECT_ID,      "ID",                   "-",                12, 1 }},
     { BINARY_PROPERTY::IMMEDIATE_RLOF_POST_COMMON_ENVELOPE,                 { TYPENAME::BOOL,           "Immediate_RLOF>CE",    "Event",             0, 0 }},
+    { BINARY_PROPERTY::IMPORTANCE_WEIGHT,                                   { TYPENAME::DOUBLE,         "Importance_Weight",    "-",                14, 6 }},
+    { BINARY_PROPERTY::KICK_RESAMPLE_BRANCH,                                { TYPENAME::INT,            "Kick_Resample_Branch", "-",                 4, 1 }},
+    { BINARY_PROPERTY::KICK_RESAMPLE_WEIGHT,                                { TYPENAME::DOUBLE,         "Kick_Resample_Weight", "-",                14, 6 }},
     { BINARY_PROPERTY::MASS_1_FINAL,                                        { TYPENAME::DOUBLE,         "Core_Mass(1)",         "Msol",             14, 6 }},
     { BINARY_PROPERTY::MASS_1_POST_COMMON_ENVELOPE,                         { TYPENAME::DOUBLE,         "Mass(1)>CE",           "Msol",             14, 6 }},
     { BINARY_PROPERTY::MASS_1_PRE_COMMON_ENVELOPE,                          { TYPENAME::DOUBLE,         "Mass(1)<CE",           "Msol",             14, 6 }},
@@ -2937,6 +3079,7 @@ enum class RUN_DETAILS_COLUMNS: int { COMPAS_VERSION,
                                       CLOCK_TIME,
                                       WALL_TIME,
                                       ACTUAL_RANDOM_SEED,
+                                      HDF5_BUFFER_HIGH_WATER_MARK,
                                       SENTINEL };
 
 const COMPASUnorderedMap<RUN_DETAILS_COLUMNS, std::tuple<std::string, TYPENAME, std::size_t>> RUN_DETAILS_DETAIL = {
@@ -2947,7 +3090,8 @@ const COMPASUnorderedMap<RUN_DETAILS_COLUMNS, std::tuple<std::string, TYPENAME,
     { RUN_DETAILS_COLUMNS::OBJECTS_CREATED,     { "Objects-Created",               TYPENAME::INT,       0 }},
     { RUN_DETAILS_COLUMNS::CLOCK_TIME,          { "Clock-Time",                    TYPENAME::DOUBLE,    0 }},
     { RUN_DETAILS_COLUMNS::WALL_TIME,           { "Wall-Time",                     TYPENAME::STRING,   10 }},
-    { RUN_DETAILS_COLUMNS::ACTUAL_RANDOM_SEED,  { "Actual-Random-Seed",            TYPENAME::ULONGINT,  0 }}
+    { RUN_DETAILS_COLUMNS::ACTUAL_RANDOM_SEED,  { "Actual-Random-Seed",            TYPENAME::ULONGINT,  0 }},
+    { RUN_DETAILS_COLUMNS::HDF5_BUFFER_HIGH_WATER_MARK, { "HDF5-Buffer-High-Water-Mark", TYPENAME::ULONGINT,  0 }}
 };
 
 
@@ -3731,16 +3875,22 @@ const std::map<int, COMPASUnorderedMap<AB_TCoeff, double>> B_COEFF = {
 const std::unordered_map<int, double> C_COEFF = {{1, -8.672073E-2}, {2, 9.301992E0}, {3, 4.637345E0}};
 
 
+// Tables held as TabulatedFunction objects are function-local statics (rather than namespace-scope
+// constants, which would be built in every translation unit that includes this file)
+
 // CDF from Table 7 in Dufton et al 2013 https://arxiv.org/abs/1212.2424
 // There is an assumption in the code that this function is monitonically increasing - it is now
-// and should remain so if the map is modified.
-const std::map<double, double> BStarRotationalVelocityCDFTable = {
-    {000.0, 0.000}, {020.0, 0.046}, {040.0, 0.094}, {060.0, 0.144}, {080.0, 0.192}, {100.0, 0.239},
-    {120.0, 0.253}, {140.0, 0.270}, {160.0, 0.288}, {180.0, 0.322}, {200.0, 0.377}, {220.0, 0.435},
-    {240.0, 0.492}, {260.0, 0.548}, {280.0, 0.609}, {300.0, 0.674}, {320.0, 0.739}, {340.0, 0.796},
-    {360.0, 0.841}, {380.0, 0.879}, {400.0, 0.912}, {420.0, 0.938}, {440.0, 0.956}, {460.0, 0.971},
-    {480.0, 0.983}, {500.0, 0.990}, {520.0, 0.993}, {540.0, 0.995}, {560.0, 0.996}, {580.0, 0.997}
-};
+// and should remain so if the table is modified.
+inline const TabulatedFunction& BStarRotationalVelocityCDFTable() {
+    static const TabulatedFunction table = {
+        {000.0, 0.000}, {020.0, 0.046}, {040.0, 0.094}, {060.0, 0.144}, {080.0, 0.192}, {100.0, 0.239},
+        {120.0, 0.253}, {140.0, 0.270}, {160.0, 0.288}, {180.0, 0.322}, {200.0, 0.377}, {220.0, 0.435},
+        {240.0, 0.492}, {260.0, 0.548}, {280.0, 0.609}, {300.0, 0.674}, {320.0, 0.739}, {340.0, 0.796},
+        {360.0, 0.841}, {380.0, 0.879}, {400.0, 0.912}, {420.0, 0.938}, {440.0, 0.956}, {460.0, 0.971},
+        {480.0, 0.983}, {500.0, 0.990}, {520.0, 0.993}, {540.0, 0.995}, {560.0, 0.996}, {580.0, 0.997}
+    };
+    return table;
+}
 
 
 // These neutron star (NS) equations-of-state (EOS) are
@@ -3752,31 +3902,34 @@ const std::map<double, double> BStarRotationalVelocityCDFTable = {
 
 // For now we choose one example EOS ARP3 from
 // Akmal et al 1998 https://arxiv.org/abs/nucl-th/9804027
-const std::map<double, double> ARP3MassRadiusRelation = {
-    {0.184 , 16.518}, {0.188 , 16.292}, {0.192 , 16.067}, {0.195 , 15.857}, {0.199 , 15.658}, {0.203 , 15.46 }, {0.207 , 15.277}, {0.212, 15.102}, {0.216, 14.933},
-    {0.221 , 14.774}, {0.225 , 14.619}, {0.23  , 14.473}, {0.235 , 14.334}, {0.24  , 14.199}, {0.245 , 14.073}, {0.251 , 13.951}, {0.256, 13.834}, {0.262, 13.725},
-    {0.268 , 13.618}, {0.273 , 13.52 }, {0.28  , 13.423}, {0.286 , 13.332}, {0.292 , 13.245}, {0.299 , 13.162}, {0.306 , 13.084}, {0.313, 13.009}, {0.32 , 12.94 },
-    {0.327 , 12.871}, {0.335 , 12.806}, {0.342 , 12.747}, {0.35  , 12.691}, {0.358 , 12.638}, {0.366 , 12.586}, {0.374 , 12.538}, {0.383, 12.493}, {0.391, 12.451},
-    {0.4   , 12.409}, {0.409 , 12.371}, {0.418 , 12.336}, {0.427 , 12.302}, {0.438 , 12.269}, {0.448 , 12.239}, {0.458 , 12.211}, {0.468, 12.184}, {0.479, 12.16 },
-    {0.49  , 12.136}, {0.501 , 12.116}, {0.512 , 12.096}, {0.524 , 12.078}, {0.535 , 12.061}, {0.547 , 12.046}, {0.559 , 12.031}, {0.572, 12.018}, {0.585, 12.007},
-    {0.598 , 11.997}, {0.611 , 11.987}, {0.625 , 11.979}, {0.638 , 11.972}, {0.652 , 11.966}, {0.666 , 11.96 }, {0.681 , 11.955}, {0.695, 11.952}, {0.71 , 11.949},
-    {0.725 , 11.947}, {0.74  , 11.946}, {0.756 , 11.945}, {0.772 , 11.945}, {0.788 , 11.945}, {0.804 , 11.946}, {0.82  , 11.947}, {0.837, 11.949}, {0.854, 11.952},
-    {0.871 , 11.955}, {0.888 , 11.957}, {0.906 , 11.961}, {0.923 , 11.964}, {0.941 , 11.968}, {0.959 , 11.972}, {0.977 , 11.977}, {0.995, 11.981}, {1.014, 11.985},
-    {1.032 , 11.99 }, {1.05  , 11.994}, {1.069 , 11.999}, {1.088 , 12.004}, {1.107 , 12.009}, {1.126 , 12.013}, {1.145 , 12.018}, {1.164, 12.022}, {1.184, 12.027},
-    {1.203 , 12.031}, {1.222 , 12.035}, {1.242 , 12.039}, {1.261 , 12.043}, {1.281 , 12.047}, {1.3   , 12.05 }, {1.32  , 12.053}, {1.339, 12.056}, {1.358, 12.058},
-    {1.378 , 12.061}, {1.397 , 12.063}, {1.416 , 12.064}, {1.436 , 12.066}, {1.455 , 12.067}, {1.474 , 12.068}, {1.493 , 12.068}, {1.512, 12.068}, {1.531, 12.068},
-    {1.549 , 12.067}, {1.568 , 12.066}, {1.586 , 12.065}, {1.604 , 12.063}, {1.623 , 12.06 }, {1.64  , 12.058}, {1.658 , 12.055}, {1.676, 12.052}, {1.693, 12.048},
-    {1.71  , 12.044}, {1.727 , 12.039}, {1.744 , 12.034}, {1.761 , 12.029}, {1.777 , 12.024}, {1.793 , 12.017}, {1.809 , 12.011}, {1.825, 12.004}, {1.84 , 11.997},
-    {1.856 , 11.989}, {1.871 , 11.981}, {1.886 , 11.973}, {1.9   , 11.965}, {1.915 , 11.956}, {1.929 , 11.946}, {1.943 , 11.937}, {1.956, 11.927}, {1.969, 11.916},
-    {1.982 , 11.906}, {1.995 , 11.895}, {2.008 , 11.884}, {2.02  , 11.827}, {2.032 , 11.86 }, {2.044 , 11.848}, {2.056 , 11.836}, {2.067, 11.823}, {2.078, 11.81 },
-    {2.089 , 11.797}, {2.099 , 11.784}, {2.109 , 11.77 }, {2.119 , 11.756}, {2.129 , 11.742}, {2.139 , 11.727}, {2.148 , 11.713}, {2.157, 11.698}, {2.166, 11.683},
-    {2.174 , 11.668}, {2.182 , 11.652}, {2.19  , 11.637}, {2.198 , 11.621}, {2.206 , 11.605}, {2.213 , 11.589}, {2.221 , 11.573}, {2.227, 11.556}, {2.234, 11.54 },
-    {2.241 , 11.523}, {2.247 , 11.506}, {2.253 , 11.49 }, {2.259 , 11.473}, {2.264 , 11.456}, {2.27  , 11.438}, {2.275 , 11.421}, {2.28 , 11.404}, {2.285, 11.386},
-    {2.29  , 11.369}, {2.294 , 11.351}, {2.299 , 11.333}, {2.303 , 11.316}, {2.307 , 11.299}, {2.31  , 11.281}, {2.314 , 11.263}, {2.317, 11.245}, {2.321, 11.227},
-    {2.324 , 11.209}, {2.327 , 11.191}, {2.33  , 11.173}, {2.332 , 11.155}, {2.335 , 11.136}, {2.337 , 11.119}, {2.339 , 11.101}, {2.342, 11.083}, {2.344, 11.065},
-    {2.345 , 11.046}, {2.347 , 11.028}, {2.349 , 11.01 }, {2.35  , 10.992}, {2.352 , 10.974}, {2.353 , 10.956}, {2.354 , 10.938}, {2.355, 10.92 }, {2.356, 10.902},
-    {2.3571, 10.885}, {2.3572, 10.866}, {2.3581, 10.849}, {2.3582, 10.831}, {2.3591, 10.813}, {2.3592, 10.795}, {2.3593, 10.777}, {2.361, 10.76 }, {2.362, 10.742}
-};
+inline const TabulatedFunction& ARP3MassRadiusRelation() {
+    static const TabulatedFunction table = {
+        {0.184 , 16.518}, {0.188 , 16.292}, {0.192 , 16.067}, {0.195 , 15.857}, {0.199 , 15.658}, {0.203 , 15.46 }, {0.207 , 15.277}, {0.212, 15.102}, {0.216, 14.933},
+        {0.221 , 14.774}, {0.225 , 14.619}, {0.23  , 14.473}, {0.235 , 14.334}, {0.24  , 14.199}, {0.245 , 14.073}, {0.251 , 13.951}, {0.256, 13.834}, {0.262, 13.725},
+        {0.268 , 13.618}, {0.273 , 13.52 }, {0.28  , 13.423}, {0.286 , 13.332}, {0.292 , 13.245}, {0.299 , 13.162}, {0.306 , 13.084}, {0.313, 13.009}, {0.32 , 12.94 },
+        {0.327 , 12.871}, {0.335 , 12.806}, {0.342 , 12.747}, {0.35  , 12.691}, {0.358 , 12.638}, {0.366 , 12.586}, {0.374 , 12.538}, {0.383, 12.493}, {0.391, 12.451},
+        {0.4   , 12.409}, {0.409 , 12.371}, {0.418 , 12.336}, {0.427 , 12.302}, {0.438 , 12.269}, {0.448 , 12.239}, {0.458 , 12.211}, {0.468, 12.184}, {0.479, 12.16 },
+        {0.49  , 12.136}, {0.501 , 12.116}, {0.512 , 12.096}, {0.524 , 12.078}, {0.535 , 12.061}, {0.547 , 12.046}, {0.559 , 12.031}, {0.572, 12.018}, {0.585, 12.007},
+        {0.598 , 11.997}, {0.611 , 11.987}, {0.625 , 11.979}, {0.638 , 11.972}, {0.652 , 11.966}, {0.666 , 11.96 }, {0.681 , 11.955}, {0.695, 11.952}, {0.71 , 11.949},
+        {0.725 , 11.947}, {0.74  , 11.946}, {0.756 , 11.945}, {0.772 , 11.945}, {0.788 , 11.945}, {0.804 , 11.946}, {0.82  , 11.947}, {0.837, 11.949}, {0.854, 11.952},
+        {0.871 , 11.955}, {0.888 , 11.957}, {0.906 , 11.961}, {0.923 , 11.964}, {0.941 , 11.968}, {0.959 , 11.972}, {0.977 , 11.977}, {0.995, 11.981}, {1.014, 11.985},
+        {1.032 , 11.99 }, {1.05  , 11.994}, {1.069 , 11.999}, {1.088 , 12.004}, {1.107 , 12.009}, {1.126 , 12.013}, {1.145 , 12.018}, {1.164, 12.022}, {1.184, 12.027},
+        {1.203 , 12.031}, {1.222 , 12.035}, {1.242 , 12.039}, {1.261 , 12.043}, {1.281 , 12.047}, {1.3   , 12.05 }, {1.32  , 12.053}, {1.339, 12.056}, {1.358, 12.058},
+        {1.378 , 12.061}, {1.397 , 12.063}, {1.416 , 12.064}, {1.436 , 12.066}, {1.455 , 12.067}, {1.474 , 12.068}, {1.493 , 12.068}, {1.512, 12.068}, {1.531, 12.068},
+        {1.549 , 12.067}, {1.568 , 12.066}, {1.586 , 12.065}, {1.604 , 12.063}, {1.623 , 12.06 }, {1.64  , 12.058}, {1.658 , 12.055}, {1.676, 12.052}, {1.693, 12.048},
+        {1.71  , 12.044}, {1.727 , 12.039}, {1.744 , 12.034}, {1.761 , 12.029}, {1.777 , 12.024}, {1.793 , 12.017}, {1.809 , 12.011}, {1.825, 12.004}, {1.84 , 11.997},
+        {1.856 , 11.989}, {1.871 , 11.981}, {1.886 , 11.973}, {1.9   , 11.965}, {1.915 , 11.956}, {1.929 , 11.946}, {1.943 , 11.937}, {1.956, 11.927}, {1.969, 11.916},
+        {1.982 , 11.906}, {1.995 , 11.895}, {2.008 , 11.884}, {2.02  , 11.827}, {2.032 , 11.86 }, {2.044 , 11.848}, {2.056 , 11.836}, {2.067, 11.823}, {2.078, 11.81 },
+        {2.089 , 11.797}, {2.099 , 11.784}, {2.109 , 11.77 }, {2.119 , 11.756}, {2.129 , 11.742}, {2.139 , 11.727}, {2.148 , 11.713}, {2.157, 11.698}, {2.166, 11.683},
+        {2.174 , 11.668}, {2.182 , 11.652}, {2.19  , 11.637}, {2.198 , 11.621}, {2.206 , 11.605}, {2.213 , 11.589}, {2.221 , 11.573}, {2.227, 11.556}, {2.234, 11.54 },
+        {2.241 , 11.523}, {2.247 , 11.506}, {2.253 , 11.49 }, {2.259 , 11.473}, {2.264 , 11.456}, {2.27  , 11.438}, {2.275 , 11.421}, {2.28 , 11.404}, {2.285, 11.386},
+        {2.29  , 11.369}, {2.294 , 11.351}, {2.299 , 11.333}, {2.303 , 11.316}, {2.307 , 11.299}, {2.31  , 11.281}, {2.314 , 11.263}, {2.317, 11.245}, {2.321, 11.227},
+        {2.324 , 11.209}, {2.327 , 11.191}, {2.33  , 11.173}, {2.332 , 11.155}, {2.335 , 11.136}, {2.337 , 11.119}, {2.339 , 11.101}, {2.342, 11.083}, {2.344, 11.065},
+        {2.345 , 11.046}, {2.347 , 11.028}, {2.349 , 11.01 }, {2.35  , 10.992}, {2.352 , 10.974}, {2.353 , 10.956}, {2.354 , 10.938}, {2.355, 10.92 }, {2.356, 10.902},
+        {2.3571, 10.885}, {2.3572, 10.866}, {2.3581, 10.849}, {2.3582, 10.831}, {2.3591, 10.813}, {2.3592, 10.795}, {2.3593, 10.777}, {2.361, 10.76 }, {2.362, 10.742}
+    };
+    return table;
+}
 
 
 // Coefficients for calculating binding and recombination energy as described in Loveridge et al. 2011
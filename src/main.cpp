@@ -8,7 +8,6 @@
 #include <fstream>
 #include <tuple>
 #include <vector>
-#include <csignal>
 #include <iostream>
 #include <iomanip>
 
@@ -16,11 +15,17 @@
 #include "typedefs.h"
 
 #include "profiling.h"
+#include "powers.h"
 #include "utils.h"
 #include "vector3d.h"
 #include "Options.h"
 #include "Rand.h"
 #include "Log.h"
+#include "AdaptiveSampler.h"
+#include "BlockSampler.h"
+#include "KickSampler.h"
+#include "CoalescenceTime.h"
+#include "TrackLibrary.h"
 
 #include "Star.h"
 #include "BinaryStar.h"
@@ -37,64 +42,6 @@ OBJECT_TYPE  ObjectType()  { return OBJECT_TYPE::MAIN; }
 STELLAR_TYPE StellarType() { return STELLAR_TYPE::NONE; }
 
 
-// The following global variables support the BSE Switch Log file
-// Ideally, rather than be declared as globals, they would be in maybe the 
-// LOGGING service singleton, but the Log class knows nothing about the 
-// BinaryStar class...
-// (maybe we could put them in the new CONSTANTS service singleton if we 
-// implement it)
-
-BinaryStar* evolvingBinaryStar      = NULL;             // pointer to the currently evolving Binary Star
-bool        evolvingBinaryStarValid = false;            // flag to indicate whether the evolvingBinaryStar pointer is valid
-
-/*
- * Signal handler
- * 
- * Only handles SIGUSR1; all other signals are left to the system to handle.
- * 
- * SIGUSR1 is a user generated signal - the system should not generate this signal,
- * though it is possible to send the signal to a process via the Un*x kill command,
- * or some other user-developed program that sends signals.  This code does some 
- * rudimentary sanity checks, but it is possible that sending a SIGUSR1 signal to a
- * running COMPAS process via the Un*x kill command, or otherwise, might cause a 
- * spurious entry in the BSE Switch Log file - c'est la vie.
- * 
- * We use SIGUSR1 in the Star class to signal when a Star object switches stellar 
- * type. We use a signal because the Star class knows nothing about binary stars, 
- * so can't call a binary star function to log binary star variables to the BSE 
- * Switch Log file. By raising a signal in the Star class and catching it here we 
- * can call the appropriate binary star class function to write the binary star 
- * variables to the log file.
- * 
- * The signal is raised in the Star::SwitchTo() function if OPTIONS->BSESwitchLog() 
- * is true, so the signal will be received here for every stellar type switch of 
- * every star.
- * 
- * We only process the signal here if the global variable evolvingBinaryStarValid 
- * is true. The global variable evolvingBinaryStarValid is only set true after a 
- * binary star has been constructed and is ready to evolve - so if the signal is 
- * raised, it will be ignored for SSE switches, and it will be ignored for switches 
- * inside the constructor of the binary star (and so its constituent stars).
- * 
- * This signal handler is installed in EvolveBinaryStars(), so it is installed only
- * if we're evolving binaries - signals will be ignored (by our code - the system
- * will still receive and handle them) if we're evolving single stars.
- *
- * 
- * void sigHandler(int p_Sig)
- * 
- * @param   [IN]        p_Sig                   The signal intercepted
- * 
- */
-void sigHandler(int p_Sig) {   
-    if (p_Sig == SIGUSR1) {                                         // SIGUSR1?  Just silently ignore anything else...
-        if (evolvingBinaryStarValid && OPTIONS->SwitchLog()) {      // yes - do we have a valid binary star, and are we logging switches?
-            (void)evolvingBinaryStar->PrintSwitchLog();             // yes - assume SIGUSR1 is a binary constituent star switching...
-        }
-    }
-}
-
-
 /*
  * Evolve single stars
  *
@@ -118,6 +65,7 @@ std::tuple<int, int> EvolveSingleStars() {
     Star*  star      = nullptr;
     bool   usingGrid = !OPTIONS->GridFilename().empty();                                                            // using grid file?
     size_t index     = 0;                                                                                           // which star
+    size_t firstOfCmdLineVariation = 0;                                                                             // index of the first star of the current commandline options variation
 
     // The options specified by the user at the commandline are set to their initial values.
     // OPTIONS->AdvanceCmdLineOptionValues(), called at the end of the loop, advances the
@@ -183,22 +131,31 @@ std::tuple<int, int> EvolveSingleStars() {
                 // (i.e. the random seed specified is used as it)).  Note that in this scenario it is the 
                 // user's responsibility to ensure that there is no duplication of seeds.
 
+                // with common random numbers (program option --common-random-numbers) the stars of each commandline
+                // options variation are seeded as the stars of the first variation, so the variations are paired
+
+                size_t systemIndex = OPTIONS->CommonRandomNumbers() ? index - firstOfCmdLineVariation : index;   // index for the random seed
+
                 unsigned long int randomSeed = 0l;
                 if (OPTIONS->FixedRandomSeedGridLine()) {                                                           // user specified a random seed in the grid file for this star?
                     randomSeed = RAND->Seed(OPTIONS->RandomSeedGridLine() + (long int)gridLineVariation);           // yes - use it (indexed)
                 }
                 else if (OPTIONS->FixedRandomSeedCmdLine()) {                                                       // no - user specified a random seed on the commandline?
-                    randomSeed = RAND->Seed(OPTIONS->RandomSeedCmdLine() + (long int)index);                        // yes - use it (indexed)
+                    randomSeed = RAND->Seed(OPTIONS->RandomSeedCmdLine() + (long int)systemIndex);                        // yes - use it (indexed)
                 }
                 else {                                                                                              // no
-                    randomSeed = RAND->Seed(RAND->DefaultSeed() + (long int)index);                                 // use default seed (based on system time) + id (index)
+                    randomSeed = RAND->Seed(RAND->DefaultSeed() + (long int)systemIndex);                                 // use default seed (based on system time) + id (index)
                 }
+                RAND->QuasiRandomNextPoint();                                                                       // next quasi-random point for the initial conditions (no-op unless QMC sampling)
+                BLOCK_SAMPLER->NextSystem(systemIndex);                                                             // next system's initial conditions from the block (no-op unless BLOCK sampling)
 
                 // the initial mass of the star is supplied - this is to allow binary stars to initialise
                 // the masses of their constituent stars (rather than have the constituent stars sample 
                 // their own mass).  Here we use the mass supplied by the user via the program options or, 
                 // if no mass was supplied by the user, sample the mass from the IMF.
 
+                RAND->Stream(RANDOM_STREAM::INITIAL_CONDITIONS);                                                    // common random numbers: initial conditions substream (no-op unless --common-random-numbers)
+
                 double initialMass = OPTIONS->OptionSpecified("initial-mass") == 1                                  // user specified mass?
                                         ? OPTIONS->InitialMass()                                                    // yes, use it
                                         : utils::SampleInitialMass(OPTIONS->InitialMassFunction(),                  // no, sample it
@@ -217,6 +174,7 @@ std::tuple<int, int> EvolveSingleStars() {
                                                                    OPTIONS->MetallicityDistributionMax(), 
                                                                    OPTIONS->MetallicityDistributionMin());          // no, sample it
 
+                RAND->StreamClear();
 
 
                 // Single stars (in SSE) are provided with a kick structure that specifies the 
@@ -238,6 +196,17 @@ std::tuple<int, int> EvolveSingleStars() {
                 kickParameters.magnitudeRandom          = OPTIONS->KickMagnitudeRandom();
                 kickParameters.magnitudeSpecified       = OPTIONS->OptionSpecified("kick-magnitude") == 1;
                 kickParameters.magnitude                = OPTIONS->KickMagnitude();
+
+                // the kick random number, if not specified by the user, is drawn here from the kick substream of the
+                // star (see Rand::Stream()) - the value in the program options is drawn when the options are advanced,
+                // from the generator as the previous star left it, so would make this star depend on the stars evolved
+                // before it
+
+                if (!kickParameters.magnitudeRandomSpecified) {                                                     // user specified kick random number?
+                    RAND->Stream(RANDOM_STREAM::SUPERNOVA_KICK, true);                                              // no - draw it from the kick substream
+                    kickParameters.magnitudeRandom = RAND->Random();
+                    RAND->StreamClear();
+                }
                        
                 // create the star
                 delete star; star = nullptr;                                                                        // so we don't leak...
@@ -292,6 +261,9 @@ std::tuple<int, int> EvolveSingleStars() {
                 evolutionStatus = EVOLUTION_STATUS::STOPPED;                                                        // no - stop evolution
                 SHOW_ERROR(ERROR::ERROR_PROCESSING_CMDLINE_OPTIONS);                                                // show error
             }
+            else if (optionsStatus > 0) {                                                                           // new options variation?
+                firstOfCmdLineVariation = index;                                                                    // yes - its first star
+            }
             else if (optionsStatus == 0) {                                                                          // end of options variations?
                 if (usingGrid || OPTIONS->CommandLineGrid() || (!usingGrid && index >= OPTIONS->nObjectsToEvolve())) { // created required number of stars?
                     evolutionStatus = EVOLUTION_STATUS::DONE;                                                       // yes - we're done
@@ -351,8 +323,6 @@ std::tuple<int, int> EvolveSingleStars() {
  */
 std::tuple<int, int> EvolveBinaryStars() {
 
-    signal(SIGUSR1, sigHandler);                                                                                // install signal handler
-
     EVOLUTION_STATUS evolutionStatus = EVOLUTION_STATUS::CONTINUE;
 
     auto wallStart = std::chrono::system_clock::now();                                                          // start wall timer
@@ -364,6 +334,7 @@ std::tuple<int, int> EvolveBinaryStars() {
     BinaryStar* binary    = nullptr;
     bool        usingGrid = !OPTIONS->GridFilename().empty();                                                   // using grid file?
     size_t      index     = 0;                                                                                  // which binary
+    size_t      firstOfCmdLineVariation = 0;                                                                    // index of the first binary of the current commandline options variation
 
     // The options specified by the user at the commandline are set to their initial values.
     // OPTIONS->AdvanceCmdLineOptionValues(), called at the end of the loop, advances the
@@ -378,9 +349,6 @@ std::tuple<int, int> EvolveBinaryStars() {
         bool doneGridFile     = false;                                                                          // flags we're done with the grid file (for this commandline variation)
         while (!doneGridFile && evolutionStatus == EVOLUTION_STATUS::CONTINUE) {                                // for each binary to be evolved
 
-            evolvingBinaryStar      = NULL;                                                                     // unset global pointer to evolving binary (for BSE Switch Log)
-            evolvingBinaryStarValid = false;                                                                    // indicate that the global pointer is not (yet) valid (for BSE Switch log)
-
             bool doneGridLine = false;                                                                          // flags we're done with this grid file line (if using a grid file)
             if (usingGrid) {                                                                                    // using grid file?
                 gridLineVariation = 0;                                                                          // yes - first variation of this grid line
@@ -438,50 +406,82 @@ std::tuple<int, int> EvolveBinaryStars() {
                 // (i.e. the random seed specified is used as it)).  Note that in this scenario it is the 
                 // user's responsibility to ensure that there is no duplication of seeds.
 
+                // with common random numbers (program option --common-random-numbers) the binaries of each commandline
+                // options variation are seeded as the binaries of the first variation, so the variations are paired
+
+                size_t systemIndex = OPTIONS->CommonRandomNumbers() ? index - firstOfCmdLineVariation : index;  // index for the random seed
+
                 unsigned long int randomSeed = 0l;
                 
                 if (OPTIONS->FixedRandomSeedGridLine()) {                                                       // user specified a random seed in the grid file for this star?
                     randomSeed = RAND->Seed(OPTIONS->RandomSeedGridLine() + (long int)gridLineVariation);       // yes - use it (indexed)
                 }
                 else if (OPTIONS->FixedRandomSeedCmdLine()) {                                                   // no - user specified a random seed on the commandline?
-                    randomSeed = RAND->Seed(OPTIONS->RandomSeedCmdLine() + (long int)index);                    // yes - use it (indexed)
+                    randomSeed = RAND->Seed(OPTIONS->RandomSeedCmdLine() + (long int)systemIndex);                    // yes - use it (indexed)
                 }
                 else {                                                                                          // no
-                    randomSeed = RAND->Seed(RAND->DefaultSeed() + (long int)index);                             // use default seed (based on system time) + id (index)
+                    randomSeed = RAND->Seed(RAND->DefaultSeed() + (long int)systemIndex);                             // use default seed (based on system time) + id (index)
                 }
+                RAND->QuasiRandomNextPoint();                                                                   // next quasi-random point for the initial conditions (no-op unless QMC sampling)
+                BLOCK_SAMPLER->NextSystem(systemIndex);                                                         // next system's initial conditions from the block (no-op unless BLOCK sampling)
+                SAMPLER->NextPoint();                                                                           // next adaptive importance sampling point for the initial conditions (no-op unless AIS sampling)
 
                 long int thisId = OPTIONS->FixedRandomSeedGridLine() ? index + gridLineVariation : index;       // set the id for the binary
                 
+                // announce result of evolving the binary (or a fork of the binary)
+                auto announce = [&](const EVOLUTION_STATUS binaryStatus) {
+
+                    if (binaryStatus == EVOLUTION_STATUS::ERROR || binaryStatus == EVOLUTION_STATUS::SSE_ERROR) {   // ok?
+                        SHOW_ERROR(ERROR::BINARY_EVOLUTION_STOPPED, EVOLUTION_STATUS_LABEL.at(binaryStatus));       // no - show error
+                    }
+
+                    if (!OPTIONS->Quiet()) {                                                                        // quiet mode?
+                                                                                                                    // no - announce result of evolving the binary
+                        if (OPTIONS->CHEMode() == CHE_MODE::NONE) {                                                 // CHE enabled?
+                            SAY(thisId                                     << ": "  <<                              // no - CHE not enabled - don't need initial stellar type
+                                EVOLUTION_STATUS_LABEL.at(binaryStatus)    << ": "  <<
+                                STELLAR_TYPE_LABEL.at(binary->Star1Type()) << " + " <<
+                                STELLAR_TYPE_LABEL.at(binary->Star2Type())
+                            );
+                        }
+                        else {                                                                                      // CHE enabled - show initial stellar type
+                            SAY(thisId                                            << ": "    <<
+                                EVOLUTION_STATUS_LABEL.at(binaryStatus)           << ": ("   <<
+                                STELLAR_TYPE_LABEL.at(binary->Star1InitialType()) << " -> "  <<
+                                STELLAR_TYPE_LABEL.at(binary->Star1Type())        << ") + (" <<
+                                STELLAR_TYPE_LABEL.at(binary->Star2InitialType()) << " -> "  <<
+                                STELLAR_TYPE_LABEL.at(binary->Star2Type())        <<  ")"
+                            );
+                        }
+                    }
+                };
+
+                // forked evolution of option variations: the binary is evolved for the first variation of the
+                // commandline options, watching for reads of the options specified as ranges or sets on the
+                // commandline (the swept options), then forked for each subsequent variation (see BinaryStar::EvolveFork())
+
+                OPTIONS->WatchSweptOptions(OPTIONS->ForkVariations());                                          // watch reads of swept options? (forked evolution only)
+
                 delete binary; binary = nullptr;                                                                // so we don't leak
                 binary = new BinaryStar(randomSeed, thisId);                                                    // generate binary according to the user options
 
-                evolvingBinaryStar      = binary;                                                               // set global pointer to evolving binary (for BSE Switch Log)
-                evolvingBinaryStarValid = true;                                                                 // indicate that the global pointer is now valid (for BSE Switch Log)
+                announce(binary->Evolve());                                                                     // evolve the binary
 
-                EVOLUTION_STATUS binaryStatus = binary->Evolve();                                               // evolve the binary
+                OPTIONS->WatchSweptOptions(false);                                                              // stop watching
 
-                if (binaryStatus == EVOLUTION_STATUS::ERROR || binaryStatus == EVOLUTION_STATUS::SSE_ERROR) {   // ok?
-                    SHOW_ERROR(ERROR::BINARY_EVOLUTION_STOPPED, EVOLUTION_STATUS_LABEL.at(binaryStatus));       // no - show error
-                }
-                
-                // announce result of evolving the binary
-                if (!OPTIONS->Quiet()) {                                                                        // quiet mode?
-                                                                                                                // no - announce result of evolving the binary
-                    if (OPTIONS->CHEMode() == CHE_MODE::NONE) {                                                 // CHE enabled?
-                        SAY(thisId                                     << ": "  <<                              // no - CHE not enabled - don't need initial stellar type
-                            EVOLUTION_STATUS_LABEL.at(binaryStatus)    << ": "  <<
-                            STELLAR_TYPE_LABEL.at(binary->Star1Type()) << " + " <<
-                            STELLAR_TYPE_LABEL.at(binary->Star2Type())
-                        );
+                if (OPTIONS->ForkVariations()) {                                                                // forked evolution?
+                    RandStateT randState = RAND->State();                                                       // yes - state after evolving the binary (for the next binary's calculated option values)
+
+                    int optionsStatus;
+                    while ((optionsStatus = OPTIONS->AdvanceCmdLineForkVariation()) > 0) {                      // for each subsequent commandline options variation (ranges/sets)
+                        ERRORS->Clean();                                                                        // clean the dynamic error catalog
+                        announce(binary->EvolveFork());                                                         // evolve a fork of the binary
                     }
-                    else {                                                                                      // CHE enabled - show initial stellar type
-                        SAY(thisId                                            << ": "    <<
-                            EVOLUTION_STATUS_LABEL.at(binaryStatus)           << ": ("   <<
-                            STELLAR_TYPE_LABEL.at(binary->Star1InitialType()) << " -> "  <<
-                            STELLAR_TYPE_LABEL.at(binary->Star1Type())        << ") + (" <<
-                            STELLAR_TYPE_LABEL.at(binary->Star2InitialType()) << " -> "  <<
-                            STELLAR_TYPE_LABEL.at(binary->Star2Type())        <<  ")"
-                        );
+
+                    RAND->RestoreState(randState);                                                              // draw as if the binary had not been forked
+                    if (optionsStatus < 0 || OPTIONS->RewindCmdLineOptionValues() < 0) {                        // ok? (first variation for the next binary)
+                        evolutionStatus = EVOLUTION_STATUS::STOPPED;                                            // no - stop evolution
+                        SHOW_ERROR(ERROR::ERROR_PROCESSING_CMDLINE_OPTIONS);                                    // show error
                     }
                 }
 
@@ -511,13 +511,16 @@ std::tuple<int, int> EvolveBinaryStars() {
         delete binary; binary = nullptr;
 
         if (evolutionStatus == EVOLUTION_STATUS::CONTINUE) {                                                    // ok?
-            int optionsStatus = OPTIONS->AdvanceCmdLineOptionValues();                                          // apply next commandline options (ranges/sets)
+            int optionsStatus = OPTIONS->ForkVariations() ? 0 : OPTIONS->AdvanceCmdLineOptionValues();         // apply next commandline options (ranges/sets) - played out per binary if forked evolution
             if (optionsStatus < 0) {                                                                            // ok?
                 evolutionStatus = EVOLUTION_STATUS::STOPPED;                                                    // no - stop evolution
                 SHOW_ERROR(ERROR::ERROR_PROCESSING_CMDLINE_OPTIONS);                                            // show error
             }
+            else if (optionsStatus > 0) {                                                                       // new options variation?
+                firstOfCmdLineVariation = index;                                                                // yes - its first binary
+            }
             else if (optionsStatus == 0) {                                                                      // end of options variations?
-                if (usingGrid || OPTIONS->CommandLineGrid() || (!usingGrid && index >= OPTIONS->nObjectsToEvolve())) { // created required number of stars?
+                if (usingGrid || (OPTIONS->CommandLineGrid() && !OPTIONS->ForkVariations()) || (!usingGrid && index >= OPTIONS->nObjectsToEvolve())) { // created required number of stars?
                     evolutionStatus = EVOLUTION_STATUS::DONE;                                                   // yes - we're done
                 }
             }
@@ -629,12 +632,41 @@ int main(int argc, char * argv[]) {
                     }
                 }
 
+                if (programStatus == PROGRAM_STATUS::CONTINUE && !SAMPLER->Initialise()) {          // initialise adaptive importance sampler (no-op unless AIS sampling)
+                    programStatus = PROGRAM_STATUS::STOPPED;                                        // failed - set status (error already shown)
+                }
+
+                if (programStatus == PROGRAM_STATUS::CONTINUE && !TRACK_LIBRARY->Initialise()) {    // initialise track library (reads the library in INTERPOLATE mode)
+                    programStatus = PROGRAM_STATUS::STOPPED;                                        // failed - set status (error already shown)
+                }
+
                 int objectsRequested = 0;                                                           // for logging
                 int objectsCreated   = 0;                                                           // for logging
 
                 if (programStatus == PROGRAM_STATUS::CONTINUE) {                                    // all ok?
 
-                    if (OPTIONS->EvolutionMode() == EVOLUTION_MODE::SSE) {                          // SSE?
+                    if (OPTIONS->InitialSampling() == INITIAL_SAMPLING::QMC) {                      // QMC initial-condition sampling?
+                        RAND->QuasiRandomInitialise(OPTIONS->FixedRandomSeedCmdLine()               // yes - scramble the sequence using the base random seed
+                                                    ? OPTIONS->RandomSeedCmdLine()
+                                                    : RAND->DefaultSeed());
+                    }
+                    else if (OPTIONS->InitialSampling() == INITIAL_SAMPLING::BLOCK) {              // block initial-condition sampling?
+                        BLOCK_SAMPLER->Initialise(OPTIONS->FixedRandomSeedCmdLine()                 // yes - seed the counter-based generator using the base random seed
+                                                  ? OPTIONS->RandomSeedCmdLine()
+                                                  : RAND->DefaultSeed());
+                    }
+
+                    powers::Enable(OPTIONS->PowerKernels());                                        // power function kernels, or std::pow() (--power-kernels)
+
+                    KICK_SAMPLER->Initialise();                                                     // build kick magnitude inverse-CDF tables (unless --kick-sampling EXACT)
+                    COALESCENCE_TIME->Initialise();                                                 // build time to coalescence table (unless --coalescence-time-kernel INTEGRAL)
+
+                    RAND->EnableStreams(OPTIONS->CommonRandomNumbers());                            // common random numbers: each random process draws from its own substream
+
+                    if (TRACK_LIBRARY->Mode() == TRACK_LIBRARY_MODE::CREATE) {                      // creating the track library?
+                        (void)TRACK_LIBRARY->Create();                                              // yes - create it (and evolve nothing else)
+                    }
+                    else if (OPTIONS->EvolutionMode() == EVOLUTION_MODE::SSE) {                     // SSE?
                         std::tie(objectsRequested, objectsCreated) = EvolveSingleStars();           // yes - evolve single stars
                     }
                     else {                                                                          // no - BSE
@@ -0,0 +1,167 @@
+#ifndef __powers_h__
+#define __powers_h__
+
+#include <cmath>
+
+
+/*
+ * Power function kernels
+ *
+ * std::pow() (PPOW() - see profiling.h) is one of the most frequently called functions in COMPAS, and
+ * most calls raise a number to a fixed exponent, or raise the same number (usually the mass) to several
+ * exponents.  std::pow() handles any base and exponent, so these calls pay for a log() and an exp()
+ * evaluated with extra precision every time.  The kernels here are cheaper for those cases:
+ *
+ *     powers::Pow<N>(x)        x^N for integer N            - repeated squaring, expanded at compile time
+ *     powers::Pow<N, D>(x)     x^(N/D) for rational N/D     - x^(N div D) * (D-th root of x)^(N mod D), with
+ *                                                             the root from sqrt()/cbrt() for D = 2, 3, 4, 6, 8, 9,
+ *                                                             and from exp2((N mod D) / D * log2(x)) otherwise
+ *     powers::Exp10(y)         10^y                         - exp2(y * log2(10))
+ *     powers::SharedBase(x)    x^y for several y            - log2(x) is calculated once, then each power
+ *                                                             is one exp2()
+ *
+ * Accuracy (checked against std::pow() over the ranges of bases and exponents used in COMPAS): Pow<N>() and
+ * Pow<N, D>() with D = 2 or 4 are within 1 ulp; the roots from cbrt() are within a few tens of ulp; exp2()/log2()
+ * based powers are within ~|y log2(x)| ulp.  All are within 1.0E-14 (relative) at the call sites, but the results
+ * are not bit-identical to std::pow(), and neither are the outputs of COMPAS: the differences grow as binaries
+ * evolve (see changelog.h, 02.19.22).
+ *
+ * The kernels are only used if enabled (program option --power-kernels - see Enable()).  Otherwise each function
+ * returns std::pow() of the base and the exponent, with the exponent N/D evaluated as N.0 / D.0 - exactly what
+ * the call sites returned before they used the kernels.
+ *
+ * Unlike std::pow(), Pow<N, D>() with D = 3 or 9 returns the real root of a negative base (std::pow()
+ * returns NaN) - the kernels are meant for the physical (positive) quantities the call sites use.
+ */
+
+namespace powers {
+
+    namespace detail {
+
+        inline bool& Enabled() { static bool enabled = false; return enabled; }                            // kernels enabled? (see Enable())
+
+        constexpr int Abs(const int p_N)                { return p_N < 0 ? -p_N : p_N; }
+        constexpr int Gcd(const int p_A, const int p_B) { return p_B == 0 ? Abs(p_A) : Gcd(p_B, p_A % p_B); }
+
+
+        // x^N for N >= 0, by repeated squaring - N is known at compile time, so this expands
+        // to (about) log2(N) multiplications
+        template <int N>
+        struct IntegerPower {
+            static inline double Of(const double p_X) { return (N % 2 == 1 ? p_X : 1.0) * IntegerPower<N / 2>::Of(p_X * p_X); }
+        };
+        template <> struct IntegerPower<1> { static inline double Of(const double p_X) { return p_X; } };
+        template <> struct IntegerPower<0> { static inline double Of(const double)     { return 1.0; } };
+
+
+        // D-th root of x, where a cheap one exists (Exact = true)
+        template <int D> struct Root    { static const bool Exact = false; static inline double Of(const double)     { return 0.0; } };
+        template <> struct Root<2>      { static const bool Exact = true;  static inline double Of(const double p_X) { return std::sqrt(p_X); } };
+        template <> struct Root<3>      { static const bool Exact = true;  static inline double Of(const double p_X) { return std::cbrt(p_X); } };
+        template <> struct Root<4>      { static const bool Exact = true;  static inline double Of(const double p_X) { return std::sqrt(std::sqrt(p_X)); } };
+        template <> struct Root<6>      { static const bool Exact = true;  static inline double Of(const double p_X) { return std::cbrt(std::sqrt(p_X)); } };
+        template <> struct Root<8>      { static const bool Exact = true;  static inline double Of(const double p_X) { return std::sqrt(std::sqrt(std::sqrt(p_X))); } };
+        template <> struct Root<9>      { static const bool Exact = true;  static inline double Of(const double p_X) { return std::cbrt(std::cbrt(p_X)); } };
+
+
+        // x^(N/D) for N >= 0, D >= 1, N/D in lowest terms
+        template <int N, int D>
+        struct PositivePower {
+            static inline double Of(const double p_X) {
+                constexpr int q = N / D;                                                                    // integer part of the exponent
+                constexpr int r = N % D;                                                                    // numerator of the fractional part
+
+                double fraction = 1.0;
+                if (r > 0) {
+                    fraction = Root<D>::Exact
+                                ? IntegerPower<r>::Of(Root<D>::Of(p_X))                                     // (D-th root of x)^r
+                                : std::exp2((static_cast<double>(r) / D) * std::log2(p_X));                 // no cheap root
+                }
+                return IntegerPower<q>::Of(p_X) * fraction;
+            }
+        };
+    }
+
+
+    /*
+     * Enable (or disable) the kernels
+     *
+     * Called from main() before evolution starts, with the value of program option --power-kernels.
+     *
+     *
+     * void Enable(const bool p_Enable)
+     *
+     * @param   [IN]    p_Enable                    Use the kernels (true), or std::pow() (false)
+     */
+    inline void Enable(const bool p_Enable) { detail::Enabled() = p_Enable; }
+
+
+    /*
+     * Raise a number to a fixed rational power
+     *
+     * The exponent N/D is a template parameter, so the kernel for it is chosen (and expanded) at compile time:
+     * e.g. Pow<3>(x) is x * x * x, Pow<1, 3>(x) is std::cbrt(x), Pow<5, 2>(x) is x * x * std::sqrt(x).
+     *
+     *
+     * double Pow<N, D>(const double p_X)
+     *
+     * @param   [IN]    p_X                         Base
+     * @return                                      p_X^(N/D)
+     */
+    template <int N, int D = 1>
+    inline double Pow(const double p_X) {
+        static_assert(D > 0, "powers::Pow<N, D>(): the denominator D must be positive");
+
+        if (!detail::Enabled()) return std::pow(p_X, static_cast<double>(N) / static_cast<double>(D));
+
+        constexpr int gcd = detail::Gcd(N, D);
+        const double  p   = detail::PositivePower<detail::Abs(N) / gcd, D / gcd>::Of(p_X);
+        return N < 0 ? 1.0 / p : p;
+    }
+
+
+    /*
+     * Raise 10 to a power
+     *
+     *
+     * double Exp10(const double p_Y)
+     *
+     * @param   [IN]    p_Y                         Exponent
+     * @return                                      10^p_Y
+     */
+    inline double Exp10(const double p_Y) {
+        if (!detail::Enabled()) return std::pow(10.0, p_Y);
+
+        return std::exp2(p_Y * 3.321928094887362347870319429489390175864831393);                            // log2(10)
+    }
+
+
+    /*
+     * Raise a number to several powers
+     *
+     * Calculates (and keeps) log2 of the base once, so each power is a single exp2():
+     *
+     *     powers::SharedBase m(p_Mass);
+     *     double top    = a[18] + (a[19] * m.Pow(a[21]));
+     *     double bottom = a[20] + m.Pow(a[22]);
+     *
+     * The base must be positive.
+     */
+    class SharedBase {
+
+    public:
+
+        explicit SharedBase(const double p_X) : m_Enabled(detail::Enabled()), m_X(p_X), m_Log2(m_Enabled ? std::log2(p_X) : 0.0) { }
+
+        double Pow(const double p_Y) const { return m_Enabled ? std::exp2(p_Y * m_Log2) : std::pow(m_X, p_Y); }
+
+    private:
+
+        bool   m_Enabled;                                                                                   // kernels enabled when constructed
+        double m_X;                                                                                         // base
+        double m_Log2;                                                                                      // log2 of the base
+    };
+
+}
+
+#endif // __powers_h__
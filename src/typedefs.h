@@ -273,4 +273,43 @@ typedef struct StellarCEDetails {                      // Common Envelope detail
 } StellarCEDetailsT; // was CommonEnvelopeDetailsT;
 
 
+// Evolution event details - see EventBus.h
+typedef struct Event {
+    EVENT_TYPE   type;                                      // event type
+    long int     id;                                        // id of the star (SSE) or binary (BSE) evolving - as used to name output files
+    OBJECT_ID    objectId;                                  // object id of the star for star events (e.g. stellar type switch, supernova), otherwise of the binary
+    STELLAR_TYPE stellarTypePrev;                           // stellar type before the event (star events only, otherwise STELLAR_TYPE::NONE)
+    STELLAR_TYPE stellarType;                               // stellar type after the event (star events only, otherwise STELLAR_TYPE::NONE)
+    double       time;                                      // time of the event (Myr) - age of the star for stellar type switches, otherwise physical time of the binary
+} EventT;
+
+
+// Predicate token - predicates are compiled to vectors of tokens in Reverse Polish Notation - see Log.h
+typedef struct PredicateToken {
+    PREDICATE_OP   op;                                      // operation
+    T_ANY_PROPERTY property;                                // property (for op = PROPERTY)
+    double         value;                                   // value (for op = CONSTANT)
+} PredicateTokenT;
+
+
+// Single star track interpolated from the track library - see TrackLibrary.h
+typedef struct TrackPoint {
+    double       time;                                      // age of the star (Myr)
+    double       mass;                                      // mass (Msol)
+    double       coreMass;                                  // core mass (Msol)
+    double       heCoreMass;                                // He core mass (Msol)
+    double       coCoreMass;                                // CO core mass (Msol)
+    double       luminosity;                                // luminosity (Lsol)
+    double       radius;                                    // radius (Rsol)
+    STELLAR_TYPE stellarType;                               // stellar type
+} TrackPointT;
+
+typedef struct Track {
+    std::vector<TrackPointT> points;                        // points, in time order
+    STELLAR_TYPE             remnantStellarType;            // stellar type of the remnant (STELLAR_TYPE::NONE if not known)
+    double                   remnantTime;                   // time of formation of the remnant (Myr)
+    double                   remnantMass;                   // mass of the remnant (Msol)
+} TrackT;
+
+
 #endif // __typedefs_h__
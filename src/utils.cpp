@@ -4,8 +4,10 @@
 #include <algorithm>
 #include <cstring>
 #include "profiling.h"
+#include "powers.h"
 #include "utils.h"
 #include "Rand.h"
+#include "BlockSampler.h"
 #include "changelog.h"
 
 /*
@@ -172,7 +174,7 @@ namespace utils {
         double a_cubed_SI_top    = G * ((p_Mass1 * MSOL_TO_KG) + (p_Mass2 * MSOL_TO_KG)) * p_Period * p_Period * SECONDS_IN_DAY * SECONDS_IN_DAY;
         double a_cubed_SI_bottom = 4.0 * M_PI * M_PI;
         double a_cubed_SI        = a_cubed_SI_top / a_cubed_SI_bottom;
-        double a_SI              = PPOW(a_cubed_SI, 1.0 / 3.0);
+        double a_SI              = powers::Pow<1, 3>(a_cubed_SI);
 
         return a_SI / AU;
     }
@@ -364,52 +366,18 @@ namespace utils {
     /*
      * Inverse sample from tabulated CDF
      *
-     * Finds X given Y and an ordered map<double, double> of (X, Y) pairs
-     * Uses simple linear interpolation
+     * Finds X given Y and a tabulated function of (X, Y) pairs
+     * Uses simple linear interpolation - see TabulatedFunction::InverseSampleCDF()
      *
      *
-     * double InverseSampleFromTabulatedCDF(const double p_Y, const std::map<double, double> p_Table)
+     * double InverseSampleFromTabulatedCDF(const double p_Y, const TabulatedFunction& p_Table)
      *
      * @param   [IN]    p_Y                 The Y value for which X is to be calculated
-     * @param   [IN]    p_Table             The table to interpolate on (Ordered map<double, double> of (X, Y) pairs)
-     * @return                              Interpolated X value
+     * @param   [IN]    p_Table             The table to interpolate on (Y must be non-decreasing in X)
+     * @return                              Interpolated X value (0.0 if the table is empty or p_Y is not in [0.0, 1.0))
      */
-    double InverseSampleFromTabulatedCDF(const double p_Y, const std::map<double, double> p_Table) {
-
-        double xInterp = 0.0;
-
-        if (p_Table.size() > 0 && (p_Y >= 0.0 && p_Y < 1.0)) {                                  // sanity check - map must not be empty, and p_Y must in [0.0, 1.0)      (Leave these as absolute compares)
-
-            std::map<double, double>::const_iterator iter;
-
-            iter        = p_Table.begin();
-            double yMin = iter->second;
-
-            iter        = p_Table.end();
-            double yMax = (--iter)->second;
-
-            double y = yMin + (p_Y * (std::max(yMin, yMax) - std::min(yMax, yMin)));            // normalise y - clamp to [yMin, yMax)
-
-            for (iter = p_Table.begin(); (iter != p_Table.end() && iter->second < y); ++iter);  // leave this as an absolute compare
-
-            double xAbove = iter->first;
-            double yAbove = iter->second;
-
-            if (iter == p_Table.begin()) {
-                xInterp = xAbove;
-            }
-            else {
-                iter--;
-                double xBelow = iter->first;
-                double yBelow = iter->second;
-
-                double gradient = (yAbove - yBelow) / (xAbove - xBelow);
-
-                xInterp = xBelow + ((y - yBelow) / gradient);
-            }
-        }
-
-        return xInterp;
+    double InverseSampleFromTabulatedCDF(const double p_Y, const TabulatedFunction& p_Table) {
+        return p_Table.InverseSampleCDF(p_Y);
     }
 
 
@@ -809,6 +777,12 @@ namespace utils {
 
         double eccentricity;
 
+        bool blockValue;
+        std::tie(blockValue, eccentricity) = BLOCK_SAMPLER->Value(BLOCK_VARIATE::ECCENTRICITY, static_cast<int>(p_Edist), p_Max, p_Min);
+        if (blockValue) return eccentricity;                                                            // block sampling: value drawn with the block (no-op unless BLOCK sampling)
+
+        RAND->QuasiRandomDimension(QMC_DIMENSION::ECCENTRICITY);                                        // QMC sampling: first uniform drawn comes from the quasi-random point
+
         switch (p_Edist) {                                                                              // which distribution?
 
             case ECCENTRICITY_DISTRIBUTION::ZERO:                                                       // ZERO - all systems are initially circular i.e. have zero eccentricity
@@ -854,6 +828,8 @@ namespace utils {
                 eccentricity = 0.0;
         }
 
+        RAND->QuasiRandomDimensionClear();                                                              // in case the distribution drew nothing
+
         return eccentricity;
     }
 
@@ -861,52 +837,21 @@ namespace utils {
     /*
      * Sample from tabulated CDF
      *
-     * Finds Y given X and an ordered map<double, double> of (X, Y) pairs
-     * Uses simple linear interpolation
+     * Finds Y given X and a tabulated function of (X, Y) pairs
+     * Uses simple linear interpolation - see TabulatedFunction::Interpolate()
      *
      *
-     * double SampleFromTabulatedCDF(const double p_X, const std::map<double, double> p_Table)
+     * double SampleFromTabulatedCDF(const double p_X, const TabulatedFunction& p_Table)
      *
      * @param   [IN]    p_X                 The X value for which Y is to be calculated
-     * @param   [IN]    p_Table             The table to interpolate on (Ordered map<double, double> of (X, Y) pairs)
-     * @return                              Interpolated Y value
+     * @param   [IN]    p_Table             The table to interpolate on
+     * @return                              Interpolated Y value (0.0 if the table is empty or p_X is not in [xMin, xMax])
      */
-    double SampleFromTabulatedCDF(const double p_X, const std::map<double, double> pTable) {
-
-        double yInterp = 0.0;
+    double SampleFromTabulatedCDF(const double p_X, const TabulatedFunction& p_Table) {
 
-        std::map<double, double>::const_iterator iter;
+        if (p_Table.Size() == 0 || p_X < p_Table.XMin() || p_X > p_Table.XMax()) return 0.0;  // sanity check - table must not be empty, and p_X must be in [xMin, xMax]  (Leave these as absolute compares)
 
-        iter        = pTable.begin();
-        double xMin = iter->first;
-
-        iter        = pTable.end();
-        double xMax = (--iter)->first;
-
-        if (pTable.size() > 0 && (p_X >= xMin && p_X <= xMax)) {                                // sanity check - map must not be empty, and p_X must be in [xMin, xMax]  (Leave these as absolute compares)
-
-            for (iter = pTable.begin(); (iter != pTable.end() && iter->first < p_X); ++iter);   // leave this as an absolute compare
-
-            if (iter == pTable.begin()) {
-                yInterp = iter->second;
-            }
-            else if (iter == pTable.end()) {
-                yInterp = (--iter)->second;
-            }
-            else {
-
-                double xAbove = iter->first;
-            double yAbove = iter->second;
-                    double xBelow = (--iter)->first;
-                double yBelow = iter->second;
-
-                double gradient = (yAbove - yBelow) / (xAbove - xBelow);
-
-                yInterp = yBelow + ((p_X - xBelow) * gradient);
-            }
-        }
-
-        return yInterp;
+        return p_Table.Interpolate(p_X);
     }
 
 
@@ -926,6 +871,12 @@ namespace utils {
 
         double thisMass = 0.0;
 
+        bool blockValue;
+        std::tie(blockValue, thisMass) = BLOCK_SAMPLER->Value(BLOCK_VARIATE::MASS, static_cast<int>(p_IMF), p_Max, p_Min, p_Power);
+        if (blockValue) return thisMass;                                                                // block sampling: value drawn with the block (no-op unless BLOCK sampling)
+
+        RAND->QuasiRandomDimension(QMC_DIMENSION::MASS);                                                // QMC sampling: first uniform drawn comes from the quasi-random point
+
         switch (p_IMF) {                                                                                            // which IMF?
 
             case INITIAL_MASS_FUNCTION::SALPETER:                                                                   // SALPETER
@@ -1018,6 +969,8 @@ namespace utils {
                 thisMass = utils::InverseSampleFromPowerLaw(KROUPA_POWER, KROUPA_MAXIMUM, KROUPA_MINIMUM);          // calculate mass using power law with default values
         }
 
+        RAND->QuasiRandomDimensionClear();                                                              // in case the distribution drew nothing
+
         return thisMass;
     }
 
@@ -1037,6 +990,12 @@ namespace utils {
 
         double q;
 
+        bool blockValue;
+        std::tie(blockValue, q) = BLOCK_SAMPLER->Value(BLOCK_VARIATE::MASS_RATIO, static_cast<int>(p_Qdist), p_Max, p_Min);
+        if (blockValue) return std::min(std::max(p_Min, q), p_Max);                                     // block sampling: value drawn with the block (no-op unless BLOCK sampling)
+
+        RAND->QuasiRandomDimension(QMC_DIMENSION::MASS_RATIO);                                          // QMC sampling: first uniform drawn comes from the quasi-random point
+
         switch (p_Qdist) {
 
             case MASS_RATIO_DISTRIBUTION::FLAT:                                                                 // FLAT mass ratio distriution
@@ -1061,6 +1020,8 @@ namespace utils {
                 q = utils::InverseSampleFromPowerLaw(0.0, 1.0, 0.0);                                            // calculate q using power law with default values
         }
 
+        RAND->QuasiRandomDimensionClear();                                                              // in case the distribution drew nothing
+
         return std::min(std::max(p_Min, q), p_Max);                                                             // clamp to [min, max]
     }
 
@@ -1080,6 +1041,12 @@ namespace utils {
 
         double metallicity;
 
+        bool blockValue;
+        std::tie(blockValue, metallicity) = BLOCK_SAMPLER->Value(BLOCK_VARIATE::METALLICITY, static_cast<int>(p_Zdist), p_Max, p_Min);
+        if (blockValue) return metallicity;                                                             // block sampling: value drawn with the block (no-op unless BLOCK sampling)
+
+        RAND->QuasiRandomDimension(QMC_DIMENSION::METALLICITY);                                         // QMC sampling: first uniform drawn comes from the quasi-random point
+
         switch (p_Zdist) {                                                                              // which distribution?
 
             case METALLICITY_DISTRIBUTION::ZSOLAR:                                                      // ZSOLAR - all systems have Z = ZSOLAR
@@ -1096,6 +1063,8 @@ namespace utils {
                 metallicity = 0.0;
         }
 
+        RAND->QuasiRandomDimensionClear();                                                              // in case the distribution drew nothing
+
         return metallicity;
     }
 
@@ -1119,6 +1088,12 @@ namespace utils {
 
         double orbitalPeriod;
 
+        bool blockValue;
+        std::tie(blockValue, orbitalPeriod) = BLOCK_SAMPLER->Value(BLOCK_VARIATE::ORBITAL_PERIOD, static_cast<int>(p_Pdist), p_PdistMax, p_PdistMin);
+        if (blockValue) return orbitalPeriod;                                                           // block sampling: value drawn with the block (no-op unless BLOCK sampling)
+
+        RAND->QuasiRandomDimension(QMC_DIMENSION::SEPARATION);                                          // QMC sampling: first uniform drawn comes from the quasi-random point
+
         switch (p_Pdist) {                                                                                              // which distribution?
 
             case ORBITAL_PERIOD_DISTRIBUTION::FLATINLOG:                                                                // FLAT IN LOG
@@ -1130,6 +1105,8 @@ namespace utils {
                 orbitalPeriod = utils::InverseSampleFromPowerLaw(-1.0, 1000.0, 1.1);                                    // calculate orbitalPeriod using power law with default values
         }
 
+        RAND->QuasiRandomDimensionClear();                                                              // in case the distribution drew nothing
+
         return orbitalPeriod;
     }
 
@@ -1168,6 +1145,19 @@ namespace utils {
 
         double semiMajorAxis;
 
+        bool blockValue;                                                                                // block sampling: value drawn with the block (no-op unless BLOCK sampling)
+        if (p_Adist == SEMI_MAJOR_AXIS_DISTRIBUTION::SANA2012) {                                        // block value is the orbital period in days
+            double periodInDays;
+            std::tie(blockValue, periodInDays) = BLOCK_SAMPLER->Value(BLOCK_VARIATE::SEMI_MAJOR_AXIS, static_cast<int>(p_Adist), p_PdistMax, p_PdistMin, p_AdistPower);
+            if (blockValue) return utils::ConvertPeriodInDaysToSemiMajorAxisInAU(p_Mass1, p_Mass2, periodInDays);
+        }
+        else {
+            std::tie(blockValue, semiMajorAxis) = BLOCK_SAMPLER->Value(BLOCK_VARIATE::SEMI_MAJOR_AXIS, static_cast<int>(p_Adist), p_AdistMax, p_AdistMin, p_AdistPower);
+            if (blockValue) return semiMajorAxis;
+        }
+
+        RAND->QuasiRandomDimension(QMC_DIMENSION::SEPARATION);                                          // QMC sampling: first uniform drawn comes from the quasi-random point
+
         switch (p_Adist) {                                                                                              // which distribution?
 
             case SEMI_MAJOR_AXIS_DISTRIBUTION::FLATINLOG:                                                               // FLAT IN LOG
@@ -1212,6 +1202,8 @@ namespace utils {
                 semiMajorAxis = utils::InverseSampleFromPowerLaw(-1.0, 100.0, 0.5);                                     // calculate semiMajorAxis using power law with default values
         }
 
+        RAND->QuasiRandomDimensionClear();                                                              // in case the distribution drew nothing
+
         return semiMajorAxis;
     }
 
@@ -90,7 +90,7 @@ namespace utils {
     double                              intPow(const double p_Base, const int p_Exponent);
 
     double                              InverseSampleFromPowerLaw(const double p_Power, const double p_Xmax, const double p_Xmin);
-    double                              InverseSampleFromTabulatedCDF(const double p_Y, const std::map<double, double> p_Table);
+    double                              InverseSampleFromTabulatedCDF(const double p_Y, const TabulatedFunction& p_Table);
 
     int                                 IsBOOL(const std::string p_Str);
     bool                                IsDOUBLE(const std::string p_Str);
@@ -117,7 +117,7 @@ namespace utils {
 
 
     double                              SampleEccentricity(const ECCENTRICITY_DISTRIBUTION p_Edist, const double p_Max, const double p_Min);
-    double                              SampleFromTabulatedCDF(const double p_X, const std::map<double, double> pTable);
+    double                              SampleFromTabulatedCDF(const double p_X, const TabulatedFunction& p_Table);
     double                              SampleInitialMass(const INITIAL_MASS_FUNCTION p_IMF, const double p_Max, const double p_Min, const double p_Power);
     double                              SampleMassRatio(const MASS_RATIO_DISTRIBUTION p_Qdist, const double p_Max, const double p_Min);
     double                              SampleMetallicity(const METALLICITY_DISTRIBUTION p_Zdist, const double p_Max, const double p_Min);